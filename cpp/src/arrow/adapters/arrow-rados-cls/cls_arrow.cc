@@ -48,7 +48,6 @@ class RandomAccessObject : public arrow::io::RandomAccessFile {
   explicit RandomAccessObject(cls_method_context_t hctx, int64_t file_size) {
     hctx_ = hctx;
     content_length_ = file_size;
-    chunks_ = std::vector<ceph::bufferlist*>();
   }
 
   /// Check if the file stream is closed.
@@ -70,7 +69,21 @@ class RandomAccessObject : public arrow::io::RandomAccessFile {
     return arrow::Status::OK();
   }
 
-  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) { return 0; }
+  /// Read a specified number of bytes from a specified position into a
+  /// caller-provided buffer.
+  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) {
+    RETURN_NOT_OK(CheckClosed());
+    RETURN_NOT_OK(CheckPosition(position, "read"));
+
+    nbytes = std::min(nbytes, content_length_ - position);
+
+    if (nbytes > 0) {
+      ARROW_ASSIGN_OR_RAISE(auto bl, ReadObject(position, nbytes));
+      arrow::dataset::BufferlistRandomAccessFile file(std::move(bl));
+      return file.ReadAt(0, nbytes, out);
+    }
+    return 0;
+  }
 
   /// Read at a specified number of bytes from a specified position.
   arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) {
@@ -81,14 +94,26 @@ class RandomAccessObject : public arrow::io::RandomAccessFile {
     nbytes = std::min(nbytes, content_length_ - position);
 
     if (nbytes > 0) {
-      ceph::bufferlist* bl = new ceph::bufferlist();
-      cls_cxx_read(hctx_, position, nbytes, bl);
-      chunks_.push_back(bl);
-      return std::make_shared<arrow::Buffer>((uint8_t*)bl->c_str(), bl->length());
+      ARROW_ASSIGN_OR_RAISE(auto bl, ReadObject(position, nbytes));
+      // The returned buffer references the memory of the bufferlist, which is
+      // released as soon as the reader drops the buffer.
+      arrow::dataset::BufferlistRandomAccessFile file(std::move(bl));
+      return file.ReadAt(0, nbytes);
     }
     return std::make_shared<arrow::Buffer>("");
   }
 
+  /// Read a specified number of bytes from a specified position. Object class
+  /// methods may only access the object from the OSD thread running them, so the
+  /// read is done synchronously. Callers such as the Parquet reader's
+  /// pre-buffering use this to issue a few large coalesced reads instead of
+  /// many small ones.
+  arrow::Future<std::shared_ptr<arrow::Buffer>> ReadAsync(const arrow::io::IOContext&,
+                                                          int64_t position,
+                                                          int64_t nbytes) {
+    return ReadAt(position, nbytes);
+  }
+
   /// Read a specified number of bytes from the current position.
   arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) {
     ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(pos_, nbytes));
@@ -125,113 +150,36 @@ class RandomAccessObject : public arrow::io::RandomAccessFile {
     return pos_;
   }
 
-  /// Closes the file stream and deletes the chunks and releases the memory
-  /// used by the chunks.
+  /// Closes the file stream.
   arrow::Status Close() {
     closed_ = true;
-    for (auto chunk : chunks_) {
-      delete chunk;
-    }
     return arrow::Status::OK();
   }
 
   bool closed() const { return closed_; }
 
  protected:
+  /// Read a range of the object into a new bufferlist.
+  arrow::Result<std::shared_ptr<ceph::bufferlist>> ReadObject(int64_t position,
+                                                              int64_t nbytes) {
+    auto bl = std::make_shared<ceph::bufferlist>();
+    int e = cls_cxx_read(hctx_, position, nbytes, bl.get());
+    if (e < 0) {
+      return arrow::Status::IOError("cls_cxx_read returned error code ", e);
+    }
+    return bl;
+  }
+
   cls_method_context_t hctx_;
   bool closed_ = false;
   int64_t pos_ = 0;
   int64_t content_length_ = -1;
-  std::vector<ceph::bufferlist*> chunks_;
 };
 
-/// \brief Scan RADOS objects containing Arrow IPC data.
-/// \param[in] hctx RADOS object context.
-/// \param[in] filter The filter expression to apply.
-/// \param[in] partition_expression The partition expression to use.
-/// \param[in] projection_schema The projection schema.
-/// \param[in] dataset_schema The dataset schema.
-/// \param[out] result_table Table to store the resultant data.
-/// \param[in] object_size The size of the object.
-/// \return Status.
-static arrow::Status ScanIpcObject(cls_method_context_t hctx,
-                                   arrow::compute::Expression filter,
-                                   arrow::compute::Expression partition_expression,
-                                   std::shared_ptr<arrow::Schema> projection_schema,
-                                   std::shared_ptr<arrow::Schema> dataset_schema,
-                                   std::shared_ptr<arrow::Table>& result_table,
-                                   int64_t object_size) {
-  auto file = std::make_shared<RandomAccessObject>(hctx, object_size);
-  arrow::dataset::FileSource source(file, arrow::Compression::LZ4_FRAME);
-
-  auto format = std::make_shared<arrow::dataset::IpcFileFormat>();
-  ARROW_ASSIGN_OR_RAISE(auto fragment,
-                        format->MakeFragment(source, partition_expression));
-
-  auto options = std::make_shared<arrow::dataset::ScanOptions>();
-  auto builder =
-      std::make_shared<arrow::dataset::ScannerBuilder>(dataset_schema, fragment, options);
-
-  ARROW_RETURN_NOT_OK(builder->Filter(filter));
-  ARROW_RETURN_NOT_OK(builder->Project(projection_schema->field_names()));
-  ARROW_RETURN_NOT_OK(builder->UseThreads(false));
-
-  ARROW_ASSIGN_OR_RAISE(auto scanner, builder->Finish());
-  ARROW_ASSIGN_OR_RAISE(auto table, scanner->ToTable());
-
-  result_table = table;
-
-  ARROW_RETURN_NOT_OK(file->Close());
-  return arrow::Status::OK();
-}
-
-/// \brief Scan RADOS objects containing Parquet binary data.
-/// \param[in] hctx RADOS object context.
-/// \param[in] filter The filter expression to apply.
-/// \param[in] partition_expression The partition expression to use.
-/// \param[in] projection_schema The projection schema.
-/// \param[in] dataset_schema The dataset schema.
-/// \param[out] result_table Table to store the resultant data.
-/// \param[in] object_size The size of the object.
-/// \return Status.
-static arrow::Status ScanParquetObject(cls_method_context_t hctx,
-                                       arrow::compute::Expression filter,
-                                       arrow::compute::Expression partition_expression,
-                                       std::shared_ptr<arrow::Schema> projection_schema,
-                                       std::shared_ptr<arrow::Schema> dataset_schema,
-                                       std::shared_ptr<arrow::Table>& result_table,
-                                       int64_t object_size) {
-  auto file = std::make_shared<RandomAccessObject>(hctx, object_size);
-  arrow::dataset::FileSource source(file);
-
-  auto format = std::make_shared<arrow::dataset::ParquetFileFormat>();
-
-  auto fragment_scan_options =
-      std::make_shared<arrow::dataset::ParquetFragmentScanOptions>();
-
-  ARROW_ASSIGN_OR_RAISE(auto fragment,
-                        format->MakeFragment(source, partition_expression));
-  auto options = std::make_shared<arrow::dataset::ScanOptions>();
-  auto builder =
-      std::make_shared<arrow::dataset::ScannerBuilder>(dataset_schema, fragment, options);
-
-  ARROW_RETURN_NOT_OK(builder->Filter(filter));
-  ARROW_RETURN_NOT_OK(builder->Project(projection_schema->field_names()));
-  ARROW_RETURN_NOT_OK(builder->UseThreads(false));
-  ARROW_RETURN_NOT_OK(builder->FragmentScanOptions(fragment_scan_options));
-
-  ARROW_ASSIGN_OR_RAISE(auto scanner, builder->Finish());
-  ARROW_ASSIGN_OR_RAISE(auto table, scanner->ToTable());
-
-  result_table = table;
-
-  ARROW_RETURN_NOT_OK(file->Close());
-  return arrow::Status::OK();
-}
-
 /// \brief The scanning operation to register on Ceph nodes. The request is
-/// deserialized, the object is scanned, and the resulting table is serialized
-/// and sent to the client.
+/// deserialized, the object is scanned, and the resulting record batches are
+/// serialized batch by batch and sent to the client. If the request carries
+/// aggregates, only their partial results per group are sent instead.
 /// \param[in] hctx RADOS object context.
 /// \param[in] in Input bufferlist.
 /// \param[out] out Output bufferlist.
@@ -246,40 +194,35 @@ static int scan_op(cls_method_context_t hctx, ceph::bufferlist* in,
   std::shared_ptr<arrow::Schema> dataset_schema;
   int64_t file_size;
   int64_t file_format = 0;  // 0 = Parquet, 1 = Ipc
+  std::vector<int> row_groups;
+  std::vector<arrow::dataset::PushdownAggregate> aggregates;
+  std::vector<std::string> keys;
+  std::string compression;
 
   // Deserialize the scan request
-  if (!(s = arrow::dataset::DeserializeScanRequest(&filter, &partition_expression,
-                                                   &projection_schema, &dataset_schema,
-                                                   file_size, file_format, *in))
+  if (!(s = arrow::dataset::DeserializeScanRequest(
+            &filter, &partition_expression, &projection_schema, &dataset_schema,
+            file_size, file_format, *in, &row_groups, &aggregates, &keys,
+            &compression))
            .ok()) {
     CLS_LOG(0, "error: %s", s.message().c_str());
     return SCAN_REQ_DESER_ERR_CODE;
   }
 
-  // Scan the object
-  std::shared_ptr<arrow::Table> table;
-  if (file_format == 0) {
-    s = ScanParquetObject(hctx, filter, partition_expression, projection_schema,
-                          dataset_schema, table, file_size);
-  } else if (file_format == 1) {
-    s = ScanIpcObject(hctx, filter, partition_expression, projection_schema,
-                      dataset_schema, table, file_size);
-  } else {
-    s = arrow::Status::Invalid("Invalid file format");
+  // Scan the object, serializing the resultant record batches straight into the
+  // output bufferlist as they are produced.
+  auto file = std::make_shared<RandomAccessObject>(hctx, file_size);
+  s = arrow::dataset::ScanObject(file, filter, partition_expression, projection_schema,
+                                 dataset_schema, file_format, row_groups, aggregates,
+                                 keys, compression, *out);
+  if (s.ok()) {
+    s = file->Close();
   }
   if (!s.ok()) {
     CLS_LOG(0, "error: %s", s.message().c_str());
     return SCAN_ERR_CODE;
   }
 
-  // Serialize the resultant table to send back to the client
-  ceph::bufferlist bl;
-  if (!(s = arrow::dataset::SerializeTable(table, bl)).ok()) {
-    CLS_LOG(0, "error: %s", s.message().c_str());
-    return SCAN_RES_SER_ERR_CODE;
-  }
-
-  *out = bl;
   return 0;
 }
 
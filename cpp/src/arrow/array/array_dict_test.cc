@@ -454,6 +454,23 @@ TEST(TestStringDictionaryBuilder, AppendIndices) {
   TestStringDictionaryAppendIndices<StringDictionary32Builder, Int32Type, int32_t>();
 }
 
+TEST(TestStringDictionaryBuilder, GetOrInsertMemoValue) {
+  StringDictionary32Builder builder;
+  ASSERT_OK(builder.InsertMemoValues(*ArrayFromJSON(utf8(), R"(["c", "a"])")));
+
+  int32_t memo_index = -1;
+  ASSERT_OK(builder.GetOrInsertMemoValue("a", &memo_index));
+  ASSERT_EQ(1, memo_index);
+  ASSERT_OK(builder.GetOrInsertMemoValue("b", &memo_index));
+  ASSERT_EQ(2, memo_index);
+  ASSERT_OK(builder.GetOrInsertMemoValue("c", &memo_index));
+  ASSERT_EQ(0, memo_index);
+
+  // No index was appended
+  ASSERT_EQ(0, builder.length());
+  ASSERT_EQ(3, builder.dictionary_length());
+}
+
 TEST(TestStringDictionaryBuilder, ArrayInit) {
   auto dict_array = ArrayFromJSON(utf8(), R"(["test", "test2"])");
   auto int_array = ArrayFromJSON(int8(), "[0, 1, 0]");
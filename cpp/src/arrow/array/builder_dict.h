@@ -291,6 +291,14 @@ class DictionaryBuilderBase : public ArrayBuilder {
     return memo_table_->InsertValues(values);
   }
 
+  /// \brief Insert a value into the dictionary's memo, if not already there, and
+  /// return its index in the memo, but do not append any index
+  ///
+  /// NOTE: Experimental API
+  Status GetOrInsertMemoValue(Value value, int32_t* memo_index) {
+    return memo_table_->GetOrInsert<T>(value, memo_index);
+  }
+
   /// \brief Append a whole dense array to the builder
   template <typename T1 = T>
   enable_if_t<!is_fixed_size_binary_type<T1>::value, Status> AppendArray(
@@ -335,6 +335,11 @@ class ARROW_EXPORT Grouper {
   /// be as wide as necessary.
   virtual Result<Datum> Consume(const ExecBatch& batch) = 0;
 
+  /// Look up a batch of keys without consuming them, producing the corresponding
+  /// group ids as an integer array. Keys which were never consumed have a null
+  /// group id.
+  virtual Result<Datum> Find(const ExecBatch& batch) = 0;
+
   /// Get current unique keys. May be called multiple times.
   virtual Result<ExecBatch> GetUniques() = 0;
 
@@ -414,6 +419,27 @@ Result<Datum> GroupBy(const std::vector<Datum>& arguments, const std::vector<Dat
                       const std::vector<Aggregate>& aggregates,
                       ExecContext* ctx = default_exec_context());
 
+/// Internal use only: look up the HashAggregateKernel of each aggregate for the
+/// descriptor of its argument.
+ARROW_EXPORT
+Result<std::vector<const HashAggregateKernel*>> GetKernels(
+    ExecContext* ctx, const std::vector<Aggregate>& aggregates,
+    const std::vector<ValueDescr>& in_descrs);
+
+/// Internal use only: initialize a KernelState for each aggregate.
+ARROW_EXPORT
+Result<std::vector<std::unique_ptr<KernelState>>> InitKernels(
+    const std::vector<const HashAggregateKernel*>& kernels, ExecContext* ctx,
+    const std::vector<Aggregate>& aggregates, const std::vector<ValueDescr>& in_descrs);
+
+/// Internal use only: resolve the output field of each aggregate.
+ARROW_EXPORT
+Result<FieldVector> ResolveKernels(
+    const std::vector<Aggregate>& aggregates,
+    const std::vector<const HashAggregateKernel*>& kernels,
+    const std::vector<std::unique_ptr<KernelState>>& states, ExecContext* ctx,
+    const std::vector<ValueDescr>& descrs);
+
 }  // namespace internal
 }  // namespace compute
 }  // namespace arrow
@@ -119,6 +119,20 @@ class ARROW_EXPORT SortOptions : public FunctionOptions {
   std::vector<SortKey> sort_keys;
 };
 
+/// \brief Options for select_k_unstable
+class ARROW_EXPORT SelectKOptions : public FunctionOptions {
+ public:
+  explicit SelectKOptions(int64_t k = -1, std::vector<SortKey> sort_keys = {});
+  constexpr static char const kTypeName[] = "SelectKOptions";
+  static SelectKOptions Defaults() { return SelectKOptions{}; }
+
+  /// The number of rows to select, must be non-negative.
+  int64_t k;
+  /// The columns to order by and how to order by them.  For array and
+  /// chunked array inputs, only the order of the first key is used.
+  std::vector<SortKey> sort_keys;
+};
+
 /// \brief Partitioning options for NthToIndices
 class ARROW_EXPORT PartitionNthOptions : public FunctionOptions {
  public:
@@ -283,6 +297,32 @@ ARROW_EXPORT
 Result<std::shared_ptr<Array>> SortIndices(const Datum& datum, const SortOptions& options,
                                            ExecContext* ctx = NULLPTR);
 
+/// \brief Returns the indices of the first k rows of an input in the
+/// specified order. Input is one of array, chunked array, record batch
+/// or table.
+///
+/// The output is the same as the first k indices of SortIndices, except
+/// that rows comparing equal on all sort keys may be output in any order.
+/// Only k rows are kept at any time, so this is much cheaper than sorting
+/// the whole input when k is small.
+///
+/// For example given input (table) = {
+/// "column1": [[null,   1], [   3, null, 2, 1]],
+/// "column2": [[   5], [3,   null, null, 5, 5]],
+/// } and options = {3, {
+/// {"column1", SortOrder::Ascending},
+/// {"column2", SortOrder::Descending},
+/// }}, the output will be [5, 1, 4].
+///
+/// \param[in] datum array, chunked array, record batch or table to select from
+/// \param[in] options options
+/// \param[in] ctx the function execution context, optional
+/// \return indices of the selected rows, in sorted order
+ARROW_EXPORT
+Result<std::shared_ptr<Array>> SelectKUnstable(const Datum& datum,
+                                               const SelectKOptions& options,
+                                               ExecContext* ctx = NULLPTR);
+
 /// \brief Compute unique elements from an array-like object
 ///
 /// Note if a null occurs in the input it will NOT be included in the output.
@@ -30,6 +30,7 @@
 #include "arrow/array/util.h"
 #include "arrow/buffer.h"
 #include "arrow/chunked_array.h"
+#include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec_internal.h"
 #include "arrow/compute/function.h"
 #include "arrow/compute/kernel.h"
@@ -42,6 +43,7 @@
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bit_run_reader.h"
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_ops.h"
 #include "arrow/util/checked_cast.h"
@@ -55,7 +57,9 @@ namespace arrow {
 using internal::BitmapAnd;
 using internal::checked_cast;
 using internal::CopyBitmap;
+using internal::CountSetBits;
 using internal::CpuInfo;
+using internal::VisitSetBitRunsVoid;
 
 namespace compute {
 
@@ -71,7 +75,12 @@ ExecBatch::ExecBatch(const RecordBatch& batch)
 }
 
 bool ExecBatch::Equals(const ExecBatch& other) const {
-  return guarantee == other.guarantee && values == other.values;
+  if (guarantee != other.guarantee || values != other.values) return false;
+  if (selection_vector == nullptr || other.selection_vector == nullptr) {
+    return selection_vector == other.selection_vector;
+  }
+  return MakeArray(selection_vector->data())
+      ->Equals(*MakeArray(other.selection_vector->data()));
 }
 
 void PrintTo(const ExecBatch& batch, std::ostream* os) {
@@ -83,6 +92,13 @@ void PrintTo(const ExecBatch& batch, std::ostream* os) {
   if (batch.guarantee != literal(true)) {
     *os << indent << "Guarantee: " << batch.guarantee.ToString() << "\n";
   }
+  if (batch.selection_vector != nullptr) {
+    PrettyPrintOptions options;
+    options.skip_new_lines = true;
+    *os << indent << "Selection: ";
+    ARROW_CHECK_OK(PrettyPrint(*MakeArray(batch.selection_vector->data()), options, os));
+    *os << "\n";
+  }
 
   int i = 0;
   for (const Datum& value : batch.values) {
@@ -103,12 +119,32 @@ void PrintTo(const ExecBatch& batch, std::ostream* os) {
 }
 
 ExecBatch ExecBatch::Slice(int64_t offset, int64_t length) const {
+  // as with ArrayData::Slice, the slice may not extend past the end of the batch
+  length = std::min(length, this->length - offset);
   ExecBatch out = *this;
+  out.length = length;
+  if (selection_vector != nullptr) {
+    // the values are left untouched; only the selected rows are sliced
+    auto selection = selection_vector->data()->Slice(offset, length);
+    out.selection_vector = std::make_shared<SelectionVector>(std::move(selection));
+    return out;
+  }
   for (auto& value : out.values) {
     if (value.is_scalar()) continue;
     value = value.array()->Slice(offset, length);
   }
-  out.length = length;
+  return out;
+}
+
+Result<ExecBatch> ExecBatch::Materialize(ExecContext* ctx) const {
+  if (selection_vector == nullptr) return *this;
+
+  ExecBatch out = *this;
+  out.selection_vector.reset();
+  out.length = selection_vector->length();
+  for (auto& value : out.values) {
+    ARROW_ASSIGN_OR_RAISE(value, selection_vector->Apply(value, ctx));
+  }
   return out;
 }
 
@@ -1009,8 +1045,39 @@ SelectionVector::SelectionVector(const Array& arr) : SelectionVector(arr.data())
 int32_t SelectionVector::length() const { return static_cast<int32_t>(data_->length); }
 
 Result<std::shared_ptr<SelectionVector>> SelectionVector::FromMask(
-    const BooleanArray& arr) {
-  return Status::NotImplemented("FromMask");
+    const BooleanArray& arr, MemoryPool* pool) {
+  const ArrayData& data = *arr.data();
+
+  // a slot is selected if it is both valid and true
+  const uint8_t* bitmap = data.buffers[1]->data();
+  int64_t offset = data.offset;
+  std::shared_ptr<Buffer> selected;
+  if (data.GetNullCount() > 0) {
+    ARROW_ASSIGN_OR_RAISE(selected, BitmapAnd(pool, data.buffers[0]->data(), data.offset,
+                                              bitmap, data.offset, data.length,
+                                              /*out_offset=*/0));
+    bitmap = selected->data();
+    offset = 0;
+  }
+
+  const int64_t num_selected = CountSetBits(bitmap, offset, data.length);
+  ARROW_ASSIGN_OR_RAISE(auto indices,
+                        AllocateBuffer(num_selected * sizeof(int32_t), pool));
+  auto out = reinterpret_cast<int32_t*>(indices->mutable_data());
+  VisitSetBitRunsVoid(bitmap, offset, data.length, [&](int64_t position, int64_t length) {
+    for (int64_t i = 0; i < length; ++i) {
+      *out++ = static_cast<int32_t>(position + i);
+    }
+  });
+
+  return std::make_shared<SelectionVector>(
+      ArrayData::Make(int32(), num_selected, {nullptr, std::move(indices)},
+                      /*null_count=*/0));
+}
+
+Result<Datum> SelectionVector::Apply(const Datum& value, ExecContext* ctx) const {
+  if (value.is_scalar()) return value;
+  return Take(value, Datum(data_), TakeOptions::NoBoundsCheck(), ctx);
 }
 
 Result<Datum> CallFunction(const std::string& func_name, const std::vector<Datum>& args,
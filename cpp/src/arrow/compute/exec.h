@@ -134,7 +134,10 @@ ARROW_EXPORT ExecContext* default_exec_context();
 /// implementations. This is especially relevant for aggregations but also
 /// applies to scalar operations.
 ///
-/// We are not yet using this so this is mostly a placeholder for now.
+/// In an ExecPlan, filter nodes attach a SelectionVector to the batches they emit
+/// rather than copying every column. ExecuteScalarExpression gathers only the
+/// referenced columns, so that kernels evaluate only the selected rows, and nodes
+/// which cannot use a selection apply it on receipt (see ExecBatch::Materialize).
 ///
 /// [1]: http://cidrdb.org/cidr2005/papers/P19.pdf
 class ARROW_EXPORT SelectionVector {
@@ -144,11 +147,20 @@ class ARROW_EXPORT SelectionVector {
   explicit SelectionVector(const Array& arr);
 
   /// \brief Create SelectionVector from boolean mask
-  static Result<std::shared_ptr<SelectionVector>> FromMask(const BooleanArray& arr);
+  ///
+  /// The indices of the true values are selected; nulls are not.
+  static Result<std::shared_ptr<SelectionVector>> FromMask(
+      const BooleanArray& arr, MemoryPool* pool = default_memory_pool());
 
   const int32_t* indices() const { return indices_; }
   int32_t length() const;
 
+  /// \brief The selection as an Int32 array
+  const std::shared_ptr<ArrayData>& data() const { return data_; }
+
+  /// \brief Gather the selected rows of an array value. Scalars are returned as is.
+  Result<Datum> Apply(const Datum& value, ExecContext* ctx = NULLPTR) const;
+
  private:
   std::shared_ptr<ArrayData> data_;
   const int32_t* indices_;
@@ -212,8 +224,13 @@ struct ARROW_EXPORT ExecBatch {
   /// \brief A convenience for the number of values / arguments.
   int num_values() const { return static_cast<int>(values.size()); }
 
+  /// \brief Slice the rows of the batch. If a selection vector is set, it is sliced
+  /// instead of the values.
   ExecBatch Slice(int64_t offset, int64_t length) const;
 
+  /// \brief Apply the selection vector, if any, returning a batch without one.
+  Result<ExecBatch> Materialize(ExecContext* ctx = NULLPTR) const;
+
   /// \brief A convenience for returning the ValueDescr objects (types and
   /// shapes) from the batch.
   std::vector<ValueDescr> GetDescriptors() const {
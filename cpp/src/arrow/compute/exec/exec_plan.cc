@@ -17,18 +17,47 @@
 
 #include "arrow/compute/exec/exec_plan.h"
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
+#include "arrow/array/builder_primitive.h"
+#include "arrow/array/concatenate.h"
+#include "arrow/array/util.h"
+#include "arrow/buffer_builder.h"
+#include "arrow/compute/api_aggregate.h"
 #include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec.h"
 #include "arrow/compute/exec/expression.h"
+#include "arrow/compute/kernel.h"
+#include "arrow/compute/kernels/vector_sort_internal.h"
 #include "arrow/datum.h"
+#include "arrow/io/file.h"
+#include "arrow/memory_pool.h"
+#include "arrow/record_batch.h"
 #include "arrow/result.h"
 #include "arrow/util/async_generator.h"
+#include "arrow/util/bit_util.h"
 #include "arrow/util/checked_cast.h"
+#include "arrow/util/config.h"
+#include "arrow/util/hash_util.h"
+#include "arrow/util/hashing.h"
+#include "arrow/util/io_util.h"
+#include "arrow/util/iterator.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/make_unique.h"
 #include "arrow/util/optional.h"
+#include "arrow/util/thread_pool.h"
+#include "arrow/util/ubsan.h"
+
+#ifdef ARROW_IPC
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#endif
 
 namespace arrow {
 
@@ -39,9 +68,10 @@ namespace compute {
 namespace {
 
 struct ExecPlanImpl : public ExecPlan {
-  ExecPlanImpl() = default;
+  explicit ExecPlanImpl(SchedulingOptions options) : options_(std::move(options)) {}
 
   ~ExecPlanImpl() override {
+    // Every task holds a reference to the plan, so none is running any more
     if (started_ && !stopped_) {
       StopProducing();
     }
@@ -58,6 +88,40 @@ struct ExecPlanImpl : public ExecPlan {
     return nodes_.back().get();
   }
 
+  Status ScheduleTask(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(tasks_mutex_);
+      ++num_tasks_running_;
+    }
+    if (options_.executor == nullptr) {
+      task();
+      OnTaskFinished();
+      return Status::OK();
+    }
+
+    // The task keeps the plan alive: nodes may still push batches while the last
+    // other reference to the plan is dropped
+    auto self = std::static_pointer_cast<ExecPlanImpl>(shared_from_this());
+    auto st = options_.executor->Spawn([self, task] {
+      task();
+      self->OnTaskFinished();
+    });
+    if (!st.ok()) {
+      OnTaskFinished();
+    }
+    return st;
+  }
+
+  void OnTaskFinished() {
+    bool mark_finished;
+    {
+      std::lock_guard<std::mutex> lock(tasks_mutex_);
+      mark_finished = --num_tasks_running_ == 0 && stopped_ && !finished_marked_;
+      if (mark_finished) finished_marked_ = true;
+    }
+    if (mark_finished) finished_.MarkFinished();
+  }
+
   Status Validate() const {
     if (nodes_.empty()) {
       return Status::Invalid("ExecPlan has no node");
@@ -93,11 +157,22 @@ struct ExecPlanImpl : public ExecPlan {
 
   void StopProducing() {
     DCHECK(started_) << "stopped an ExecPlan which never started";
-    stopped_ = true;
+    {
+      std::lock_guard<std::mutex> lock(tasks_mutex_);
+      stopped_ = true;
+    }
 
     for (const auto& node : sorted_nodes_) {
       node->StopProducing();
     }
+
+    bool mark_finished;
+    {
+      std::lock_guard<std::mutex> lock(tasks_mutex_);
+      mark_finished = num_tasks_running_ == 0 && !finished_marked_;
+      if (mark_finished) finished_marked_ = true;
+    }
+    if (mark_finished) finished_.MarkFinished();
   }
 
   NodeVector TopoSort() {
@@ -133,6 +208,14 @@ struct ExecPlanImpl : public ExecPlan {
     return std::move(Impl{nodes_}.sorted);
   }
 
+  const SchedulingOptions options_;
+
+  std::mutex tasks_mutex_;
+  int64_t num_tasks_running_ = 0;
+  // Marked once the plan has been stopped and none of its tasks is running
+  Future<> finished_ = Future<>::Make();
+  bool finished_marked_ = false;
+
   bool started_ = false, stopped_ = false;
   std::vector<std::unique_ptr<ExecNode>> nodes_;
   NodeVector sorted_nodes_;
@@ -155,8 +238,18 @@ util::optional<int> GetNodeIndex(const std::vector<ExecNode*>& nodes,
 
 }  // namespace
 
-Result<std::shared_ptr<ExecPlan>> ExecPlan::Make() {
-  return std::make_shared<ExecPlanImpl>();
+constexpr int64_t SchedulingOptions::kDefaultMorselSize;
+
+SchedulingOptions SchedulingOptions::Defaults() { return SchedulingOptions(); }
+
+Result<std::shared_ptr<ExecPlan>> ExecPlan::Make(SchedulingOptions options) {
+  if (options.morsel_size <= 0) {
+    return Status::Invalid("Morsel size must be positive, got ", options.morsel_size);
+  }
+  if (options.max_tasks_in_flight < 0 && options.executor != nullptr) {
+    options.max_tasks_in_flight = 2 * options.executor->GetCapacity();
+  }
+  return std::make_shared<ExecPlanImpl>(std::move(options));
 }
 
 ExecNode* ExecPlan::AddNode(std::unique_ptr<ExecNode> node) {
@@ -175,6 +268,24 @@ Status ExecPlan::StartProducing() { return ToDerived(this)->StartProducing(); }
 
 void ExecPlan::StopProducing() { ToDerived(this)->StopProducing(); }
 
+Future<> ExecPlan::finished() { return ToDerived(this)->finished_; }
+
+const SchedulingOptions& ExecPlan::scheduling_options() const {
+  return ToDerived(this)->options_;
+}
+
+Status ExecPlan::ScheduleTask(ExecNode* node, std::function<void()> task) {
+  ++node->num_tasks_scheduled_;
+  auto st = ToDerived(this)->ScheduleTask([node, task] {
+    task();
+    ++node->num_tasks_finished_;
+  });
+  if (!st.ok()) {
+    --node->num_tasks_scheduled_;
+  }
+  return st;
+}
+
 ExecNode::ExecNode(ExecPlan* plan, std::string label, NodeVector inputs,
                    std::vector<std::string> input_labels,
                    std::shared_ptr<Schema> output_schema, int num_outputs)
@@ -233,9 +344,13 @@ struct SourceNode : ExecNode {
     finished_fut_ =
         Loop([this] {
           std::unique_lock<std::mutex> lock(mutex_);
-          int seq = next_batch_index_++;
           if (finished_) {
-            return Future<ControlFlow<int>>::MakeFinished(Break(seq));
+            return Future<ControlFlow<int>>::MakeFinished(Break(next_batch_index_));
+          }
+          if (!CanProduceUnlocked()) {
+            // Wait until one of our tasks finishes or our output resumes
+            ready_ = Future<>::Make();
+            return ready_.Then([]() -> ControlFlow<int> { return Continue(); });
           }
           lock.unlock();
 
@@ -244,15 +359,11 @@ struct SourceNode : ExecNode {
                 std::unique_lock<std::mutex> lock(mutex_);
                 if (!batch || finished_) {
                   finished_ = true;
-                  return Break(seq);
+                  return Break(next_batch_index_);
                 }
                 lock.unlock();
 
-                // TODO check if we are on the desired Executor and transfer if not.
-                // This can happen for in-memory scans where batches didn't require
-                // any CPU work to decode. Otherwise, parsing etc should have already
-                // been placed us on the thread pool
-                outputs_[0]->InputReceived(this, seq, *batch);
+                ScheduleMorsels(*batch);
                 return Continue();
               },
               [=](const Status& error) -> ControlFlow<int> {
@@ -264,8 +375,9 @@ struct SourceNode : ExecNode {
                   // XXX is this correct? Is it reasonable for a consumer to
                   // ignore errors from a finished producer?
                   outputs_[0]->ErrorReceived(this, error);
+                  lock.lock();
                 }
-                return Break(seq);
+                return Break(next_batch_index_);
               });
         }).Then([&](int seq) {
           /// XXX this is probably redundant: do we always call InputFinished after
@@ -276,16 +388,94 @@ struct SourceNode : ExecNode {
     return Status::OK();
   }
 
-  void PauseProducing(ExecNode* output) override {}
+  // Push each morsel of a batch to our output in a task of its own
+  void ScheduleMorsels(const ExecBatch& batch) {
+    const int64_t morsel_size = plan_->scheduling_options().morsel_size;
+    int64_t offset = 0;
+    do {
+      ExecBatch morsel = batch.length > morsel_size ? batch.Slice(offset, morsel_size)
+                                                    : batch;
+      int seq;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (finished_) return;
+        seq = next_batch_index_++;
+        ++num_tasks_in_flight_;
+      }
 
-  void ResumeProducing(ExecNode* output) override {}
+      auto st = plan_->ScheduleTask(this, [this, seq, morsel] {
+        outputs_[0]->InputReceived(this, seq, morsel);
+        OnTaskFinished();
+      });
+      if (!st.ok()) {
+        // The morsel was counted but will never be received: fail the output instead
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          --num_tasks_in_flight_;
+          finished_ = true;
+        }
+        outputs_[0]->ErrorReceived(this, std::move(st));
+        return;
+      }
+      offset += morsel_size;
+    } while (offset < batch.length);
+  }
+
+  bool CanProduceUnlocked() const {
+    auto max_tasks_in_flight = plan_->scheduling_options().max_tasks_in_flight;
+    return num_pauses_ <= 0 &&
+           (max_tasks_in_flight < 0 || num_tasks_in_flight_ < max_tasks_in_flight);
+  }
+
+  // Return the future the production loop waits on, if any, to be marked finished
+  // once the lock is released
+  Future<> WakeUnlocked() {
+    if (ready_.is_finished()) return Future<>();
+    Future<> ready = std::move(ready_);
+    ready_ = Future<>::MakeFinished();
+    return ready;
+  }
+
+  static void Wake(Future<> ready) {
+    if (ready.is_valid()) ready.MarkFinished();
+  }
+
+  void OnTaskFinished() {
+    Future<> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_tasks_in_flight_;
+      if (CanProduceUnlocked()) ready = WakeUnlocked();
+    }
+    Wake(std::move(ready));
+  }
+
+  // Pause and resume calls may arrive in any order from concurrent threads, hence
+  // the count rather than a flag
+  void PauseProducing(ExecNode* output) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_pauses_;
+  }
+
+  void ResumeProducing(ExecNode* output) override {
+    Future<> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_pauses_;
+      if (CanProduceUnlocked()) ready = WakeUnlocked();
+    }
+    Wake(std::move(ready));
+  }
 
   void StopProducing(ExecNode* output) override {
     DCHECK_EQ(output, outputs_[0]);
+    Future<> ready;
     {
       std::unique_lock<std::mutex> lock(mutex_);
       finished_ = true;
+      ready = WakeUnlocked();
     }
+    Wake(std::move(ready));
     finished_fut_.Wait();
   }
 
@@ -295,6 +485,10 @@ struct SourceNode : ExecNode {
   std::mutex mutex_;
   bool finished_{false};
   int next_batch_index_{0};
+  int num_tasks_in_flight_{0};
+  int num_pauses_{0};
+  // Finished unless the production loop waits for a task to finish or a resume
+  Future<> ready_ = Future<>::MakeFinished();
   Future<> finished_fut_ = Future<>::MakeFinished();
   AsyncGenerator<util::optional<ExecBatch>> generator_;
 };
@@ -331,12 +525,40 @@ struct FilterNode : ExecNode {
       return target.Slice(0, 0);
     }
 
-    auto values = target.values;
-    for (auto& value : values) {
-      if (value.is_scalar()) continue;
-      ARROW_ASSIGN_OR_RAISE(value, Filter(value, mask, FilterOptions::Defaults()));
+    // Rather than copying every column, defer the filter to our output as a selection
+    // of the rows of the target's values
+    ARROW_ASSIGN_OR_RAISE(auto selection,
+                          SelectionVector::FromMask(BooleanArray(mask.array())));
+    if (selection->length() == target.length) {
+      return target;
     }
-    return ExecBatch::Make(std::move(values));
+
+    if (target.selection_vector != nullptr) {
+      // the mask was evaluated over the rows already selected
+      ARROW_ASSIGN_OR_RAISE(
+          Datum composed,
+          Take(target.selection_vector->data(), selection->data(),
+               TakeOptions::NoBoundsCheck()));
+      selection = std::make_shared<SelectionVector>(composed.array());
+    }
+
+    ExecBatch out = target;
+    out.selection_vector = std::move(selection);
+    out.length = out.selection_vector->length();
+
+    // Once few enough rows remain, copying them is cheaper than carrying every row of
+    // the values through the rest of the plan
+    int64_t num_rows = out.length;
+    for (const auto& value : target.values) {
+      if (value.is_array()) {
+        num_rows = value.length();
+        break;
+      }
+    }
+    if (out.length < kMaterializeSelectivity * num_rows) {
+      return out.Materialize();
+    }
+    return out;
   }
 
   void InputReceived(ExecNode* input, int seq, ExecBatch batch) override {
@@ -366,9 +588,9 @@ struct FilterNode : ExecNode {
 
   Status StartProducing() override { return Status::OK(); }
 
-  void PauseProducing(ExecNode* output) override {}
+  void PauseProducing(ExecNode* output) override { inputs_[0]->PauseProducing(this); }
 
-  void ResumeProducing(ExecNode* output) override {}
+  void ResumeProducing(ExecNode* output) override { inputs_[0]->ResumeProducing(this); }
 
   void StopProducing(ExecNode* output) override {
     DCHECK_EQ(output, outputs_[0]);
@@ -378,9 +600,15 @@ struct FilterNode : ExecNode {
   void StopProducing() override { StopProducing(outputs_[0]); }
 
  private:
+  // The fraction of the rows of a batch's values below which a selection is applied
+  // immediately instead of being deferred
+  static constexpr double kMaterializeSelectivity = 0.125;
+
   Expression filter_;
 };
 
+constexpr double FilterNode::kMaterializeSelectivity;
+
 Result<ExecNode*> MakeFilterNode(ExecNode* input, std::string label, Expression filter) {
   if (!filter.IsBound()) {
     ARROW_ASSIGN_OR_RAISE(filter, filter.Bind(*input->output_schema()));
@@ -445,9 +673,9 @@ struct ProjectNode : ExecNode {
 
   Status StartProducing() override { return Status::OK(); }
 
-  void PauseProducing(ExecNode* output) override {}
+  void PauseProducing(ExecNode* output) override { inputs_[0]->PauseProducing(this); }
 
-  void ResumeProducing(ExecNode* output) override {}
+  void ResumeProducing(ExecNode* output) override { inputs_[0]->ResumeProducing(this); }
 
   void StopProducing(ExecNode* output) override {
     DCHECK_EQ(output, outputs_[0]);
@@ -477,83 +705,1657 @@ Result<ExecNode*> MakeProjectNode(ExecNode* input, std::string label,
       input, std::move(label), schema(std::move(fields)), std::move(exprs));
 }
 
-struct SinkNode : ExecNode {
-  SinkNode(ExecNode* input, std::string label,
-           AsyncGenerator<util::optional<ExecBatch>>* generator)
-      : ExecNode(input->plan(), std::move(label), {input}, {"collected"}, {},
-                 /*num_outputs=*/0),
-        producer_(MakeProducer(generator)) {}
+// Hash each value of an array into `hashes`. Nulls hash alike, whatever value lies
+// beneath them.
+Status HashValues(const ArrayData& data, std::vector<size_t>* hashes) {
+  hashes->assign(data.length, 0);
+  size_t* out = hashes->data();
 
-  static PushGenerator<util::optional<ExecBatch>>::Producer MakeProducer(
-      AsyncGenerator<util::optional<ExecBatch>>* out_gen) {
-    PushGenerator<util::optional<ExecBatch>> gen;
-    auto out = gen.producer();
-    *out_gen = std::move(gen);
+  const uint8_t* validity = data.GetNullCount() > 0 ? data.buffers[0]->data() : nullptr;
+  auto hash = [&](int64_t i, const uint8_t* value, int64_t length) {
+    if (validity == nullptr || BitUtil::GetBit(validity, data.offset + i)) {
+      out[i] = ::arrow::internal::ComputeStringHash<0>(value, length);
+    }
+  };
+
+  const auto type_id = data.type->id();
+  if (type_id == Type::BOOL) {
+    const uint8_t* bits = data.buffers[1]->data();
+    for (int64_t i = 0; i < data.length; ++i) {
+      uint8_t value = BitUtil::GetBit(bits, data.offset + i);
+      hash(i, &value, sizeof(value));
+    }
+  } else if (is_fixed_width(type_id) && type_id != Type::DICTIONARY) {
+    int byte_width = checked_cast<const FixedWidthType&>(*data.type).bit_width() / 8;
+    const uint8_t* values = data.buffers[1]->data() + data.offset * byte_width;
+    for (int64_t i = 0; i < data.length; ++i) {
+      hash(i, values + i * byte_width, byte_width);
+    }
+  } else if (is_binary_like(type_id)) {
+    const int32_t* offsets = data.GetValues<int32_t>(1);
+    const uint8_t* values = data.buffers[2]->data();
+    for (int64_t i = 0; i < data.length; ++i) {
+      hash(i, values + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  } else if (is_large_binary_like(type_id)) {
+    const int64_t* offsets = data.GetValues<int64_t>(1);
+    const uint8_t* values = data.buffers[2]->data();
+    for (int64_t i = 0; i < data.length; ++i) {
+      hash(i, values + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  } else {
+    return Status::NotImplemented("Hashing keys of type ", *data.type);
+  }
+  return Status::OK();
+}
+
+// Valid indices are non-negative, whatever the signedness of their type
+uint64_t GetDictionaryIndex(const uint8_t* indices, int byte_width, int64_t i) {
+  switch (byte_width) {
+    case 1:
+      return indices[i];
+    case 2:
+      return util::SafeLoadAs<uint16_t>(indices + i * 2);
+    case 4:
+      return util::SafeLoadAs<uint32_t>(indices + i * 4);
+    default:
+      return util::SafeLoadAs<uint64_t>(indices + i * 8);
+  }
+}
+
+// Combine the hashes of each row's keys into `hashes`. These only route rows to a
+// partition, e.g. of a hash join's build side; the Grouper of each partition does the
+// actual hashing and comparison of keys.
+//
+// Dictionary keys are hashed on their values, since batches may carry different
+// dictionaries which the Grouper unifies.
+Status HashKeys(const ExecBatch& keys, std::vector<size_t>* hashes) {
+  hashes->assign(keys.length, 0);
+  size_t* out = hashes->data();
+
+  std::vector<size_t> key_hashes;
+  for (const Datum& key : keys.values) {
+    const ArrayData& data = *key.array();
+    if (data.type->id() != Type::DICTIONARY) {
+      RETURN_NOT_OK(HashValues(data, &key_hashes));
+      for (int64_t i = 0; i < keys.length; ++i) {
+        ::arrow::internal::hash_combine(out[i], key_hashes[i]);
+      }
+      continue;
+    }
+
+    RETURN_NOT_OK(HashValues(*data.dictionary, &key_hashes));
+    const uint8_t* validity = data.GetNullCount() > 0 ? data.buffers[0]->data() : nullptr;
+    const int byte_width =
+        checked_cast<const FixedWidthType&>(*data.type).bit_width() / 8;
+    const uint8_t* indices = data.buffers[1]->data() + data.offset * byte_width;
+    for (int64_t i = 0; i < keys.length; ++i) {
+      size_t hash = 0;
+      if (validity == nullptr || BitUtil::GetBit(validity, data.offset + i)) {
+        hash = key_hashes[GetDictionaryIndex(indices, byte_width, i)];
+      }
+      ::arrow::internal::hash_combine(out[i], hash);
+    }
+  }
+  return Status::OK();
+}
+
+// The spill files of a node, created on demand in a temporary subdirectory which is
+// removed along with them
+class SpillFiles {
+ public:
+  explicit SpillFiles(std::string base_dir) : base_dir_(std::move(base_dir)) {}
+
+  Result<std::string> NewPath() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_ == nullptr) {
+      const std::string prefix = "arrow-spill-";
+      if (base_dir_.empty()) {
+        ARROW_ASSIGN_OR_RAISE(dir_, ::arrow::internal::TemporaryDir::Make(prefix));
+      } else {
+        ARROW_ASSIGN_OR_RAISE(auto base_dir,
+                              ::arrow::internal::PlatformFilename::FromString(base_dir_));
+        ARROW_ASSIGN_OR_RAISE(dir_,
+                              ::arrow::internal::TemporaryDir::Make(prefix, base_dir));
+      }
+    }
+    ARROW_ASSIGN_OR_RAISE(auto path,
+                          dir_->path().Join("spill-" + std::to_string(num_files_++)));
+    return path.ToString();
+  }
+
+  // Remove every spill file
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dir_.reset();
+  }
+
+ private:
+  const std::string base_dir_;
+  std::mutex mutex_;
+  std::unique_ptr<::arrow::internal::TemporaryDir> dir_;
+  int num_files_ = 0;
+};
+
+#ifdef ARROW_IPC
+
+// A spill file being written as an Arrow IPC stream
+struct SpillWriter {
+  static Result<SpillWriter> Open(std::string path,
+                                  const std::shared_ptr<Schema>& schema) {
+    SpillWriter out;
+    out.path = std::move(path);
+    ARROW_ASSIGN_OR_RAISE(out.file, io::FileOutputStream::Open(out.path));
+    ARROW_ASSIGN_OR_RAISE(out.writer, ipc::MakeStreamWriter(out.file, schema));
     return out;
   }
 
-  const char* kind_name() override { return "SinkNode"; }
+  Status Write(const RecordBatch& batch) { return writer->WriteRecordBatch(batch); }
 
-  Status StartProducing() override { return Status::OK(); }
+  Status Close() {
+    RETURN_NOT_OK(writer->Close());
+    return file->Close();
+  }
 
-  // sink nodes have no outputs from which to feel backpressure
-  static void NoOutputs() { DCHECK(false) << "no outputs; this should never be called"; }
-  void ResumeProducing(ExecNode* output) override { NoOutputs(); }
-  void PauseProducing(ExecNode* output) override { NoOutputs(); }
-  void StopProducing(ExecNode* output) override { NoOutputs(); }
+  std::string path;
+  std::shared_ptr<io::FileOutputStream> file;
+  std::shared_ptr<ipc::RecordBatchWriter> writer;
+};
 
-  void StopProducing() override {
-    std::unique_lock<std::mutex> lock(mutex_);
-    InputFinishedUnlocked();
+// Read back the batches of a spill file, one at a time
+Result<RecordBatchIterator> ReadSpillFile(const std::string& path, MemoryPool* pool) {
+  ARROW_ASSIGN_OR_RAISE(auto file, io::ReadableFile::Open(path, pool));
+  auto read_options = ipc::IpcReadOptions::Defaults();
+  read_options.memory_pool = pool;
+  ARROW_ASSIGN_OR_RAISE(std::shared_ptr<RecordBatchReader> reader,
+                        ipc::RecordBatchStreamReader::Open(file, read_options));
+  return MakeFunctionIterator([reader] { return reader->Next(); });
+}
+
+#else
+
+// Spill files are Arrow IPC streams, so spilling needs ARROW_IPC
+struct SpillWriter {
+  static Result<SpillWriter> Open(std::string path, const std::shared_ptr<Schema>&) {
+    return Status::NotImplemented("Spilling requires Arrow to be built with ARROW_IPC");
   }
 
-  void InputReceived(ExecNode* input, int seq_num, ExecBatch batch) override {
-    DCHECK_EQ(input, inputs_[0]);
+  Status Write(const RecordBatch&) { return Status::OK(); }
 
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (stopped_) return;
+  Status Close() { return Status::OK(); }
 
-    ++num_received_;
-    if (num_received_ == emit_stop_) {
-      InputFinishedUnlocked();
+  std::string path;
+};
+
+Result<RecordBatchIterator> ReadSpillFile(const std::string& path, MemoryPool* pool) {
+  return Status::NotImplemented("Spilling requires Arrow to be built with ARROW_IPC");
+}
+
+#endif  // ARROW_IPC
+
+struct GroupByNode : ExecNode {
+  GroupByNode(ExecNode* input, std::string label, std::shared_ptr<Schema> output_schema,
+              ExecContext* ctx, std::vector<int> key_field_ids,
+              std::vector<ValueDescr> key_descrs, std::vector<int> agg_src_field_ids,
+              std::vector<ValueDescr> agg_src_descrs,
+              std::vector<internal::Aggregate> aggs,
+              std::vector<const HashAggregateKernel*> agg_kernels,
+              SpillOptions spill_options)
+      : ExecNode(input->plan(), std::move(label), {input}, {"groupby"},
+                 std::move(output_schema), /*num_outputs=*/1),
+        ctx_(ctx),
+        state_pool_(ctx->memory_pool()),
+        state_ctx_(&state_pool_, ctx->func_registry()),
+        spill_options_(std::move(spill_options)),
+        spill_files_(spill_options_.directory),
+        spill_partitions_(kNumSpillPartitions),
+        key_field_ids_(std::move(key_field_ids)),
+        key_descrs_(std::move(key_descrs)),
+        agg_src_field_ids_(std::move(agg_src_field_ids)),
+        agg_src_descrs_(std::move(agg_src_descrs)),
+        aggs_(std::move(aggs)),
+        agg_kernels_(std::move(agg_kernels)) {}
+
+  const char* kind_name() override { return "GroupByNode"; }
+
+  // Grouper and aggregation states accumulated by a single thread
+  struct ThreadLocalState {
+    // Held by the thread while it consumes a batch, and by any thread spilling
+    std::mutex mutex;
+    std::unique_ptr<internal::Grouper> grouper;
+    std::vector<std::unique_ptr<KernelState>> agg_states;
+  };
+
+  bool spill_enabled() const { return spill_options_.memory_limit >= 0; }
+
+  // The context in which the threads accumulate their groups. When spilling is
+  // enabled, its memory pool counts the bytes held by this node's states.
+  ExecContext* local_ctx() { return spill_enabled() ? &state_ctx_ : ctx_; }
+
+  // (Re)initialize a state to hold no groups
+  Status ResetState(ThreadLocalState* state, ExecContext* ctx) {
+    ARROW_ASSIGN_OR_RAISE(state->grouper, internal::Grouper::Make(key_descrs_, ctx));
+    ARROW_ASSIGN_OR_RAISE(
+        state->agg_states,
+        internal::InitKernels(agg_kernels_, ctx, aggs_, agg_src_descrs_));
+    return Status::OK();
+  }
+
+  Result<ThreadLocalState*> GetLocalState() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto thread_id = std::this_thread::get_id();
+    auto it = local_state_indices_.find(thread_id);
+    if (it != local_state_indices_.end()) {
+      return local_states_[it->second].get();
     }
 
-    if (emit_stop_ != -1) {
-      DCHECK_LE(seq_num, emit_stop_);
+    auto state = ::arrow::internal::make_unique<ThreadLocalState>();
+    RETURN_NOT_OK(ResetState(state.get(), local_ctx()));
+    local_state_indices_.emplace(thread_id, local_states_.size());
+    local_states_.push_back(std::move(state));
+    return local_states_.back().get();
+  }
+
+  Result<Datum> GetColumn(const ExecBatch& batch, int field_id) {
+    const Datum& value = batch.values[field_id];
+    if (value.is_scalar()) {
+      // e.g. a partition field which was materialized as a scalar by the scan
+      ARROW_ASSIGN_OR_RAISE(auto array, MakeArrayFromScalar(*value.scalar(), batch.length,
+                                                            ctx_->memory_pool()));
+      return Datum(std::move(array));
+    }
+    if (batch.selection_vector != nullptr) {
+      // only the key and argument columns of a filtered batch are gathered
+      return batch.selection_vector->Apply(value, ctx_);
+    }
+    return value;
+  }
+
+  Status Consume(const ExecBatch& batch) {
+    if (batch.length == 0) return Status::OK();
+
+    ARROW_ASSIGN_OR_RAISE(ThreadLocalState * state, GetLocalState());
+    {
+      std::lock_guard<std::mutex> state_lock(state->mutex);
+      RETURN_NOT_OK(Consume(batch, state));
+    }
+    if (OverMemoryLimit()) return SpillLargest();
+    return Status::OK();
+  }
+
+  Status Consume(const ExecBatch& batch, ThreadLocalState* state) {
+    std::vector<Datum> keys(key_field_ids_.size());
+    for (size_t i = 0; i < key_field_ids_.size(); ++i) {
+      ARROW_ASSIGN_OR_RAISE(keys[i], GetColumn(batch, key_field_ids_[i]));
+    }
+    ARROW_ASSIGN_OR_RAISE(ExecBatch key_batch, ExecBatch::Make(std::move(keys)));
+
+    // compute a batch of group ids
+    ARROW_ASSIGN_OR_RAISE(Datum id_batch, state->grouper->Consume(key_batch));
+
+    // consume group ids with HashAggregateKernels
+    for (size_t i = 0; i < agg_kernels_.size(); ++i) {
+      KernelContext kernel_ctx{local_ctx()};
+      kernel_ctx.SetState(state->agg_states[i].get());
+      ARROW_ASSIGN_OR_RAISE(Datum argument, GetColumn(batch, agg_src_field_ids_[i]));
+      ARROW_ASSIGN_OR_RAISE(
+          auto agg_batch,
+          ExecBatch::Make({std::move(argument), id_batch,
+                           Datum(state->grouper->num_groups())}));
+      RETURN_NOT_OK(agg_kernels_[i]->consume(&kernel_ctx, agg_batch));
+    }
+    return Status::OK();
+  }
+
+  // Only the memory held by the states of this node counts, not that of other
+  // nodes or scans sharing the memory pool
+  bool OverMemoryLimit() const {
+    return spill_enabled() && state_pool_.bytes_allocated() > spill_options_.memory_limit;
+  }
+
+  // Spill the states of the threads, those holding the most groups first, until they
+  // are back under the memory limit. Any thread may hold most of the memory, not
+  // necessarily the one which crossed the limit.
+  Status SpillLargest() {
+    std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+    // another thread may have spilled while this one waited
+    if (!OverMemoryLimit()) return Status::OK();
+
+    std::vector<std::pair<int64_t, ThreadLocalState*>> states;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& state : local_states_) {
+        states.emplace_back(0, state.get());
+      }
+    }
+    for (auto& state : states) {
+      std::lock_guard<std::mutex> state_lock(state.second->mutex);
+      state.first = state.second->grouper->num_groups();
+    }
+    std::stable_sort(states.begin(), states.end(),
+                     [](const std::pair<int64_t, ThreadLocalState*>& left,
+                        const std::pair<int64_t, ThreadLocalState*>& right) {
+                       return left.first > right.first;
+                     });
+
+    for (const auto& state : states) {
+      if (!OverMemoryLimit()) break;
+      std::lock_guard<std::mutex> state_lock(state.second->mutex);
+      RETURN_NOT_OK(Spill(state.second));
+    }
+    return Status::OK();
+  }
+
+  // Export the groups of a state, hash-partitioned on their keys, to the spill files
+  // of their partitions, then reset the state.
+  Status Spill(ThreadLocalState* state) {
+    if (state->grouper->num_groups() == 0) return Status::OK();
+
+    // a spilled batch holds the keys of its groups followed by their exported states
+    ARROW_ASSIGN_OR_RAISE(ExecBatch keys, state->grouper->GetUniques());
+    FieldVector fields;
+    ArrayVector columns;
+    for (size_t i = 0; i < key_field_ids_.size(); ++i) {
+      fields.push_back(output_schema_->field(static_cast<int>(agg_kernels_.size() + i)));
+      columns.push_back(keys.values[i].make_array());
+    }
+    for (size_t i = 0; i < agg_kernels_.size(); ++i) {
+      KernelContext kernel_ctx{local_ctx()};
+      kernel_ctx.SetState(state->agg_states[i].get());
+      Datum exported;
+      RETURN_NOT_OK(agg_kernels_[i]->export_state(&kernel_ctx, &exported));
+      fields.push_back(field("state" + std::to_string(i), exported.type()));
+      columns.push_back(exported.make_array());
+    }
+    auto groups = RecordBatch::Make(schema(std::move(fields)), keys.length, columns);
+
+    std::vector<size_t> hashes;
+    RETURN_NOT_OK(HashKeys(keys, &hashes));
+    RETURN_NOT_OK(ResetState(state, local_ctx()));
+
+    std::vector<std::vector<int64_t>> partition_rows(kNumSpillPartitions);
+    for (int64_t i = 0; i < keys.length; ++i) {
+      partition_rows[hashes[i] % kNumSpillPartitions].push_back(i);
+    }
+    for (int i = 0; i < kNumSpillPartitions; ++i) {
+      if (partition_rows[i].empty()) continue;
+
+      Int64Builder builder(ctx_->memory_pool());
+      RETURN_NOT_OK(builder.AppendValues(partition_rows[i]));
+      ARROW_ASSIGN_OR_RAISE(auto indices, builder.Finish());
+      ARROW_ASSIGN_OR_RAISE(Datum partition_groups,
+                            Take(groups, indices, TakeOptions::NoBoundsCheck(), ctx_));
+
+      SpillPartition& partition = spill_partitions_[i];
+      std::lock_guard<std::mutex> lock(partition.mutex);
+      if (partition.writer == nullptr) {
+        ARROW_ASSIGN_OR_RAISE(std::string path, spill_files_.NewPath());
+        ARROW_ASSIGN_OR_RAISE(auto writer, SpillWriter::Open(std::move(path),
+                                                             groups->schema()));
+        partition.writer.reset(new SpillWriter(std::move(writer)));
+      }
+      RETURN_NOT_OK(partition.writer->Write(*partition_groups.record_batch()));
+    }
+    spilled_ = true;
+    return Status::OK();
+  }
+
+  // Fold every thread's groups into the first state, then finalize it.
+  Result<ExecBatch> MergeAndFinalize() {
+    if (local_states_.empty()) {
+      // no rows were received; emit the aggregates of zero groups
+      RETURN_NOT_OK(GetLocalState().status());
+    }
+
+    if (spill_enabled()) {
+      // The finalized arrays may share the buffers of the state, which must then not
+      // be allocated from state_pool_ since they outlive this node
+      auto state = ::arrow::internal::make_unique<ThreadLocalState>();
+      RETURN_NOT_OK(ResetState(state.get(), ctx_));
+      local_states_.insert(local_states_.begin(), std::move(state));
+    }
+
+    ThreadLocalState* state = local_states_[0].get();
+    for (size_t i = 1; i < local_states_.size(); ++i) {
+      ThreadLocalState* other = local_states_[i].get();
+      if (other->grouper->num_groups() == 0) continue;
+
+      ARROW_ASSIGN_OR_RAISE(ExecBatch other_keys, other->grouper->GetUniques());
+      ARROW_ASSIGN_OR_RAISE(Datum group_id_mapping, state->grouper->Consume(other_keys));
+      other->grouper.reset();
+
+      for (size_t j = 0; j < agg_kernels_.size(); ++j) {
+        KernelContext kernel_ctx{ctx_};
+        kernel_ctx.SetState(state->agg_states[j].get());
+        RETURN_NOT_OK(agg_kernels_[j]->merge(
+            &kernel_ctx, std::move(*other->agg_states[j]), *group_id_mapping.array()));
+        other->agg_states[j].reset();
+      }
+    }
+
+    return Finalize(state);
+  }
+
+  Result<ExecBatch> Finalize(ThreadLocalState* state) {
+    std::vector<Datum> out_data(agg_kernels_.size() + key_field_ids_.size());
+    for (size_t i = 0; i < agg_kernels_.size(); ++i) {
+      KernelContext kernel_ctx{ctx_};
+      kernel_ctx.SetState(state->agg_states[i].get());
+      RETURN_NOT_OK(agg_kernels_[i]->finalize(&kernel_ctx, &out_data[i]));
+    }
+
+    ARROW_ASSIGN_OR_RAISE(ExecBatch out_keys, state->grouper->GetUniques());
+    std::move(out_keys.values.begin(), out_keys.values.end(),
+              out_data.begin() + agg_kernels_.size());
+    return ExecBatch::Make(std::move(out_data));
+  }
+
+  // Spill the groups still in memory, then aggregate each partition of the spilled
+  // groups on its own.
+  Status MergeSpilledAndOutput(int* num_out_batches) {
+    for (auto& state : local_states_) {
+      RETURN_NOT_OK(Spill(state.get()));
+    }
+    local_states_.clear();
+
+    const int num_keys = static_cast<int>(key_field_ids_.size());
+    for (auto& partition : spill_partitions_) {
+      if (partition.writer == nullptr) continue;
+      RETURN_NOT_OK(partition.writer->Close());
+      ARROW_ASSIGN_OR_RAISE(auto groups,
+                            ReadSpillFile(partition.writer->path, ctx_->memory_pool()));
+
+      ThreadLocalState state;
+      RETURN_NOT_OK(ResetState(&state, ctx_));
+      while (true) {
+        ARROW_ASSIGN_OR_RAISE(auto batch, groups.Next());
+        if (batch == nullptr) break;
+
+        const ArrayVector columns = batch->columns();
+        std::vector<Datum> keys(columns.begin(), columns.begin() + num_keys);
+        ARROW_ASSIGN_OR_RAISE(ExecBatch key_batch, ExecBatch::Make(std::move(keys)));
+        ARROW_ASSIGN_OR_RAISE(Datum group_id_mapping, state.grouper->Consume(key_batch));
+        for (size_t i = 0; i < agg_kernels_.size(); ++i) {
+          KernelContext kernel_ctx{ctx_};
+          kernel_ctx.SetState(state.agg_states[i].get());
+          RETURN_NOT_OK(agg_kernels_[i]->merge_exported(
+              &kernel_ctx, columns[num_keys + i],
+              *group_id_mapping.array()));
+        }
+      }
+
+      ARROW_ASSIGN_OR_RAISE(ExecBatch out, Finalize(&state));
+      Output(out, num_out_batches);
+    }
+    return Status::OK();
+  }
+
+  // Slice a result into batches of at most exec_chunksize rows
+  void Output(const ExecBatch& out, int* num_out_batches) {
+    int64_t chunksize = ctx_->exec_chunksize();
+    for (int64_t offset = 0; offset < out.length; offset += chunksize) {
+      outputs_[0]->InputReceived(this, (*num_out_batches)++,
+                                 out.Slice(offset, chunksize));
+    }
+  }
+
+  void OutputResult() {
+    if (finished_.exchange(true)) return;
+
+    int num_out_batches = 0;
+    Status st;
+    if (spilled_) {
+      st = MergeSpilledAndOutput(&num_out_batches);
+    } else {
+      auto maybe_out = MergeAndFinalize();
+      st = maybe_out.status();
+      if (st.ok()) Output(*maybe_out, &num_out_batches);
+    }
+    local_states_.clear();
+    spill_partitions_.clear();
+    spill_files_.Clear();
+
+    if (!st.ok()) {
+      outputs_[0]->ErrorReceived(this, std::move(st));
+    }
+    outputs_[0]->InputFinished(this, num_out_batches);
+  }
+
+  void InputReceived(ExecNode* input, int seq, ExecBatch batch) override {
+    DCHECK_EQ(input, inputs_[0]);
+    if (finished_) return;
+
+    auto st = Consume(batch);
+    if (!st.ok()) {
+      ErrorReceived(input, std::move(st));
+      return;
     }
-    lock.unlock();
 
-    producer_.Push(std::move(batch));
+    if (++num_input_batches_processed_ == num_input_batches_total_.load()) {
+      OutputResult();
+    }
   }
 
   void ErrorReceived(ExecNode* input, Status error) override {
     DCHECK_EQ(input, inputs_[0]);
-    producer_.Push(std::move(error));
-    std::unique_lock<std::mutex> lock(mutex_);
-    InputFinishedUnlocked();
+    if (finished_.exchange(true)) return;
+
+    // Any batches still arriving from the input are ignored. The input is not
+    // stopped here since this may run inside one of its own callbacks.
+    outputs_[0]->ErrorReceived(this, std::move(error));
+    outputs_[0]->InputFinished(this, 0);
   }
 
-  void InputFinished(ExecNode* input, int seq_stop) override {
-    std::unique_lock<std::mutex> lock(mutex_);
-    emit_stop_ = seq_stop;
-    if (emit_stop_ == num_received_) {
-      InputFinishedUnlocked();
+  void InputFinished(ExecNode* input, int seq) override {
+    DCHECK_EQ(input, inputs_[0]);
+    num_input_batches_total_ = seq;
+    if (num_input_batches_processed_.load() == seq) {
+      OutputResult();
     }
   }
 
- private:
-  void InputFinishedUnlocked() {
-    if (!stopped_) {
-      stopped_ = true;
-      producer_.Close();
-    }
+  Status StartProducing() override { return Status::OK(); }
+
+  void PauseProducing(ExecNode* output) override {}
+
+  void ResumeProducing(ExecNode* output) override {}
+
+  void StopProducing(ExecNode* output) override {
+    DCHECK_EQ(output, outputs_[0]);
+    finished_ = true;
+    inputs_[0]->StopProducing(this);
   }
 
+  void StopProducing() override { StopProducing(outputs_[0]); }
+
+ private:
+  // The number of partitions into which groups are spilled. Aggregating the groups of
+  // a partition takes a fraction of the memory of aggregating all of them at once.
+  static constexpr int kNumSpillPartitions = 32;
+
+  // The spill file of a partition, written by any thread which spills
+  struct SpillPartition {
+    std::mutex mutex;
+    std::unique_ptr<SpillWriter> writer;
+  };
+
+  ExecContext* ctx_;
+  // Tracks the allocations of the threads' states, to decide when to spill
+  ProxyMemoryPool state_pool_;
+  ExecContext state_ctx_;
+  const SpillOptions spill_options_;
+  SpillFiles spill_files_;
+  std::vector<SpillPartition> spill_partitions_;
+  std::atomic<bool> spilled_{false};
+  // Held while spilling to get back under the memory limit
+  std::mutex spill_mutex_;
+
   std::mutex mutex_;
+  std::unordered_map<std::thread::id, size_t> local_state_indices_;
+  std::vector<std::unique_ptr<ThreadLocalState>> local_states_;
+
+  std::atomic<int> num_input_batches_processed_{0};
+  std::atomic<int> num_input_batches_total_{-1};
+  std::atomic<bool> finished_{false};
+
+  const std::vector<int> key_field_ids_;
+  const std::vector<ValueDescr> key_descrs_;
+  const std::vector<int> agg_src_field_ids_;
+  const std::vector<ValueDescr> agg_src_descrs_;
+  const std::vector<internal::Aggregate> aggs_;
+  const std::vector<const HashAggregateKernel*> agg_kernels_;
+};
 
-  int num_received_ = 0;
-  int emit_stop_ = -1;
-  bool stopped_ = false;
+Result<ExecNode*> MakeGroupByNode(ExecNode* input, std::string label,
+                                  std::vector<FieldRef> keys,
+                                  std::vector<FieldRef> agg_srcs,
+                                  std::vector<internal::Aggregate> aggs,
+                                  ExecContext* ctx, SpillOptions spill_options) {
+  if (agg_srcs.size() != aggs.size()) {
+    return Status::Invalid(aggs.size(), " aggregate functions were specified but ",
+                           agg_srcs.size(), " arguments were provided.");
+  }
+
+  const auto& input_schema = *input->output_schema();
+
+  auto resolve = [&](const std::vector<FieldRef>& refs, std::vector<int>* field_ids,
+                     std::vector<ValueDescr>* descrs) -> Status {
+    for (const auto& ref : refs) {
+      ARROW_ASSIGN_OR_RAISE(FieldPath match, ref.FindOne(input_schema));
+      if (match.indices().size() != 1) {
+        return Status::NotImplemented("Grouped aggregation of nested field ",
+                                      ref.ToString());
+      }
+      field_ids->push_back(match[0]);
+      descrs->push_back(ValueDescr::Array(input_schema.field(match[0])->type()));
+    }
+    return Status::OK();
+  };
+
+  std::vector<int> key_field_ids, agg_src_field_ids;
+  std::vector<ValueDescr> key_descrs, agg_src_descrs;
+  RETURN_NOT_OK(resolve(keys, &key_field_ids, &key_descrs));
+  RETURN_NOT_OK(resolve(agg_srcs, &agg_src_field_ids, &agg_src_descrs));
+
+  // Construct a set of kernel states only to resolve the output types
+  ARROW_ASSIGN_OR_RAISE(auto agg_kernels,
+                        internal::GetKernels(ctx, aggs, agg_src_descrs));
+  ARROW_ASSIGN_OR_RAISE(auto agg_states,
+                        internal::InitKernels(agg_kernels, ctx, aggs, agg_src_descrs));
+  ARROW_ASSIGN_OR_RAISE(
+      FieldVector output_fields,
+      internal::ResolveKernels(aggs, agg_kernels, agg_states, ctx, agg_src_descrs));
+
+  for (int key_field_id : key_field_ids) {
+    output_fields.push_back(input_schema.field(key_field_id));
+  }
+
+  if (spill_options.memory_limit >= 0) {
+    for (size_t i = 0; i < aggs.size(); ++i) {
+      if (!agg_kernels[i]->export_state || !agg_kernels[i]->merge_exported) {
+        return Status::NotImplemented("Spilling the state of ", aggs[i].function);
+      }
+    }
+    for (const auto& descr : key_descrs) {
+      if (descr.type->id() == Type::DICTIONARY) {
+        // the spilled keys of each thread would be encoded with its own dictionary
+        return Status::NotImplemented("Spilling grouped aggregation on dictionary key ",
+                                      *descr.type);
+      }
+    }
+  }
+
+  return input->plan()->EmplaceNode<GroupByNode>(
+      input, std::move(label), schema(std::move(output_fields)), ctx,
+      std::move(key_field_ids), std::move(key_descrs), std::move(agg_src_field_ids),
+      std::move(agg_src_descrs), std::move(aggs), std::move(agg_kernels),
+      std::move(spill_options));
+}
+
+struct HashJoinNode : ExecNode {
+  // The rows of the build side whose keys hash to this partition
+  struct Partition {
+    std::mutex mutex;
+    std::unique_ptr<internal::Grouper> grouper;
+
+    // The group id of each inserted row, and its index among all build rows
+    std::vector<uint32_t> group_ids;
+    std::vector<int64_t> row_ids;
+
+    // Once the build side has finished, the build rows with the keys of group i are
+    // row_ids[group_offsets[i]], ..., row_ids[group_offsets[i + 1] - 1]
+    std::vector<int64_t> group_offsets;
+  };
+
+  HashJoinNode(ExecNode* left_input, ExecNode* right_input, std::string label,
+               std::shared_ptr<Schema> output_schema, ExecContext* ctx,
+               JoinType join_type, std::vector<int> left_key_field_ids,
+               std::vector<int> right_key_field_ids,
+               std::vector<std::unique_ptr<internal::Grouper>> groupers)
+      : ExecNode(left_input->plan(), std::move(label), {left_input, right_input},
+                 {"probe", "build"}, std::move(output_schema), /*num_outputs=*/1),
+        ctx_(ctx),
+        join_type_(join_type),
+        left_key_field_ids_(std::move(left_key_field_ids)),
+        right_key_field_ids_(std::move(right_key_field_ids)) {
+    for (auto& grouper : groupers) {
+      partitions_.emplace_back(new Partition);
+      partitions_.back()->grouper = std::move(grouper);
+    }
+  }
+
+  const char* kind_name() override { return "HashJoinNode"; }
+
+  Result<Datum> GetColumn(const ExecBatch& batch, int field_id) {
+    const Datum& value = batch.values[field_id];
+    if (value.is_scalar()) {
+      ARROW_ASSIGN_OR_RAISE(auto array, MakeArrayFromScalar(*value.scalar(), batch.length,
+                                                            ctx_->memory_pool()));
+      return Datum(std::move(array));
+    }
+    return value;
+  }
+
+  Result<ExecBatch> GetKeys(const ExecBatch& batch, const std::vector<int>& field_ids) {
+    ExecBatch keys({}, batch.length);
+    keys.values.resize(field_ids.size());
+    for (size_t i = 0; i < field_ids.size(); ++i) {
+      ARROW_ASSIGN_OR_RAISE(keys.values[i], GetColumn(batch, field_ids[i]));
+    }
+    return keys;
+  }
+
+  // Assign each row to the partition of its keys. Rows with a null key can't match any
+  // row and are assigned to the extra, last list instead.
+  Result<std::vector<std::vector<int32_t>>> PartitionRows(const ExecBatch& keys) {
+    std::vector<size_t> hashes;
+    RETURN_NOT_OK(HashKeys(keys, &hashes));
+
+    std::vector<bool> has_null_key(keys.length, false);
+    for (const Datum& key : keys.values) {
+      const ArrayData& data = *key.array();
+      if (data.GetNullCount() == 0) continue;
+      const uint8_t* validity = data.buffers[0]->data();
+      for (int64_t i = 0; i < keys.length; ++i) {
+        if (!BitUtil::GetBit(validity, data.offset + i)) {
+          has_null_key[i] = true;
+        }
+      }
+    }
+
+    std::vector<std::vector<int32_t>> rows(partitions_.size() + 1);
+    for (int64_t i = 0; i < keys.length; ++i) {
+      size_t partition =
+          has_null_key[i] ? partitions_.size() : hashes[i] % partitions_.size();
+      rows[partition].push_back(static_cast<int32_t>(i));
+    }
+    return rows;
+  }
+
+  Result<ExecBatch> TakeRows(const ExecBatch& keys, const std::vector<int32_t>& rows) {
+    if (static_cast<int64_t>(rows.size()) == keys.length) {
+      // every row, in order
+      return keys;
+    }
+
+    Int32Array indices(static_cast<int64_t>(rows.size()), Buffer::Wrap(rows));
+    ExecBatch taken({}, indices.length());
+    taken.values.resize(keys.values.size());
+    for (size_t i = 0; i < keys.values.size(); ++i) {
+      ARROW_ASSIGN_OR_RAISE(taken.values[i],
+                            Take(keys.values[i], indices, TakeOptions::NoBoundsCheck(),
+                                 ctx_));
+    }
+    return taken;
+  }
+
+  Status ConsumeBuild(const ExecBatch& batch) {
+    if (batch.length == 0) return Status::OK();
+
+    ExecBatch columns({}, batch.length);
+    for (int i = 0; i < batch.num_values(); ++i) {
+      ARROW_ASSIGN_OR_RAISE(Datum column, GetColumn(batch, i));
+      columns.values.push_back(std::move(column));
+    }
+    ARROW_ASSIGN_OR_RAISE(ExecBatch keys, GetKeys(columns, right_key_field_ids_));
+    ARROW_ASSIGN_OR_RAISE(auto partition_rows, PartitionRows(keys));
+
+    int64_t base_row_id;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      base_row_id = num_build_rows_;
+      num_build_rows_ += batch.length;
+      build_batches_.push_back(std::move(columns));
+    }
+
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      const auto& rows = partition_rows[i];
+      if (rows.empty()) continue;
+      ARROW_ASSIGN_OR_RAISE(ExecBatch partition_keys, TakeRows(keys, rows));
+
+      Partition* partition = partitions_[i].get();
+      std::lock_guard<std::mutex> lock(partition->mutex);
+      ARROW_ASSIGN_OR_RAISE(Datum ids, partition->grouper->Consume(partition_keys));
+      const uint32_t* id_values = ids.array()->GetValues<uint32_t>(1);
+      partition->group_ids.insert(partition->group_ids.end(), id_values,
+                                  id_values + rows.size());
+      for (int32_t row : rows) {
+        partition->row_ids.push_back(base_row_id + row);
+      }
+    }
+    return Status::OK();
+  }
+
+  // Sort the build rows of each partition by group, and concatenate the build batches
+  // so that the row ids index them.
+  Status FinishBuild() {
+    for (auto& partition : partitions_) {
+      auto num_groups = partition->grouper->num_groups();
+      auto& offsets = partition->group_offsets;
+      offsets.assign(num_groups + 1, 0);
+      for (uint32_t id : partition->group_ids) {
+        ++offsets[id + 1];
+      }
+      for (uint32_t id = 0; id < num_groups; ++id) {
+        offsets[id + 1] += offsets[id];
+      }
+
+      std::vector<int64_t> positions(offsets.begin(), offsets.end() - 1);
+      std::vector<int64_t> sorted_row_ids(partition->row_ids.size());
+      for (size_t i = 0; i < partition->row_ids.size(); ++i) {
+        sorted_row_ids[positions[partition->group_ids[i]]++] = partition->row_ids[i];
+      }
+      partition->row_ids = std::move(sorted_row_ids);
+      partition->group_ids.clear();
+      partition->group_ids.shrink_to_fit();
+    }
+
+    const auto& build_schema = *inputs_[1]->output_schema();
+    build_columns_.resize(build_schema.num_fields());
+    for (int i = 0; i < build_schema.num_fields(); ++i) {
+      if (build_batches_.empty()) {
+        ARROW_ASSIGN_OR_RAISE(build_columns_[i],
+                              MakeArrayOfNull(build_schema.field(i)->type(), 0,
+                                              ctx_->memory_pool()));
+        continue;
+      }
+
+      ArrayVector chunks;
+      for (const auto& batch : build_batches_) {
+        chunks.push_back(batch.values[i].make_array());
+      }
+      ARROW_ASSIGN_OR_RAISE(build_columns_[i], Concatenate(chunks, ctx_->memory_pool()));
+    }
+    build_batches_.clear();
+    return Status::OK();
+  }
+
+  Result<ExecBatch> Probe(const ExecBatch& batch) {
+    ARROW_ASSIGN_OR_RAISE(ExecBatch keys, GetKeys(batch, left_key_field_ids_));
+    ARROW_ASSIGN_OR_RAISE(auto partition_rows, PartitionRows(keys));
+
+    // Look up the group of each row within its partition, or -1 if it has no match
+    std::vector<int> row_partitions(batch.length);
+    std::vector<int64_t> row_groups(batch.length, -1);
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      const auto& rows = partition_rows[i];
+      if (rows.empty()) continue;
+      ARROW_ASSIGN_OR_RAISE(ExecBatch partition_keys, TakeRows(keys, rows));
+
+      Partition* partition = partitions_[i].get();
+      Datum ids;
+      {
+        // Grouper::Find uses scratch space of the Grouper
+        std::lock_guard<std::mutex> lock(partition->mutex);
+        ARROW_ASSIGN_OR_RAISE(ids, partition->grouper->Find(partition_keys));
+      }
+
+      const ArrayData& id_data = *ids.array();
+      const uint32_t* id_values = id_data.GetValues<uint32_t>(1);
+      const uint8_t* found = id_data.GetValues<uint8_t>(0, 0);
+      for (size_t j = 0; j < rows.size(); ++j) {
+        if (found == nullptr || BitUtil::GetBit(found, id_data.offset + j)) {
+          row_partitions[rows[j]] = static_cast<int>(i);
+          row_groups[rows[j]] = id_values[j];
+        }
+      }
+    }
+
+    TypedBufferBuilder<int64_t> probe_indices(ctx_->memory_pool());
+    TypedBufferBuilder<int64_t> build_indices(ctx_->memory_pool());
+    TypedBufferBuilder<bool> build_valid(ctx_->memory_pool());
+    for (int64_t i = 0; i < batch.length; ++i) {
+      if (row_groups[i] == -1) {
+        if (join_type_ == JoinType::LEFT_OUTER) {
+          RETURN_NOT_OK(probe_indices.Append(i));
+          RETURN_NOT_OK(build_indices.Append(0));
+          RETURN_NOT_OK(build_valid.Append(false));
+        } else if (join_type_ == JoinType::LEFT_ANTI) {
+          RETURN_NOT_OK(probe_indices.Append(i));
+        }
+        continue;
+      }
+
+      if (join_type_ == JoinType::LEFT_SEMI) {
+        RETURN_NOT_OK(probe_indices.Append(i));
+        continue;
+      }
+      if (join_type_ == JoinType::LEFT_ANTI) {
+        continue;
+      }
+
+      const Partition& partition = *partitions_[row_partitions[i]];
+      int64_t begin = partition.group_offsets[row_groups[i]];
+      int64_t end = partition.group_offsets[row_groups[i] + 1];
+      RETURN_NOT_OK(probe_indices.Append(end - begin, i));
+      RETURN_NOT_OK(build_indices.Append(partition.row_ids.data() + begin, end - begin));
+      RETURN_NOT_OK(build_valid.Append(end - begin, true));
+    }
+
+    int64_t length = probe_indices.length();
+    ARROW_ASSIGN_OR_RAISE(auto probe_indices_buffer, probe_indices.Finish());
+    Int64Array probe_index_array(length, std::move(probe_indices_buffer));
+
+    ExecBatch out({}, length);
+    for (const Datum& value : batch.values) {
+      if (value.is_scalar()) {
+        out.values.push_back(value);
+        continue;
+      }
+      ARROW_ASSIGN_OR_RAISE(Datum taken, Take(value, probe_index_array,
+                                              TakeOptions::NoBoundsCheck(), ctx_));
+      out.values.push_back(std::move(taken));
+    }
+
+    if (join_type_ == JoinType::INNER || join_type_ == JoinType::LEFT_OUTER) {
+      auto null_count = build_valid.false_count();
+      ARROW_ASSIGN_OR_RAISE(auto build_indices_buffer, build_indices.Finish());
+      ARROW_ASSIGN_OR_RAISE(auto build_valid_buffer, build_valid.Finish());
+      if (null_count == 0) {
+        build_valid_buffer = nullptr;
+      }
+      Int64Array build_index_array(length, std::move(build_indices_buffer),
+                                   std::move(build_valid_buffer), null_count);
+      for (const auto& column : build_columns_) {
+        ARROW_ASSIGN_OR_RAISE(Datum taken, Take(column, build_index_array,
+                                                TakeOptions::NoBoundsCheck(), ctx_));
+        out.values.push_back(std::move(taken));
+      }
+    }
+
+    out.guarantee = batch.guarantee;
+    return out;
+  }
+
+  void ProbeAndOutput(int seq, const ExecBatch& batch) {
+    if (finished_) return;
+
+    auto maybe_out = Probe(batch);
+    if (!maybe_out.ok()) {
+      ErrorReceived(inputs_[0], maybe_out.status());
+      return;
+    }
+    outputs_[0]->InputReceived(this, seq, maybe_out.MoveValueUnsafe());
+  }
+
+  void OnBuildFinished() {
+    if (build_finished_.exchange(true)) return;
+
+    auto st = FinishBuild();
+    if (!st.ok()) {
+      ErrorReceived(inputs_[1], std::move(st));
+      return;
+    }
+
+    std::vector<std::pair<int, ExecBatch>> queued;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      hash_table_ready_ = true;
+      queued.swap(queued_probe_batches_);
+    }
+    for (const auto& seq_batch : queued) {
+      ProbeAndOutput(seq_batch.first, seq_batch.second);
+    }
+  }
+
+  void InputReceived(ExecNode* input, int seq, ExecBatch batch) override {
+    if (finished_) return;
+
+    if (batch.selection_vector != nullptr) {
+      auto maybe_materialized = batch.Materialize(ctx_);
+      if (!maybe_materialized.ok()) {
+        ErrorReceived(input, maybe_materialized.status());
+        return;
+      }
+      batch = maybe_materialized.MoveValueUnsafe();
+    }
+
+    if (input == inputs_[1]) {
+      auto st = ConsumeBuild(batch);
+      if (!st.ok()) {
+        ErrorReceived(input, std::move(st));
+        return;
+      }
+      if (++num_build_batches_processed_ == num_build_batches_total_.load()) {
+        OnBuildFinished();
+      }
+      return;
+    }
+
+    DCHECK_EQ(input, inputs_[0]);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!hash_table_ready_) {
+        queued_probe_batches_.emplace_back(seq, std::move(batch));
+        return;
+      }
+    }
+    ProbeAndOutput(seq, batch);
+  }
+
+  void ErrorReceived(ExecNode* input, Status error) override {
+    if (finished_.exchange(true)) return;
+
+    // As in GroupByNode, the inputs are not stopped here since this may run inside
+    // one of their callbacks.
+    outputs_[0]->ErrorReceived(this, std::move(error));
+  }
+
+  void InputFinished(ExecNode* input, int seq) override {
+    if (input == inputs_[1]) {
+      num_build_batches_total_ = seq;
+      if (num_build_batches_processed_.load() == seq) {
+        OnBuildFinished();
+      }
+      return;
+    }
+
+    // Each probe batch produces exactly one output batch
+    DCHECK_EQ(input, inputs_[0]);
+    outputs_[0]->InputFinished(this, seq);
+  }
+
+  Status StartProducing() override { return Status::OK(); }
+
+  // Only the probe side streams through to our output
+  void PauseProducing(ExecNode* output) override { inputs_[0]->PauseProducing(this); }
+
+  void ResumeProducing(ExecNode* output) override { inputs_[0]->ResumeProducing(this); }
+
+  void StopProducing(ExecNode* output) override {
+    DCHECK_EQ(output, outputs_[0]);
+    finished_ = true;
+    inputs_[0]->StopProducing(this);
+    inputs_[1]->StopProducing(this);
+  }
+
+  void StopProducing() override { StopProducing(outputs_[0]); }
+
+ private:
+  ExecContext* ctx_;
+  const JoinType join_type_;
+  const std::vector<int> left_key_field_ids_;
+  const std::vector<int> right_key_field_ids_;
+
+  std::vector<std::unique_ptr<Partition>> partitions_;
+
+  // Guards the build batches and the queue of probe batches
+  std::mutex mutex_;
+  int64_t num_build_rows_ = 0;
+  std::vector<ExecBatch> build_batches_;
+  std::vector<std::shared_ptr<Array>> build_columns_;
+  bool hash_table_ready_ = false;
+  std::vector<std::pair<int, ExecBatch>> queued_probe_batches_;
+
+  std::atomic<int> num_build_batches_processed_{0};
+  std::atomic<int> num_build_batches_total_{-1};
+  std::atomic<bool> build_finished_{false};
+  std::atomic<bool> finished_{false};
+};
+
+Result<ExecNode*> MakeHashJoinNode(ExecNode* left_input, ExecNode* right_input,
+                                   std::string label, JoinType join_type,
+                                   std::vector<FieldRef> left_keys,
+                                   std::vector<FieldRef> right_keys,
+                                   ExecContext* ctx) {
+  if (left_keys.size() != right_keys.size()) {
+    return Status::Invalid(left_keys.size(), " left keys were specified but ",
+                           right_keys.size(), " right keys were provided.");
+  }
+  if (left_keys.empty()) {
+    return Status::Invalid("A hash join requires at least one key");
+  }
+
+  const auto& left_schema = *left_input->output_schema();
+  const auto& right_schema = *right_input->output_schema();
+
+  auto resolve = [](const Schema& schema, const std::vector<FieldRef>& refs,
+                    std::vector<int>* field_ids) -> Status {
+    for (const auto& ref : refs) {
+      ARROW_ASSIGN_OR_RAISE(FieldPath match, ref.FindOne(schema));
+      if (match.indices().size() != 1) {
+        return Status::NotImplemented("Joining on nested field ", ref.ToString());
+      }
+      field_ids->push_back(match[0]);
+    }
+    return Status::OK();
+  };
+
+  std::vector<int> left_key_field_ids, right_key_field_ids;
+  RETURN_NOT_OK(resolve(left_schema, left_keys, &left_key_field_ids));
+  RETURN_NOT_OK(resolve(right_schema, right_keys, &right_key_field_ids));
+
+  std::vector<ValueDescr> key_descrs;
+  for (size_t i = 0; i < left_key_field_ids.size(); ++i) {
+    const auto& left_type = left_schema.field(left_key_field_ids[i])->type();
+    const auto& right_type = right_schema.field(right_key_field_ids[i])->type();
+    if (!left_type->Equals(*right_type)) {
+      return Status::TypeError("Join keys ", left_keys[i].ToString(), " and ",
+                               right_keys[i].ToString(), " have differing types ",
+                               *left_type, " and ", *right_type);
+    }
+    key_descrs.push_back(ValueDescr::Array(left_type));
+  }
+
+  // Partition the build side so that it can be inserted into by as many threads as
+  // may push batches to it
+  int num_partitions = std::max(1, GetCpuThreadPoolCapacity());
+  std::vector<std::unique_ptr<internal::Grouper>> groupers(num_partitions);
+  for (auto& grouper : groupers) {
+    ARROW_ASSIGN_OR_RAISE(grouper, internal::Grouper::Make(key_descrs, ctx));
+  }
+
+  FieldVector output_fields = left_schema.fields();
+  if (join_type == JoinType::INNER) {
+    for (const auto& field : right_schema.fields()) {
+      output_fields.push_back(field);
+    }
+  } else if (join_type == JoinType::LEFT_OUTER) {
+    for (const auto& field : right_schema.fields()) {
+      output_fields.push_back(field->WithNullable(true));
+    }
+  }
+
+  return left_input->plan()->EmplaceNode<HashJoinNode>(
+      left_input, right_input, std::move(label), schema(std::move(output_fields)), ctx,
+      join_type, std::move(left_key_field_ids), std::move(right_key_field_ids),
+      std::move(groupers));
+}
+
+// The number of bytes held by the buffers of an array
+int64_t GetBufferSize(const ArrayData& data) {
+  int64_t size = 0;
+  for (const auto& buffer : data.buffers) {
+    if (buffer) size += buffer->size();
+  }
+  for (const auto& child : data.child_data) {
+    size += GetBufferSize(*child);
+  }
+  if (data.dictionary) size += GetBufferSize(*data.dictionary);
+  return size;
+}
+
+// Merges sorted runs of rows into a single sorted run.
+//
+// Each run is read one batch at a time, its current batch occupying a slot of a
+// RecordBatchRowComparator, while a heap orders the runs by their next row. The merged
+// rows are gathered in chunks with a single Take from the slices of the batches they
+// were drawn from, or simply sliced when a chunk is drawn from a single batch.
+class SortedRunMerger {
+ public:
+  using EmitFn = std::function<Status(std::shared_ptr<RecordBatch>)>;
+
+  SortedRunMerger(std::shared_ptr<Schema> schema, std::vector<RecordBatchIterator> runs,
+                  int64_t chunksize, ExecContext* ctx)
+      : schema_(std::move(schema)),
+        runs_(std::move(runs)),
+        chunksize_(chunksize),
+        ctx_(ctx),
+        batches_(runs_.size()),
+        rows_(runs_.size(), 0),
+        pending_slice_of_run_(runs_.size(), -1) {}
+
+  // Pass the merged rows to `emit` in batches of at most chunksize rows
+  Status Merge(const std::vector<SortKey>& sort_keys, const EmitFn& emit) {
+    const int num_runs = static_cast<int>(runs_.size());
+    ARROW_ASSIGN_OR_RAISE(comparator_, internal::RecordBatchRowComparator::Make(
+                                           *schema_, sort_keys, num_runs));
+
+    // a min-heap of the runs with rows left, ordered by their next row
+    auto after = [this](int left, int right) {
+      return comparator_->Less(right, rows_[right], left, rows_[left]);
+    };
+    std::vector<int> heap;
+    for (int run = 0; run < num_runs; ++run) {
+      ARROW_ASSIGN_OR_RAISE(bool has_rows, NextBatch(run));
+      if (has_rows) heap.push_back(run);
+    }
+    std::make_heap(heap.begin(), heap.end(), after);
+
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), after);
+      const int run = heap.back();
+      AddPendingRow(run);
+      if (static_cast<int64_t>(pending_rows_.size()) == chunksize_) {
+        RETURN_NOT_OK(Flush(emit));
+      }
+      if (++rows_[run] == batches_[run]->num_rows()) {
+        ARROW_ASSIGN_OR_RAISE(bool has_rows, NextBatch(run));
+        if (!has_rows) {
+          heap.pop_back();
+          continue;
+        }
+      }
+      std::push_heap(heap.begin(), heap.end(), after);
+    }
+    return Flush(emit);
+  }
+
+ private:
+  // The rows [begin, end) of a batch, all of which are pending
+  struct PendingSlice {
+    std::shared_ptr<RecordBatch> batch;
+    int64_t begin;
+    int64_t end;
+  };
+
+  // Move a run to its next non-empty batch, if any
+  Result<bool> NextBatch(int run) {
+    pending_slice_of_run_[run] = -1;
+    while (true) {
+      ARROW_ASSIGN_OR_RAISE(batches_[run], runs_[run].Next());
+      if (batches_[run] == nullptr) return false;
+      if (batches_[run]->num_rows() > 0) break;
+    }
+    rows_[run] = 0;
+    RETURN_NOT_OK(comparator_->SetBatch(run, *batches_[run]));
+    return true;
+  }
+
+  void AddPendingRow(int run) {
+    int& slice = pending_slice_of_run_[run];
+    if (slice < 0) {
+      slice = static_cast<int>(pending_slices_.size());
+      pending_slices_.push_back({batches_[run], rows_[run], rows_[run]});
+    }
+    pending_slices_[slice].end = rows_[run] + 1;
+    pending_rows_.emplace_back(slice, rows_[run]);
+  }
+
+  Status Flush(const EmitFn& emit) {
+    // an unsupported sort key type is only detected by comparing rows
+    RETURN_NOT_OK(comparator_->status());
+    if (pending_rows_.empty()) return Status::OK();
+
+    std::shared_ptr<RecordBatch> out;
+    if (pending_slices_.size() == 1) {
+      const auto& slice = pending_slices_[0];
+      out = slice.batch->Slice(slice.begin, slice.end - slice.begin);
+    } else {
+      ARROW_ASSIGN_OR_RAISE(out, Gather());
+    }
+
+    pending_slices_.clear();
+    pending_rows_.clear();
+    std::fill(pending_slice_of_run_.begin(), pending_slice_of_run_.end(), -1);
+    return emit(std::move(out));
+  }
+
+  Result<std::shared_ptr<RecordBatch>> Gather() {
+    std::vector<int64_t> offsets(pending_slices_.size());
+    int64_t length = 0;
+    for (size_t i = 0; i < pending_slices_.size(); ++i) {
+      offsets[i] = length;
+      length += pending_slices_[i].end - pending_slices_[i].begin;
+    }
+
+    ArrayVector columns(schema_->num_fields());
+    for (int i = 0; i < schema_->num_fields(); ++i) {
+      ArrayVector pieces;
+      for (const auto& slice : pending_slices_) {
+        pieces.push_back(
+            slice.batch->column(i)->Slice(slice.begin, slice.end - slice.begin));
+      }
+      ARROW_ASSIGN_OR_RAISE(columns[i], Concatenate(pieces, ctx_->memory_pool()));
+    }
+
+    const auto num_rows = static_cast<int64_t>(pending_rows_.size());
+    ARROW_ASSIGN_OR_RAISE(
+        auto indices_buffer,
+        AllocateBuffer(num_rows * sizeof(int64_t), ctx_->memory_pool()));
+    auto indices = reinterpret_cast<int64_t*>(indices_buffer->mutable_data());
+    for (int64_t i = 0; i < num_rows; ++i) {
+      const auto& row = pending_rows_[i];
+      indices[i] = offsets[row.first] + row.second - pending_slices_[row.first].begin;
+    }
+
+    auto concatenated = RecordBatch::Make(schema_, length, std::move(columns));
+    ARROW_ASSIGN_OR_RAISE(
+        Datum taken,
+        Take(concatenated, Datum(ArrayData::Make(int64(), num_rows,
+                                                 {nullptr, std::move(indices_buffer)})),
+             TakeOptions::NoBoundsCheck(), ctx_));
+    return taken.record_batch();
+  }
+
+  const std::shared_ptr<Schema> schema_;
+  std::vector<RecordBatchIterator> runs_;
+  const int64_t chunksize_;
+  ExecContext* ctx_;
+
+  std::unique_ptr<internal::RecordBatchRowComparator> comparator_;
+  // The current batch of each run, and the index of its next row
+  RecordBatchVector batches_;
+  std::vector<int64_t> rows_;
+
+  // The rows merged since the last flush, as the index of their slice and their row
+  // within the slice's batch
+  std::vector<PendingSlice> pending_slices_;
+  std::vector<std::pair<int, int64_t>> pending_rows_;
+  std::vector<int> pending_slice_of_run_;
+};
+
+struct OrderByNode : ExecNode {
+  OrderByNode(ExecNode* input, std::string label, SortOptions sort_options,
+              SpillOptions spill_options, ExecContext* ctx)
+      : ExecNode(input->plan(), std::move(label), {input}, {"target"},
+                 input->output_schema(), /*num_outputs=*/1),
+        ctx_(ctx),
+        sort_options_(std::move(sort_options)),
+        spill_options_(std::move(spill_options)),
+        spill_files_(spill_options_.directory) {}
+
+  const char* kind_name() override { return "OrderByNode"; }
+
+  Result<std::shared_ptr<RecordBatch>> SortBatch(const ExecBatch& batch) {
+    if (batch.selection_vector != nullptr) {
+      ARROW_ASSIGN_OR_RAISE(auto materialized, batch.Materialize(ctx_));
+      return SortBatch(materialized);
+    }
+
+    ArrayVector columns(batch.values.size());
+    for (size_t i = 0; i < batch.values.size(); ++i) {
+      const Datum& value = batch.values[i];
+      if (value.is_scalar()) {
+        ARROW_ASSIGN_OR_RAISE(columns[i], MakeArrayFromScalar(*value.scalar(),
+                                                              batch.length,
+                                                              ctx_->memory_pool()));
+      } else {
+        columns[i] = value.make_array();
+      }
+    }
+    auto record_batch =
+        RecordBatch::Make(output_schema_, batch.length, std::move(columns));
+
+    ARROW_ASSIGN_OR_RAISE(auto indices,
+                          SortIndices(Datum(record_batch), sort_options_, ctx_));
+    ARROW_ASSIGN_OR_RAISE(
+        Datum sorted, Take(record_batch, indices, TakeOptions::NoBoundsCheck(), ctx_));
+    return sorted.record_batch();
+  }
+
+  Status Consume(const ExecBatch& batch) {
+    if (batch.length == 0) return Status::OK();
+
+    ARROW_ASSIGN_OR_RAISE(auto run, SortBatch(batch));
+    int64_t run_size = 0;
+    for (const auto& column : run->columns()) {
+      run_size += GetBufferSize(*column->data());
+    }
+
+    RecordBatchVector to_spill;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      runs_in_memory_.push_back(std::move(run));
+      bytes_in_memory_ += run_size;
+      if (spill_options_.memory_limit >= 0 &&
+          bytes_in_memory_ > spill_options_.memory_limit) {
+        to_spill.swap(runs_in_memory_);
+        bytes_in_memory_ = 0;
+      }
+    }
+    if (to_spill.empty()) return Status::OK();
+    return Spill(std::move(to_spill));
+  }
+
+  static std::vector<RecordBatchIterator> MakeInMemoryRuns(RecordBatchVector runs) {
+    std::vector<RecordBatchIterator> iterators;
+    for (auto& run : runs) {
+      iterators.push_back(MakeVectorIterator(RecordBatchVector{std::move(run)}));
+    }
+    return iterators;
+  }
+
+  // Merge the runs into a single run, written to a new spill file
+  Status Spill(RecordBatchVector runs) {
+    ARROW_ASSIGN_OR_RAISE(std::string path, spill_files_.NewPath());
+    ARROW_ASSIGN_OR_RAISE(auto spill, SpillWriter::Open(std::move(path), output_schema_));
+
+    SortedRunMerger merger(output_schema_, MakeInMemoryRuns(std::move(runs)),
+                           ctx_->exec_chunksize(), ctx_);
+    RETURN_NOT_OK(merger.Merge(sort_options_.sort_keys,
+                               [&](std::shared_ptr<RecordBatch> batch) {
+                                 return spill.Write(*batch);
+                               }));
+    RETURN_NOT_OK(spill.Close());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    spill_paths_.push_back(std::move(spill.path));
+    return Status::OK();
+  }
+
+  // Merge the runs on disk and in memory, emitting the merged rows
+  Status MergeAndOutput(int* num_out_batches) {
+    std::vector<RecordBatchIterator> runs;
+    for (const auto& path : spill_paths_) {
+      ARROW_ASSIGN_OR_RAISE(auto run, ReadSpillFile(path, ctx_->memory_pool()));
+      runs.push_back(std::move(run));
+    }
+    for (auto& run : MakeInMemoryRuns(std::move(runs_in_memory_))) {
+      runs.push_back(std::move(run));
+    }
+
+    SortedRunMerger merger(output_schema_, std::move(runs), ctx_->exec_chunksize(), ctx_);
+    return merger.Merge(sort_options_.sort_keys, [&](std::shared_ptr<RecordBatch> batch) {
+      outputs_[0]->InputReceived(this, (*num_out_batches)++, ExecBatch(*batch));
+      return Status::OK();
+    });
+  }
+
+  void OutputResult() {
+    if (finished_.exchange(true)) return;
+
+    int num_out_batches = 0;
+    auto st = MergeAndOutput(&num_out_batches);
+    runs_in_memory_.clear();
+    spill_files_.Clear();
+    if (!st.ok()) {
+      outputs_[0]->ErrorReceived(this, std::move(st));
+    }
+    outputs_[0]->InputFinished(this, num_out_batches);
+  }
+
+  void InputReceived(ExecNode* input, int seq, ExecBatch batch) override {
+    DCHECK_EQ(input, inputs_[0]);
+    if (finished_) return;
+
+    auto st = Consume(batch);
+    if (!st.ok()) {
+      ErrorReceived(input, std::move(st));
+      return;
+    }
+
+    if (++num_input_batches_processed_ == num_input_batches_total_.load()) {
+      OutputResult();
+    }
+  }
+
+  void ErrorReceived(ExecNode* input, Status error) override {
+    DCHECK_EQ(input, inputs_[0]);
+    if (finished_.exchange(true)) return;
+
+    // As in GroupByNode, the input is not stopped here since this may run inside one
+    // of its own callbacks.
+    outputs_[0]->ErrorReceived(this, std::move(error));
+    outputs_[0]->InputFinished(this, 0);
+  }
+
+  void InputFinished(ExecNode* input, int seq) override {
+    DCHECK_EQ(input, inputs_[0]);
+    num_input_batches_total_ = seq;
+    if (num_input_batches_processed_.load() == seq) {
+      OutputResult();
+    }
+  }
+
+  Status StartProducing() override { return Status::OK(); }
+
+  void PauseProducing(ExecNode* output) override {}
+
+  void ResumeProducing(ExecNode* output) override {}
+
+  void StopProducing(ExecNode* output) override {
+    DCHECK_EQ(output, outputs_[0]);
+    finished_ = true;
+    inputs_[0]->StopProducing(this);
+  }
+
+  void StopProducing() override { StopProducing(outputs_[0]); }
+
+ private:
+  ExecContext* ctx_;
+  const SortOptions sort_options_;
+  const SpillOptions spill_options_;
+  SpillFiles spill_files_;
+
+  // Guards the runs and the paths of the spill files
+  std::mutex mutex_;
+  RecordBatchVector runs_in_memory_;
+  int64_t bytes_in_memory_ = 0;
+  std::vector<std::string> spill_paths_;
+
+  std::atomic<int> num_input_batches_processed_{0};
+  std::atomic<int> num_input_batches_total_{-1};
+  std::atomic<bool> finished_{false};
+};
+
+Result<ExecNode*> MakeOrderByNode(ExecNode* input, std::string label,
+                                  SortOptions sort_options, SpillOptions spill_options,
+                                  ExecContext* ctx) {
+  if (sort_options.sort_keys.empty()) {
+    return Status::Invalid("Must specify one or more sort keys");
+  }
+  const auto& input_schema = *input->output_schema();
+  for (const auto& sort_key : sort_options.sort_keys) {
+    if (input_schema.GetFieldIndex(sort_key.name) < 0) {
+      return Status::Invalid("Nonexistent sort key column: ", sort_key.name);
+    }
+  }
+
+  return input->plan()->EmplaceNode<OrderByNode>(
+      input, std::move(label), std::move(sort_options), std::move(spill_options), ctx);
+}
+
+struct SinkNode : ExecNode {
+  // The batches pushed but not pulled yet, shared with the generator of the consumer
+  // which may outlive the plan
+  struct Backpressure {
+    std::mutex mutex;
+    // Null once the sink has stopped
+    SinkNode* sink;
+    int max_queued;
+    int num_queued = 0;
+    bool paused = false;
+
+    void OnPushed() {
+      std::unique_lock<std::mutex> lock(mutex);
+      ++num_queued;
+      if (sink == nullptr || paused || max_queued < 0 || num_queued <= max_queued) {
+        return;
+      }
+      paused = true;
+      auto sink_node = sink;
+      lock.unlock();
+      // Not under the lock, as the input may push synchronously once resumed
+      sink_node->inputs_[0]->PauseProducing(sink_node);
+    }
+
+    void OnPulled() {
+      std::unique_lock<std::mutex> lock(mutex);
+      --num_queued;
+      if (sink == nullptr || !paused || num_queued > max_queued / 2) {
+        return;
+      }
+      paused = false;
+      auto sink_node = sink;
+      lock.unlock();
+      sink_node->inputs_[0]->ResumeProducing(sink_node);
+    }
+  };
+
+  SinkNode(ExecNode* input, std::string label,
+           AsyncGenerator<util::optional<ExecBatch>>* generator)
+      : ExecNode(input->plan(), std::move(label), {input}, {"collected"}, {},
+                 /*num_outputs=*/0),
+        backpressure_(std::make_shared<Backpressure>()),
+        producer_(MakeProducer(backpressure_, generator)) {
+    backpressure_->sink = this;
+    backpressure_->max_queued = plan_->scheduling_options().max_queued_batches;
+  }
+
+  static PushGenerator<util::optional<ExecBatch>>::Producer MakeProducer(
+      std::shared_ptr<Backpressure> backpressure,
+      AsyncGenerator<util::optional<ExecBatch>>* out_gen) {
+    PushGenerator<util::optional<ExecBatch>> gen;
+    auto out = gen.producer();
+    *out_gen = [gen, backpressure]() mutable {
+      auto next = gen();
+      backpressure->OnPulled();
+      return next;
+    };
+    return out;
+  }
+
+  const char* kind_name() override { return "SinkNode"; }
+
+  Status StartProducing() override { return Status::OK(); }
+
+  // sink nodes have no outputs from which to feel backpressure
+  static void NoOutputs() { DCHECK(false) << "no outputs; this should never be called"; }
+  void ResumeProducing(ExecNode* output) override { NoOutputs(); }
+  void PauseProducing(ExecNode* output) override { NoOutputs(); }
+  void StopProducing(ExecNode* output) override { NoOutputs(); }
+
+  void StopProducing() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    InputFinishedUnlocked();
+  }
+
+  void InputReceived(ExecNode* input, int seq_num, ExecBatch batch) override {
+    DCHECK_EQ(input, inputs_[0]);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) return;
+    if (emit_stop_ != -1) {
+      DCHECK_LE(seq_num, emit_stop_);
+    }
+    lock.unlock();
+
+    // Consumers of the plan see whole batches, so a deferred filter is applied here
+    if (batch.selection_vector != nullptr) {
+      auto maybe_materialized = batch.Materialize();
+      if (!maybe_materialized.ok()) {
+        ErrorReceived(input, maybe_materialized.status());
+        return;
+      }
+      batch = maybe_materialized.MoveValueUnsafe();
+    }
+
+    // Only count the batch once pushed, lest InputFinished close the producer first
+    if (producer_.Push(std::move(batch))) {
+      backpressure_->OnPushed();
+    }
+
+    lock.lock();
+    ++num_received_;
+    if (num_received_ == emit_stop_) {
+      InputFinishedUnlocked();
+    }
+  }
+
+  void ErrorReceived(ExecNode* input, Status error) override {
+    DCHECK_EQ(input, inputs_[0]);
+    producer_.Push(std::move(error));
+    std::unique_lock<std::mutex> lock(mutex_);
+    InputFinishedUnlocked();
+  }
+
+  void InputFinished(ExecNode* input, int seq_stop) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    emit_stop_ = seq_stop;
+    if (emit_stop_ == num_received_) {
+      InputFinishedUnlocked();
+    }
+  }
+
+ private:
+  void InputFinishedUnlocked() {
+    if (!stopped_) {
+      stopped_ = true;
+      producer_.Close();
+
+      std::lock_guard<std::mutex> lock(backpressure_->mutex);
+      backpressure_->sink = nullptr;
+    }
+  }
+
+  std::mutex mutex_;
+
+  int num_received_ = 0;
+  int emit_stop_ = -1;
+  bool stopped_ = false;
+
+  std::shared_ptr<Backpressure> backpressure_;
 
   PushGenerator<util::optional<ExecBatch>>::Producer producer_;
 };
@@ -17,15 +17,21 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "arrow/compute/api_aggregate.h"
+#include "arrow/compute/api_vector.h"
+#include "arrow/compute/exec.h"
 #include "arrow/compute/type_fwd.h"
+#include "arrow/type.h"
 #include "arrow/type_fwd.h"
 #include "arrow/util/macros.h"
 #include "arrow/util/optional.h"
+#include "arrow/util/type_fwd.h"
 #include "arrow/util/visibility.h"
 
 // NOTES:
@@ -38,6 +44,46 @@ namespace compute {
 
 class ExecNode;
 
+/// \brief Options controlling how an ExecPlan schedules the work of its nodes
+struct ARROW_EXPORT SchedulingOptions {
+  explicit SchedulingOptions(::arrow::internal::Executor* executor = NULLPTR,
+                             int64_t morsel_size = kDefaultMorselSize,
+                             int max_tasks_in_flight = -1, int max_queued_batches = 64)
+      : executor(executor),
+        morsel_size(morsel_size),
+        max_tasks_in_flight(max_tasks_in_flight),
+        max_queued_batches(max_queued_batches) {}
+
+  /// \brief Run tasks synchronously, as plans did before they could use an executor
+  static SchedulingOptions Defaults();
+
+  static constexpr int64_t kDefaultMorselSize = 32 * 1024;
+
+  /// \brief The executor running the tasks of the plan's nodes
+  ///
+  /// If null, tasks run synchronously on the thread scheduling them, so each source
+  /// pushes its batches through the plan one at a time.
+  ::arrow::internal::Executor* executor;
+
+  /// \brief The maximum number of rows in the batches pushed by a source node
+  ///
+  /// Larger batches are sliced into morsels of this many rows, each pushed through
+  /// the plan by a task of its own.
+  int64_t morsel_size;
+
+  /// \brief The number of tasks a source node may have running or waiting to run
+  ///
+  /// Once reached, the source stops pulling batches until one of its tasks has
+  /// finished. If negative, twice the capacity of the executor.
+  int max_tasks_in_flight;
+
+  /// \brief The number of batches a sink node may hold before they are consumed
+  ///
+  /// Once exceeded, the sink pauses its input until its consumer has caught up with
+  /// half of them. If negative, sinks never pause their input.
+  int max_queued_batches;
+};
+
 class ARROW_EXPORT ExecPlan : public std::enable_shared_from_this<ExecPlan> {
  public:
   using NodeVector = std::vector<ExecNode*>;
@@ -45,7 +91,8 @@ class ARROW_EXPORT ExecPlan : public std::enable_shared_from_this<ExecPlan> {
   virtual ~ExecPlan() = default;
 
   /// Make an empty exec plan
-  static Result<std::shared_ptr<ExecPlan>> Make();
+  static Result<std::shared_ptr<ExecPlan>> Make(
+      SchedulingOptions options = SchedulingOptions::Defaults());
 
   ExecNode* AddNode(std::unique_ptr<ExecNode> node);
 
@@ -73,6 +120,20 @@ class ARROW_EXPORT ExecPlan : public std::enable_shared_from_this<ExecPlan> {
 
   void StopProducing();
 
+  /// \brief A future marked finished once the plan has been stopped and none of its
+  /// tasks is running any more
+  Future<> finished();
+
+  const SchedulingOptions& scheduling_options() const;
+
+  /// \brief Run a task of a node, typically pushing a batch through the plan
+  ///
+  /// The task is submitted to the executor of the plan, or run synchronously if it
+  /// has none. Tasks report their errors to the nodes concerned, as they would
+  /// otherwise, and must not wait for other tasks. Each task holds a reference to the
+  /// plan, so that the plan outlives its tasks.
+  Status ScheduleTask(ExecNode* node, std::function<void()> task);
+
  protected:
   ExecPlan() = default;
 };
@@ -111,6 +172,12 @@ class ARROW_EXPORT ExecNode {
 
   Status Validate() const;
 
+  /// \brief The number of tasks this node has scheduled, see ExecPlan::ScheduleTask
+  int64_t num_tasks_scheduled() const { return num_tasks_scheduled_.load(); }
+
+  /// \brief The number of tasks scheduled by this node which have finished
+  int64_t num_tasks_finished() const { return num_tasks_finished_.load(); }
+
   /// Upstream API:
   /// These functions are called by input nodes that want to inform this node
   /// about an updated condition (a new input batch, an error, an impeding
@@ -225,12 +292,21 @@ class ARROW_EXPORT ExecNode {
   std::shared_ptr<Schema> output_schema_;
   int num_outputs_;
   NodeVector outputs_;
+
+ private:
+  friend class ExecPlan;
+
+  std::atomic<int64_t> num_tasks_scheduled_{0};
+  std::atomic<int64_t> num_tasks_finished_{0};
 };
 
 /// \brief Adapt an AsyncGenerator<ExecBatch> as a source node
 ///
-/// TODO this should accept an Executor and explicitly handle batches
-/// as they are generated on each of the Executor's threads.
+/// The generator is pulled one batch at a time. Each batch is sliced into morsels of
+/// at most SchedulingOptions::morsel_size rows, and each morsel is pushed through the
+/// plan by a task of its own, so that the downstream nodes process morsels in
+/// parallel on the executor of the plan. The source stops pulling while its output
+/// has paused it or while it has SchedulingOptions::max_tasks_in_flight tasks.
 ARROW_EXPORT
 ExecNode* MakeSourceNode(ExecPlan*, std::string label,
                          std::shared_ptr<Schema> output_schema,
@@ -239,7 +315,8 @@ ExecNode* MakeSourceNode(ExecPlan*, std::string label,
 /// \brief Add a sink node which forwards to an AsyncGenerator<ExecBatch>
 ///
 /// Emitted batches will not be ordered; instead they will be tagged with the `seq` at
-/// which they were received.
+/// which they were received. The sink pauses its input while it holds more than
+/// SchedulingOptions::max_queued_batches batches which were not pulled yet.
 ARROW_EXPORT
 std::function<Future<util::optional<ExecBatch>>()> MakeSinkNode(ExecNode* input,
                                                                 std::string label);
@@ -250,6 +327,9 @@ std::function<Future<util::optional<ExecBatch>>()> MakeSinkNode(ExecNode* input,
 /// this node. Any rows for which the filter does not evaluate to `true` will be excluded
 /// in the batch emitted by this node.
 ///
+/// Unless few rows remain, the excluded rows are not copied out: the emitted batch
+/// shares its input's values and carries an ExecBatch::selection_vector instead.
+///
 /// If the filter is not already bound, it will be bound against the input's schema.
 ARROW_EXPORT
 Result<ExecNode*> MakeFilterNode(ExecNode* input, std::string label, Expression filter);
@@ -264,5 +344,99 @@ ARROW_EXPORT
 Result<ExecNode*> MakeProjectNode(ExecNode* input, std::string label,
                                   std::vector<Expression> exprs);
 
+/// \brief Options controlling when and where a node spills its state to disk
+struct ARROW_EXPORT SpillOptions {
+  explicit SpillOptions(int64_t memory_limit = -1, std::string directory = "")
+      : memory_limit(memory_limit), directory(std::move(directory)) {}
+
+  /// \brief The number of bytes of memory past which a node spills
+  ///
+  /// Each node documents which memory it counts. A negative limit never spills.
+  /// Spill files are Arrow IPC streams: if Arrow is built without ARROW_IPC, a node
+  /// which needs to spill fails with NotImplemented.
+  int64_t memory_limit;
+
+  /// \brief The directory in which the node creates its spill files
+  ///
+  /// The files are placed in a temporary subdirectory which is removed once the node
+  /// is done with them. If empty, the platform's temporary directory is used.
+  std::string directory;
+};
+
+/// \brief Make a node which computes grouped aggregations of its input.
+///
+/// Each aggregate is computed over the input field of the same index in `agg_srcs`,
+/// grouped by the unique combinations of the `keys` fields. Batches may be pushed to
+/// this node concurrently: each thread accumulates into its own Grouper and
+/// aggregation states, which are merged once all input has been received. The
+/// emitted batches hold the aggregates followed by the keys, one row per group.
+///
+/// Once the groupers and aggregation states of this node hold more than
+/// `spill_options.memory_limit` bytes, the groups of the threads are spilled, those of
+/// the thread holding the most groups first, until they are back under the limit:
+/// their keys and exported aggregation states are hash-partitioned on the keys and
+/// appended to a spill file per partition, and the thread starts over with no
+/// groups. When all input has been received, the remaining groups are spilled too,
+/// and each partition is aggregated and emitted on its own. This requires every
+/// aggregate function to support exporting its state.
+///
+/// The options of `aggs` must outlive the ExecPlan.
+ARROW_EXPORT
+Result<ExecNode*> MakeGroupByNode(ExecNode* input, std::string label,
+                                  std::vector<FieldRef> keys,
+                                  std::vector<FieldRef> agg_srcs,
+                                  std::vector<internal::Aggregate> aggs,
+                                  ExecContext* ctx = default_exec_context(),
+                                  SpillOptions spill_options = SpillOptions());
+
+/// \brief Make a node which sorts its input.
+///
+/// Batches may be pushed to this node concurrently: each is sorted on arrival into a
+/// sorted run. Once the runs held in memory exceed `spill_options.memory_limit`, they
+/// are merged and written to disk as a single run in the Arrow IPC stream format.
+/// When all input has been received, the runs on disk and in memory are streamed
+/// through a k-way merge, which emits the sorted rows in order in batches of at most
+/// exec_chunksize rows.
+///
+/// As with sort_indices, NaNs and then nulls are ordered last whatever the order of
+/// their key. Rows with equal keys may be emitted in any order.
+ARROW_EXPORT
+Result<ExecNode*> MakeOrderByNode(ExecNode* input, std::string label,
+                                  SortOptions sort_options,
+                                  SpillOptions spill_options = SpillOptions(),
+                                  ExecContext* ctx = default_exec_context());
+
+/// \brief The rows emitted by a hash join node
+enum class JoinType {
+  /// One row for each pair of left and right rows with equal keys
+  INNER,
+  /// As INNER, plus a row for each left row without a match, in which the right
+  /// fields are null
+  LEFT_OUTER,
+  /// The left rows which have at least one match
+  LEFT_SEMI,
+  /// The left rows which have no match
+  LEFT_ANTI,
+};
+
+/// \brief Make a node which joins two inputs on the equality of their keys.
+///
+/// The right input is the build side. Its batches may be pushed concurrently and are
+/// inserted into a hash table which is partitioned on the keys, so that threads only
+/// contend when inserting into the same partition. The left input is the probe side.
+/// Its batches are streamed through the hash table once the build side has finished
+/// (batches received earlier are held until then), and each produces one output
+/// batch preserving the order of its rows.
+///
+/// Inner and left outer joins emit the left fields followed by the right fields;
+/// semi and anti joins emit only the left fields. Keys are compared pairwise and must
+/// have identical types. As in SQL, a null key never matches.
+ARROW_EXPORT
+Result<ExecNode*> MakeHashJoinNode(ExecNode* left_input, ExecNode* right_input,
+                                   std::string label, JoinType join_type,
+                                   std::vector<FieldRef> left_keys,
+                                   std::vector<FieldRef> right_keys,
+                                   ExecContext* ctx = default_exec_context());
+
 }  // namespace compute
 }  // namespace arrow
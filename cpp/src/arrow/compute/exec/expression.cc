@@ -28,6 +28,8 @@
 #include "arrow/io/memory.h"
 #include "arrow/ipc/reader.h"
 #include "arrow/ipc/writer.h"
+#include "arrow/util/bit_util.h"
+#include "arrow/util/bitmap_ops.h"
 #include "arrow/util/hash_util.h"
 #include "arrow/util/key_value_metadata.h"
 #include "arrow/util/logging.h"
@@ -37,8 +39,13 @@
 
 namespace arrow {
 
+using internal::BitmapAnd;
+using internal::BitmapOrNot;
 using internal::checked_cast;
 using internal::checked_pointer_cast;
+using internal::CopyBitmap;
+using internal::CountSetBits;
+using internal::InvertBitmap;
 
 namespace compute {
 
@@ -489,22 +496,205 @@ Result<Datum> ExecuteScalarExpression(const Expression& expr, const Schema& full
   return ExecuteScalarExpression(expr, input, exec_context);
 }
 
-Result<Datum> ExecuteScalarExpression(const Expression& expr, const ExecBatch& input,
-                                      compute::ExecContext* exec_context) {
-  if (exec_context == nullptr) {
-    compute::ExecContext exec_context;
-    return ExecuteScalarExpression(expr, input, &exec_context);
+namespace {
+
+// The results of the calls evaluated against one batch, so that a subexpression
+// which appears more than once in an expression is evaluated only once.
+using ExpressionResultCache = std::unordered_map<Expression, Datum, Expression::Hash>;
+
+// Replace each field referenced by a bound expression with its selected rows. Fields
+// which are not referenced are left as they are, since no kernel will see them.
+// Subexpressions whose results over the whole batch are in `cache` have those results
+// gathered into `selected_cache` instead of the fields they reference.
+Status GatherReferencedFields(const Expression& expr, const SelectionVector& selection,
+                              compute::ExecContext* exec_context, ExecBatch* batch,
+                              std::vector<bool>* gathered,
+                              const ExpressionResultCache* cache = NULLPTR,
+                              ExpressionResultCache* selected_cache = NULLPTR) {
+  if (expr.literal()) return Status::OK();
+
+  if (auto param = expr.parameter()) {
+    if ((*gathered)[param->index]) return Status::OK();
+    (*gathered)[param->index] = true;
+
+    Datum* value = &batch->values[param->index];
+    ARROW_ASSIGN_OR_RAISE(*value, selection.Apply(*value, exec_context));
+    return Status::OK();
   }
 
-  if (!expr.IsBound()) {
-    return Status::Invalid("Cannot Execute unbound expression.");
+  if (cache != NULLPTR) {
+    auto it = cache->find(expr);
+    if (it != cache->end()) {
+      if (selected_cache->count(expr) == 0) {
+        ARROW_ASSIGN_OR_RAISE(Datum selected, selection.Apply(it->second, exec_context));
+        selected_cache->emplace(expr, std::move(selected));
+      }
+      return Status::OK();
+    }
   }
 
-  if (!expr.IsScalarExpression()) {
-    return Status::Invalid(
-        "ExecuteScalarExpression cannot Execute non-scalar expression ", expr.ToString());
+  for (const Expression& arg : CallNotNull(expr)->arguments) {
+    RETURN_NOT_OK(GatherReferencedFields(arg, selection, exec_context, batch, gathered,
+                                         cache, selected_cache));
+  }
+  return Status::OK();
+}
+
+Result<Datum> ExecuteBoundExpression(const Expression& expr, const ExecBatch& input,
+                                     compute::ExecContext* exec_context,
+                                     ExpressionResultCache* cache);
+
+// Return a bitmap of the rows whose and_kleene (or or_kleene) is not decided by `lhs`:
+// those which are not false (or true) and valid.
+Result<std::shared_ptr<Buffer>> UndecidedRows(const ArrayData& lhs, bool is_and,
+                                              MemoryPool* pool) {
+  const uint8_t* values = lhs.buffers[1]->data();
+  if (lhs.GetNullCount() == 0) {
+    return is_and ? CopyBitmap(pool, values, lhs.offset, lhs.length)
+                  : InvertBitmap(pool, values, lhs.offset, lhs.length);
+  }
+
+  const uint8_t* validity = lhs.buffers[0]->data();
+  if (is_and) {
+    // null or true
+    return BitmapOrNot(pool, values, lhs.offset, validity, lhs.offset, lhs.length,
+                       /*out_offset=*/0);
+  }
+  // null or false
+  ARROW_ASSIGN_OR_RAISE(auto decided, BitmapAnd(pool, validity, lhs.offset, values,
+                                                lhs.offset, lhs.length,
+                                                /*out_offset=*/0));
+  return InvertBitmap(pool, decided->data(), 0, lhs.length);
+}
+
+// Combine `lhs` with `rhs`, which was evaluated over the undecided rows only
+Result<Datum> MergeKleene(const ArrayData& lhs, const SelectionVector& undecided,
+                          const ArrayData& rhs, bool is_and, MemoryPool* pool) {
+  ARROW_ASSIGN_OR_RAISE(auto values,
+                        CopyBitmap(pool, lhs.buffers[1]->data(), lhs.offset, lhs.length));
+  std::shared_ptr<Buffer> validity;
+  if (lhs.GetNullCount() != 0 || rhs.GetNullCount() != 0) {
+    if (lhs.GetNullCount() != 0) {
+      ARROW_ASSIGN_OR_RAISE(validity, CopyBitmap(pool, lhs.buffers[0]->data(),
+                                                 lhs.offset, lhs.length));
+    } else {
+      ARROW_ASSIGN_OR_RAISE(validity, AllocateEmptyBitmap(lhs.length, pool));
+      BitUtil::SetBitsTo(validity->mutable_data(), 0, lhs.length, true);
+    }
+  }
+
+  // the value which decides the result, whatever the other operand
+  const bool decisive = !is_and;
+  const uint8_t* rhs_values = rhs.buffers[1]->data();
+  const uint8_t* rhs_validity = rhs.GetNullCount() != 0 ? rhs.buffers[0]->data() : NULLPTR;
+  for (int32_t j = 0; j < undecided.length(); ++j) {
+    const int64_t i = undecided.indices()[j];
+    const bool rhs_valid =
+        rhs_validity == NULLPTR || BitUtil::GetBit(rhs_validity, rhs.offset + j);
+    const bool rhs_value = BitUtil::GetBit(rhs_values, rhs.offset + j);
+
+    if (validity == nullptr || BitUtil::GetBit(validity->data(), i)) {
+      // lhs is the identity of the operation
+      BitUtil::SetBitTo(values->mutable_data(), i, rhs_value);
+      if (validity != nullptr) BitUtil::SetBitTo(validity->mutable_data(), i, rhs_valid);
+    } else if (rhs_valid && rhs_value == decisive) {
+      // lhs is null, but rhs decides the result
+      BitUtil::SetBitTo(values->mutable_data(), i, decisive);
+      BitUtil::SetBit(validity->mutable_data(), i);
+    }
+  }
+
+  return Datum(ArrayData::Make(boolean(), lhs.length,
+                               {std::move(validity), std::move(values)}));
+}
+
+// Evaluate the right hand side of and_kleene/or_kleene over only those rows which are
+// not decided by the left hand side, whatever their number, so that whether it raises
+// an error never depends on how the rows happen to be decided. Returns null if the
+// right hand side must be evaluated over the whole batch instead.
+Result<util::optional<Datum>> ShortCircuitKleene(const Expression::Call& call,
+                                                 const Datum& lhs,
+                                                 const ExecBatch& input,
+                                                 compute::ExecContext* exec_context,
+                                                 ExpressionResultCache* cache) {
+  if (!lhs.is_array() || lhs.length() == 0) return util::nullopt;
+
+  const bool is_and = call.function_name == "and_kleene";
+  const ArrayData& lhs_data = *lhs.array();
+  ARROW_ASSIGN_OR_RAISE(auto undecided_rows,
+                        UndecidedRows(lhs_data, is_and, exec_context->memory_pool()));
+  const int64_t num_undecided = CountSetBits(undecided_rows->data(), 0, lhs_data.length);
+
+  if (num_undecided == 0) {
+    // every row is decided
+    return util::optional<Datum>(lhs);
+  }
+  if (num_undecided == lhs_data.length) {
+    // no row is decided
+    return util::nullopt;
+  }
+
+  ARROW_ASSIGN_OR_RAISE(auto undecided,
+                        SelectionVector::FromMask(
+                            BooleanArray(lhs_data.length, std::move(undecided_rows)),
+                            exec_context->memory_pool()));
+
+  // Results already cached for the whole batch are gathered rather than recomputed
+  const Expression& rhs_expr = call.arguments[1];
+  ExecBatch selected = input;
+  selected.length = undecided->length();
+  std::vector<bool> gathered(input.values.size(), false);
+  ExpressionResultCache selected_cache;
+  RETURN_NOT_OK(GatherReferencedFields(rhs_expr, *undecided, exec_context, &selected,
+                                       &gathered, cache, &selected_cache));
+  ARROW_ASSIGN_OR_RAISE(Datum rhs, ExecuteBoundExpression(rhs_expr, selected,
+                                                          exec_context, &selected_cache));
+  if (rhs.is_scalar()) {
+    ARROW_ASSIGN_OR_RAISE(auto rhs_array,
+                          MakeArrayFromScalar(*rhs.scalar(), undecided->length(),
+                                              exec_context->memory_pool()));
+    rhs = Datum(std::move(rhs_array));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(Datum merged, MergeKleene(lhs_data, *undecided, *rhs.array(),
+                                                  is_and, exec_context->memory_pool()));
+  return util::optional<Datum>(std::move(merged));
+}
+
+Result<Datum> ExecuteBoundCall(const Expression::Call& call, const ExecBatch& input,
+                               compute::ExecContext* exec_context,
+                               ExpressionResultCache* cache) {
+  std::vector<Datum> arguments(call.arguments.size());
+  for (size_t i = 0; i < arguments.size(); ++i) {
+    ARROW_ASSIGN_OR_RAISE(arguments[i], ExecuteBoundExpression(call.arguments[i], input,
+                                                               exec_context, cache));
+
+    if (i == 0 && (call.function_name == "and_kleene" ||
+                   call.function_name == "or_kleene")) {
+      ARROW_ASSIGN_OR_RAISE(
+          auto result, ShortCircuitKleene(call, arguments[0], input, exec_context, cache));
+      if (result) return std::move(*result);
+    }
   }
 
+  auto executor = compute::detail::KernelExecutor::MakeScalar();
+
+  compute::KernelContext kernel_context(exec_context);
+  kernel_context.SetState(call.kernel_state.get());
+
+  auto kernel = call.kernel;
+  auto descrs = GetDescriptors(arguments);
+  auto options = call.options.get();
+  RETURN_NOT_OK(executor->Init(&kernel_context, {kernel, descrs, options}));
+
+  auto listener = std::make_shared<compute::detail::DatumAccumulator>();
+  RETURN_NOT_OK(executor->Execute(arguments, listener.get()));
+  return executor->WrapResults(arguments, listener->values());
+}
+
+Result<Datum> ExecuteBoundExpression(const Expression& expr, const ExecBatch& input,
+                                     compute::ExecContext* exec_context,
+                                     ExpressionResultCache* cache) {
   if (auto lit = expr.literal()) return *lit;
 
   if (auto param = expr.parameter()) {
@@ -522,27 +712,48 @@ Result<Datum> ExecuteScalarExpression(const Expression& expr, const ExecBatch& i
     return field;
   }
 
-  auto call = CallNotNull(expr);
+  auto it = cache->find(expr);
+  if (it != cache->end()) return it->second;
 
-  std::vector<Datum> arguments(call->arguments.size());
-  for (size_t i = 0; i < arguments.size(); ++i) {
-    ARROW_ASSIGN_OR_RAISE(
-        arguments[i], ExecuteScalarExpression(call->arguments[i], input, exec_context));
+  ARROW_ASSIGN_OR_RAISE(Datum result,
+                        ExecuteBoundCall(*CallNotNull(expr), input, exec_context, cache));
+  cache->emplace(expr, result);
+  return result;
+}
+
+}  // namespace
+
+Result<Datum> ExecuteScalarExpression(const Expression& expr, const ExecBatch& input,
+                                      compute::ExecContext* exec_context) {
+  if (exec_context == nullptr) {
+    compute::ExecContext exec_context;
+    return ExecuteScalarExpression(expr, input, &exec_context);
   }
 
-  auto executor = compute::detail::KernelExecutor::MakeScalar();
+  if (!expr.IsBound()) {
+    return Status::Invalid("Cannot Execute unbound expression.");
+  }
 
-  compute::KernelContext kernel_context(exec_context);
-  kernel_context.SetState(call->kernel_state.get());
+  if (!expr.IsScalarExpression()) {
+    return Status::Invalid(
+        "ExecuteScalarExpression cannot Execute non-scalar expression ", expr.ToString());
+  }
 
-  auto kernel = call->kernel;
-  auto descrs = GetDescriptors(arguments);
-  auto options = call->options.get();
-  RETURN_NOT_OK(executor->Init(&kernel_context, {kernel, descrs, options}));
+  if (auto lit = expr.literal()) return *lit;
 
-  auto listener = std::make_shared<compute::detail::DatumAccumulator>();
-  RETURN_NOT_OK(executor->Execute(arguments, listener.get()));
-  return executor->WrapResults(arguments, listener->values());
+  if (input.selection_vector != nullptr) {
+    // Evaluate only the selected rows, without materializing unreferenced fields
+    ExecBatch selected = input;
+    selected.selection_vector.reset();
+    selected.length = input.selection_vector->length();
+    std::vector<bool> gathered(input.values.size(), false);
+    RETURN_NOT_OK(GatherReferencedFields(expr, *input.selection_vector, exec_context,
+                                         &selected, &gathered));
+    return ExecuteScalarExpression(expr, selected, exec_context);
+  }
+
+  ExpressionResultCache cache;
+  return ExecuteBoundExpression(expr, input, exec_context, &cache);
 }
 
 namespace {
@@ -221,6 +221,11 @@ ARROW_EXPORT Result<ExecBatch> MakeExecBatch(const Schema& full_schema,
 
 /// Execute a scalar expression against the provided state and input ExecBatch. This
 /// expression must be bound.
+///
+/// Subexpressions which appear more than once are evaluated only once per batch. The
+/// right hand side of and_kleene/or_kleene is evaluated only over the rows which its
+/// left hand side does not decide, whatever their number, and not at all if the left
+/// hand side decides every row.
 ARROW_EXPORT
 Result<Datum> ExecuteScalarExpression(const Expression&, const ExecBatch& input,
                                       ExecContext* = NULLPTR);
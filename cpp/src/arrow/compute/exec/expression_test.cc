@@ -26,6 +26,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "arrow/compute/exec.h"
 #include "arrow/compute/exec/expression_internal.h"
 #include "arrow/compute/function_internal.h"
 #include "arrow/compute/registry.h"
@@ -693,6 +694,101 @@ TEST(Expression, ExecuteCall) {
   ])"));
 }
 
+TEST(Expression, ExecuteCommonSubexpressions) {
+  auto twice_a = call("multiply", {field_ref("a"), literal(2)});
+  ExpectExecute(call("add", {twice_a, call("subtract", {twice_a, field_ref("b")})}),
+                ArrayFromJSON(struct_({field("a", int32()), field("b", int32())}), R"([
+    {"a": 1, "b": 3},
+    {"a": null, "b": 1},
+    {"a": -2, "b": null}
+  ])"));
+}
+
+TEST(Expression, ExecuteShortCircuit) {
+  auto in = ArrayFromJSON(struct_({field("a", int32()), field("b", int32())}), R"([
+    {"a": 1, "b": 1},
+    {"a": -1, "b": null},
+    {"a": -2, "b": 3},
+    {"a": null, "b": null},
+    {"a": -3, "b": 5},
+    {"a": -4, "b": 2}
+  ])");
+  ExpectExecute(and_(greater(field_ref("a"), literal(0)),
+                     greater(field_ref("b"), literal(0))),
+                in);
+  ExpectExecute(or_(less_equal(field_ref("a"), literal(0)),
+                    greater(field_ref("b"), literal(0))),
+                in);
+
+  // the right hand side is not evaluated over rows decided by the left, where it
+  // would divide by zero
+  auto schm = schema({field("a", int32()), field("b", int32())});
+  auto batch = RecordBatchFromJSON(schm, R"([
+    {"a": 1, "b": 2},
+    {"a": -1, "b": 0},
+    {"a": -2, "b": 0},
+    {"a": null, "b": 5}
+  ])");
+  auto ten_over_b_is_5 =
+      equal(call("divide_checked", {literal(10), field_ref("b")}), literal(5));
+
+  ASSERT_OK_AND_ASSIGN(
+      auto expr, and_(greater(field_ref("a"), literal(0)), ten_over_b_is_5).Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(Datum actual, ExecuteScalarExpression(expr, *schm, batch));
+  AssertDatumsEqual(ArrayFromJSON(boolean(), "[true, false, false, false]"), actual);
+
+  ASSERT_OK_AND_ASSIGN(
+      expr, or_(less_equal(field_ref("a"), literal(0)), ten_over_b_is_5).Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(actual, ExecuteScalarExpression(expr, *schm, batch));
+  AssertDatumsEqual(ArrayFromJSON(boolean(), "[true, true, true, null]"), actual);
+
+  // however many rows the left hand side leaves undecided
+  batch = RecordBatchFromJSON(schm, R"([
+    {"a": 1, "b": 2},
+    {"a": 1, "b": 5},
+    {"a": 1, "b": 10},
+    {"a": -1, "b": 0}
+  ])");
+  ASSERT_OK_AND_ASSIGN(
+      expr, and_(greater(field_ref("a"), literal(0)), ten_over_b_is_5).Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(actual, ExecuteScalarExpression(expr, *schm, batch));
+  AssertDatumsEqual(ArrayFromJSON(boolean(), "[true, false, false, false]"), actual);
+
+  // a subexpression of the right hand side already evaluated over the whole batch is
+  // reused for the undecided rows
+  auto b_is_positive = greater(field_ref("b"), literal(0));
+  ASSERT_OK_AND_ASSIGN(
+      expr, and_(and_(b_is_positive, greater(field_ref("a"), literal(0))), b_is_positive)
+                .Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(actual, ExecuteScalarExpression(expr, *schm, batch));
+  AssertDatumsEqual(ArrayFromJSON(boolean(), "[true, true, true, false]"), actual);
+}
+
+TEST(Expression, ExecuteSelectionVector) {
+  auto schm = schema({field("a", float64()), field("b", float64()), field("c", utf8())});
+
+  ExecBatch batch({ArrayFromJSON(float64(), "[6.125, 0.0, -1, 2]"),
+                   ArrayFromJSON(float64(), "[3.375, 1, 4.75, 0]"),
+                   ArrayFromJSON(utf8(), R"(["w", "x", "y", "z"])")},
+                  /*length=*/2);
+  batch.selection_vector =
+      std::make_shared<SelectionVector>(*ArrayFromJSON(int32(), "[0, 2]"));
+
+  // only the selected rows are evaluated
+  ASSERT_OK_AND_ASSIGN(auto expr,
+                       call("add", {field_ref("a"), field_ref("b")}).Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(Datum actual, ExecuteScalarExpression(expr, batch));
+  AssertDatumsEqual(ArrayFromJSON(float64(), "[9.5, 3.75]"), actual);
+
+  ASSERT_OK_AND_ASSIGN(expr, field_ref("c").Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(actual, ExecuteScalarExpression(expr, batch));
+  AssertDatumsEqual(ArrayFromJSON(utf8(), R"(["w", "y"])"), actual);
+
+  ASSERT_OK_AND_ASSIGN(expr, literal(1).Bind(*schm));
+  ASSERT_OK_AND_ASSIGN(actual, ExecuteScalarExpression(expr, batch));
+  AssertDatumsEqual(Datum(1), actual);
+}
+
 TEST(Expression, ExecuteDictionaryTransparent) {
   ExpectExecute(
       equal(field_ref("a"), field_ref("b")),
@@ -44,6 +44,16 @@ class SwissTable {
 
   Status map(const int ckeys, const uint32_t* hashes, uint32_t* outgroupids);
 
+  /// \brief Find group ids for keys without inserting missing keys.
+  ///
+  /// A bit is set in out_match_bitvector for every key present in the hash table,
+  /// in which case the corresponding entry of out_groupids holds its group id.
+  /// Entries of out_groupids are undefined for keys that are not present.
+  /// The bit vector is read back in 64-bit words, so it must have at least
+  /// 8 bytes of padding.
+  void find(const int ckeys, const uint32_t* hashes, uint8_t* out_match_bitvector,
+            uint32_t* out_groupids);
+
  private:
   // Lookup helpers
 
@@ -108,6 +118,10 @@ class SwissTable {
                          uint32_t* out_next_slot_ids);
 #endif
 
+  void first_pass(const int num_keys, const uint32_t* hashes,
+                  uint8_t* out_match_bitvector, uint32_t* out_group_ids,
+                  uint32_t* out_slot_ids);
+
   // Completing hash table lookup post first access
   Status lookup_2(const uint32_t* hashes, uint32_t* inout_num_selected,
                   uint16_t* inout_selection, bool* out_need_resize,
@@ -15,21 +15,30 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 #include <gmock/gmock-matchers.h>
 
+#include "arrow/array/concatenate.h"
+#include "arrow/compute/api_aggregate.h"
+#include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec.h"
 #include "arrow/compute/exec/exec_plan.h"
 #include "arrow/compute/exec/expression.h"
 #include "arrow/compute/exec/test_util.h"
 #include "arrow/record_batch.h"
+#include "arrow/table.h"
 #include "arrow/testing/future_util.h"
 #include "arrow/testing/gtest_util.h"
 #include "arrow/testing/matchers.h"
 #include "arrow/testing/random.h"
 #include "arrow/util/async_generator.h"
+#include "arrow/util/config.h"
+#include "arrow/util/io_util.h"
 #include "arrow/util/logging.h"
 #include "arrow/util/thread_pool.h"
 #include "arrow/util/vector.h"
@@ -197,7 +206,7 @@ Result<ExecNode*> MakeTestSourceNode(ExecPlan* plan, std::string label,
                                      bool slow) {
   DCHECK_GT(batches_with_schema.batches.size(), 0);
 
-  auto opt_batches = internal::MapVector(
+  auto opt_batches = ::arrow::internal::MapVector(
       [](ExecBatch batch) { return util::make_optional(std::move(batch)); },
       std::move(batches_with_schema.batches));
 
@@ -207,10 +216,10 @@ Result<ExecNode*> MakeTestSourceNode(ExecPlan* plan, std::string label,
     // emulate batches completing initial decode-after-scan on a cpu thread
     ARROW_ASSIGN_OR_RAISE(
         gen, MakeBackgroundGenerator(MakeVectorIterator(std::move(opt_batches)),
-                                     internal::GetCpuThreadPool()));
+                                     ::arrow::internal::GetCpuThreadPool()));
 
     // ensure that callbacks are not executed immediately on a background thread
-    gen = MakeTransferredGenerator(std::move(gen), internal::GetCpuThreadPool());
+    gen = MakeTransferredGenerator(std::move(gen), ::arrow::internal::GetCpuThreadPool());
   } else {
     gen = MakeVectorGenerator(std::move(opt_batches));
   }
@@ -236,7 +245,7 @@ Result<std::vector<ExecBatch>> StartAndCollect(
 
   plan->StopProducing();
 
-  return internal::MapVector(
+  return ::arrow::internal::MapVector(
       [](util::optional<ExecBatch> batch) { return std::move(*batch); }, collected);
 }
 
@@ -249,6 +258,91 @@ BatchesWithSchema MakeBasicBatches() {
   return out;
 }
 
+BatchesWithSchema MakeGroupableBatches(int multiplicity = 1) {
+  BatchesWithSchema out;
+
+  out.batches = {ExecBatchFromJSON({int32(), utf8()}, R"([
+                   [12, "alfa"],
+                   [7,  "beta"],
+                   [3,  "alfa"]
+                 ])"),
+                 ExecBatchFromJSON({int32(), utf8()}, R"([
+                   [-2, "alfa"],
+                   [-1, "gama"],
+                   [3,  "alfa"]
+                 ])"),
+                 ExecBatchFromJSON({int32(), utf8()}, R"([
+                   [5,  "gama"],
+                   [3,  "beta"],
+                   [-8, "alfa"]
+                 ])")};
+
+  size_t batch_count = out.batches.size();
+  for (int repeat = 1; repeat < multiplicity; ++repeat) {
+    for (size_t i = 0; i < batch_count; ++i) {
+      out.batches.push_back(out.batches[i]);
+    }
+  }
+
+  out.schema = schema({field("i32", int32()), field("str", utf8())});
+
+  return out;
+}
+
+// Sort the rows of a single emitted batch by its last (key) column, since the order
+// of the groups of a grouped aggregation is unspecified.
+Result<ExecBatch> SortByKey(const std::vector<ExecBatch>& batches) {
+  if (batches.size() != 1) {
+    return Status::Invalid("Expected a single batch, got ", batches.size());
+  }
+  const ExecBatch& batch = batches[0];
+  ARROW_ASSIGN_OR_RAISE(auto indices, SortIndices(*batch.values.back().make_array()));
+  std::vector<Datum> values(batch.values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    ARROW_ASSIGN_OR_RAISE(values[i], Take(batch.values[i], indices));
+  }
+  return ExecBatch::Make(std::move(values));
+}
+
+BatchesWithSchema MakeJoinBatches(const std::shared_ptr<Schema>& schema,
+                                  const std::vector<std::string>& json) {
+  BatchesWithSchema out;
+  std::vector<ValueDescr> descrs;
+  for (const auto& field : schema->fields()) {
+    descrs.emplace_back(field->type());
+  }
+  for (const auto& batch_json : json) {
+    out.batches.push_back(ExecBatchFromJSON(descrs, batch_json));
+  }
+  out.schema = schema;
+  return out;
+}
+
+Result<std::shared_ptr<Table>> TableFromExecBatches(
+    const std::shared_ptr<Schema>& schema, const std::vector<ExecBatch>& batches) {
+  RecordBatchVector record_batches;
+  for (const auto& batch : batches) {
+    ArrayVector columns;
+    for (const auto& value : batch.values) {
+      columns.push_back(value.make_array());
+    }
+    record_batches.push_back(RecordBatch::Make(schema, batch.length, columns));
+  }
+  return Table::FromRecordBatches(schema, record_batches);
+}
+
+// Sort a table on all of its columns, to compare the rows emitted by nodes which
+// don't specify their order.
+Result<std::shared_ptr<Table>> SortTable(const std::shared_ptr<Table>& table) {
+  std::vector<SortKey> sort_keys;
+  for (const auto& field : table->schema()->fields()) {
+    sort_keys.emplace_back(field->name());
+  }
+  ARROW_ASSIGN_OR_RAISE(auto indices, SortIndices(table, SortOptions(sort_keys)));
+  ARROW_ASSIGN_OR_RAISE(Datum sorted, Take(table, indices));
+  return sorted.table()->CombineChunks();
+}
+
 BatchesWithSchema MakeRandomBatches(const std::shared_ptr<Schema>& schema,
                                     int num_batches = 10, int batch_size = 4) {
   BatchesWithSchema out;
@@ -382,5 +476,767 @@ TEST(ExecPlanExecution, SourceProjectSink) {
                                      "[[null, 6], [true, 7], [true, 8]]")})));
 }
 
+TEST(ExecPlanExecution, SourceFilterProjectSink) {
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+
+  auto basic_data = MakeBasicBatches();
+
+  ASSERT_OK_AND_ASSIGN(auto source,
+                       MakeTestSourceNode(plan.get(), "source", basic_data,
+                                          /*parallel=*/false, /*slow=*/false));
+
+  ASSERT_OK_AND_ASSIGN(
+      auto filter,
+      MakeFilterNode(source, "filter", not_equal(field_ref("i32"), literal(6))));
+
+  // the filtered rows are only selected, and the projection evaluates no others
+  ASSERT_OK_AND_ASSIGN(auto projection,
+                       MakeProjectNode(filter, "project",
+                                       {call("add", {field_ref("i32"), literal(1)}),
+                                        field_ref("bool")}));
+
+  auto sink_gen = MakeSinkNode(projection, "sink");
+
+  ASSERT_THAT(StartAndCollect(plan.get(), sink_gen),
+              ResultWith(UnorderedElementsAreArray(
+                  {ExecBatchFromJSON({int32(), boolean()}, "[[5, false]]"),
+                   ExecBatchFromJSON({int32(), boolean()}, "[[6, null], [8, false]]")})));
+}
+
+TEST(ExecPlanExecution, SourceProjectSinkMorsels) {
+  BatchesWithSchema input;
+  input.schema = schema({field("a", int32()), field("b", boolean())});
+  input.batches = {
+      ExecBatch(*random::RandomArrayGenerator(42).BatchOf(input.schema->fields(), 1000))};
+
+  std::vector<ExecBatch> morsels;
+  for (int64_t offset = 0; offset < 1000; offset += 64) {
+    morsels.push_back(input.batches[0].Slice(offset, 64));
+  }
+
+  // plans run their tasks synchronously unless given an executor
+  ASSERT_EQ(SchedulingOptions::Defaults().executor, nullptr);
+
+  for (bool use_threads : {false, true}) {
+    SCOPED_TRACE(use_threads ? "threaded" : "serial");
+
+    SchedulingOptions options(
+        use_threads ? ::arrow::internal::GetCpuThreadPool() : nullptr,
+        /*morsel_size=*/64);
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make(options));
+
+    ASSERT_OK_AND_ASSIGN(auto source,
+                         MakeTestSourceNode(plan.get(), "source", input,
+                                            /*parallel=*/false, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(auto projection,
+                         MakeProjectNode(source, "project",
+                                         {field_ref("a"), field_ref("b")}));
+    auto sink_gen = MakeSinkNode(projection, "sink");
+
+    ASSERT_THAT(StartAndCollect(plan.get(), sink_gen),
+                ResultWith(UnorderedElementsAreArray(morsels)));
+
+    ASSERT_EQ(source->num_tasks_scheduled(), static_cast<int64_t>(morsels.size()));
+    BusyWait(10, [&] {
+      return source->num_tasks_finished() == source->num_tasks_scheduled();
+    });
+    ASSERT_EQ(source->num_tasks_finished(), source->num_tasks_scheduled());
+    ASSERT_EQ(projection->num_tasks_scheduled(), 0);
+  }
+}
+
+TEST(ExecPlanExecution, SourceSinkBackpressure) {
+  auto input = MakeRandomBatches(schema({field("a", int32()), field("b", boolean())}),
+                                 /*num_batches=*/100);
+  const int max_queued_batches = 4;
+
+  for (bool use_threads : {false, true}) {
+    SCOPED_TRACE(use_threads ? "threaded" : "serial");
+
+    SchedulingOptions options(
+        use_threads ? ::arrow::internal::GetCpuThreadPool() : nullptr,
+        SchedulingOptions::kDefaultMorselSize, /*max_tasks_in_flight=*/2,
+        max_queued_batches);
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make(options));
+
+    std::atomic<int> num_pulled{0};
+    auto vector_gen = MakeVectorGenerator(::arrow::internal::MapVector(
+        [](ExecBatch batch) { return util::make_optional(std::move(batch)); },
+        input.batches));
+    auto source = MakeSourceNode(plan.get(), "source", input.schema, [&] {
+      ++num_pulled;
+      return vector_gen();
+    });
+    auto sink_gen = MakeSinkNode(source, "sink");
+
+    ASSERT_OK(plan->StartProducing());
+    SleepABit();
+    // The source stops pulling once the sink holds more than max_queued_batches; a
+    // batch may be pulled for each task in flight by then
+    ASSERT_LE(num_pulled.load(),
+              max_queued_batches + 1 + (use_threads ? options.max_tasks_in_flight : 0));
+
+    ASSERT_FINISHES_OK_AND_ASSIGN(auto collected, CollectAsyncGenerator(sink_gen));
+    plan->StopProducing();
+    ASSERT_FINISHES_OK(plan->finished());
+    ASSERT_EQ(collected.size(), input.batches.size());
+    ASSERT_EQ(num_pulled.load(), static_cast<int>(input.batches.size()) + 1);
+  }
+}
+
+TEST(ExecPlanExecution, SourceGroupedSum) {
+  for (bool parallel : {false, true}) {
+    SCOPED_TRACE(parallel ? "parallel/merged" : "serial");
+
+    int multiplicity = parallel ? 100 : 1;
+    auto input = MakeGroupableBatches(multiplicity);
+
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+    ASSERT_OK_AND_ASSIGN(auto source, MakeTestSourceNode(plan.get(), "source", input,
+                                                         parallel, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(
+        auto gby, MakeGroupByNode(source, "gby", /*keys=*/{"str"}, /*agg_srcs=*/{"i32"},
+                                  {{"hash_sum", nullptr}}));
+    EXPECT_EQ(*gby->output_schema(),
+              *schema({field("hash_sum", int64()), field("str", utf8())}));
+
+    auto sink_gen = MakeSinkNode(gby, "sink");
+
+    ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+    ASSERT_OK_AND_ASSIGN(auto sorted, SortByKey(collected));
+    EXPECT_EQ(sorted,
+              ExecBatchFromJSON({int64(), utf8()},
+                                parallel
+                                    ? R"([[800, "alfa"], [1000, "beta"], [400, "gama"]])"
+                                    : R"([[8, "alfa"], [10, "beta"], [4, "gama"]])"));
+  }
+}
+
+TEST(ExecPlanExecution, SourceFilterFilterGroupedSum) {
+  auto input = MakeGroupableBatches();
+
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+  ASSERT_OK_AND_ASSIGN(auto source, MakeTestSourceNode(plan.get(), "source", input,
+                                                       /*parallel=*/false,
+                                                       /*slow=*/false));
+
+  // the second filter is evaluated over the rows selected by the first
+  ASSERT_OK_AND_ASSIGN(auto positive,
+                       MakeFilterNode(source, "positive",
+                                      greater_equal(field_ref("i32"), literal(0))));
+  ASSERT_OK_AND_ASSIGN(auto not_gama,
+                       MakeFilterNode(positive, "not_gama",
+                                      not_equal(field_ref("str"), literal("gama"))));
+  ASSERT_OK_AND_ASSIGN(
+      auto gby, MakeGroupByNode(not_gama, "gby", /*keys=*/{"str"}, /*agg_srcs=*/{"i32"},
+                                {{"hash_sum", nullptr}}));
+
+  auto sink_gen = MakeSinkNode(gby, "sink");
+
+  ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+  ASSERT_OK_AND_ASSIGN(auto sorted, SortByKey(collected));
+  EXPECT_EQ(sorted,
+            ExecBatchFromJSON({int64(), utf8()}, R"([[18, "alfa"], [10, "beta"]])"));
+}
+
+TEST(ExecPlanExecution, SourceGroupedCountMinMax) {
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+
+  auto input = MakeGroupableBatches(/*multiplicity=*/10);
+  ASSERT_OK_AND_ASSIGN(auto source,
+                       MakeTestSourceNode(plan.get(), "source", input,
+                                          /*parallel=*/true, /*slow=*/false));
+
+  ExecContext ctx;
+  ctx.set_exec_chunksize(2);
+  ASSERT_OK_AND_ASSIGN(auto gby, MakeGroupByNode(source, "gby", /*keys=*/{"str"},
+                                                 /*agg_srcs=*/{"i32", "i32"},
+                                                 {{"hash_count", nullptr},
+                                                  {"hash_min_max", nullptr}},
+                                                 &ctx));
+  auto sink_gen = MakeSinkNode(gby, "sink");
+
+  // the 3 groups are emitted as batches of at most exec_chunksize rows
+  ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+  ASSERT_EQ(collected.size(), 2);
+  std::vector<Datum> columns(3);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    ASSERT_OK_AND_ASSIGN(auto column, Concatenate({collected[0][i].make_array(),
+                                                    collected[1][i].make_array()}));
+    columns[i] = std::move(column);
+  }
+  ASSERT_OK_AND_ASSIGN(auto concatenated, ExecBatch::Make(std::move(columns)));
+  ASSERT_OK_AND_ASSIGN(auto sorted, SortByKey({concatenated}));
+
+  auto min_max_type = struct_({field("min", int32()), field("max", int32())});
+  EXPECT_EQ(sorted, ExecBatchFromJSON({int64(), min_max_type, utf8()}, R"([
+    [50, {"min": -8, "max": 12}, "alfa"],
+    [20, {"min": 3,  "max": 7},  "beta"],
+    [20, {"min": -1, "max": 5},  "gama"]
+  ])"));
+}
+
+TEST(ExecPlanExecution, StressSourceGroupedSpilling) {
+#ifndef ARROW_IPC
+  GTEST_SKIP() << "Spilling requires ARROW_IPC";
+#endif
+  // many groups with null keys, aggregated with and without spilling
+  auto input_schema =
+      schema({field("key", int32()), field("str", utf8()), field("value", int64())});
+  random::RandomArrayGenerator rng(42);
+  BatchesWithSchema input;
+  input.schema = input_schema;
+  for (int i = 0; i < 30; ++i) {
+    const int64_t batch_size = 200;
+    input.batches.push_back(
+        ExecBatch({rng.Int32(batch_size, 0, 500, /*null_probability=*/0.05),
+                   rng.String(batch_size, 0, 1, /*null_probability=*/0.1),
+                   rng.Int64(batch_size, -100, 100, /*null_probability=*/0.1)},
+                  batch_size));
+  }
+
+  ASSERT_OK_AND_ASSIGN(auto spill_dir,
+                       ::arrow::internal::TemporaryDir::Make("group-by-test-"));
+  ExecContext ctx;
+  ctx.set_exec_chunksize(100);
+
+  std::shared_ptr<Table> expected;
+  // never spilling, and spilling after every batch
+  for (int64_t memory_limit : {-1, 0}) {
+    SCOPED_TRACE(memory_limit);
+
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+    ASSERT_OK_AND_ASSIGN(auto source,
+                         MakeTestSourceNode(plan.get(), "source", input,
+                                            /*parallel=*/true, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(
+        auto gby,
+        MakeGroupByNode(source, "gby", /*keys=*/{"key", "str"},
+                        /*agg_srcs=*/{"value", "value", "value"},
+                        {{"hash_count", nullptr},
+                         {"hash_sum", nullptr},
+                         {"hash_min_max", nullptr}},
+                        &ctx, SpillOptions(memory_limit, spill_dir->path().ToString())));
+    auto sink_gen = MakeSinkNode(gby, "sink");
+
+    ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+    ASSERT_OK_AND_ASSIGN(auto actual,
+                         TableFromExecBatches(gby->output_schema(), collected));
+    ASSERT_OK(actual->ValidateFull());
+    // sort on the keys, which are unique
+    ASSERT_OK_AND_ASSIGN(
+        auto indices, SortIndices(actual, SortOptions({SortKey("key"), SortKey("str")})));
+    ASSERT_OK_AND_ASSIGN(Datum sorted, Take(actual, indices));
+    ASSERT_OK_AND_ASSIGN(actual, sorted.table()->CombineChunks());
+    ASSERT_GT(actual->num_rows(), 1000);
+
+    if (expected == nullptr) {
+      expected = actual;
+    } else {
+      AssertTablesEqual(*expected, *actual);
+    }
+
+    // the spill files have been removed
+    ASSERT_OK_AND_ASSIGN(auto listing, ::arrow::internal::ListDir(spill_dir->path()));
+    ASSERT_EQ(listing.size(), 0);
+  }
+}
+
+// Wraps a pool, recording the peak of the bytes allocated until StopTracking is called
+class PeakTrackingMemoryPool : public MemoryPool {
+ public:
+  explicit PeakTrackingMemoryPool(MemoryPool* pool) : pool_(pool) {}
+
+  Status Allocate(int64_t size, uint8_t** out) override {
+    RETURN_NOT_OK(pool_->Allocate(size, out));
+    Update(size);
+    return Status::OK();
+  }
+
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override {
+    RETURN_NOT_OK(pool_->Reallocate(old_size, new_size, ptr));
+    Update(new_size - old_size);
+    return Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) override {
+    pool_->Free(buffer, size);
+    Update(-size);
+  }
+
+  int64_t bytes_allocated() const override { return bytes_allocated_.load(); }
+
+  int64_t max_memory() const override { return max_memory_.load(); }
+
+  std::string backend_name() const override { return pool_->backend_name(); }
+
+  void StopTracking() { tracking_ = false; }
+
+ private:
+  void Update(int64_t diff) {
+    const int64_t allocated = bytes_allocated_ += diff;
+    if (!tracking_) return;
+    int64_t peak = max_memory_.load();
+    while (allocated > peak && !max_memory_.compare_exchange_weak(peak, allocated)) {
+    }
+  }
+
+  MemoryPool* pool_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::atomic<bool> tracking_{true};
+};
+
+TEST(ExecPlanExecution, StressSourceGroupedSpillingMemoryLimit) {
+#ifndef ARROW_IPC
+  GTEST_SKIP() << "Spilling requires ARROW_IPC";
+#endif
+  // Every thread sees most of the keys, so that its groups alone would take several
+  // times the memory limit
+  constexpr int64_t kNumKeys = 400000;
+  constexpr int64_t kMemoryLimit = 4 << 20;
+  auto input_schema = schema({field("key", int64()), field("value", int64())});
+  random::RandomArrayGenerator rng(42);
+  BatchesWithSchema input;
+  input.schema = input_schema;
+  std::unordered_set<int64_t> distinct_keys;
+  for (int i = 0; i < 512; ++i) {
+    const int64_t batch_size = 2048;
+    auto keys = rng.Int64(batch_size, 0, kNumKeys - 1, /*null_probability=*/0);
+    const auto& key_values =
+        ::arrow::internal::checked_cast<const Int64Array&>(*keys);
+    for (int64_t j = 0; j < batch_size; ++j) {
+      distinct_keys.insert(key_values.Value(j));
+    }
+    input.batches.push_back(
+        ExecBatch({keys, rng.Int64(batch_size, -100, 100, /*null_probability=*/0)},
+                  batch_size));
+  }
+
+  ASSERT_OK_AND_ASSIGN(auto spill_dir,
+                       ::arrow::internal::TemporaryDir::Make("group-by-test-"));
+  PeakTrackingMemoryPool pool(default_memory_pool());
+  ExecContext ctx(&pool);
+
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+  ASSERT_OK_AND_ASSIGN(auto source,
+                       MakeTestSourceNode(plan.get(), "source", input,
+                                          /*parallel=*/true, /*slow=*/false));
+  ASSERT_OK_AND_ASSIGN(
+      auto gby,
+      MakeGroupByNode(source, "gby", /*keys=*/{"key"}, /*agg_srcs=*/{"value"},
+                      {{"hash_count", nullptr}}, &ctx,
+                      SpillOptions(kMemoryLimit, spill_dir->path().ToString())));
+  auto sink_gen = MakeSinkNode(gby, "sink");
+
+  // The output, which is not part of the groups held while consuming, is not tracked.
+  // The batches are dropped as they arrive.
+  ASSERT_OK(plan->StartProducing());
+  int64_t num_groups = 0;
+  std::function<Status(util::optional<ExecBatch>)> visitor =
+      [&](util::optional<ExecBatch> batch) {
+        pool.StopTracking();
+        num_groups += batch->length;
+        return Status::OK();
+      };
+  ASSERT_FINISHES_OK(VisitAsyncGenerator(sink_gen, std::move(visitor)));
+  plan->StopProducing();
+  ASSERT_FINISHES_OK(plan->finished());
+
+  ASSERT_EQ(num_groups, static_cast<int64_t>(distinct_keys.size()));
+  // Past the limit, each thread may still grow by a batch before the groups are spilled
+  ASSERT_LT(pool.max_memory(), 3 * kMemoryLimit);
+}
+
+TEST(ExecPlanExecution, SourceGroupByErrors) {
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+
+  auto input = MakeGroupableBatches();
+  ASSERT_OK_AND_ASSIGN(auto source,
+                       MakeTestSourceNode(plan.get(), "source", input,
+                                          /*parallel=*/false, /*slow=*/false));
+
+  // summing strings is not supported
+  ASSERT_RAISES(NotImplemented, MakeGroupByNode(source, "gby", /*keys=*/{"i32"},
+                                                /*agg_srcs=*/{"str"},
+                                                {{"hash_sum", nullptr}}));
+
+  ASSERT_RAISES(Invalid,
+                MakeGroupByNode(source, "gby", /*keys=*/{"str"}, /*agg_srcs=*/{},
+                                {{"hash_sum", nullptr}}));
+
+  EXPECT_RAISES_WITH_MESSAGE_THAT(
+      Invalid, HasSubstr("No match"),
+      MakeGroupByNode(source, "gby", /*keys=*/{"missing"}, /*agg_srcs=*/{"i32"},
+                      {{"hash_sum", nullptr}}));
+
+  // the keys of each thread would be spilled with differing dictionaries
+  BatchesWithSchema dict_input;
+  dict_input.schema =
+      schema({field("i32", int32()), field("dict", dictionary(int32(), utf8()))});
+  dict_input.batches = {
+      ExecBatch({ArrayFromJSON(int32(), "[1, 2, 3]"),
+                 DictArrayFromJSON(dictionary(int32(), utf8()), "[0, 1, 0]",
+                                   R"(["alfa", "beta"])")},
+                3),
+      ExecBatch({ArrayFromJSON(int32(), "[4, 5]"),
+                 DictArrayFromJSON(dictionary(int32(), utf8()), "[1, 0]",
+                                   R"(["gama", "alfa"])")},
+                2)};
+  ASSERT_OK_AND_ASSIGN(auto dict_source,
+                       MakeTestSourceNode(plan.get(), "dict_source", dict_input,
+                                          /*parallel=*/false, /*slow=*/false));
+  ASSERT_RAISES(NotImplemented,
+                MakeGroupByNode(dict_source, "gby", /*keys=*/{"dict"},
+                                /*agg_srcs=*/{"i32"}, {{"hash_sum", nullptr}},
+                                default_exec_context(),
+                                SpillOptions(/*memory_limit=*/0)));
+}
+
+TEST(ExecPlanExecution, SourceHashJoin) {
+  auto left = MakeJoinBatches(schema({field("l_str", utf8()), field("l_i32", int32())}),
+                              {R"([["alfa", 1], ["beta", 2], [null, 3]])",
+                               R"([["gama", 4], ["alfa", 5], ["delta", 6]])"});
+  auto right = MakeJoinBatches(schema({field("r_str", utf8()), field("r_i32", int32())}),
+                               {R"([["alfa", 10], ["beta", 20]])",
+                                R"([["alfa", 11], [null, 30], ["epsilon", 40]])"});
+  auto joined_schema = schema({field("l_str", utf8()), field("l_i32", int32()),
+                               field("r_str", utf8()), field("r_i32", int32())});
+
+  struct {
+    JoinType join_type;
+    std::shared_ptr<Schema> output_schema;
+    std::string expected;
+  } cases[] = {
+      {JoinType::INNER, joined_schema,
+       R"([["alfa", 1, "alfa", 10], ["alfa", 1, "alfa", 11], ["beta", 2, "beta", 20],
+           ["alfa", 5, "alfa", 10], ["alfa", 5, "alfa", 11]])"},
+      {JoinType::LEFT_OUTER, joined_schema,
+       R"([["alfa", 1, "alfa", 10], ["alfa", 1, "alfa", 11], ["beta", 2, "beta", 20],
+           [null, 3, null, null], ["gama", 4, null, null], ["alfa", 5, "alfa", 10],
+           ["alfa", 5, "alfa", 11], ["delta", 6, null, null]])"},
+      {JoinType::LEFT_SEMI, left.schema, R"([["alfa", 1], ["beta", 2], ["alfa", 5]])"},
+      {JoinType::LEFT_ANTI, left.schema, R"([[null, 3], ["gama", 4], ["delta", 6]])"},
+  };
+
+  for (const auto& join_case : cases) {
+    for (bool parallel : {false, true}) {
+      SCOPED_TRACE(parallel ? "parallel" : "serial");
+
+      ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+      ASSERT_OK_AND_ASSIGN(auto left_source,
+                           MakeTestSourceNode(plan.get(), "left", left, parallel,
+                                              /*slow=*/false));
+      ASSERT_OK_AND_ASSIGN(auto right_source,
+                           MakeTestSourceNode(plan.get(), "right", right, parallel,
+                                              /*slow=*/false));
+      ASSERT_OK_AND_ASSIGN(auto join,
+                           MakeHashJoinNode(left_source, right_source, "join",
+                                            join_case.join_type, {"l_str"}, {"r_str"}));
+      AssertSchemaEqual(join_case.output_schema, join->output_schema());
+
+      auto sink_gen = MakeSinkNode(join, "sink");
+
+      // one batch is emitted for each probe batch
+      ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+      ASSERT_EQ(collected.size(), left.batches.size());
+
+      ASSERT_OK_AND_ASSIGN(auto actual,
+                           TableFromExecBatches(join_case.output_schema, collected));
+      ASSERT_OK_AND_ASSIGN(actual, SortTable(actual));
+      ASSERT_OK_AND_ASSIGN(
+          auto expected,
+          SortTable(TableFromJSON(join_case.output_schema, {join_case.expected})));
+      AssertTablesEqual(*expected, *actual, /*same_chunk_layout=*/false);
+    }
+  }
+}
+
+TEST(ExecPlanExecution, SourceHashJoinMultipleKeys) {
+  auto left = MakeJoinBatches(
+      schema({field("l_str", utf8()), field("l_i32", int32()), field("l_id", int32())}),
+      {R"([["a", 1, 0], ["a", 2, 1], ["b", 1, 2], ["a", null, 3]])"});
+  auto right = MakeJoinBatches(
+      schema({field("r_i32", int32()), field("r_str", utf8()), field("r_id", int32())}),
+      {R"([[1, "a", 10], [2, "b", 11]])", R"([[1, "a", 12], [null, "a", 13]])"});
+
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+  ASSERT_OK_AND_ASSIGN(auto left_source,
+                       MakeTestSourceNode(plan.get(), "left", left, /*parallel=*/false,
+                                          /*slow=*/false));
+  ASSERT_OK_AND_ASSIGN(auto right_source,
+                       MakeTestSourceNode(plan.get(), "right", right,
+                                          /*parallel=*/false, /*slow=*/false));
+  ASSERT_OK_AND_ASSIGN(auto join, MakeHashJoinNode(left_source, right_source, "join",
+                                                   JoinType::INNER, {"l_str", "l_i32"},
+                                                   {"r_str", "r_i32"}));
+  auto sink_gen = MakeSinkNode(join, "sink");
+
+  // rows of a probe batch are emitted in order
+  ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+  ASSERT_EQ(collected.size(), 1);
+  EXPECT_EQ(collected[0],
+            ExecBatchFromJSON({utf8(), int32(), int32(), int32(), utf8(), int32()},
+                              R"([["a", 1, 0, 1, "a", 10], ["a", 1, 0, 1, "a", 12]])"));
+}
+
+TEST(ExecPlanExecution, StressSourceHashJoin) {
+  // join on a few distinct keys, with nulls, against a nested loop join
+  auto left_schema = schema({field("l_key", int32()), field("l_id", int32())});
+  auto right_schema = schema({field("r_key", int32()), field("r_id", int32())});
+
+  random::RandomArrayGenerator rng(42);
+  auto make_batches = [&](const std::shared_ptr<Schema>& schema, int num_batches,
+                          int batch_size, int32_t first_id) {
+    BatchesWithSchema out;
+    for (int i = 0; i < num_batches; ++i) {
+      auto keys = rng.Int32(batch_size, 0, 16, /*null_probability=*/0.1);
+      std::shared_ptr<Array> ids;
+      Int32Builder builder;
+      for (int j = 0; j < batch_size; ++j) {
+        ARROW_EXPECT_OK(builder.Append(first_id++));
+      }
+      ARROW_EXPECT_OK(builder.Finish(&ids));
+      out.batches.push_back(ExecBatch({keys, ids}, batch_size));
+    }
+    out.schema = schema;
+    return out;
+  };
+  auto left = make_batches(left_schema, 20, 50, 0);
+  auto right = make_batches(right_schema, 10, 20, 1000);
+
+  ASSERT_OK_AND_ASSIGN(auto left_table, TableFromExecBatches(left_schema, left.batches));
+  ASSERT_OK_AND_ASSIGN(auto right_table,
+                       TableFromExecBatches(right_schema, right.batches));
+  ASSERT_OK_AND_ASSIGN(left_table, left_table->CombineChunks());
+  ASSERT_OK_AND_ASSIGN(right_table, right_table->CombineChunks());
+  auto column = [](const std::shared_ptr<Table>& table, int i) -> const Int32Array& {
+    const auto& chunk = *table->column(i)->chunk(0);
+    return ::arrow::internal::checked_cast<const Int32Array&>(chunk);
+  };
+  const auto& left_keys = column(left_table, 0);
+  const auto& left_ids = column(left_table, 1);
+  const auto& right_keys = column(right_table, 0);
+  const auto& right_ids = column(right_table, 1);
+
+  for (JoinType join_type : {JoinType::INNER, JoinType::LEFT_OUTER, JoinType::LEFT_SEMI,
+                             JoinType::LEFT_ANTI}) {
+    SCOPED_TRACE(static_cast<int>(join_type));
+
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+    ASSERT_OK_AND_ASSIGN(auto left_source,
+                         MakeTestSourceNode(plan.get(), "left", left, /*parallel=*/true,
+                                            /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(auto right_source,
+                         MakeTestSourceNode(plan.get(), "right", right,
+                                            /*parallel=*/true, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(auto join, MakeHashJoinNode(left_source, right_source, "join",
+                                                     join_type, {"l_key"}, {"r_key"}));
+    auto sink_gen = MakeSinkNode(join, "sink");
+
+    ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+    ASSERT_OK_AND_ASSIGN(auto actual,
+                         TableFromExecBatches(join->output_schema(), collected));
+    ASSERT_OK_AND_ASSIGN(actual, SortTable(actual));
+
+    std::vector<std::unique_ptr<Int32Builder>> builders(
+        join->output_schema()->num_fields());
+    for (auto& builder : builders) {
+      builder.reset(new Int32Builder);
+    }
+    auto append = [](Int32Builder* builder, const Int32Array& array, int64_t i) {
+      return array.IsValid(i) ? builder->Append(array.Value(i)) : builder->AppendNull();
+    };
+    for (int64_t i = 0; i < left_table->num_rows(); ++i) {
+      bool matched = false;
+      for (int64_t j = 0; j < right_table->num_rows(); ++j) {
+        if (left_keys.IsNull(i) || right_keys.IsNull(j) ||
+            left_keys.Value(i) != right_keys.Value(j)) {
+          continue;
+        }
+        matched = true;
+        if (join_type == JoinType::INNER || join_type == JoinType::LEFT_OUTER) {
+          ASSERT_OK(append(builders[0].get(), left_keys, i));
+          ASSERT_OK(append(builders[1].get(), left_ids, i));
+          ASSERT_OK(append(builders[2].get(), right_keys, j));
+          ASSERT_OK(append(builders[3].get(), right_ids, j));
+        }
+      }
+      if ((matched && join_type == JoinType::LEFT_SEMI) ||
+          (!matched && join_type != JoinType::INNER &&
+           join_type != JoinType::LEFT_SEMI)) {
+        ASSERT_OK(append(builders[0].get(), left_keys, i));
+        ASSERT_OK(append(builders[1].get(), left_ids, i));
+        if (join_type == JoinType::LEFT_OUTER) {
+          ASSERT_OK(builders[2]->AppendNull());
+          ASSERT_OK(builders[3]->AppendNull());
+        }
+      }
+    }
+    ArrayVector expected_columns(builders.size());
+    for (size_t i = 0; i < builders.size(); ++i) {
+      ASSERT_OK(builders[i]->Finish(&expected_columns[i]));
+    }
+    ASSERT_OK_AND_ASSIGN(
+        auto expected, SortTable(Table::Make(join->output_schema(), expected_columns)));
+    AssertTablesEqual(*expected, *actual, /*same_chunk_layout=*/false);
+  }
+}
+
+TEST(ExecPlanExecution, SourceHashJoinErrors) {
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+
+  auto input = MakeGroupableBatches();
+  ASSERT_OK_AND_ASSIGN(auto left_source,
+                       MakeTestSourceNode(plan.get(), "left", input,
+                                          /*parallel=*/false, /*slow=*/false));
+  ASSERT_OK_AND_ASSIGN(auto right_source,
+                       MakeTestSourceNode(plan.get(), "right", input,
+                                          /*parallel=*/false, /*slow=*/false));
+
+  ASSERT_RAISES(Invalid, MakeHashJoinNode(left_source, right_source, "join",
+                                          JoinType::INNER, {"str", "i32"}, {"str"}));
+
+  ASSERT_RAISES(Invalid, MakeHashJoinNode(left_source, right_source, "join",
+                                          JoinType::INNER, {}, {}));
+
+  ASSERT_RAISES(TypeError, MakeHashJoinNode(left_source, right_source, "join",
+                                            JoinType::INNER, {"str"}, {"i32"}));
+
+  EXPECT_RAISES_WITH_MESSAGE_THAT(
+      Invalid, HasSubstr("No match"),
+      MakeHashJoinNode(left_source, right_source, "join", JoinType::INNER, {"missing"},
+                       {"str"}));
+}
+
+// Sort the rows of a set of batches with sort_indices, to compare against the order of
+// an order-by node.
+Result<std::shared_ptr<Table>> SortBatches(const BatchesWithSchema& input,
+                                           const SortOptions& options) {
+  ARROW_ASSIGN_OR_RAISE(auto table, TableFromExecBatches(input.schema, input.batches));
+  ARROW_ASSIGN_OR_RAISE(auto indices, SortIndices(table, options));
+  ARROW_ASSIGN_OR_RAISE(Datum sorted, Take(table, indices));
+  return sorted.table();
+}
+
+TEST(ExecPlanExecution, SourceOrderBy) {
+  for (bool parallel : {false, true}) {
+    SCOPED_TRACE(parallel ? "parallel" : "serial");
+
+    auto input = MakeGroupableBatches(/*multiplicity=*/parallel ? 100 : 1);
+    SortOptions options({SortKey("str"), SortKey("i32", SortOrder::Descending)});
+
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+    ASSERT_OK_AND_ASSIGN(auto source, MakeTestSourceNode(plan.get(), "source", input,
+                                                         parallel, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(auto order_by, MakeOrderByNode(source, "order_by", options));
+    EXPECT_EQ(*order_by->output_schema(), *input.schema);
+    auto sink_gen = MakeSinkNode(order_by, "sink");
+
+    ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+    ASSERT_OK_AND_ASSIGN(auto actual, TableFromExecBatches(input.schema, collected));
+    ASSERT_OK_AND_ASSIGN(auto expected, SortBatches(input, options));
+    AssertTablesEqual(*expected, *actual, /*same_chunk_layout=*/false);
+
+    if (!parallel) {
+      auto expected_batch = ExecBatchFromJSON({int32(), utf8()}, R"([
+        [12, "alfa"], [3, "alfa"], [3, "alfa"], [-2, "alfa"], [-8, "alfa"],
+        [7, "beta"], [3, "beta"], [5, "gama"], [-1, "gama"]
+      ])");
+      ASSERT_OK_AND_ASSIGN(expected,
+                           TableFromExecBatches(input.schema, {expected_batch}));
+      AssertTablesEqual(*expected, *actual, /*same_chunk_layout=*/false);
+    }
+  }
+}
+
+TEST(ExecPlanExecution, StressSourceOrderBySpilling) {
+#ifndef ARROW_IPC
+  GTEST_SKIP() << "Spilling requires ARROW_IPC";
+#endif
+  // sort on keys with ties, nulls and NaNs; the unique id makes the order total
+  auto input_schema = schema({field("key", int32()), field("value", float64()),
+                              field("str", utf8()), field("id", int64())});
+  random::RandomArrayGenerator rng(42);
+  BatchesWithSchema input;
+  input.schema = input_schema;
+  int64_t id = 0;
+  for (int i = 0; i < 40; ++i) {
+    const int64_t batch_size = 100 + i;
+    Int64Builder ids;
+    for (int64_t j = 0; j < batch_size; ++j) {
+      ASSERT_OK(ids.Append(id++));
+    }
+    ASSERT_OK_AND_ASSIGN(auto id_array, ids.Finish());
+    input.batches.push_back(ExecBatch(
+        {rng.Int32(batch_size, 0, 10, /*null_probability=*/0.1),
+         rng.Float64(batch_size, -1, 1, /*null_probability=*/0.1,
+                     /*nan_probability=*/0.1),
+         rng.String(batch_size, 0, 3, /*null_probability=*/0.1), id_array},
+        batch_size));
+  }
+  SortOptions options({SortKey("key", SortOrder::Descending), SortKey("str"),
+                       SortKey("value", SortOrder::Descending), SortKey("id")});
+  ASSERT_OK_AND_ASSIGN(auto expected, SortBatches(input, options));
+
+  ASSERT_OK_AND_ASSIGN(auto spill_dir,
+                       ::arrow::internal::TemporaryDir::Make("order-by-test-"));
+  ExecContext ctx;
+  ctx.set_exec_chunksize(64);
+
+  // never spilling, spilling every few batches, and spilling every batch
+  for (int64_t memory_limit : {-1, 16 << 10, 0}) {
+    SCOPED_TRACE(memory_limit);
+
+    ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+    ASSERT_OK_AND_ASSIGN(auto source,
+                         MakeTestSourceNode(plan.get(), "source", input,
+                                            /*parallel=*/true, /*slow=*/false));
+    ASSERT_OK_AND_ASSIGN(
+        auto order_by,
+        MakeOrderByNode(source, "order_by", options,
+                        SpillOptions(memory_limit, spill_dir->path().ToString()), &ctx));
+    auto sink_gen = MakeSinkNode(order_by, "sink");
+
+    ASSERT_OK_AND_ASSIGN(auto collected, StartAndCollect(plan.get(), sink_gen));
+    for (const auto& batch : collected) {
+      ASSERT_LE(batch.length, ctx.exec_chunksize());
+    }
+    ASSERT_OK_AND_ASSIGN(auto actual, TableFromExecBatches(input_schema, collected));
+    ASSERT_EQ(actual->num_columns(), expected->num_columns());
+    for (int i = 0; i < expected->num_columns(); ++i) {
+      AssertChunkedApproxEquivalent(*expected->column(i), *actual->column(i),
+                                    EqualOptions().nans_equal(true));
+    }
+
+    // the spill files have been removed
+    ASSERT_OK_AND_ASSIGN(auto listing, ::arrow::internal::ListDir(spill_dir->path()));
+    ASSERT_EQ(listing.size(), 0);
+  }
+}
+
+TEST(ExecPlanExecution, SourceOrderByErrors) {
+  ASSERT_OK_AND_ASSIGN(auto plan, ExecPlan::Make());
+
+  auto input = MakeGroupableBatches();
+  ASSERT_OK_AND_ASSIGN(auto source,
+                       MakeTestSourceNode(plan.get(), "source", input,
+                                          /*parallel=*/false, /*slow=*/false));
+
+  ASSERT_RAISES(Invalid, MakeOrderByNode(source, "order_by", SortOptions()));
+
+  EXPECT_RAISES_WITH_MESSAGE_THAT(
+      Invalid, HasSubstr("Nonexistent sort key column"),
+      MakeOrderByNode(source, "order_by", SortOptions({SortKey("missing")})));
+
+  // the spill directory must exist
+  ASSERT_OK_AND_ASSIGN(
+      auto order_by,
+      MakeOrderByNode(source, "order_by", SortOptions({SortKey("str")}),
+                      SpillOptions(/*memory_limit=*/0, "/nonexistent/directory")));
+  auto sink_gen = MakeSinkNode(order_by, "sink");
+  ASSERT_RAISES(IOError, StartAndCollect(plan.get(), sink_gen));
+}
+
 }  // namespace compute
 }  // namespace arrow
@@ -25,7 +25,9 @@
 #include "arrow/testing/random.h"
 
 #include "arrow/array/array_base.h"
+#include "arrow/array/array_primitive.h"
 #include "arrow/array/data.h"
+#include "arrow/array/util.h"
 #include "arrow/buffer.h"
 #include "arrow/chunked_array.h"
 #include "arrow/compute/exec.h"
@@ -89,6 +91,46 @@ TEST(SelectionVector, Basics) {
   ASSERT_EQ(3, sel_vector->indices()[1]);
 }
 
+TEST(SelectionVector, FromMask) {
+  auto FromMask = [](const std::shared_ptr<Array>& mask) {
+    return SelectionVector::FromMask(checked_cast<const BooleanArray&>(*mask));
+  };
+
+  auto mask = ArrayFromJSON(boolean(), "[true, false, null, true, true, null, false]");
+  ASSERT_OK_AND_ASSIGN(auto sel_vector, FromMask(mask));
+  AssertArraysEqual(*ArrayFromJSON(int32(), "[0, 3, 4]"), *MakeArray(sel_vector->data()));
+
+  // sliced masks are indexed from their offset
+  ASSERT_OK_AND_ASSIGN(sel_vector, FromMask(mask->Slice(3)));
+  AssertArraysEqual(*ArrayFromJSON(int32(), "[0, 1]"), *MakeArray(sel_vector->data()));
+
+  ASSERT_OK_AND_ASSIGN(sel_vector, FromMask(ArrayFromJSON(boolean(), "[false, null]")));
+  ASSERT_EQ(0, sel_vector->length());
+}
+
+TEST(ExecBatch, SelectionVector) {
+  ExecBatch batch({ArrayFromJSON(int32(), "[1, 2, 3, 4, 5]"),
+                   Datum(std::make_shared<StringScalar>("a"))},
+                  /*length=*/3);
+  batch.selection_vector =
+      std::make_shared<SelectionVector>(*ArrayFromJSON(int32(), "[0, 2, 4]"));
+
+  ASSERT_OK_AND_ASSIGN(auto materialized, batch.Materialize());
+  ASSERT_EQ(nullptr, materialized.selection_vector);
+  ASSERT_EQ(3, materialized.length);
+  AssertDatumsEqual(ArrayFromJSON(int32(), "[1, 3, 5]"), materialized[0]);
+  AssertDatumsEqual(batch[1], materialized[1]);
+
+  // slicing a batch with a selection vector slices the selection, not the values
+  auto sliced = batch.Slice(1, 2);
+  ASSERT_EQ(2, sliced.length);
+  ASSERT_EQ(batch[0], sliced[0]);
+  ASSERT_OK_AND_ASSIGN(materialized, sliced.Materialize());
+  AssertDatumsEqual(ArrayFromJSON(int32(), "[3, 5]"), materialized[0]);
+
+  ASSERT_NE(batch, *batch.Materialize());
+}
+
 void AssertValidityZeroExtraBits(const ArrayData& arr) {
   const Buffer& buf = *arr.buffers[0];
 
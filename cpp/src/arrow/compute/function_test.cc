@@ -106,6 +106,9 @@ TEST(FunctionOptions, Equality) {
   options.emplace_back(new SortOptions({SortKey("key", SortOrder::Ascending)}));
   options.emplace_back(new SortOptions(
       {SortKey("key", SortOrder::Descending), SortKey("value", SortOrder::Descending)}));
+  options.emplace_back(new SelectKOptions());
+  options.emplace_back(new SelectKOptions(
+      /*k=*/10, {SortKey("key", SortOrder::Descending), SortKey("value")}));
   options.emplace_back(new PartitionNthOptions(/*pivot=*/0));
   options.emplace_back(new PartitionNthOptions(/*pivot=*/42));
 
@@ -645,6 +645,11 @@ using ScalarAggregateMerge =
 // Finalize returns Datum to permit multiple return values
 using ScalarAggregateFinalize = std::function<Status(KernelContext*, Datum*)>;
 
+// Export returns the state as a Datum so that it can leave the process
+using ScalarAggregateExport = std::function<Status(KernelContext*, Datum*)>;
+
+using ScalarAggregateMergeExported = std::function<Status(KernelContext*, const Datum&)>;
+
 /// \brief Kernel data structure for implementations of
 /// ScalarAggregateFunction. The four necessary components of an aggregation
 /// kernel are the init, consume, merge, and finalize functions.
@@ -655,6 +660,15 @@ using ScalarAggregateFinalize = std::function<Status(KernelContext*, Datum*)>;
 /// * merge: combines one KernelState with another.
 /// * finalize: produces the end result of the aggregation using the
 ///   KernelState in the KernelContext.
+///
+/// Kernels may also provide the optional export_state and merge_exported
+/// functions, which allow combining partial aggregations across processes.
+///
+/// * export_state: produces the KernelState found in the KernelContext as a
+///   struct scalar, which can be serialized like any other Arrow data (e.g.
+///   with IPC). As with finalize, the state may not be used afterwards.
+/// * merge_exported: combines a state produced by export_state with the same
+///   kernel and options into the KernelState found in the KernelContext.
 struct ScalarAggregateKernel : public Kernel {
   ScalarAggregateKernel() = default;
 
@@ -676,6 +690,8 @@ struct ScalarAggregateKernel : public Kernel {
   ScalarAggregateConsume consume;
   ScalarAggregateMerge merge;
   ScalarAggregateFinalize finalize;
+  ScalarAggregateExport export_state;
+  ScalarAggregateMergeExported merge_exported;
 };
 
 // ----------------------------------------------------------------------
@@ -684,11 +700,17 @@ struct ScalarAggregateKernel : public Kernel {
 using HashAggregateConsume = std::function<Status(KernelContext*, const ExecBatch&)>;
 
 using HashAggregateMerge =
-    std::function<Status(KernelContext*, KernelState&&, KernelState*)>;
+    std::function<Status(KernelContext*, KernelState&&, const ArrayData&)>;
 
 // Finalize returns Datum to permit multiple return values
 using HashAggregateFinalize = std::function<Status(KernelContext*, Datum*)>;
 
+// Export returns the state as a Datum so that it can leave the process
+using HashAggregateExport = std::function<Status(KernelContext*, Datum*)>;
+
+using HashAggregateMergeExported =
+    std::function<Status(KernelContext*, const Datum&, const ArrayData&)>;
+
 /// \brief Kernel data structure for implementations of
 /// HashAggregateFunction. The four necessary components of an aggregation
 /// kernel are the init, consume, merge, and finalize functions.
@@ -697,9 +719,23 @@ using HashAggregateFinalize = std::function<Status(KernelContext*, Datum*)>;
 /// * consume: processes an ExecBatch (which includes the argument as well
 ///   as an array of group identifiers) and updates the KernelState found in the
 ///   KernelContext.
-/// * merge: combines one KernelState with another.
+/// * merge: combines another KernelState into the KernelState found in the
+///   KernelContext. The uint32 array maps each group of the other state to
+///   the corresponding group of this state.
 /// * finalize: produces the end result of the aggregation using the
 ///   KernelState in the KernelContext.
+///
+/// Kernels may also provide the optional export_state and merge_exported
+/// functions, which allow combining partial aggregations across processes.
+///
+/// * export_state: produces the KernelState found in the KernelContext as a
+///   struct array with one row per group, which can be serialized like any
+///   other Arrow data (e.g. with IPC). As with finalize, the state may not be
+///   used afterwards.
+/// * merge_exported: combines a state produced by export_state with the same
+///   kernel and options into the KernelState found in the KernelContext. The
+///   uint32 array maps each row of the exported state to the corresponding
+///   group of this state.
 struct HashAggregateKernel : public Kernel {
   HashAggregateKernel() = default;
 
@@ -721,6 +757,8 @@ struct HashAggregateKernel : public Kernel {
   HashAggregateConsume consume;
   HashAggregateMerge merge;
   HashAggregateFinalize finalize;
+  HashAggregateExport export_state;
+  HashAggregateMergeExported merge_exported;
 };
 
 }  // namespace compute
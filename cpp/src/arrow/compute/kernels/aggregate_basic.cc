@@ -39,12 +39,43 @@ Status AggregateFinalize(KernelContext* ctx, Datum* out) {
   return checked_cast<ScalarAggregator*>(ctx->state())->Finalize(ctx, out);
 }
 
+Status AggregateExport(KernelContext* ctx, Datum* out) {
+  return checked_cast<ScalarAggregator*>(ctx->state())->ExportState(ctx, out);
+}
+
+Status AggregateMergeExported(KernelContext* ctx, const Datum& state) {
+  return checked_cast<ScalarAggregator*>(ctx->state())->MergeExported(ctx, state);
+}
+
 }  // namespace
 
+Result<const ScalarVector*> GetExportedState(const Datum& state, const DataType& type) {
+  if (!state.is_scalar()) {
+    return Status::TypeError("Expected an aggregate state scalar, got ",
+                             state.ToString());
+  }
+  if (!state.scalar()->type->Equals(type)) {
+    return Status::TypeError("Expected an aggregate state of type ", type, ", got ",
+                             *state.scalar()->type);
+  }
+  const auto& scalar = checked_cast<const StructScalar&>(*state.scalar());
+  if (!scalar.is_valid) {
+    return Status::Invalid("Aggregate state may not be null");
+  }
+  for (const auto& field : scalar.value) {
+    if (!field->is_valid) {
+      return Status::Invalid("Aggregate state fields may not be null");
+    }
+  }
+  return &scalar.value;
+}
+
 void AddAggKernel(std::shared_ptr<KernelSignature> sig, KernelInit init,
                   ScalarAggregateFunction* func, SimdLevel::type simd_level) {
   ScalarAggregateKernel kernel(std::move(sig), init, AggregateConsume, AggregateMerge,
                                AggregateFinalize);
+  kernel.export_state = AggregateExport;
+  kernel.merge_exported = AggregateMergeExported;
   // Set the simd level
   kernel.simd_level = simd_level;
   DCHECK_OK(func->AddKernel(kernel));
@@ -73,6 +104,23 @@ struct CountImpl : public ScalarAggregator {
     return Status::OK();
   }
 
+  Status ExportState(KernelContext*, Datum* out) override {
+    out->value = std::make_shared<StructScalar>(
+        ScalarVector{MakeScalar(non_nulls), MakeScalar(nulls)}, state_type());
+    return Status::OK();
+  }
+
+  Status MergeExported(KernelContext*, const Datum& state) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields, GetExportedState(state, *state_type()));
+    this->non_nulls += checked_cast<const Int64Scalar&>(*(*fields)[0]).value;
+    this->nulls += checked_cast<const Int64Scalar&>(*(*fields)[1]).value;
+    return Status::OK();
+  }
+
+  static std::shared_ptr<DataType> state_type() {
+    return struct_({field("non_nulls", int64()), field("nulls", int64())});
+  }
+
   Status Finalize(KernelContext* ctx, Datum* out) override {
     const auto& state = checked_cast<const CountImpl&>(*ctx->state());
     if (state.options.skip_nulls) {
@@ -77,6 +77,25 @@ struct SumImpl : public ScalarAggregator {
     return Status::OK();
   }
 
+  Status ExportState(KernelContext*, Datum* out) override {
+    ScalarVector values{MakeScalar(static_cast<int64_t>(this->count)),
+                        MakeScalar(this->sum)};
+    out->value = std::make_shared<StructScalar>(std::move(values), state_type());
+    return Status::OK();
+  }
+
+  Status MergeExported(KernelContext*, const Datum& state) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields, GetExportedState(state, *state_type()));
+    this->count += checked_cast<const Int64Scalar&>(*(*fields)[0]).value;
+    this->sum += checked_cast<const OutputType&>(*(*fields)[1]).value;
+    return Status::OK();
+  }
+
+  static std::shared_ptr<DataType> state_type() {
+    return struct_({field("count", int64()),
+                    field("sum", TypeTraits<SumType>::type_singleton())});
+  }
+
   Status Finalize(KernelContext*, Datum* out) override {
     if (this->count < options.min_count) {
       out->value = std::make_shared<OutputType>();
@@ -258,6 +277,36 @@ struct MinMaxImpl : public ScalarAggregator {
     return Status::OK();
   }
 
+  Status ExportState(KernelContext*, Datum* out) override {
+    using ScalarType = typename TypeTraits<ArrowType>::ScalarType;
+
+    ScalarVector values{std::make_shared<ScalarType>(state.min),
+                        std::make_shared<ScalarType>(state.max),
+                        std::make_shared<BooleanScalar>(state.has_nulls),
+                        std::make_shared<BooleanScalar>(state.has_values)};
+    out->value = std::make_shared<StructScalar>(std::move(values), state_type());
+    return Status::OK();
+  }
+
+  Status MergeExported(KernelContext*, const Datum& exported) override {
+    using ScalarType = typename TypeTraits<ArrowType>::ScalarType;
+
+    ARROW_ASSIGN_OR_RAISE(auto fields, GetExportedState(exported, *state_type()));
+    StateType other;
+    other.min = checked_cast<const ScalarType&>(*(*fields)[0]).value;
+    other.max = checked_cast<const ScalarType&>(*(*fields)[1]).value;
+    other.has_nulls = checked_cast<const BooleanScalar&>(*(*fields)[2]).value;
+    other.has_values = checked_cast<const BooleanScalar&>(*(*fields)[3]).value;
+    this->state += other;
+    return Status::OK();
+  }
+
+  std::shared_ptr<DataType> state_type() const {
+    const auto& value_type = out_type->field(0)->type();
+    return struct_({field("min", value_type), field("max", value_type),
+                    field("has_nulls", boolean()), field("has_values", boolean())});
+  }
+
   Status Finalize(KernelContext*, Datum* out) override {
     using ScalarType = typename TypeTraits<ArrowType>::ScalarType;
 
@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "arrow/chunked_array.h"
 #include "arrow/compute/api.h"
 #include "arrow/testing/gtest_util.h"
 #include "arrow/testing/random.h"
@@ -463,6 +464,71 @@ GROUP_BY_BENCHMARK(SumDoublesGroupedByMediumIntStringPairSet, [&] {
   BenchmarkGroupBy(state, {{"hash_sum", NULLPTR}}, {summand}, {int_key, str_key});
 });
 
+GROUP_BY_BENCHMARK(SumDoublesGroupedByMediumStringStringIntTripleSet, [&] {
+  auto summand = rng.Float64(args.size,
+                             /*min=*/0.0,
+                             /*max=*/1.0e14,
+                             /*null_probability=*/args.null_proportion,
+                             /*nan_probability=*/args.null_proportion / 10);
+
+  auto tenant_key = rng.StringWithRepeats(args.size,
+                                          /*unique=*/64,
+                                          /*min_length=*/3,
+                                          /*max_length=*/32);
+  auto region_key = rng.StringWithRepeats(args.size,
+                                          /*unique=*/8,
+                                          /*min_length=*/3,
+                                          /*max_length=*/16);
+  auto day_key = rng.Int32(args.size,
+                           /*min=*/0,
+                           /*max=*/30);
+
+  BenchmarkGroupBy(state, {{"hash_sum", NULLPTR}}, {summand},
+                   {tenant_key, region_key, day_key});
+});
+
+GROUP_BY_BENCHMARK(SumDoublesGroupedByMediumLargeStringSet, [&] {
+  auto summand = rng.Float64(args.size,
+                             /*min=*/0.0,
+                             /*max=*/1.0e14,
+                             /*null_probability=*/args.null_proportion,
+                             /*nan_probability=*/args.null_proportion / 10);
+
+  auto key = rng.StringWithRepeats(args.size,
+                                   /*unique=*/4096,
+                                   /*min_length=*/3,
+                                   /*max_length=*/32);
+  Datum large_key = Cast(key, large_utf8()).ValueOrDie();
+
+  BenchmarkGroupBy(state, {{"hash_sum", NULLPTR}}, {summand}, {large_key});
+});
+
+// Each chunk of the key carries its own dictionary, which must be unified
+GROUP_BY_BENCHMARK(SumDoublesGroupedByMediumDictionarySet, [&] {
+  const int64_t num_chunks = 16;
+  const int64_t chunk_size = args.size / num_chunks;
+
+  ArrayVector summand_chunks;
+  ArrayVector key_chunks;
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    summand_chunks.push_back(
+        rng.Float64(chunk_size,
+                    /*min=*/0.0,
+                    /*max=*/1.0e14,
+                    /*null_probability=*/args.null_proportion,
+                    /*nan_probability=*/args.null_proportion / 10));
+    auto key = rng.StringWithRepeats(chunk_size,
+                                     /*unique=*/4096,
+                                     /*min_length=*/3,
+                                     /*max_length=*/32);
+    key_chunks.push_back(DictionaryEncode(key).ValueOrDie().make_array());
+  }
+
+  BenchmarkGroupBy(state, {{"hash_sum", NULLPTR}},
+                   {std::make_shared<ChunkedArray>(std::move(summand_chunks))},
+                   {std::make_shared<ChunkedArray>(std::move(key_chunks))});
+});
+
 //
 // Sum
 //
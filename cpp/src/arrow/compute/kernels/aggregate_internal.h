@@ -53,8 +53,22 @@ struct ScalarAggregator : public KernelState {
   virtual Status Consume(KernelContext* ctx, const ExecBatch& batch) = 0;
   virtual Status MergeFrom(KernelContext* ctx, KernelState&& src) = 0;
   virtual Status Finalize(KernelContext* ctx, Datum* out) = 0;
+
+  /// \brief Export the state as a struct scalar, see ScalarAggregateKernel
+  virtual Status ExportState(KernelContext* ctx, Datum* out) {
+    return Status::NotImplemented("Exporting the state of this aggregate");
+  }
+
+  /// \brief Merge a state produced by ExportState into this one
+  virtual Status MergeExported(KernelContext* ctx, const Datum& state) {
+    return Status::NotImplemented("Merging an exported state of this aggregate");
+  }
 };
 
+/// \brief Return the fields of a state produced by ScalarAggregator::ExportState,
+/// after checking that it is a valid struct scalar of the given type
+Result<const ScalarVector*> GetExportedState(const Datum& state, const DataType& type);
+
 void AddAggKernel(std::shared_ptr<KernelSignature> sig, KernelInit init,
                   ScalarAggregateFunction* func,
                   SimdLevel::type simd_level = SimdLevel::NONE);
@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include "arrow/array/builder_primitive.h"
 #include "arrow/compute/api_aggregate.h"
 #include "arrow/compute/kernels/aggregate_internal.h"
 #include "arrow/compute/kernels/common.h"
@@ -37,7 +38,7 @@ struct TDigestImpl : public ScalarAggregator {
   using CType = typename ArrowType::c_type;
 
   explicit TDigestImpl(const TDigestOptions& options)
-      : q{options.q}, tdigest{options.delta, options.buffer_size} {}
+      : q{options.q}, delta{options.delta}, tdigest{options.delta, options.buffer_size} {}
 
   Status Consume(KernelContext*, const ExecBatch& batch) override {
     const ArrayData& data = *batch[0].array();
@@ -62,6 +63,51 @@ struct TDigestImpl : public ScalarAggregator {
     return Status::OK();
   }
 
+  Status ExportState(KernelContext* ctx, Datum* out) override {
+    std::vector<double> means, weights;
+    double min, max;
+    this->tdigest.GetCentroids(&means, &weights, &min, &max);
+
+    DoubleBuilder builder(ctx->memory_pool());
+    std::shared_ptr<Array> means_array, weights_array;
+    RETURN_NOT_OK(builder.AppendValues(means));
+    RETURN_NOT_OK(builder.Finish(&means_array));
+    RETURN_NOT_OK(builder.AppendValues(weights));
+    RETURN_NOT_OK(builder.Finish(&weights_array));
+
+    ScalarVector values{std::make_shared<ListScalar>(std::move(means_array)),
+                        std::make_shared<ListScalar>(std::move(weights_array)),
+                        MakeScalar(min), MakeScalar(max)};
+    out->value = std::make_shared<StructScalar>(std::move(values), state_type());
+    return Status::OK();
+  }
+
+  Status MergeExported(KernelContext*, const Datum& exported) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields, GetExportedState(exported, *state_type()));
+    const auto& means_array = checked_cast<const ListScalar&>(*(*fields)[0]).value;
+    const auto& weights_array = checked_cast<const ListScalar&>(*(*fields)[1]).value;
+    if (means_array->null_count() > 0 || weights_array->null_count() > 0) {
+      return Status::Invalid("tdigest centroids may not be null");
+    }
+    const auto& means = checked_cast<const DoubleArray&>(*means_array);
+    const auto& weights = checked_cast<const DoubleArray&>(*weights_array);
+
+    std::vector<TDigest> other_tdigest;
+    other_tdigest.emplace_back(this->delta, /*buffer_size=*/0);
+    RETURN_NOT_OK(other_tdigest[0].SetCentroids(
+        {means.raw_values(), means.raw_values() + means.length()},
+        {weights.raw_values(), weights.raw_values() + weights.length()},
+        checked_cast<const DoubleScalar&>(*(*fields)[2]).value,
+        checked_cast<const DoubleScalar&>(*(*fields)[3]).value));
+    this->tdigest.Merge(&other_tdigest);
+    return Status::OK();
+  }
+
+  static std::shared_ptr<DataType> state_type() {
+    return struct_({field("mean", list(float64())), field("weight", list(float64())),
+                    field("min", float64()), field("max", float64())});
+  }
+
   Status Finalize(KernelContext* ctx, Datum* out) override {
     const int64_t out_length = this->tdigest.is_empty() ? 0 : this->q.size();
     auto out_data = ArrayData::Make(float64(), out_length, 0);
@@ -81,6 +127,7 @@ struct TDigestImpl : public ScalarAggregator {
   }
 
   const std::vector<double>& q;
+  const uint32_t delta;
   TDigest tdigest;
 };
 
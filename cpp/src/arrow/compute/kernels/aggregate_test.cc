@@ -25,6 +25,7 @@
 #include <gtest/gtest.h>
 
 #include "arrow/array.h"
+#include "arrow/array/util.h"
 #include "arrow/chunked_array.h"
 #include "arrow/compute/api_aggregate.h"
 #include "arrow/compute/api_scalar.h"
@@ -33,6 +34,10 @@
 #include "arrow/compute/kernels/aggregate_internal.h"
 #include "arrow/compute/kernels/test_util.h"
 #include "arrow/compute/registry.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/record_batch.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
 #include "arrow/util/bitmap_reader.h"
@@ -2194,5 +2199,116 @@ TEST_F(TestTDigestKernel, AllNullsOrNaNs) {
   }
 }
 
+//
+// Exported states
+//
+
+// Send an exported state through IPC, as it would go to another process
+Result<Datum> RoundTripState(const Datum& state) {
+  ARROW_ASSIGN_OR_RAISE(auto array, MakeArrayFromScalar(*state.scalar(), 1));
+  auto batch = RecordBatch::Make(schema({field("state", array->type())}), 1, {array});
+
+  ARROW_ASSIGN_OR_RAISE(auto sink, io::BufferOutputStream::Create());
+  ARROW_ASSIGN_OR_RAISE(auto writer, ipc::MakeStreamWriter(sink, batch->schema()));
+  RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
+  RETURN_NOT_OK(writer->Close());
+  ARROW_ASSIGN_OR_RAISE(auto buffer, sink->Finish());
+
+  ARROW_ASSIGN_OR_RAISE(auto reader, ipc::RecordBatchStreamReader::Open(
+                                         std::make_shared<io::BufferReader>(buffer)));
+  std::shared_ptr<RecordBatch> read_batch;
+  RETURN_NOT_OK(reader->ReadNext(&read_batch));
+  return read_batch->column(0)->GetScalar(0);
+}
+
+// Aggregate each chunk into its own state, fold the exported states of the other
+// chunks into the first one's and check that the result matches aggregating the
+// whole chunked array at once.
+void CheckMergeExported(const std::string& func_name,
+                        const std::shared_ptr<ChunkedArray>& chunked,
+                        const FunctionOptions* options = nullptr) {
+  ASSERT_OK_AND_ASSIGN(auto function, GetFunctionRegistry()->GetFunction(func_name));
+  if (options == nullptr) {
+    options = function->default_options();
+  }
+  std::vector<ValueDescr> inputs{ValueDescr::Array(chunked->type())};
+  ASSERT_OK_AND_ASSIGN(auto kernel, function->DispatchExact(inputs));
+  auto agg_kernel = static_cast<const ScalarAggregateKernel*>(kernel);
+
+  std::vector<std::unique_ptr<KernelState>> states;
+  std::vector<Datum> exported;
+  for (const auto& chunk : chunked->chunks()) {
+    KernelContext ctx{default_exec_context()};
+    ASSERT_OK_AND_ASSIGN(auto state,
+                         agg_kernel->init(&ctx, KernelInitArgs{kernel, inputs, options}));
+    ctx.SetState(state.get());
+    ASSERT_OK(agg_kernel->consume(&ctx, ExecBatch({chunk}, chunk->length())));
+    if (!states.empty()) {
+      Datum out;
+      ASSERT_OK(agg_kernel->export_state(&ctx, &out));
+      ASSERT_OK_AND_ASSIGN(out, RoundTripState(out));
+      exported.push_back(std::move(out));
+    }
+    states.push_back(std::move(state));
+  }
+
+  KernelContext ctx{default_exec_context()};
+  ctx.SetState(states[0].get());
+  for (const auto& state : exported) {
+    ASSERT_OK(agg_kernel->merge_exported(&ctx, state));
+  }
+  Datum actual;
+  ASSERT_OK(agg_kernel->finalize(&ctx, &actual));
+
+  ASSERT_OK_AND_ASSIGN(Datum expected, CallFunction(func_name, {chunked}, options));
+  AssertDatumsEqual(expected, actual, /*verbose=*/true);
+}
+
+TEST(TestExportedStates, MergeExported) {
+  auto ints = ChunkedArrayFromJSON(int32(), {"[1, 2, null]", "[]", "[4, -5, 6, null]"});
+  auto floats =
+      ChunkedArrayFromJSON(float64(), {"[1.5, null]", "[-0.25, 3.0]", "[null, null]"});
+  auto bools = ChunkedArrayFromJSON(boolean(), {"[true, null]", "[false]"});
+
+  for (const auto& chunked : {ints, floats, bools}) {
+    ARROW_SCOPED_TRACE(chunked->type()->ToString());
+    CheckMergeExported("count", chunked);
+    CheckMergeExported("sum", chunked);
+    CheckMergeExported("mean", chunked);
+    CheckMergeExported("min_max", chunked);
+  }
+  ScalarAggregateOptions keep_nulls(/*skip_nulls=*/false);
+  CheckMergeExported("count", ints, &keep_nulls);
+  CheckMergeExported("min_max", floats, &keep_nulls);
+
+  VarianceOptions variance_options(/*ddof=*/1);
+  for (const auto& chunked : {ints, floats}) {
+    ARROW_SCOPED_TRACE(chunked->type()->ToString());
+    CheckMergeExported("variance", chunked, &variance_options);
+    CheckMergeExported("stddev", chunked);
+    CheckMergeExported("tdigest", chunked);
+  }
+  TDigestOptions quantiles({0, 0.25, 0.5, 1});
+  CheckMergeExported("tdigest", floats, &quantiles);
+}
+
+TEST(TestExportedStates, MergeInvalid) {
+  ASSERT_OK_AND_ASSIGN(auto function, GetFunctionRegistry()->GetFunction("sum"));
+  std::vector<ValueDescr> inputs{ValueDescr::Array(int64())};
+  ASSERT_OK_AND_ASSIGN(auto kernel, function->DispatchExact(inputs));
+  auto agg_kernel = static_cast<const ScalarAggregateKernel*>(kernel);
+
+  KernelContext ctx{default_exec_context()};
+  KernelInitArgs args{kernel, inputs, function->default_options()};
+  ASSERT_OK_AND_ASSIGN(auto state, agg_kernel->init(&ctx, args));
+  ctx.SetState(state.get());
+
+  ASSERT_RAISES(TypeError, agg_kernel->merge_exported(&ctx, Datum(int64_t(1))));
+  ASSERT_RAISES(TypeError,
+                agg_kernel->merge_exported(&ctx, ArrayFromJSON(int64(), "[]")));
+  auto state_type = struct_({field("count", int64()), field("sum", int64())});
+  ASSERT_RAISES(Invalid, agg_kernel->merge_exported(&ctx, MakeNullScalar(state_type)));
+}
+
 }  // namespace compute
 }  // namespace arrow
@@ -163,6 +163,28 @@ struct VarStdImpl : public ScalarAggregator {
     return Status::OK();
   }
 
+  Status ExportState(KernelContext*, Datum* out) override {
+    ScalarVector values{MakeScalar(this->state.count), MakeScalar(this->state.mean),
+                        MakeScalar(this->state.m2)};
+    out->value = std::make_shared<StructScalar>(std::move(values), state_type());
+    return Status::OK();
+  }
+
+  Status MergeExported(KernelContext*, const Datum& exported) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields, GetExportedState(exported, *state_type()));
+    VarStdState<ArrowType> other;
+    other.count = checked_cast<const Int64Scalar&>(*(*fields)[0]).value;
+    other.mean = checked_cast<const DoubleScalar&>(*(*fields)[1]).value;
+    other.m2 = checked_cast<const DoubleScalar&>(*(*fields)[2]).value;
+    this->state.MergeFrom(other);
+    return Status::OK();
+  }
+
+  static std::shared_ptr<DataType> state_type() {
+    return struct_(
+        {field("count", int64()), field("mean", float64()), field("m2", float64())});
+  }
+
   Status Finalize(KernelContext*, Datum* out) override {
     if (this->state.count <= options.ddof) {
       out->value = std::make_shared<DoubleScalar>();
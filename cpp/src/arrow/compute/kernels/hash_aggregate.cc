@@ -16,13 +16,17 @@
 // under the License.
 
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "arrow/array/array_dict.h"
+#include "arrow/array/concatenate.h"
 #include "arrow/buffer_builder.h"
 #include "arrow/compute/api_aggregate.h"
+#include "arrow/compute/api_scalar.h"
 #include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec/key_compare.h"
 #include "arrow/compute/exec/key_encode.h"
@@ -360,29 +364,37 @@ struct GrouperImpl : Grouper {
     return std::move(impl);
   }
 
-  Result<Datum> Consume(const ExecBatch& batch) override {
-    std::vector<int32_t> offsets_batch(batch.length + 1);
+  Status EncodeKeys(const ExecBatch& batch, std::vector<int32_t>* offsets_batch,
+                    std::vector<uint8_t>* key_bytes_batch) {
+    offsets_batch->resize(batch.length + 1);
     for (int i = 0; i < batch.num_values(); ++i) {
-      encoders_[i]->AddLength(*batch[i].array(), offsets_batch.data());
+      encoders_[i]->AddLength(*batch[i].array(), offsets_batch->data());
     }
 
     int32_t total_length = 0;
     for (int64_t i = 0; i < batch.length; ++i) {
       auto total_length_before = total_length;
-      total_length += offsets_batch[i];
-      offsets_batch[i] = total_length_before;
+      total_length += (*offsets_batch)[i];
+      (*offsets_batch)[i] = total_length_before;
     }
-    offsets_batch[batch.length] = total_length;
+    (*offsets_batch)[batch.length] = total_length;
 
-    std::vector<uint8_t> key_bytes_batch(total_length);
+    key_bytes_batch->resize(total_length);
     std::vector<uint8_t*> key_buf_ptrs(batch.length);
     for (int64_t i = 0; i < batch.length; ++i) {
-      key_buf_ptrs[i] = key_bytes_batch.data() + offsets_batch[i];
+      key_buf_ptrs[i] = key_bytes_batch->data() + (*offsets_batch)[i];
     }
 
     for (int i = 0; i < batch.num_values(); ++i) {
       RETURN_NOT_OK(encoders_[i]->Encode(*batch[i].array(), key_buf_ptrs.data()));
     }
+    return Status::OK();
+  }
+
+  Result<Datum> Consume(const ExecBatch& batch) override {
+    std::vector<int32_t> offsets_batch;
+    std::vector<uint8_t> key_bytes_batch;
+    RETURN_NOT_OK(EncodeKeys(batch, &offsets_batch, &key_bytes_batch));
 
     TypedBufferBuilder<uint32_t> group_ids_batch(ctx_->memory_pool());
     RETURN_NOT_OK(group_ids_batch.Resize(batch.length));
@@ -412,6 +424,39 @@ struct GrouperImpl : Grouper {
     return Datum(UInt32Array(batch.length, std::move(group_ids)));
   }
 
+  Result<Datum> Find(const ExecBatch& batch) override {
+    std::vector<int32_t> offsets_batch;
+    std::vector<uint8_t> key_bytes_batch;
+    RETURN_NOT_OK(EncodeKeys(batch, &offsets_batch, &key_bytes_batch));
+
+    TypedBufferBuilder<uint32_t> group_ids_batch(ctx_->memory_pool());
+    TypedBufferBuilder<bool> found_batch(ctx_->memory_pool());
+    RETURN_NOT_OK(group_ids_batch.Resize(batch.length));
+    RETURN_NOT_OK(found_batch.Resize(batch.length));
+
+    for (int64_t i = 0; i < batch.length; ++i) {
+      int32_t key_length = offsets_batch[i + 1] - offsets_batch[i];
+      std::string key(
+          reinterpret_cast<const char*>(key_bytes_batch.data() + offsets_batch[i]),
+          key_length);
+
+      auto it = map_.find(key);
+      if (it != map_.end()) {
+        group_ids_batch.UnsafeAppend(it->second);
+        found_batch.UnsafeAppend(true);
+      } else {
+        group_ids_batch.UnsafeAppend(0);
+        found_batch.UnsafeAppend(false);
+      }
+    }
+
+    auto null_count = found_batch.false_count();
+    ARROW_ASSIGN_OR_RAISE(auto group_ids, group_ids_batch.Finish());
+    ARROW_ASSIGN_OR_RAISE(auto found, found_batch.Finish());
+    return Datum(
+        UInt32Array(batch.length, std::move(group_ids), std::move(found), null_count));
+  }
+
   uint32_t num_groups() const override { return num_groups_; }
 
   Result<ExecBatch> GetUniques() override {
@@ -449,7 +494,8 @@ struct GrouperFastImpl : Grouper {
 #if ARROW_LITTLE_ENDIAN
     for (size_t i = 0; i < keys.size(); ++i) {
       const auto& key = keys[i].type;
-      if (is_large_binary_like(key->id())) {
+      if (key->id() != Type::DICTIONARY && !is_fixed_width(key->id()) &&
+          !is_base_binary_like(key->id())) {
         return false;
       }
     }
@@ -459,6 +505,28 @@ struct GrouperFastImpl : Grouper {
 #endif
   }
 
+  // Batches of dictionary keys are grouped on their indices into a dictionary unifying
+  // all those seen so far. It only grows, so that the indices of earlier batches keep
+  // their meaning. Until a second dictionary is seen, no unification takes place.
+  // Find only looks values up in the unified dictionary and never grows it.
+  struct DictionaryKey {
+    // The first dictionary, which is the unified one as long as there is no unifier
+    std::shared_ptr<Array> first_dictionary;
+    std::unique_ptr<DictionaryUnifier> unifier;
+    int64_t unified_length = 0;
+
+    // The dictionary of the previous batch and the transposition of its indices into
+    // the unified dictionary, which is null if trivial
+    std::shared_ptr<ArrayData> last_dictionary;
+    std::shared_ptr<Buffer> last_transpose;
+
+    // The dictionary last looked up by Find, the positions of its values in the
+    // unified dictionary (null where absent) and the unified length they refer to
+    std::shared_ptr<ArrayData> lookup_dictionary;
+    std::shared_ptr<Array> lookup_positions;
+    int64_t lookup_unified_length = -1;
+  };
+
   static Result<std::unique_ptr<GrouperFastImpl>> Make(
       const std::vector<ValueDescr>& keys, ExecContext* ctx) {
     auto impl = ::arrow::internal::make_unique<GrouperFastImpl>();
@@ -472,7 +540,7 @@ struct GrouperFastImpl : Grouper {
     auto num_columns = keys.size();
     impl->col_metadata_.resize(num_columns);
     impl->key_types_.resize(num_columns);
-    impl->dictionaries_.resize(num_columns);
+    impl->dictionary_keys_.resize(num_columns);
     for (size_t icol = 0; icol < num_columns; ++icol) {
       const auto& key = keys[icol].type;
       if (key->id() == Type::DICTIONARY) {
@@ -486,7 +554,8 @@ struct GrouperFastImpl : Grouper {
       } else if (is_fixed_width(key->id())) {
         impl->col_metadata_[icol] = arrow::compute::KeyEncoder::KeyColumnMetadata(
             true, checked_cast<const FixedWidthType&>(*key).bit_width() / 8);
-      } else if (is_binary_like(key->id())) {
+      } else if (is_base_binary_like(key->id())) {
+        // The offsets of large binary keys are narrowed to 32 bits, see ConsumeImpl
         impl->col_metadata_[icol] =
             arrow::compute::KeyEncoder::KeyColumnMetadata(false, sizeof(uint32_t));
       } else {
@@ -522,6 +591,7 @@ struct GrouperFastImpl : Grouper {
     impl->cols_.resize(num_columns);
     impl->minibatch_hashes_.resize(impl->minibatch_size_max_ +
                                    kPaddingForSIMD / sizeof(uint32_t));
+    impl->minibatch_found_.resize(impl->minibatch_size_max_ / 8 + kPaddingForSIMD);
 
     return std::move(impl);
   }
@@ -529,22 +599,27 @@ struct GrouperFastImpl : Grouper {
   ~GrouperFastImpl() { map_.cleanup(); }
 
   Result<Datum> Consume(const ExecBatch& batch) override {
+    return ConsumeImpl(batch, /*insert=*/true);
+  }
+
+  Result<Datum> Find(const ExecBatch& batch) override {
+    return ConsumeImpl(batch, /*insert=*/false);
+  }
+
+  Result<Datum> ConsumeImpl(const ExecBatch& batch, bool insert) {
     int64_t num_rows = batch.length;
     int num_columns = batch.num_values();
 
-    // Process dictionaries
+    ArrayDataVector key_data(num_columns);
+    // Rows of Find whose dictionary value is absent from the unified dictionary
+    std::shared_ptr<Buffer> unknown_rows;
     for (int icol = 0; icol < num_columns; ++icol) {
+      key_data[icol] = batch[icol].array();
       if (key_types_[icol]->id() == Type::DICTIONARY) {
-        auto data = batch[icol].array();
-        auto dict = MakeArray(data->dictionary);
-        if (dictionaries_[icol]) {
-          if (!dictionaries_[icol]->Equals(dict)) {
-            // TODO(bkietz) unify if necessary. For now, just error if any batch's
-            // dictionary differs from the first we saw for this key
-            return Status::NotImplemented("Unifying differing dictionaries");
-          }
+        if (insert) {
+          RETURN_NOT_OK(UnifyDictionary(icol, &key_data[icol]));
         } else {
-          dictionaries_[icol] = std::move(dict);
+          RETURN_NOT_OK(LookupDictionary(icol, &key_data[icol], &unknown_rows));
         }
       }
     }
@@ -552,20 +627,41 @@ struct GrouperFastImpl : Grouper {
     std::shared_ptr<arrow::Buffer> group_ids;
     ARROW_ASSIGN_OR_RAISE(
         group_ids, AllocateBuffer(sizeof(uint32_t) * num_rows, ctx_->memory_pool()));
+    std::shared_ptr<arrow::Buffer> found;
+    if (!insert) {
+      ARROW_ASSIGN_OR_RAISE(found, AllocateBitmap(num_rows, ctx_->memory_pool()));
+    }
 
+    // The encoder reads bit vectors from a byte boundary, so slices which do not
+    // start on one are copied. The copies must outlive the encoding below.
     for (int icol = 0; icol < num_columns; ++icol) {
+      if (key_data[icol]->offset % 8 != 0) {
+        ARROW_ASSIGN_OR_RAISE(
+            auto unsliced, Concatenate({MakeArray(key_data[icol])}, ctx_->memory_pool()));
+        key_data[icol] = unsliced->data();
+      }
+      if (is_large_binary_like(key_types_[icol]->id())) {
+        ARROW_ASSIGN_OR_RAISE(key_data[icol], NarrowOffsets(*key_data[icol]));
+      }
+    }
+
+    for (int icol = 0; icol < num_columns; ++icol) {
+      const std::shared_ptr<ArrayData>& data = key_data[icol];
+
       const uint8_t* non_nulls = nullptr;
-      if (batch[icol].array()->buffers[0] != NULLPTR) {
-        non_nulls = batch[icol].array()->buffers[0]->data();
+      if (data->buffers[0] != NULLPTR) {
+        non_nulls = data->buffers[0]->data();
       }
-      const uint8_t* fixedlen = batch[icol].array()->buffers[1]->data();
+      const uint8_t* fixedlen = data->buffers[1]->data();
       const uint8_t* varlen = nullptr;
       if (!col_metadata_[icol].is_fixed_length) {
-        varlen = batch[icol].array()->buffers[2]->data();
+        varlen = data->buffers[2]->data();
       }
 
-      cols_[icol] = arrow::compute::KeyEncoder::KeyColumnArray(
-          col_metadata_[icol], num_rows, non_nulls, fixedlen, varlen);
+      arrow::compute::KeyEncoder::KeyColumnArray unsliced_col(
+          col_metadata_[icol], data->offset + num_rows, non_nulls, fixedlen, varlen);
+      cols_[icol] = arrow::compute::KeyEncoder::KeyColumnArray(unsliced_col, data->offset,
+                                                               num_rows);
     }
 
     // Split into smaller mini-batches
@@ -594,9 +690,17 @@ struct GrouperFastImpl : Grouper {
       }
 
       // Map
-      RETURN_NOT_OK(
-          map_.map(batch_size_next, minibatch_hashes_.data(),
-                   reinterpret_cast<uint32_t*>(group_ids->mutable_data()) + start_row));
+      auto minibatch_group_ids =
+          reinterpret_cast<uint32_t*>(group_ids->mutable_data()) + start_row;
+      if (insert) {
+        RETURN_NOT_OK(
+            map_.map(batch_size_next, minibatch_hashes_.data(), minibatch_group_ids));
+      } else {
+        map_.find(batch_size_next, minibatch_hashes_.data(), minibatch_found_.data(),
+                  minibatch_group_ids);
+        arrow::internal::CopyBitmap(minibatch_found_.data(), 0, batch_size_next,
+                                    found->mutable_data(), start_row);
+      }
 
       start_row += batch_size_next;
 
@@ -605,7 +709,205 @@ struct GrouperFastImpl : Grouper {
       }
     }
 
-    return Datum(UInt32Array(batch.length, std::move(group_ids)));
+    if (insert) {
+      return Datum(UInt32Array(batch.length, std::move(group_ids)));
+    }
+    if (unknown_rows) {
+      arrow::internal::BitmapAndNot(found->data(), 0, unknown_rows->data(), 0, num_rows,
+                                    0, found->mutable_data());
+    }
+    auto null_count =
+        num_rows - arrow::internal::CountSetBits(found->data(), 0, num_rows);
+    return Datum(
+        UInt32Array(batch.length, std::move(group_ids), std::move(found), null_count));
+  }
+
+  Status UnifyDictionary(int icol, std::shared_ptr<ArrayData>* data) {
+    DictionaryKey* key = &dictionary_keys_[icol];
+    const auto& dictionary = (*data)->dictionary;
+
+    if (!key->first_dictionary) {
+      key->first_dictionary = MakeArray(dictionary);
+      key->unified_length = dictionary->length;
+      key->last_dictionary = dictionary;
+      return Status::OK();
+    }
+
+    if (dictionary != key->last_dictionary &&
+        !MakeArray(dictionary)->Equals(*MakeArray(key->last_dictionary))) {
+      const auto& type = checked_cast<const DictionaryType&>(*key_types_[icol]);
+      if (!key->unifier) {
+        ARROW_ASSIGN_OR_RAISE(auto unifier, DictionaryUnifier::Make(
+                                                type.value_type(), ctx_->memory_pool()));
+        // The indices of the first dictionary were grouped on as they are
+        std::shared_ptr<Buffer> transpose;
+        RETURN_NOT_OK(unifier->Unify(*key->first_dictionary, &transpose));
+        if (!IsTrivialTransposition(*transpose, key->first_dictionary->length())) {
+          return Status::NotImplemented(
+              "Unifying differing dictionaries where the first has duplicate values");
+        }
+        key->unifier = std::move(unifier);
+      }
+
+      std::shared_ptr<Buffer> transpose;
+      RETURN_NOT_OK(key->unifier->Unify(*MakeArray(dictionary), &transpose));
+
+      const int32_t* transpose_map = reinterpret_cast<const int32_t*>(transpose->data());
+      for (int64_t i = 0; i < dictionary->length; ++i) {
+        key->unified_length =
+            std::max(key->unified_length, static_cast<int64_t>(transpose_map[i]) + 1);
+      }
+      const auto& index_type = checked_cast<const IntegerType&>(*type.index_type());
+      const int64_t max_index =
+          index_type.is_signed() || index_type.bit_width() == 64
+              ? (int64_t(1) << (index_type.bit_width() - 1)) - 1
+              : (int64_t(1) << index_type.bit_width()) - 1;
+      if (key->unified_length - 1 > max_index) {
+        return Status::Invalid("The unified dictionary of key ", icol, " has ",
+                               key->unified_length, " values, too many for indices of ",
+                               index_type);
+      }
+
+      key->last_dictionary = dictionary;
+      key->last_transpose =
+          IsTrivialTransposition(*transpose, dictionary->length) ? nullptr : transpose;
+    }
+
+    if (key->last_transpose) {
+      // The dictionary attached to the transposed indices is irrelevant: only the
+      // indices are encoded
+      const auto* transpose_map =
+          reinterpret_cast<const int32_t*>(key->last_transpose->data());
+      ARROW_ASSIGN_OR_RAISE(auto transposed,
+                            DictionaryArray(*data).Transpose(key_types_[icol],
+                                                             MakeArray(dictionary),
+                                                             transpose_map,
+                                                             ctx_->memory_pool()));
+      *data = transposed->data();
+    }
+    return Status::OK();
+  }
+
+  // Transposes the indices of a batch passed to Find into the unified dictionary without
+  // growing it. Indices of values absent from it are transposed to 0 and their rows
+  // flagged in a bitmap *unknown_rows, allocated on first use.
+  Status LookupDictionary(int icol, std::shared_ptr<ArrayData>* data,
+                          std::shared_ptr<Buffer>* unknown_rows) {
+    DictionaryKey* key = &dictionary_keys_[icol];
+    const auto dictionary = (*data)->dictionary;
+    if (!key->first_dictionary) {
+      // Nothing was grouped yet, so no row will be found anyway
+      return Status::OK();
+    }
+    if (dictionary == key->last_dictionary ||
+        MakeArray(dictionary)->Equals(*MakeArray(key->last_dictionary))) {
+      // Known to be unified already
+      if (key->last_transpose) {
+        const auto* transpose_map =
+            reinterpret_cast<const int32_t*>(key->last_transpose->data());
+        ARROW_ASSIGN_OR_RAISE(auto transposed,
+                              DictionaryArray(*data).Transpose(key_types_[icol],
+                                                               MakeArray(dictionary),
+                                                               transpose_map,
+                                                               ctx_->memory_pool()));
+        *data = transposed->data();
+      }
+      return Status::OK();
+    }
+
+    if (dictionary != key->lookup_dictionary ||
+        key->unified_length != key->lookup_unified_length) {
+      ARROW_ASSIGN_OR_RAISE(auto unified, GetUnifiedDictionary(icol));
+      ARROW_ASSIGN_OR_RAISE(Datum positions,
+                            IndexIn(MakeArray(dictionary), SetLookupOptions(unified),
+                                    ctx_));
+      key->lookup_dictionary = dictionary;
+      key->lookup_positions = positions.make_array();
+      key->lookup_unified_length = key->unified_length;
+    }
+    const auto& positions = checked_cast<const Int32Array&>(*key->lookup_positions);
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto transpose,
+        AllocateBuffer(dictionary->length * sizeof(int32_t), ctx_->memory_pool()));
+    auto transpose_map = reinterpret_cast<int32_t*>(transpose->mutable_data());
+    for (int64_t i = 0; i < dictionary->length; ++i) {
+      transpose_map[i] = positions.IsValid(i) ? positions.Value(i) : 0;
+    }
+
+    if (positions.null_count() > 0) {
+      // A row is unknown if its index is valid but the value it points to is absent
+      auto indices = DictionaryArray(*data).indices();
+      ARROW_ASSIGN_OR_RAISE(Datum row_positions,
+                            Take(key->lookup_positions, indices,
+                                 TakeOptions::Defaults(), ctx_));
+      auto row_positions_array = row_positions.make_array();
+      if (!*unknown_rows) {
+        ARROW_ASSIGN_OR_RAISE(
+            *unknown_rows, AllocateEmptyBitmap(indices->length(), ctx_->memory_pool()));
+      }
+      uint8_t* unknown = (*unknown_rows)->mutable_data();
+      for (int64_t i = 0; i < indices->length(); ++i) {
+        if (indices->IsValid(i) && row_positions_array->IsNull(i)) {
+          BitUtil::SetBit(unknown, i);
+        }
+      }
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto transposed,
+                          DictionaryArray(*data).Transpose(key_types_[icol],
+                                                           MakeArray(dictionary),
+                                                           transpose_map,
+                                                           ctx_->memory_pool()));
+    *data = transposed->data();
+    return Status::OK();
+  }
+
+  static bool IsTrivialTransposition(const Buffer& transpose, int64_t length) {
+    const int32_t* transpose_map = reinterpret_cast<const int32_t*>(transpose.data());
+    for (int64_t i = 0; i < length; ++i) {
+      if (transpose_map[i] != i) return false;
+    }
+    return true;
+  }
+
+  Result<std::shared_ptr<Array>> GetUnifiedDictionary(int icol) {
+    const DictionaryKey& key = dictionary_keys_[icol];
+    const auto& type = checked_cast<const DictionaryType&>(*key_types_[icol]);
+    if (!key.first_dictionary) {
+      return MakeArrayOfNull(type.value_type(), 0, ctx_->memory_pool());
+    }
+    if (!key.unifier) {
+      return key.first_dictionary;
+    }
+
+    // This leaves the unifier as it is, so that it can go on unifying
+    std::shared_ptr<Array> unified;
+    RETURN_NOT_OK(key.unifier->GetResultWithIndexType(type.index_type(), &unified));
+    return unified;
+  }
+
+  // The encoder reads 32-bit offsets, to which those of large binary keys are narrowed
+  Result<std::shared_ptr<ArrayData>> NarrowOffsets(const ArrayData& data) {
+    const int64_t* offsets = data.GetValues<int64_t>(1, /*absolute_offset=*/0);
+    if (offsets[data.offset + data.length] > std::numeric_limits<uint32_t>::max()) {
+      return Status::CapacityError("Grouping on large binary keys of more than ",
+                                   std::numeric_limits<uint32_t>::max(), " bytes");
+    }
+
+    // Only the offsets of the slice are filled in, those before are never read
+    ARROW_ASSIGN_OR_RAISE(
+        std::shared_ptr<Buffer> narrow_offsets,
+        AllocateBuffer((data.offset + data.length + 1) * sizeof(uint32_t),
+                       ctx_->memory_pool()));
+    auto narrow = reinterpret_cast<uint32_t*>(narrow_offsets->mutable_data());
+    for (int64_t i = data.offset; i <= data.offset + data.length; ++i) {
+      narrow[i] = static_cast<uint32_t>(offsets[i]);
+    }
+
+    auto out = data.Copy();
+    out->buffers[1] = std::move(narrow_offsets);
+    return out;
   }
 
   uint32_t num_groups() const override { return static_cast<uint32_t>(rows_.length()); }
@@ -626,6 +928,17 @@ struct GrouperFastImpl : Grouper {
     return SliceMutableBuffer(buf, 0, size);
   }
 
+  Result<std::shared_ptr<Buffer>> WidenOffsets(const Buffer& narrow_offsets,
+                                               int64_t length) {
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<Buffer> offsets,
+                          AllocateBuffer((length + 1) * sizeof(int64_t),
+                                         ctx_->memory_pool()));
+    const uint32_t* narrow = reinterpret_cast<const uint32_t*>(narrow_offsets.data());
+    auto wide = reinterpret_cast<int64_t*>(offsets->mutable_data());
+    std::copy(narrow, narrow + length + 1, wide);
+    return offsets;
+  }
+
   Result<ExecBatch> GetUniques() override {
     auto num_columns = static_cast<uint32_t>(col_metadata_.size());
     int64_t num_groups = rows_.length();
@@ -694,6 +1007,10 @@ struct GrouperFastImpl : Grouper {
             key_types_[i], num_groups,
             {std::move(non_null_bufs[i]), std::move(fixedlen_bufs[i])}, null_count);
       } else {
+        if (is_large_binary_like(key_types_[i]->id())) {
+          ARROW_ASSIGN_OR_RAISE(fixedlen_bufs[i],
+                                WidenOffsets(*fixedlen_bufs[i], num_groups));
+        }
         out.values[i] =
             ArrayData::Make(key_types_[i], num_groups,
                             {std::move(non_null_bufs[i]), std::move(fixedlen_bufs[i]),
@@ -702,15 +1019,11 @@ struct GrouperFastImpl : Grouper {
       }
     }
 
-    // Process dictionaries
     for (size_t icol = 0; icol < num_columns; ++icol) {
       if (key_types_[icol]->id() == Type::DICTIONARY) {
-        if (dictionaries_[icol]) {
-          out.values[icol].array()->dictionary = dictionaries_[icol]->data();
-        } else {
-          ARROW_ASSIGN_OR_RAISE(auto dict, MakeArrayOfNull(key_types_[icol], 0));
-          out.values[icol].array()->dictionary = dict->data();
-        }
+        ARROW_ASSIGN_OR_RAISE(auto dictionary,
+                              GetUnifiedDictionary(static_cast<int>(icol)));
+        out.values[icol].array()->dictionary = dictionary->data();
       }
     }
 
@@ -730,8 +1043,9 @@ struct GrouperFastImpl : Grouper {
   std::vector<arrow::compute::KeyEncoder::KeyColumnMetadata> col_metadata_;
   std::vector<arrow::compute::KeyEncoder::KeyColumnArray> cols_;
   std::vector<uint32_t> minibatch_hashes_;
+  std::vector<uint8_t> minibatch_found_;
 
-  std::vector<std::shared_ptr<Array>> dictionaries_;
+  std::vector<DictionaryKey> dictionary_keys_;
 
   arrow::compute::KeyEncoder::KeyRowArray rows_;
   arrow::compute::KeyEncoder::KeyRowArray rows_minibatch_;
@@ -748,8 +1062,50 @@ struct GroupedAggregator : KernelState {
 
   virtual Status Consume(const ExecBatch& batch) = 0;
 
+  /// Fold the groups of another aggregator of the same kind into this one.
+  /// group_id_mapping holds, for each group of other, the id of the matching
+  /// group in this aggregator.
+  virtual Status Merge(GroupedAggregator&& other, const ArrayData& group_id_mapping) = 0;
+
   virtual Result<Datum> Finalize() = 0;
 
+  /// Export the groups as a struct array with one row per group, from which
+  /// MergeExported can rebuild them. The aggregator may not be used afterwards.
+  virtual Result<Datum> ExportState() = 0;
+
+  /// Fold the groups exported by another aggregator of the same kind into this
+  /// one. group_id_mapping holds, for each row of state, the id of the matching
+  /// group in this aggregator.
+  virtual Status MergeExported(const ArrayData& state,
+                               const ArrayData& group_id_mapping) = 0;
+
+  /// Return the fields of a state produced by ExportState, after checking that it
+  /// has the given type and holds as many non-null rows as group_id_mapping.
+  static Result<ArrayVector> GetExportedFields(const ArrayData& state,
+                                               const DataType& type,
+                                               const ArrayData& group_id_mapping) {
+    if (!state.type->Equals(type)) {
+      return Status::TypeError("Expected an aggregate state of type ", type, ", got ",
+                               *state.type);
+    }
+    if (state.length != group_id_mapping.length) {
+      return Status::Invalid("Aggregate state has ", state.length,
+                             " groups but the group id mapping has ",
+                             group_id_mapping.length);
+    }
+    StructArray array(std::make_shared<ArrayData>(state));
+    ArrayVector fields;
+    bool has_nulls = array.null_count() > 0;
+    for (int i = 0; i < array.num_fields(); ++i) {
+      fields.push_back(array.field(i));
+      has_nulls |= fields.back()->null_count() > 0;
+    }
+    if (has_nulls) {
+      return Status::Invalid("Aggregate state may not contain nulls");
+    }
+    return fields;
+  }
+
   template <typename Reserve>
   Status MaybeReserve(int64_t old_num_groups, const ExecBatch& batch,
                       const Reserve& reserve) {
@@ -760,6 +1116,20 @@ struct GroupedAggregator : KernelState {
     return reserve(new_num_groups - old_num_groups);
   }
 
+  template <typename Reserve>
+  Status MaybeReserve(int64_t old_num_groups, const ArrayData& group_id_mapping,
+                      const Reserve& reserve) {
+    auto mapping = group_id_mapping.GetValues<uint32_t>(1);
+    int64_t new_num_groups = old_num_groups;
+    for (int64_t i = 0; i < group_id_mapping.length; ++i) {
+      new_num_groups = std::max<int64_t>(new_num_groups, mapping[i] + 1);
+    }
+    if (new_num_groups <= old_num_groups) {
+      return Status::OK();
+    }
+    return reserve(new_num_groups - old_num_groups);
+  }
+
   virtual std::shared_ptr<DataType> out_type() const = 0;
 };
 
@@ -774,10 +1144,14 @@ struct GroupedCountImpl : public GroupedAggregator {
     return Status::OK();
   }
 
+  Status Reserve(int64_t added_groups) {
+    num_groups_ += added_groups;
+    return counts_.Append(added_groups * sizeof(int64_t), 0);
+  }
+
   Status Consume(const ExecBatch& batch) override {
     RETURN_NOT_OK(MaybeReserve(num_groups_, batch, [&](int64_t added_groups) {
-      num_groups_ += added_groups;
-      return counts_.Append(added_groups * sizeof(int64_t), 0);
+      return Reserve(added_groups);
     }));
 
     auto group_ids = batch[1].array()->GetValues<uint32_t>(1);
@@ -798,8 +1172,8 @@ struct GroupedCountImpl : public GroupedAggregator {
     arrow::internal::VisitSetBitRunsVoid(
         input->buffers[0], input->offset, input->length,
         [&](int64_t begin, int64_t length) {
-          for (int64_t input_i = begin, i = begin - input->offset;
-               input_i < begin + length; ++input_i, ++i) {
+          // NB: runs are positioned relative to input->offset
+          for (int64_t i = begin; i < begin + length; ++i) {
             auto g = group_ids[i];
             raw_counts[g] += 1;
           }
@@ -807,11 +1181,53 @@ struct GroupedCountImpl : public GroupedAggregator {
     return Status::OK();
   }
 
+  Status Merge(GroupedAggregator&& raw_other,
+               const ArrayData& group_id_mapping) override {
+    auto other = checked_cast<GroupedCountImpl*>(&raw_other);
+    return MergeCounts(reinterpret_cast<const int64_t*>(other->counts_.data()),
+                       group_id_mapping);
+  }
+
+  Status MergeExported(const ArrayData& state,
+                       const ArrayData& group_id_mapping) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields,
+                          GetExportedFields(state, *state_type(), group_id_mapping));
+    return MergeCounts(checked_cast<const Int64Array&>(*fields[0]).raw_values(),
+                       group_id_mapping);
+  }
+
+  Status MergeCounts(const int64_t* other_raw_counts,
+                     const ArrayData& group_id_mapping) {
+    RETURN_NOT_OK(MaybeReserve(num_groups_, group_id_mapping, [&](int64_t added_groups) {
+      return Reserve(added_groups);
+    }));
+
+    auto g = group_id_mapping.GetValues<uint32_t>(1);
+    auto raw_counts = reinterpret_cast<int64_t*>(counts_.mutable_data());
+
+    for (int64_t other_g = 0; other_g < group_id_mapping.length; ++other_g) {
+      raw_counts[g[other_g]] += other_raw_counts[other_g];
+    }
+    return Status::OK();
+  }
+
   Result<Datum> Finalize() override {
     ARROW_ASSIGN_OR_RAISE(auto counts, counts_.Finish());
     return std::make_shared<Int64Array>(num_groups_, std::move(counts));
   }
 
+  Result<Datum> ExportState() override {
+    ARROW_ASSIGN_OR_RAISE(auto counts, counts_.Finish());
+    return ArrayData::Make(state_type(), num_groups_, {nullptr},
+                           {ArrayData::Make(int64(), num_groups_,
+                                            {nullptr, std::move(counts)}, 0)},
+                           0);
+  }
+
+  static std::shared_ptr<DataType> state_type() {
+    return struct_({field("count", int64())});
+  }
+
   std::shared_ptr<DataType> out_type() const override { return int64(); }
 
   int64_t num_groups_ = 0;
@@ -830,6 +1246,8 @@ struct GroupedSumImpl : public GroupedAggregator {
   using ConsumeImpl = std::function<void(const std::shared_ptr<ArrayData>&,
                                          const uint32_t*, void*, int64_t*)>;
 
+  using MergeImpl = std::function<void(const void*, const uint32_t*, int64_t, void*)>;
+
   struct GetConsumeImpl {
     template <typename T, typename AccType = typename FindAccumulatorType<T>::Type>
     Status Visit(const T&) {
@@ -846,6 +1264,15 @@ struct GroupedSumImpl : public GroupedAggregator {
             },
             [&] { ++group; });
       };
+      merge_impl = [](const void* boxed_other_sums, const uint32_t* group,
+                      int64_t other_num_groups, void* boxed_sums) {
+        using AccCType = typename TypeTraits<AccType>::CType;
+        auto sums = reinterpret_cast<AccCType*>(boxed_sums);
+        auto other_sums = reinterpret_cast<const AccCType*>(boxed_other_sums);
+        for (int64_t other_g = 0; other_g < other_num_groups; ++other_g) {
+          sums[group[other_g]] += other_sums[other_g];
+        }
+      };
       out_type = TypeTraits<AccType>::type_singleton();
       return Status::OK();
     }
@@ -859,6 +1286,7 @@ struct GroupedSumImpl : public GroupedAggregator {
     }
 
     ConsumeImpl consume_impl;
+    MergeImpl merge_impl;
     std::shared_ptr<DataType> out_type;
   };
 
@@ -872,17 +1300,22 @@ struct GroupedSumImpl : public GroupedAggregator {
     RETURN_NOT_OK(VisitTypeInline(*input_type, &get_consume_impl));
 
     consume_impl_ = std::move(get_consume_impl.consume_impl);
+    merge_impl_ = std::move(get_consume_impl.merge_impl);
     out_type_ = std::move(get_consume_impl.out_type);
 
     return Status::OK();
   }
 
+  Status Reserve(int64_t added_groups) {
+    num_groups_ += added_groups;
+    RETURN_NOT_OK(sums_.Append(added_groups * kSumSize, 0));
+    RETURN_NOT_OK(counts_.Append(added_groups * sizeof(int64_t), 0));
+    return Status::OK();
+  }
+
   Status Consume(const ExecBatch& batch) override {
     RETURN_NOT_OK(MaybeReserve(num_groups_, batch, [&](int64_t added_groups) {
-      num_groups_ += added_groups;
-      RETURN_NOT_OK(sums_.Append(added_groups * kSumSize, 0));
-      RETURN_NOT_OK(counts_.Append(added_groups * sizeof(int64_t), 0));
-      return Status::OK();
+      return Reserve(added_groups);
     }));
 
     auto group_ids = batch[1].array()->GetValues<uint32_t>(1);
@@ -891,6 +1324,40 @@ struct GroupedSumImpl : public GroupedAggregator {
     return Status::OK();
   }
 
+  Status Merge(GroupedAggregator&& raw_other,
+               const ArrayData& group_id_mapping) override {
+    auto other = checked_cast<GroupedSumImpl*>(&raw_other);
+    return MergeSums(other->sums_.data(),
+                     reinterpret_cast<const int64_t*>(other->counts_.data()),
+                     group_id_mapping);
+  }
+
+  Status MergeExported(const ArrayData& state,
+                       const ArrayData& group_id_mapping) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields,
+                          GetExportedFields(state, *state_type(), group_id_mapping));
+    // all the accumulator types are 64 bits wide, see kSumSize
+    return MergeSums(fields[0]->data()->GetValues<int64_t>(1),
+                     checked_cast<const Int64Array&>(*fields[1]).raw_values(),
+                     group_id_mapping);
+  }
+
+  Status MergeSums(const void* other_sums, const int64_t* other_counts,
+                   const ArrayData& group_id_mapping) {
+    RETURN_NOT_OK(MaybeReserve(num_groups_, group_id_mapping, [&](int64_t added_groups) {
+      return Reserve(added_groups);
+    }));
+
+    auto g = group_id_mapping.GetValues<uint32_t>(1);
+    merge_impl_(other_sums, g, group_id_mapping.length, sums_.mutable_data());
+
+    auto counts = reinterpret_cast<int64_t*>(counts_.mutable_data());
+    for (int64_t other_g = 0; other_g < group_id_mapping.length; ++other_g) {
+      counts[g[other_g]] += other_counts[other_g];
+    }
+    return Status::OK();
+  }
+
   Result<Datum> Finalize() override {
     std::shared_ptr<Buffer> null_bitmap;
     int64_t null_count = 0;
@@ -913,6 +1380,20 @@ struct GroupedSumImpl : public GroupedAggregator {
                            {std::move(null_bitmap), std::move(sums)}, null_count);
   }
 
+  Result<Datum> ExportState() override {
+    ARROW_ASSIGN_OR_RAISE(auto sums, sums_.Finish());
+    ARROW_ASSIGN_OR_RAISE(auto counts, counts_.Finish());
+    return ArrayData::Make(
+        state_type(), num_groups_, {nullptr},
+        {ArrayData::Make(out_type_, num_groups_, {nullptr, std::move(sums)}, 0),
+         ArrayData::Make(int64(), num_groups_, {nullptr, std::move(counts)}, 0)},
+        0);
+  }
+
+  std::shared_ptr<DataType> state_type() const {
+    return struct_({field("sum", out_type_), field("count", int64())});
+  }
+
   std::shared_ptr<DataType> out_type() const override { return out_type_; }
 
   // NB: counts are used here instead of a simple "has_values_" bitmap since
@@ -921,6 +1402,7 @@ struct GroupedSumImpl : public GroupedAggregator {
   BufferBuilder sums_, counts_;
   std::shared_ptr<DataType> out_type_;
   ConsumeImpl consume_impl_;
+  MergeImpl merge_impl_;
   MemoryPool* pool_;
 };
 
@@ -947,6 +1429,9 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
       std::function<void(const std::shared_ptr<ArrayData>&, const uint32_t*, void*, void*,
                          uint8_t*, uint8_t*)>;
 
+  using MergeImpl = std::function<void(const void*, const void*, const uint32_t*,
+                                       int64_t, void*, void*)>;
+
   using ResizeImpl = std::function<Status(BufferBuilder*, int64_t)>;
 
   template <typename CType>
@@ -979,6 +1464,21 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
             [&] { BitUtil::SetBit(has_nulls, *group++); });
       };
 
+      merge_impl = [](const void* other_mins, const void* other_maxes,
+                      const uint32_t* group, int64_t other_num_groups, void* mins,
+                      void* maxes) {
+        auto raw_mins = reinterpret_cast<CType*>(mins);
+        auto raw_maxes = reinterpret_cast<CType*>(maxes);
+        auto other_raw_mins = reinterpret_cast<const CType*>(other_mins);
+        auto other_raw_maxes = reinterpret_cast<const CType*>(other_maxes);
+
+        for (int64_t other_g = 0; other_g < other_num_groups; ++other_g) {
+          auto g = group[other_g];
+          raw_mins[g] = std::min(raw_mins[g], other_raw_mins[other_g]);
+          raw_maxes[g] = std::max(raw_maxes[g], other_raw_maxes[other_g]);
+        }
+      };
+
       resize_min_impl = MakeResizeImpl(Extrema<CType>::max());
       resize_max_impl = MakeResizeImpl(Extrema<CType>::min());
       return Status::OK();
@@ -997,6 +1497,7 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
     }
 
     ConsumeImpl consume_impl;
+    MergeImpl merge_impl;
     ResizeImpl resize_min_impl, resize_max_impl;
   };
 
@@ -1014,20 +1515,25 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
     RETURN_NOT_OK(VisitTypeInline(*input_type, &get_impl));
 
     consume_impl_ = std::move(get_impl.consume_impl);
+    merge_impl_ = std::move(get_impl.merge_impl);
     resize_min_impl_ = std::move(get_impl.resize_min_impl);
     resize_max_impl_ = std::move(get_impl.resize_max_impl);
 
     return Status::OK();
   }
 
+  Status Reserve(int64_t added_groups) {
+    num_groups_ += added_groups;
+    RETURN_NOT_OK(resize_min_impl_(&mins_, added_groups));
+    RETURN_NOT_OK(resize_max_impl_(&maxes_, added_groups));
+    RETURN_NOT_OK(has_values_.Append(added_groups, false));
+    RETURN_NOT_OK(has_nulls_.Append(added_groups, false));
+    return Status::OK();
+  }
+
   Status Consume(const ExecBatch& batch) override {
     RETURN_NOT_OK(MaybeReserve(num_groups_, batch, [&](int64_t added_groups) {
-      num_groups_ += added_groups;
-      RETURN_NOT_OK(resize_min_impl_(&mins_, added_groups));
-      RETURN_NOT_OK(resize_max_impl_(&maxes_, added_groups));
-      RETURN_NOT_OK(has_values_.Append(added_groups, false));
-      RETURN_NOT_OK(has_nulls_.Append(added_groups, false));
-      return Status::OK();
+      return Reserve(added_groups);
     }));
 
     auto group_ids = batch[1].array()->GetValues<uint32_t>(1);
@@ -1037,6 +1543,52 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
     return Status::OK();
   }
 
+  Status Merge(GroupedAggregator&& raw_other,
+               const ArrayData& group_id_mapping) override {
+    auto other = checked_cast<GroupedMinMaxImpl*>(&raw_other);
+    return MergeExtrema(other->mins_.data(), other->maxes_.data(),
+                        other->has_values_.data(), 0, other->has_nulls_.data(), 0,
+                        group_id_mapping);
+  }
+
+  Status MergeExported(const ArrayData& state,
+                       const ArrayData& group_id_mapping) override {
+    ARROW_ASSIGN_OR_RAISE(auto fields,
+                          GetExportedFields(state, *state_type(), group_id_mapping));
+    const int64_t byte_width = BitUtil::BytesForBits(
+        checked_cast<const FixedWidthType&>(*type_).bit_width());
+    auto values = [&](const Array& array) {
+      return array.data()->buffers[1]->data() + array.offset() * byte_width;
+    };
+    auto bits = [&](const Array& array) { return array.data()->buffers[1]->data(); };
+    return MergeExtrema(values(*fields[0]), values(*fields[1]), bits(*fields[2]),
+                        fields[2]->offset(), bits(*fields[3]), fields[3]->offset(),
+                        group_id_mapping);
+  }
+
+  Status MergeExtrema(const void* other_mins, const void* other_maxes,
+                      const uint8_t* other_has_values, int64_t has_values_offset,
+                      const uint8_t* other_has_nulls, int64_t has_nulls_offset,
+                      const ArrayData& group_id_mapping) {
+    RETURN_NOT_OK(MaybeReserve(num_groups_, group_id_mapping, [&](int64_t added_groups) {
+      return Reserve(added_groups);
+    }));
+
+    auto g = group_id_mapping.GetValues<uint32_t>(1);
+    merge_impl_(other_mins, other_maxes, g, group_id_mapping.length,
+                mins_.mutable_data(), maxes_.mutable_data());
+
+    for (int64_t other_g = 0; other_g < group_id_mapping.length; ++other_g) {
+      if (BitUtil::GetBit(other_has_values, has_values_offset + other_g)) {
+        BitUtil::SetBit(has_values_.mutable_data(), g[other_g]);
+      }
+      if (BitUtil::GetBit(other_has_nulls, has_nulls_offset + other_g)) {
+        BitUtil::SetBit(has_nulls_.mutable_data(), g[other_g]);
+      }
+    }
+    return Status::OK();
+  }
+
   Result<Datum> Finalize() override {
     // aggregation for group is valid if there was at least one value in that group
     ARROW_ASSIGN_OR_RAISE(auto null_bitmap, has_values_.Finish());
@@ -1057,15 +1609,33 @@ struct GroupedMinMaxImpl : public GroupedAggregator {
                            {std::move(mins), std::move(maxes)});
   }
 
+  Result<Datum> ExportState() override {
+    ArrayDataVector fields;
+    for (const auto& type : {type_, type_, boolean(), boolean()}) {
+      fields.push_back(ArrayData::Make(type, num_groups_, {nullptr, nullptr}, 0));
+    }
+    ARROW_ASSIGN_OR_RAISE(fields[0]->buffers[1], mins_.Finish());
+    ARROW_ASSIGN_OR_RAISE(fields[1]->buffers[1], maxes_.Finish());
+    ARROW_ASSIGN_OR_RAISE(fields[2]->buffers[1], has_values_.Finish());
+    ARROW_ASSIGN_OR_RAISE(fields[3]->buffers[1], has_nulls_.Finish());
+    return ArrayData::Make(state_type(), num_groups_, {nullptr}, std::move(fields), 0);
+  }
+
+  std::shared_ptr<DataType> state_type() const {
+    return struct_({field("min", type_), field("max", type_),
+                    field("has_values", boolean()), field("has_nulls", boolean())});
+  }
+
   std::shared_ptr<DataType> out_type() const override {
     return struct_({field("min", type_), field("max", type_)});
   }
 
-  int64_t num_groups_;
+  int64_t num_groups_ = 0;
   BufferBuilder mins_, maxes_;
   TypedBufferBuilder<bool> has_values_, has_nulls_;
   std::shared_ptr<DataType> type_;
   ConsumeImpl consume_impl_;
+  MergeImpl merge_impl_;
   ResizeImpl resize_min_impl_, resize_max_impl_;
   ScalarAggregateOptions options_;
 };
@@ -1095,9 +1665,10 @@ HashAggregateKernel MakeKernel(InputType argument_type) {
     return checked_cast<GroupedAggregator*>(ctx->state())->Consume(batch);
   };
 
-  kernel.merge = [](KernelContext* ctx, KernelState&&, KernelState*) {
-    // TODO(ARROW-11840) merge two hash tables
-    return Status::NotImplemented("Merge hashed aggregations");
+  kernel.merge = [](KernelContext* ctx, KernelState&& other,
+                    const ArrayData& group_id_mapping) {
+    return checked_cast<GroupedAggregator*>(ctx->state())
+        ->Merge(checked_cast<GroupedAggregator&&>(other), group_id_mapping);
   };
 
   kernel.finalize = [](KernelContext* ctx, Datum* out) {
@@ -1106,9 +1677,27 @@ HashAggregateKernel MakeKernel(InputType argument_type) {
     return Status::OK();
   };
 
+  kernel.export_state = [](KernelContext* ctx, Datum* out) {
+    ARROW_ASSIGN_OR_RAISE(*out,
+                          checked_cast<GroupedAggregator*>(ctx->state())->ExportState());
+    return Status::OK();
+  };
+
+  kernel.merge_exported = [](KernelContext* ctx, const Datum& state,
+                             const ArrayData& group_id_mapping) {
+    if (!state.is_array()) {
+      return Status::TypeError("Expected an aggregate state array, got ",
+                               state.ToString());
+    }
+    return checked_cast<GroupedAggregator*>(ctx->state())
+        ->MergeExported(*state.array(), group_id_mapping);
+  };
+
   return kernel;
 }
 
+}  // namespace
+
 Result<std::vector<const HashAggregateKernel*>> GetKernels(
     ExecContext* ctx, const std::vector<Aggregate>& aggregates,
     const std::vector<ValueDescr>& in_descrs) {
@@ -1183,8 +1772,6 @@ Result<FieldVector> ResolveKernels(
   return fields;
 }
 
-}  // namespace
-
 Result<std::unique_ptr<Grouper>> Grouper::Make(const std::vector<ValueDescr>& descrs,
                                                ExecContext* ctx) {
   if (GrouperFastImpl::CanUse(descrs)) {
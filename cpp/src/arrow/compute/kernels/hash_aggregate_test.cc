@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -183,6 +184,13 @@ struct TestGrouper {
     ExpectConsume(*ExecBatch::Make(key_batch), expected);
   }
 
+  void ExpectFind(const std::string& key_json, const std::string& expected) {
+    ExecBatch key_batch(*RecordBatchFromJSON(key_schema_, key_json));
+    ASSERT_OK_AND_ASSIGN(Datum ids, grouper_->Find(key_batch));
+    ValidateOutput(ids);
+    AssertDatumsEqual(ArrayFromJSON(uint32(), expected), ids, /*verbose=*/true);
+  }
+
   void AssertEquivalentIds(const Datum& expected, const Datum& actual) {
     auto left = expected.make_array();
     auto right = actual.make_array();
@@ -351,9 +359,7 @@ TEST(Grouper, StringKey) {
 TEST(Grouper, DictKey) {
   TestGrouper g({dictionary(int32(), utf8())});
 
-  // For dictionary keys, all batches must share a single dictionary.
-  // Eventually, differing dictionaries will be unified and indices transposed
-  // during encoding to relieve this restriction.
+  // Batches sharing a single dictionary are grouped on their indices as they are
   const auto dict = ArrayFromJSON(utf8(), R"(["ex", "why", "zee", null])");
 
   auto WithIndices = [&](const std::string& indices) {
@@ -372,13 +378,74 @@ TEST(Grouper, DictKey) {
   g.ExpectConsume({WithIndices("           [3, 1, null, 0, 2]")},
                   ArrayFromJSON(uint32(), "[3, 1, 4,    0, 2]"));
 
+  // A dictionary with a null value can't be unified with a differing one
   EXPECT_RAISES_WITH_MESSAGE_THAT(
-      NotImplemented, HasSubstr("Unifying differing dictionaries"),
+      Invalid, HasSubstr("unify dictionaries with nulls"),
       g.grouper_->Consume(*ExecBatch::Make({*DictionaryArray::FromArrays(
           ArrayFromJSON(int32(), "[0, 1]"),
           ArrayFromJSON(utf8(), R"(["different", "dictionary"])"))})));
 }
 
+TEST(Grouper, DictKeyUnification) {
+  for (auto index_type : {int8(), uint16(), int64()}) {
+    SCOPED_TRACE("index type: " + index_type->ToString());
+    auto type = dictionary(index_type, utf8());
+    TestGrouper g({type});
+
+    auto WithDictionary = [&](const std::string& indices, const std::string& dict) {
+      return ExecBatch({DictArrayFromJSON(type, indices, dict)}, 4);
+    };
+
+    ASSERT_OK_AND_ASSIGN(Datum ids,
+                         g.grouper_->Consume(WithDictionary("[0, 1, null, 0]",
+                                                            R"(["ex", "why"])")));
+    AssertDatumsEqual(ArrayFromJSON(uint32(), "[0, 1, 2, 0]"), ids);
+
+    // a different dictionary is unified into the first and its indices transposed
+    ASSERT_OK_AND_ASSIGN(ids, g.grouper_->Consume(WithDictionary(
+                                  "[0, 1, 2, null]", R"(["why", "zee", "ex"])")));
+    AssertDatumsEqual(ArrayFromJSON(uint32(), "[1, 3, 0, 2]"), ids);
+
+    // as is a dictionary equal to the first one
+    ASSERT_OK_AND_ASSIGN(ids, g.grouper_->Consume(WithDictionary(
+                                  "[1, 1, 0, 0]", R"(["ex", "why"])")));
+    AssertDatumsEqual(ArrayFromJSON(uint32(), "[1, 1, 0, 0]"), ids);
+
+    // Find looks values up without adding them to the unified dictionary
+    ASSERT_OK_AND_ASSIGN(ids, g.grouper_->Find(WithDictionary(
+                                  "[1, 0, null, 2]", R"(["new", "zee", "ex"])")));
+    AssertDatumsEqual(ArrayFromJSON(uint32(), "[3, null, 2, 0]"), ids);
+    ASSERT_OK_AND_ASSIGN(ids, g.grouper_->Find(WithDictionary(
+                                  "[0, 0, 1, null]", R"(["new", "why"])")));
+    AssertDatumsEqual(ArrayFromJSON(uint32(), "[null, null, 1, 2]"), ids);
+
+    ASSERT_OK_AND_ASSIGN(ExecBatch uniques, g.grouper_->GetUniques());
+    ValidateOutput(uniques[0]);
+    AssertDatumsEqual(DictArrayFromJSON(type, "[0, 1, null, 2]",
+                                        R"(["ex", "why", "zee"])"),
+                      uniques[0], /*verbose=*/true);
+  }
+
+  // the unified dictionary must fit the index type
+  auto type = dictionary(int8(), int32());
+  TestGrouper g({type});
+  for (int32_t batch = 0; batch < 2; ++batch) {
+    std::vector<int32_t> values(100);
+    std::iota(values.begin(), values.end(), batch * 100);
+    std::shared_ptr<Array> dict;
+    ArrayFromVector<Int32Type>(values, &dict);
+    auto indices = ArrayFromJSON(int8(), "[0, 99]");
+    ASSERT_OK_AND_ASSIGN(auto key_batch, ExecBatch::Make({*DictionaryArray::FromArrays(
+                                             type, indices, dict)}));
+    if (batch == 0) {
+      ASSERT_OK(g.grouper_->Consume(key_batch));
+    } else {
+      EXPECT_RAISES_WITH_MESSAGE_THAT(Invalid, HasSubstr("too many for indices"),
+                                      g.grouper_->Consume(key_batch));
+    }
+  }
+}
+
 TEST(Grouper, StringInt64Key) {
   TestGrouper g({utf8(), int64()});
 
@@ -441,15 +508,31 @@ TEST(Grouper, RandomInt64Keys) {
   }
 }
 
-TEST(Grouper, RandomStringInt64Keys) {
-  TestGrouper g({utf8(), int64()});
+TEST(Grouper, ManyRandomInt64Keys) {
+  // Enough distinct keys for the hash table to need 32-bit group ids
+  TestGrouper g({int64()});
   for (int i = 0; i < 4; ++i) {
     SCOPED_TRACE(std::to_string(i) + "th key batch");
 
     ExecBatch key_batch{
-        *random::GenerateBatch(g.key_schema_->fields(), 1 << 12, 0xDEADBEEF)};
+        *random::GenerateBatch(g.key_schema_->fields(), 1 << 15, 0xDEADBEEF + i)};
     g.ConsumeAndValidate(key_batch);
   }
+  ASSERT_GT(g.grouper_->num_groups(), 1 << 16);
+}
+
+TEST(Grouper, RandomStringInt64Keys) {
+  for (auto str_type : {utf8(), large_utf8()}) {
+    SCOPED_TRACE("string type: " + str_type->ToString());
+    TestGrouper g({str_type, int64()});
+    for (int i = 0; i < 4; ++i) {
+      SCOPED_TRACE(std::to_string(i) + "th key batch");
+
+      ExecBatch key_batch{
+          *random::GenerateBatch(g.key_schema_->fields(), 1 << 12, 0xDEADBEEF)};
+      g.ConsumeAndValidate(key_batch);
+    }
+  }
 }
 
 TEST(Grouper, RandomStringInt64DoubleInt32Keys) {
@@ -463,6 +546,72 @@ TEST(Grouper, RandomStringInt64DoubleInt32Keys) {
   }
 }
 
+TEST(Grouper, SlicedKeys) {
+  for (auto str_type : {utf8(), large_utf8()}) {
+    SCOPED_TRACE("string type: " + str_type->ToString());
+    TestGrouper g({boolean(), int64(), str_type});
+
+    auto bools = ArrayFromJSON(boolean(), R"([true, false, null, true, false, true,
+                                              null, false, true, false, true])");
+    auto ints = ArrayFromJSON(int64(), "[0, 1, 2, 3, null, 3, 3, 7, 0, 1, 3]");
+    auto strs = ArrayFromJSON(
+        str_type, R"(["a", "b", "c", "d", "e", "d", "f", "g", "a", "b", "d"])");
+
+    // slices which start within a byte of their null bitmaps
+    g.ExpectConsume({bools->Slice(3, 3), ints->Slice(3, 3), strs->Slice(3, 3)},
+                    ArrayFromJSON(uint32(), "[0, 1, 0]"));
+
+    // slices which start on a byte boundary
+    g.ExpectConsume({bools->Slice(8, 3), ints->Slice(8, 3), strs->Slice(8, 3)},
+                    ArrayFromJSON(uint32(), "[2, 3, 0]"));
+  }
+}
+
+TEST(Grouper, Find) {
+  for (auto ty : {utf8(), large_utf8()}) {
+    SCOPED_TRACE(ty->ToString());
+    TestGrouper g({ty, int64()});
+
+    g.ExpectFind(R"([["a", 1]])", "[null]");
+
+    g.ExpectConsume(R"([["a", 1], ["b", 2], [null, 1], ["a", null]])", "[0, 1, 2, 3]");
+
+    g.ExpectFind(R"([["b", 2], ["a", 2], [null, 1], ["c", 1], ["a", null], ["a", 1]])",
+                 "[1, null, 2, null, 3, 0]");
+    ASSERT_EQ(g.grouper_->num_groups(), 4);
+  }
+}
+
+TEST(Grouper, RandomFind) {
+  TestGrouper g({utf8(), int64()});
+
+  ExecBatch consumed{
+      *random::GenerateBatch(g.key_schema_->fields(), 1 << 12, 0xDEADBEEF)};
+  Datum consumed_ids;
+  g.ConsumeAndValidate(consumed, &consumed_ids);
+  auto num_groups = g.grouper_->num_groups();
+
+  ASSERT_OK_AND_ASSIGN(Datum found_ids, g.grouper_->Find(consumed));
+  AssertDatumsEqual(consumed_ids, found_ids, /*verbose=*/true);
+
+  // keys which were never consumed are not inserted and have null ids, any others
+  // must map to their group
+  ExecBatch probed{
+      *random::GenerateBatch(g.key_schema_->fields(), 1 << 12, 0xBEEFDEAD)};
+  ASSERT_OK_AND_ASSIGN(found_ids, g.grouper_->Find(probed));
+  ValidateOutput(found_ids);
+  ASSERT_EQ(g.grouper_->num_groups(), num_groups);
+
+  ASSERT_OK_AND_ASSIGN(Datum found, IsValid(found_ids));
+  ASSERT_OK_AND_ASSIGN(found_ids, Filter(found_ids, found));
+  for (int i = 0; i < probed.num_values(); ++i) {
+    SCOPED_TRACE(std::to_string(i) + "th key array");
+    ASSERT_OK_AND_ASSIGN(Datum expected, Filter(probed[i], found));
+    ASSERT_OK_AND_ASSIGN(Datum actual, Take(g.uniques_[i], found_ids));
+    AssertDatumsEqual(expected, actual, /*verbose=*/true);
+  }
+}
+
 TEST(Grouper, MakeGroupings) {
   auto ExpectGroupings = [](std::string ids_json, std::string expected_json) {
     auto ids = checked_pointer_cast<UInt32Array>(ArrayFromJSON(uint32(), ids_json));
@@ -687,6 +836,35 @@ TEST(GroupBy, SumOnlyStringAndDictKeys) {
   }
 }
 
+TEST(GroupBy, SumDictKeysWithDifferingDictionaries) {
+  auto dict_type = dictionary(int32(), utf8());
+  auto argument = std::make_shared<ChunkedArray>(
+      ArrayVector{ArrayFromJSON(float64(), "[1.0, 2.0, 3.0]"),
+                  ArrayFromJSON(float64(), "[4.0, 5.0, 6.0]")});
+  auto key = std::make_shared<ChunkedArray>(
+      ArrayVector{DictArrayFromJSON(dict_type, "[0, 1, 0]", R"(["alfa", "beta"])"),
+                  DictArrayFromJSON(dict_type, "[0, 1, null]", R"(["gama", "alfa"])")});
+
+  ASSERT_OK_AND_ASSIGN(Datum aggregated_and_grouped,
+                       internal::GroupBy({argument}, {key},
+                                         {
+                                             {"hash_sum", nullptr},
+                                         }));
+
+  AssertDatumsEqual(ArrayFromJSON(struct_({
+                                      field("hash_sum", float64()),
+                                      field("key_0", dict_type),
+                                  }),
+                                  R"([
+    [9.0, "alfa"],
+    [2.0, "beta"],
+    [4.0, "gama"],
+    [6.0,  null ]
+  ])"),
+                    aggregated_and_grouped,
+                    /*verbose=*/true);
+}
+
 TEST(GroupBy, ConcreteCaseWithValidateGroupBy) {
   auto batch = RecordBatchFromJSON(
       schema({field("argument", float64()), field("key", utf8())}), R"([
@@ -844,5 +1022,172 @@ TEST(GroupBy, MinMaxWithNewGroupsInChunkedArray) {
                     aggregated_and_grouped,
                     /*verbose=*/true);
 }
+
+TEST(GroupBy, MergeStates) {
+  auto batch = RecordBatchFromJSON(
+      schema({field("argument", float64()), field("key", int64())}), R"([
+    [1.0,   1],
+    [null,  1],
+    [0.0,   2],
+    [null,  3],
+    [4.0,   null],
+    [3.25,  1],
+    [0.125, 2],
+    [-0.25, 2],
+    [0.75,  null],
+    [null,  3]
+  ])");
+
+  std::vector<internal::Aggregate> aggregates = {
+      {"hash_count", nullptr}, {"hash_sum", nullptr}, {"hash_min_max", nullptr}};
+  std::vector<ValueDescr> descrs(aggregates.size(), ValueDescr::Array(float64()));
+  ExecContext* ctx = default_exec_context();
+  ASSERT_OK_AND_ASSIGN(auto kernels, internal::GetKernels(ctx, aggregates, descrs));
+
+  // accumulate each half of the batch into its own Grouper and states
+  std::unique_ptr<internal::Grouper> groupers[2];
+  std::vector<std::unique_ptr<KernelState>> states[2];
+  for (int half = 0; half < 2; ++half) {
+    auto slice = batch->Slice(half * 5, 5);
+    ASSERT_OK_AND_ASSIGN(groupers[half],
+                         internal::Grouper::Make({ValueDescr::Array(int64())}, ctx));
+    ASSERT_OK_AND_ASSIGN(states[half],
+                         internal::InitKernels(kernels, ctx, aggregates, descrs));
+    ASSERT_OK_AND_ASSIGN(
+        Datum ids,
+        groupers[half]->Consume(ExecBatch({slice->GetColumnByName("key")}, 5)));
+
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      KernelContext kernel_ctx{ctx};
+      kernel_ctx.SetState(states[half][i].get());
+      ASSERT_OK(kernels[i]->consume(
+          &kernel_ctx, ExecBatch({slice->GetColumnByName("argument"), ids,
+                                  Datum(groupers[half]->num_groups())},
+                                 5)));
+    }
+  }
+
+  // merge the second half's groups into the first's
+  ASSERT_OK_AND_ASSIGN(ExecBatch other_keys, groupers[1]->GetUniques());
+  ASSERT_OK_AND_ASSIGN(Datum group_id_mapping, groupers[0]->Consume(other_keys));
+
+  ArrayVector columns;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    KernelContext kernel_ctx{ctx};
+    kernel_ctx.SetState(states[0][i].get());
+    ASSERT_OK(kernels[i]->merge(&kernel_ctx, std::move(*states[1][i]),
+                                *group_id_mapping.array()));
+    Datum out;
+    ASSERT_OK(kernels[i]->finalize(&kernel_ctx, &out));
+    columns.push_back(out.make_array());
+  }
+  ASSERT_OK_AND_ASSIGN(ExecBatch uniques, groupers[0]->GetUniques());
+  columns.push_back(uniques[0].make_array());
+
+  ASSERT_OK_AND_ASSIGN(auto merged,
+                       StructArray::Make(columns, std::vector<std::string>{
+                                                      "hash_count", "hash_sum",
+                                                      "hash_min_max", "key_0"}));
+
+  ASSERT_OK_AND_ASSIGN(Datum expected,
+                       internal::GroupBy({batch->GetColumnByName("argument"),
+                                          batch->GetColumnByName("argument"),
+                                          batch->GetColumnByName("argument")},
+                                         {batch->GetColumnByName("key")}, aggregates));
+  ValidateOutput(*merged);
+  AssertDatumsEqual(expected, merged, /*verbose=*/true);
+}
+
+TEST(GroupBy, MergeExportedStates) {
+  auto batch = RecordBatchFromJSON(
+      schema({field("argument", int32()), field("key", utf8())}), R"([
+    [1,    "a"],
+    [null, "a"],
+    [0,    "b"],
+    [null, "c"],
+    [4,    null],
+    [3,    "a"],
+    [5,    "d"],
+    [-2,   "b"],
+    [7,    null],
+    [null, "c"]
+  ])");
+
+  std::vector<internal::Aggregate> aggregates = {
+      {"hash_count", nullptr}, {"hash_sum", nullptr}, {"hash_min_max", nullptr}};
+  std::vector<ValueDescr> descrs(aggregates.size(), ValueDescr::Array(int32()));
+  ExecContext* ctx = default_exec_context();
+  ASSERT_OK_AND_ASSIGN(auto kernels, internal::GetKernels(ctx, aggregates, descrs));
+
+  // accumulate each half of the batch into its own Grouper and states, then
+  // export the second half's states, sliced to exercise the offsets
+  std::unique_ptr<internal::Grouper> groupers[2];
+  std::vector<std::unique_ptr<KernelState>> states[2];
+  std::vector<Datum> exported;
+  for (int half = 0; half < 2; ++half) {
+    auto slice = batch->Slice(half * 5, 5);
+    ASSERT_OK_AND_ASSIGN(groupers[half],
+                         internal::Grouper::Make({ValueDescr::Array(utf8())}, ctx));
+    ASSERT_OK_AND_ASSIGN(states[half],
+                         internal::InitKernels(kernels, ctx, aggregates, descrs));
+    ASSERT_OK_AND_ASSIGN(
+        Datum ids,
+        groupers[half]->Consume(ExecBatch({slice->GetColumnByName("key")}, 5)));
+
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      KernelContext kernel_ctx{ctx};
+      kernel_ctx.SetState(states[half][i].get());
+      ASSERT_OK(kernels[i]->consume(
+          &kernel_ctx, ExecBatch({slice->GetColumnByName("argument"), ids,
+                                  Datum(groupers[half]->num_groups())},
+                                 5)));
+      if (half == 1) {
+        Datum out;
+        ASSERT_OK(kernels[i]->export_state(&kernel_ctx, &out));
+        ValidateOutput(out);
+        exported.push_back(out.make_array()->Slice(1));
+      }
+    }
+  }
+
+  // merge the exported groups into the first half's
+  ASSERT_OK_AND_ASSIGN(ExecBatch other_keys, groupers[1]->GetUniques());
+  other_keys.values[0] = other_keys.values[0].make_array()->Slice(1);
+  other_keys.length -= 1;
+  ASSERT_OK_AND_ASSIGN(Datum group_id_mapping, groupers[0]->Consume(other_keys));
+
+  ArrayVector columns;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    KernelContext kernel_ctx{ctx};
+    kernel_ctx.SetState(states[0][i].get());
+    auto short_mapping = ArrayFromJSON(uint32(), "[0]");
+    ASSERT_RAISES(Invalid, kernels[i]->merge_exported(&kernel_ctx, exported[i],
+                                                      *short_mapping->data()));
+    ASSERT_OK(kernels[i]->merge_exported(&kernel_ctx, exported[i],
+                                         *group_id_mapping.array()));
+    Datum out;
+    ASSERT_OK(kernels[i]->finalize(&kernel_ctx, &out));
+    columns.push_back(out.make_array());
+  }
+  ASSERT_OK_AND_ASSIGN(ExecBatch uniques, groupers[0]->GetUniques());
+  columns.push_back(uniques[0].make_array());
+
+  ASSERT_OK_AND_ASSIGN(auto merged,
+                       StructArray::Make(columns, std::vector<std::string>{
+                                                      "hash_count", "hash_sum",
+                                                      "hash_min_max", "key_0"}));
+
+  // the first exported group, "a", and its only row were dropped by the slicing
+  ASSERT_OK_AND_ASSIGN(auto table, Table::FromRecordBatches(
+                                       {batch->Slice(0, 5), batch->Slice(6)}));
+  ASSERT_OK_AND_ASSIGN(table, table->CombineChunks());
+  auto argument = table->GetColumnByName("argument")->chunk(0);
+  ASSERT_OK_AND_ASSIGN(Datum expected,
+                       internal::GroupBy({argument, argument, argument},
+                                         {table->GetColumnByName("key")->chunk(0)},
+                                         aggregates));
+  ValidateOutput(*merged);
+  AssertDatumsEqual(expected, merged, /*verbose=*/true);
+}
 }  // namespace compute
 }  // namespace arrow
@@ -26,11 +26,15 @@
 #include "arrow/compute/api_vector.h"
 #include "arrow/compute/kernels/common.h"
 #include "arrow/compute/kernels/util_internal.h"
+#include "arrow/compute/kernels/vector_sort_internal.h"
 #include "arrow/table.h"
 #include "arrow/type_traits.h"
 #include "arrow/util/bit_block_counter.h"
 #include "arrow/util/checked_cast.h"
+#include "arrow/util/make_unique.h"
 #include "arrow/util/optional.h"
+#include "arrow/util/parallel.h"
+#include "arrow/util/thread_pool.h"
 #include "arrow/visitor_inline.h"
 
 namespace arrow {
@@ -1377,6 +1381,33 @@ class TableRadixSorter {
   }
 };
 
+// Preprocessed sort key of a table.
+struct ResolvedTableSortKey {
+  ResolvedTableSortKey(const ChunkedArray& chunked_array, const SortOrder order)
+      : order(order),
+        type(GetPhysicalType(chunked_array.type())),
+        chunks(GetPhysicalChunks(chunked_array, type)),
+        chunk_pointers(GetArrayPointers(chunks)),
+        null_count(chunked_array.null_count()),
+        num_chunks(chunked_array.num_chunks()),
+        resolver(chunk_pointers) {}
+
+  // Finds the target chunk and index in the target chunk from an
+  // index in chunked array.
+  template <typename ArrayType>
+  ResolvedChunk<ArrayType> GetChunk(int64_t index) const {
+    return resolver.Resolve<ArrayType>(index);
+  }
+
+  const SortOrder order;
+  const std::shared_ptr<DataType> type;
+  const ArrayVector chunks;
+  const std::vector<const Array*> chunk_pointers;
+  const int64_t null_count;
+  const int num_chunks;
+  const ChunkedArrayResolver resolver;
+};
+
 // Sort a table using a single sort and multiple-key comparisons.
 class MultipleKeyTableSorter : public TypeVisitor {
  private:
@@ -1384,33 +1415,7 @@ class MultipleKeyTableSorter : public TypeVisitor {
   // split the table into RecordBatches and pay the cost of chunked indexing
   // at the first column only.
 
-  // Preprocessed sort key.
-  struct ResolvedSortKey {
-    ResolvedSortKey(const ChunkedArray& chunked_array, const SortOrder order)
-        : order(order),
-          type(GetPhysicalType(chunked_array.type())),
-          chunks(GetPhysicalChunks(chunked_array, type)),
-          chunk_pointers(GetArrayPointers(chunks)),
-          null_count(chunked_array.null_count()),
-          num_chunks(chunked_array.num_chunks()),
-          resolver(chunk_pointers) {}
-
-    // Finds the target chunk and index in the target chunk from an
-    // index in chunked array.
-    template <typename ArrayType>
-    ResolvedChunk<ArrayType> GetChunk(int64_t index) const {
-      return resolver.Resolve<ArrayType>(index);
-    }
-
-    const SortOrder order;
-    const std::shared_ptr<DataType> type;
-    const ArrayVector chunks;
-    const std::vector<const Array*> chunk_pointers;
-    const int64_t null_count;
-    const int num_chunks;
-    const ChunkedArrayResolver resolver;
-  };
-
+  using ResolvedSortKey = ResolvedTableSortKey;
   using Comparator = MultipleKeyComparator<ResolvedSortKey>;
 
  public:
@@ -1548,6 +1553,183 @@ class MultipleKeyTableSorter : public TypeVisitor {
   Comparator comparator_;
 };
 
+// ----------------------------------------------------------------------
+// Top-K selection implementation
+
+// Select the first k rows of a table in the order given by multiple sort keys.
+//
+// The rows are split into ranges that are scanned in parallel, each keeping
+// its best k rows in a bounded heap whose front is the worst row kept.  Most
+// rows lose a single comparison against that front, so a range of n rows costs
+// O(n + m log k) comparisons when m rows enter the heap, instead of the
+// O(n log n) of a full sort.  The heaps are merged and sorted at the end.
+class TableSelecter {
+ public:
+  TableSelecter(ExecContext* ctx, std::vector<std::shared_ptr<ChunkedArray>> columns,
+                std::vector<SortOrder> orders, int64_t k)
+      : ctx_(ctx), columns_(std::move(columns)), orders_(std::move(orders)), k_(k) {}
+
+  Result<Datum> Select() {
+    const int64_t num_rows = columns_[0]->length();
+    int num_tasks = 1;
+    if (ctx_->use_threads()) {
+      num_tasks = static_cast<int>(std::min<int64_t>(
+          GetCpuThreadPoolCapacity(),
+          std::max<int64_t>(1, num_rows / kMinRowsPerTask)));
+    }
+    const int64_t rows_per_task = BitUtil::CeilDiv(num_rows, num_tasks);
+
+    std::vector<std::vector<uint64_t>> heaps(num_tasks);
+    if (k_ > 0) {
+      RETURN_NOT_OK(::arrow::internal::OptionalParallelFor(
+          ctx_->use_threads(), num_tasks, [&](int task) {
+            const int64_t begin = std::min(num_rows, task * rows_per_task);
+            const int64_t end = std::min(num_rows, begin + rows_per_task);
+            return SelectRange(begin, end, &heaps[task]);
+          }));
+    }
+
+    std::vector<uint64_t> selected;
+    for (const auto& heap : heaps) {
+      selected.insert(selected.end(), heap.begin(), heap.end());
+    }
+    auto sort_keys = ResolveSortKeys();
+    Comparator comparator(sort_keys);
+    std::sort(selected.begin(), selected.end(), [&](uint64_t left, uint64_t right) {
+      return comparator.Compare(left, right, 0);
+    });
+    RETURN_NOT_OK(comparator.status());
+    selected.resize(std::min<int64_t>(k_, selected.size()));
+
+    const auto length = static_cast<int64_t>(selected.size());
+    ARROW_ASSIGN_OR_RAISE(auto indices, AllocateBuffer(length * sizeof(uint64_t),
+                                                       ctx_->memory_pool()));
+    std::copy(selected.begin(), selected.end(),
+              reinterpret_cast<uint64_t*>(indices->mutable_data()));
+    return ArrayData::Make(uint64(), length, {nullptr, std::move(indices)}, 0);
+  }
+
+ private:
+  using ResolvedSortKey = ResolvedTableSortKey;
+  using Comparator = MultipleKeyComparator<ResolvedSortKey>;
+
+  // Don't bother spreading fewer rows over several threads
+  static constexpr int64_t kMinRowsPerTask = 1 << 16;
+
+  // The resolved sort keys cache the last chunk they accessed, so every
+  // thread needs its own.
+  std::vector<ResolvedSortKey> ResolveSortKeys() const {
+    std::vector<ResolvedSortKey> resolved;
+    resolved.reserve(columns_.size());
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      resolved.emplace_back(*columns_[i], orders_[i]);
+    }
+    return resolved;
+  }
+
+  // Keep the best k rows of [begin, end) in a heap
+  Status SelectRange(int64_t begin, int64_t end, std::vector<uint64_t>* heap) {
+    auto sort_keys = ResolveSortKeys();
+    Comparator comparator(sort_keys);
+    auto row_less = [&](uint64_t left, uint64_t right) {
+      return comparator.Compare(left, right, 0);
+    };
+
+    heap->reserve(std::min(k_, end - begin));
+    int64_t i = begin;
+    for (; i < end && static_cast<int64_t>(heap->size()) < k_; ++i) {
+      heap->push_back(i);
+    }
+    std::make_heap(heap->begin(), heap->end(), row_less);
+    for (; i < end; ++i) {
+      if (row_less(i, heap->front())) {
+        std::pop_heap(heap->begin(), heap->end(), row_less);
+        heap->back() = i;
+        std::push_heap(heap->begin(), heap->end(), row_less);
+      }
+    }
+    return comparator.status();
+  }
+
+  ExecContext* ctx_;
+  const std::vector<std::shared_ptr<ChunkedArray>> columns_;
+  const std::vector<SortOrder> orders_;
+  const int64_t k_;
+};
+
+// ----------------------------------------------------------------------
+// Comparison of rows across record batches
+
+// Preprocessed sort key of a set of record batch slots.  A row is addressed by its
+// slot in the upper bits and its index within the slot's batch in the lower bits.
+struct ResolvedSlotsSortKey {
+  static constexpr int kRowBits = 40;
+  static constexpr int64_t kRowMask = (int64_t(1) << kRowBits) - 1;
+
+  ResolvedSlotsSortKey(const std::shared_ptr<DataType>& type, const SortOrder order,
+                       int num_slots)
+      : order(order), type(GetPhysicalType(type)), arrays(num_slots) {}
+
+  template <typename ArrayType>
+  ResolvedChunk<ArrayType> GetChunk(int64_t index) const {
+    return ResolvedChunk<ArrayType>(
+        checked_cast<const ArrayType*>(arrays[index >> kRowBits].get()),
+        index & kRowMask);
+  }
+
+  void SetArray(int slot, const Array& array) {
+    if (arrays[slot]) {
+      null_count -= arrays[slot]->null_count();
+    }
+    arrays[slot] = GetPhysicalArray(array, type);
+    null_count += arrays[slot]->null_count();
+  }
+
+  const SortOrder order;
+  const std::shared_ptr<DataType> type;
+  ArrayVector arrays;
+  // The total null count of the slots' arrays
+  int64_t null_count = 0;
+};
+
+class RecordBatchRowComparatorImpl : public RecordBatchRowComparator {
+ public:
+  RecordBatchRowComparatorImpl(std::vector<int> field_indices,
+                               std::vector<ResolvedSlotsSortKey> sort_keys)
+      : field_indices_(std::move(field_indices)),
+        sort_keys_(std::move(sort_keys)),
+        comparator_(sort_keys_) {}
+
+  Status SetBatch(int slot, const RecordBatch& batch) override {
+    if (batch.num_rows() > ResolvedSlotsSortKey::kRowMask) {
+      return Status::Invalid("Cannot compare the rows of a batch of ", batch.num_rows(),
+                             " rows");
+    }
+    for (size_t i = 0; i < sort_keys_.size(); ++i) {
+      sort_keys_[i].SetArray(slot, *batch.column(field_indices_[i]));
+    }
+    return Status::OK();
+  }
+
+  bool Less(int left_slot, int64_t left_row, int right_slot,
+            int64_t right_row) override {
+    return comparator_.Compare(ToIndex(left_slot, left_row),
+                               ToIndex(right_slot, right_row), 0);
+  }
+
+  Status status() const override { return comparator_.status(); }
+
+ private:
+  static uint64_t ToIndex(int slot, int64_t row) {
+    return (static_cast<uint64_t>(slot) << ResolvedSlotsSortKey::kRowBits) |
+           static_cast<uint64_t>(row);
+  }
+
+  const std::vector<int> field_indices_;
+  std::vector<ResolvedSlotsSortKey> sort_keys_;
+  MultipleKeyComparator<ResolvedSlotsSortKey> comparator_;
+};
+
 // ----------------------------------------------------------------------
 // Top-level sort functions
 
@@ -1710,6 +1892,98 @@ class SortIndicesMetaFunction : public MetaFunction {
   }
 };
 
+const auto kDefaultSelectKOptions = SelectKOptions::Defaults();
+
+const FunctionDoc select_k_unstable_doc(
+    "Return the indices of the first k rows of an array, record batch or table",
+    ("This function computes the indices of the first `k` rows of the input\n"
+     "in the order given by the sort keys, i.e. the first `k` indices that\n"
+     "`sort_indices` would return.  Unlike with `sort_indices`, rows comparing\n"
+     "equal on all sort keys may be output in any order.  Null values are\n"
+     "considered greater than any other value.  For floating-point types,\n"
+     "NaNs are considered greater than any other non-null value, but smaller\n"
+     "than null values.\n"
+     "\n"
+     "`k` must be given in SelectKOptions."),
+    {"input"}, "SelectKOptions");
+
+class SelectKUnstableMetaFunction : public MetaFunction {
+ public:
+  SelectKUnstableMetaFunction()
+      : MetaFunction("select_k_unstable", Arity::Unary(), &select_k_unstable_doc,
+                     &kDefaultSelectKOptions) {}
+
+  Result<Datum> ExecuteImpl(const std::vector<Datum>& args,
+                            const FunctionOptions* options,
+                            ExecContext* ctx) const override {
+    const auto& select_options = static_cast<const SelectKOptions&>(*options);
+    if (select_options.k < 0) {
+      return Status::Invalid("select_k_unstable requires a non-negative k, got ",
+                             select_options.k);
+    }
+    switch (args[0].kind()) {
+      case Datum::ARRAY:
+        return SelectK(std::make_shared<ChunkedArray>(args[0].make_array()),
+                       select_options, ctx);
+      case Datum::CHUNKED_ARRAY:
+        return SelectK(args[0].chunked_array(), select_options, ctx);
+      case Datum::RECORD_BATCH: {
+        const auto& batch = *args[0].record_batch();
+        return SelectKByColumns(
+            [&](const std::string& name) -> std::shared_ptr<ChunkedArray> {
+              auto column = batch.GetColumnByName(name);
+              if (!column) return nullptr;
+              return std::make_shared<ChunkedArray>(std::move(column));
+            },
+            select_options, ctx);
+      }
+      case Datum::TABLE: {
+        const auto& table = *args[0].table();
+        return SelectKByColumns(
+            [&](const std::string& name) { return table.GetColumnByName(name); },
+            select_options, ctx);
+      }
+      default:
+        break;
+    }
+    return Status::NotImplemented(
+        "Unsupported types for select_k_unstable operation: "
+        "values=",
+        args[0].ToString());
+  }
+
+ private:
+  Result<Datum> SelectK(const std::shared_ptr<ChunkedArray>& values,
+                        const SelectKOptions& options, ExecContext* ctx) const {
+    SortOrder order = SortOrder::Ascending;
+    if (!options.sort_keys.empty()) {
+      order = options.sort_keys[0].order;
+    }
+    TableSelecter selecter(ctx, {values}, {order}, options.k);
+    return selecter.Select();
+  }
+
+  template <typename GetColumn>
+  Result<Datum> SelectKByColumns(GetColumn&& get_column, const SelectKOptions& options,
+                                 ExecContext* ctx) const {
+    if (options.sort_keys.empty()) {
+      return Status::Invalid("Must specify one or more sort keys");
+    }
+    std::vector<std::shared_ptr<ChunkedArray>> columns;
+    std::vector<SortOrder> orders;
+    for (const auto& sort_key : options.sort_keys) {
+      auto column = get_column(sort_key.name);
+      if (!column) {
+        return Status::Invalid("Nonexistent sort key column: ", sort_key.name);
+      }
+      columns.push_back(std::move(column));
+      orders.push_back(sort_key.order);
+    }
+    TableSelecter selecter(ctx, std::move(columns), std::move(orders), options.k);
+    return selecter.Select();
+  }
+};
+
 const auto kDefaultArraySortOptions = ArraySortOptions::Defaults();
 
 const FunctionDoc array_sort_indices_doc(
@@ -1740,6 +2014,27 @@ const FunctionDoc partition_nth_indices_doc(
 
 }  // namespace
 
+Result<std::unique_ptr<RecordBatchRowComparator>> RecordBatchRowComparator::Make(
+    const Schema& schema, const std::vector<SortKey>& sort_keys, int num_slots) {
+  if (num_slots >= (1 << (64 - ResolvedSlotsSortKey::kRowBits - 1))) {
+    return Status::Invalid("Cannot compare the rows of ", num_slots, " batches");
+  }
+
+  std::vector<int> field_indices;
+  std::vector<ResolvedSlotsSortKey> resolved;
+  for (const auto& sort_key : sort_keys) {
+    int i = schema.GetFieldIndex(sort_key.name);
+    if (i < 0) {
+      return Status::Invalid("Nonexistent sort key column: ", sort_key.name);
+    }
+    field_indices.push_back(i);
+    resolved.emplace_back(schema.field(i)->type(), sort_key.order, num_slots);
+  }
+
+  return ::arrow::internal::make_unique<RecordBatchRowComparatorImpl>(
+      std::move(field_indices), std::move(resolved));
+}
+
 void RegisterVectorSort(FunctionRegistry* registry) {
   // The kernel outputs into preallocated memory and is never null
   VectorKernel base;
@@ -1755,6 +2050,8 @@ void RegisterVectorSort(FunctionRegistry* registry) {
 
   DCHECK_OK(registry->AddFunction(std::make_shared<SortIndicesMetaFunction>()));
 
+  DCHECK_OK(registry->AddFunction(std::make_shared<SelectKUnstableMetaFunction>()));
+
   // partition_nth_indices has a parameter so needs its init function
   auto part_indices = std::make_shared<VectorFunction>(
       "partition_nth_indices", Arity::Unary(), &partition_nth_indices_doc);
@@ -223,6 +223,49 @@ static void TableSortIndicesInt64Wide(benchmark::State& state) {
                         std::numeric_limits<int64_t>::max());
 }
 
+static void DatumSelectKBenchmark(benchmark::State& state, const Datum& datum,
+                                  const SelectKOptions& options, int64_t num_records) {
+  for (auto _ : state) {
+    ABORT_NOT_OK(SelectKUnstable(datum, options).status());
+  }
+  state.SetItemsProcessed(state.iterations() * num_records);
+}
+
+static void ChunkedArraySelectKInt64Wide(benchmark::State& state) {
+  const int64_t num_records = state.range(0);
+  const int64_t k = state.range(1);
+  const int64_t num_chunks = 8;
+
+  auto rand = random::RandomArrayGenerator(kSeed);
+  ArrayVector chunks;
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    chunks.push_back(rand.Int64(num_records / num_chunks,
+                                std::numeric_limits<int64_t>::min(),
+                                std::numeric_limits<int64_t>::max(), 0.01));
+  }
+  auto values = std::make_shared<ChunkedArray>(chunks);
+  DatumSelectKBenchmark(state, Datum(values), SelectKOptions(k), num_records);
+}
+
+static void TableSelectKInt64(benchmark::State& state, int64_t min, int64_t max) {
+  TableSortIndicesArgs args(state);
+  const int64_t k = state.range(4);
+
+  auto data = MakeBatchOrTableBenchmarkDataInt64(args, args.num_chunks, min, max);
+  auto table = Table::Make(data.schema, data.columns, args.num_records);
+  SelectKOptions options(k, data.sort_keys);
+  DatumSelectKBenchmark(state, Datum(*table), options, args.num_records);
+}
+
+static void TableSelectKInt64Narrow(benchmark::State& state) {
+  TableSelectKInt64(state, -100, 100);
+}
+
+static void TableSelectKInt64Wide(benchmark::State& state) {
+  TableSelectKInt64(state, std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max());
+}
+
 BENCHMARK(ArraySortIndicesInt64Narrow)
     ->Apply(RegressionSetArgs)
     ->Args({1 << 20, 100})
@@ -281,5 +324,32 @@ BENCHMARK(TableSortIndicesInt64Wide)
     })
     ->Unit(benchmark::TimeUnit::kNanosecond);
 
+BENCHMARK(ChunkedArraySelectKInt64Wide)
+    ->ArgsProduct({
+        {1 << 20, 1 << 23},  // the number of records
+        {10, 1000},          // k
+    })
+    ->Unit(benchmark::TimeUnit::kNanosecond);
+
+BENCHMARK(TableSelectKInt64Narrow)
+    ->ArgsProduct({
+        {1 << 20},    // the number of records
+        {100, 0},     // inverse null proportion
+        {8, 2, 1},    // the number of columns
+        {32, 1},      // the number of chunks
+        {10, 1000},   // k
+    })
+    ->Unit(benchmark::TimeUnit::kNanosecond);
+
+BENCHMARK(TableSelectKInt64Wide)
+    ->ArgsProduct({
+        {1 << 20},    // the number of records
+        {100, 0},     // inverse null proportion
+        {8, 2, 1},    // the number of columns
+        {32, 1},      // the number of chunks
+        {10, 1000},   // k
+    })
+    ->Unit(benchmark::TimeUnit::kNanosecond);
+
 }  // namespace compute
 }  // namespace arrow
@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/compute/api_vector.h"
+#include "arrow/record_batch.h"
+#include "arrow/result.h"
+#include "arrow/type.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+namespace compute {
+namespace internal {
+
+// Compares rows drawn from a fixed number of record batch slots, in the order which
+// sort_indices would give them: by each sort key in turn, with NaNs and then nulls
+// last whatever the order.
+//
+// This is used to merge separately sorted runs of rows, each run occupying a slot
+// which holds its current batch.  It is not thread-safe.
+class ARROW_EXPORT RecordBatchRowComparator {
+ public:
+  virtual ~RecordBatchRowComparator() = default;
+
+  // The schema must hold every sort key column.  Each slot initially holds no rows.
+  static Result<std::unique_ptr<RecordBatchRowComparator>> Make(
+      const Schema& schema, const std::vector<SortKey>& sort_keys, int num_slots);
+
+  // Replace the batch held in a slot.  The batch must have the schema given to Make.
+  virtual Status SetBatch(int slot, const RecordBatch& batch) = 0;
+
+  // Whether row left_row of the batch in left_slot is ordered strictly before row
+  // right_row of the batch in right_slot.
+  virtual bool Less(int left_slot, int64_t left_row, int right_slot,
+                    int64_t right_row) = 0;
+
+  // An error raised by a comparison, e.g. for an unsupported type.
+  virtual Status status() const = 0;
+};
+
+}  // namespace internal
+}  // namespace compute
+}  // namespace arrow
@@ -1260,5 +1260,121 @@ INSTANTIATE_TEST_SUITE_P(MayNull, TestTableSortIndicesRandom,
 INSTANTIATE_TEST_SUITE_P(AllNull, TestTableSortIndicesRandom,
                          testing::Combine(first_sort_keys, testing::Values(1.0)));
 
+// Tests for select_k_unstable.
+class TestSelectKUnstable : public ::testing::Test {
+ protected:
+  void AssertSelectK(const Datum& input, const SelectKOptions& options,
+                     const std::string& expected) {
+    ASSERT_OK_AND_ASSIGN(auto actual, SelectKUnstable(input, options));
+    ValidateOutput(*actual);
+    AssertArraysEqual(*ArrayFromJSON(uint64(), expected), *actual, /*verbose=*/true);
+  }
+
+  // Check that the selected rows hold the same sort key values as the first k
+  // rows of sort_indices, since rows comparing equal may be selected in any order.
+  void AssertSelectKLikeSort(const std::shared_ptr<Table>& table,
+                             const SelectKOptions& options) {
+    ASSERT_OK_AND_ASSIGN(auto sorted,
+                         SortIndices(Datum(table), SortOptions(options.sort_keys)));
+    auto expected = sorted->Slice(0, std::min(options.k, sorted->length()));
+    ASSERT_OK_AND_ASSIGN(auto actual, SelectKUnstable(Datum(table), options));
+    ValidateOutput(*actual);
+    ASSERT_EQ(actual->length(), expected->length());
+    for (const auto& sort_key : options.sort_keys) {
+      auto column = table->GetColumnByName(sort_key.name);
+      ASSERT_OK_AND_ASSIGN(Datum expected_values, Take(column, expected));
+      ASSERT_OK_AND_ASSIGN(Datum actual_values, Take(column, actual));
+      AssertChunkedEquivalent(*expected_values.chunked_array(),
+                              *actual_values.chunked_array());
+    }
+  }
+};
+
+TEST_F(TestSelectKUnstable, Array) {
+  auto array = ArrayFromJSON(float64(), "[5, null, 1, NaN, 3, 2]");
+  AssertSelectK(array, SelectKOptions(0), "[]");
+  AssertSelectK(array, SelectKOptions(4), "[2, 5, 4, 0]");
+  AssertSelectK(array, SelectKOptions(4, {SortKey("", SortOrder::Descending)}),
+                "[0, 4, 5, 2]");
+  // NaNs and then nulls come last, whatever the order
+  AssertSelectK(array, SelectKOptions(10), "[2, 5, 4, 0, 3, 1]");
+  AssertSelectK(array, SelectKOptions(6, {SortKey("", SortOrder::Descending)}),
+                "[0, 4, 5, 2, 3, 1]");
+
+  AssertSelectK(ArrayFromJSON(utf8(), R"(["b", "d", null, "a", "c"])"),
+                SelectKOptions(3, {SortKey("", SortOrder::Descending)}), "[1, 4, 0]");
+  AssertSelectK(ArrayFromJSON(int32(), "[]"), SelectKOptions(3), "[]");
+}
+
+TEST_F(TestSelectKUnstable, ChunkedArray) {
+  auto chunked = ChunkedArrayFromJSON(int64(), {"[4, null]", "[]", "[1, 7, 3]", "[0]"});
+  AssertSelectK(chunked, SelectKOptions(3), "[5, 2, 4]");
+  AssertSelectK(chunked, SelectKOptions(3, {SortKey("", SortOrder::Descending)}),
+                "[3, 0, 4]");
+  AssertSelectK(chunked, SelectKOptions(7), "[5, 2, 4, 0, 3, 1]");
+}
+
+TEST_F(TestSelectKUnstable, RecordBatchAndTable) {
+  auto schema = ::arrow::schema({
+      {field("a", uint8())},
+      {field("b", float64())},
+  });
+  SelectKOptions options(
+      3, {SortKey("a", SortOrder::Ascending), SortKey("b", SortOrder::Descending)});
+  const std::vector<std::string> json = {R"([{"a": null, "b": 5},
+                                             {"a": 1,    "b": 3},
+                                             {"a": 3,    "b": null}
+                                            ])",
+                                         R"([{"a": null, "b": null},
+                                             {"a": 2,    "b": 5},
+                                             {"a": 1,    "b": NaN}
+                                            ])"};
+  auto table = TableFromJSON(schema, json);
+  AssertSelectK(table, options, "[1, 5, 4]");
+  options.k = 6;
+  AssertSelectK(table, options, "[1, 5, 4, 2, 0, 3]");
+
+  auto batch = RecordBatchFromJSON(schema, R"([{"a": 2, "b": 1},
+                                               {"a": 1, "b": 3},
+                                               {"a": 1, "b": null}])");
+  options.k = 2;
+  AssertSelectK(batch, options, "[1, 2]");
+}
+
+TEST_F(TestSelectKUnstable, Errors) {
+  auto table = TableFromJSON(::arrow::schema({field("a", int32())}), {"[[1], [2]]"});
+  ASSERT_RAISES(Invalid, SelectKUnstable(table, SelectKOptions(-1, {SortKey("a")})));
+  ASSERT_RAISES(Invalid, SelectKUnstable(table, SelectKOptions(1)));
+  ASSERT_RAISES(Invalid, SelectKUnstable(table, SelectKOptions(1, {SortKey("b")})));
+  ASSERT_RAISES(NotImplemented,
+                SelectKUnstable(Datum(std::make_shared<Int32Scalar>(1)),
+                                SelectKOptions(1)));
+}
+
+TEST_F(TestSelectKUnstable, Random) {
+  const auto seed = 0x1d2e3f;
+  // enough rows to be split over several threads
+  const int64_t length = 150000;
+  auto rand = random::RandomArrayGenerator(seed);
+  auto schema = ::arrow::schema(
+      {field("few", int8()), field("many", float64()), field("text", utf8())});
+  ArrayVector columns = {rand.Int8(length, -5, 5, 0.1),
+                         rand.Float64(length, -1e6, 1e6, 0.1),
+                         rand.String(length, 0, 4, 0.1)};
+  auto table = Table::Make(schema, columns, length);
+  TableBatchReader reader(*table);
+  reader.set_chunksize(length / 7);
+  ASSERT_OK_AND_ASSIGN(auto chunked_table, Table::FromRecordBatchReader(&reader));
+
+  for (const int64_t k : {0, 1, 100, 5000}) {
+    ARROW_SCOPED_TRACE("k = ", k);
+    AssertSelectKLikeSort(
+        chunked_table, SelectKOptions(k, {SortKey("few", SortOrder::Descending),
+                                          SortKey("text"), SortKey("many")}));
+    AssertSelectKLikeSort(chunked_table,
+                          SelectKOptions(k, {SortKey("many", SortOrder::Descending)}));
+  }
+}
+
 }  // namespace compute
 }  // namespace arrow
@@ -36,6 +36,7 @@ class KernelContext;
 struct Kernel;
 struct ScalarKernel;
 struct ScalarAggregateKernel;
+struct HashAggregateKernel;
 struct VectorKernel;
 
 struct KernelState;
@@ -17,6 +17,8 @@
 
 #include "arrow/dataset/file_parquet.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -24,11 +26,17 @@
 #include <utility>
 #include <vector>
 
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_primitive.h"
+#include "arrow/compute/api_scalar.h"
+#include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec.h"
 #include "arrow/dataset/dataset_internal.h"
 #include "arrow/dataset/scanner.h"
 #include "arrow/filesystem/path_util.h"
 #include "arrow/table.h"
+#include "arrow/util/bit_run_reader.h"
+#include "arrow/util/bitmap_ops.h"
 #include "arrow/util/checked_cast.h"
 #include "arrow/util/future.h"
 #include "arrow/util/iterator.h"
@@ -37,8 +45,11 @@
 #include "parquet/arrow/reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/arrow/writer.h"
+#include "parquet/bloom_filter.h"
 #include "parquet/file_reader.h"
+#include "parquet/page_index.h"
 #include "parquet/properties.h"
+#include "parquet/schema.h"
 #include "parquet/statistics.h"
 
 namespace arrow {
@@ -54,6 +65,182 @@ using parquet::arrow::StatisticsAsScalars;
 
 namespace {
 
+/// \brief The columns decoded by each phase of a late materialized row group read
+struct LateMaterialization {
+  /// The scan filter, simplified against the fragment's partition expression
+  compute::Expression filter;
+  /// Leaf columns of the top level fields referenced by the filter, decoded first
+  std::vector<int> filter_columns;
+  /// Leaf columns of the other projected fields, decoded for the selected rows only
+  std::vector<int> other_columns;
+  /// Top level fields of filter_columns and of other_columns, in file order
+  std::vector<int> filter_fields;
+  std::vector<int> other_fields;
+};
+
+// Split the column projection into the columns the filter needs and the others, or
+// return nullptr if a late materialized read does not apply.
+Result<std::shared_ptr<const LateMaterialization>> PlanLateMaterialization(
+    parquet::arrow::FileReader* reader, const Fragment& fragment,
+    const ScanOptions& options, const std::vector<int>& column_projection) {
+  ARROW_ASSIGN_OR_RAISE(
+      auto filter,
+      SimplifyWithGuarantee(options.filter, fragment.partition_expression()));
+  if (!ExpressionHasFieldRefs(filter)) return nullptr;
+
+  std::shared_ptr<Schema> physical_schema;
+  RETURN_NOT_OK(reader->GetSchema(&physical_schema));
+  std::unordered_set<int> filter_fields;
+  for (const FieldRef& ref : FieldsInExpression(filter)) {
+    ARROW_ASSIGN_OR_RAISE(auto match, ref.FindOneOrNone(*physical_schema));
+    // Fields missing from the file (such as partition fields) are only known once the
+    // scanner projects the batches, so the filter cannot be evaluated here
+    if (match.empty()) return nullptr;
+    filter_fields.insert(match[0]);
+  }
+
+  const SchemaManifest& manifest = reader->manifest();
+  const parquet::SchemaDescriptor* descr = reader->parquet_reader()->metadata()->schema();
+  auto plan = std::make_shared<LateMaterialization>();
+  for (int column : column_projection) {
+    // Repeated columns cannot be read by row ranges
+    if (descr->Column(column)->max_repetition_level() > 0) return nullptr;
+    ARROW_ASSIGN_OR_RAISE(auto field, manifest.GetFieldIndices({column}));
+    if (filter_fields.count(field[0]) > 0) {
+      plan->filter_columns.push_back(column);
+    } else {
+      plan->other_columns.push_back(column);
+    }
+  }
+  if (plan->filter_columns.empty() || plan->other_columns.empty()) return nullptr;
+
+  plan->filter = std::move(filter);
+  ARROW_ASSIGN_OR_RAISE(plan->filter_fields,
+                        manifest.GetFieldIndices(plan->filter_columns));
+  ARROW_ASSIGN_OR_RAISE(plan->other_fields,
+                        manifest.GetFieldIndices(plan->other_columns));
+  return plan;
+}
+
+// Map the set bits of a selection over the given rows back to ranges of row group rows.
+parquet::RowRanges SelectedRowRanges(const uint8_t* selection, int64_t offset,
+                                     const parquet::RowRanges& rows) {
+  parquet::RowRanges selected;
+  size_t r = 0;
+  // Position of rows[r] within the selection
+  int64_t r_position = 0;
+  const int64_t length = parquet::RowRangesLength(rows);
+  arrow::internal::SetBitRunReader run_reader(selection, offset, length);
+  for (auto run = run_reader.NextRun(); !run.AtEnd(); run = run_reader.NextRun()) {
+    int64_t position = run.position;
+    int64_t remaining = run.length;
+    while (remaining > 0) {
+      while (position >= r_position + rows[r].length()) {
+        r_position += rows[r].length();
+        ++r;
+      }
+      const int64_t n = std::min(remaining, r_position + rows[r].length() - position);
+      const int64_t first = rows[r].first + (position - r_position);
+      if (!selected.empty() && selected.back().last + 1 == first) {
+        selected.back().last += n;
+      } else {
+        selected.push_back({first, first + n - 1});
+      }
+      position += n;
+      remaining -= n;
+    }
+  }
+  return selected;
+}
+
+// Read the rows of a row group which satisfy the filter, decoding the other columns
+// only for those rows. Returns nullptr if no row is selected.
+Result<std::shared_ptr<Table>> ReadRowGroupLate(parquet::arrow::FileReader* reader,
+                                                int row_group,
+                                                const LateMaterialization& plan,
+                                                const ScanOptions& options) {
+  const parquet::RowRanges rows = reader->GetRowGroupRowRanges(row_group);
+  if (rows.empty()) return nullptr;
+
+  std::shared_ptr<Table> filter_table;
+  RETURN_NOT_OK(
+      reader->ReadRowGroup(row_group, plan.filter_columns, rows, &filter_table));
+  ARROW_ASSIGN_OR_RAISE(filter_table, filter_table->CombineChunks(options.pool));
+  ArrayVector filter_arrays;
+  for (const auto& column : filter_table->columns()) {
+    filter_arrays.push_back(column->chunk(0));
+  }
+  auto filter_batch = RecordBatch::Make(filter_table->schema(), filter_table->num_rows(),
+                                        std::move(filter_arrays));
+
+  compute::ExecContext exec_context(options.pool);
+  ARROW_ASSIGN_OR_RAISE(auto input,
+                        compute::MakeExecBatch(*options.dataset_schema, filter_batch));
+  ARROW_ASSIGN_OR_RAISE(Datum mask,
+                        ExecuteScalarExpression(plan.filter, input, &exec_context));
+
+  parquet::RowRanges selected;
+  if (mask.is_scalar()) {
+    const auto& value = mask.scalar_as<BooleanScalar>();
+    if (!value.is_valid || !value.value) return nullptr;
+    selected = rows;
+  } else {
+    auto mask_array = mask.array_as<BooleanArray>();
+    if (mask_array->null_count() > 0) {
+      // Null counts as not selected
+      ARROW_ASSIGN_OR_RAISE(
+          auto selection,
+          arrow::internal::BitmapAnd(options.pool, mask_array->values()->data(),
+                                     mask_array->offset(), mask_array->null_bitmap_data(),
+                                     mask_array->offset(), mask_array->length(), 0));
+      selected = SelectedRowRanges(selection->data(), 0, rows);
+    } else {
+      selected = SelectedRowRanges(mask_array->values()->data(), mask_array->offset(),
+                                   rows);
+    }
+    if (selected.empty()) return nullptr;
+    ARROW_ASSIGN_OR_RAISE(auto filtered,
+                          compute::Filter(filter_table, mask,
+                                          compute::FilterOptions::Defaults(),
+                                          &exec_context));
+    filter_table = filtered.table();
+  }
+
+  std::shared_ptr<Table> other_table;
+  RETURN_NOT_OK(
+      reader->ReadRowGroup(row_group, plan.other_columns, selected, &other_table));
+
+  // Interleave the fields of both tables back into file order
+  FieldVector fields;
+  ChunkedArrayVector columns;
+  size_t f = 0, o = 0;
+  while (f < plan.filter_fields.size() || o < plan.other_fields.size()) {
+    if (o == plan.other_fields.size() ||
+        (f < plan.filter_fields.size() && plan.filter_fields[f] < plan.other_fields[o])) {
+      fields.push_back(filter_table->field(static_cast<int>(f)));
+      columns.push_back(filter_table->column(static_cast<int>(f)));
+      ++f;
+    } else {
+      fields.push_back(other_table->field(static_cast<int>(o)));
+      columns.push_back(other_table->column(static_cast<int>(o)));
+      ++o;
+    }
+  }
+  return Table::Make(schema(std::move(fields)), std::move(columns),
+                     parquet::RowRangesLength(selected));
+}
+
+// Slice a table read by ReadRowGroupLate into batches of at most batch_size rows.
+Result<RecordBatchVector> ToRecordBatches(const std::shared_ptr<Table>& table,
+                                          int64_t batch_size) {
+  RecordBatchVector batches;
+  if (table == nullptr) return batches;
+  TableBatchReader batch_reader(*table);
+  batch_reader.set_chunksize(batch_size);
+  RETURN_NOT_OK(batch_reader.ReadAll(&batches));
+  return batches;
+}
+
 /// \brief A ScanTask backed by a parquet file and a RowGroup within a parquet file.
 class ParquetScanTask : public ScanTask {
  public:
@@ -62,6 +249,7 @@ class ParquetScanTask : public ScanTask {
                   std::shared_ptr<std::once_flag> pre_buffer_once,
                   std::vector<int> pre_buffer_row_groups, arrow::io::IOContext io_context,
                   arrow::io::CacheOptions cache_options,
+                  std::shared_ptr<const LateMaterialization> late_materialization,
                   std::shared_ptr<ScanOptions> options,
                   std::shared_ptr<Fragment> fragment)
       : ScanTask(std::move(options), std::move(fragment)),
@@ -71,7 +259,8 @@ class ParquetScanTask : public ScanTask {
         pre_buffer_once_(std::move(pre_buffer_once)),
         pre_buffer_row_groups_(std::move(pre_buffer_row_groups)),
         io_context_(std::move(io_context)),
-        cache_options_(cache_options) {}
+        cache_options_(cache_options),
+        late_materialization_(std::move(late_materialization)) {}
 
   Result<RecordBatchIterator> Execute() override {
     // The construction of parquet's RecordBatchReader is deferred here to
@@ -92,6 +281,13 @@ class ParquetScanTask : public ScanTask {
     } NextBatch;
 
     RETURN_NOT_OK(EnsurePreBuffered());
+    if (late_materialization_ != nullptr) {
+      ARROW_ASSIGN_OR_RAISE(auto table, ReadRowGroupLate(reader_.get(), row_group_,
+                                                         *late_materialization_,
+                                                         *options_));
+      ARROW_ASSIGN_OR_RAISE(auto batches, ToRecordBatches(table, options_->batch_size));
+      return MakeVectorIterator(std::move(batches));
+    }
     NextBatch.file_reader = reader_;
     RETURN_NOT_OK(reader_->GetRecordBatchReader({row_group_}, column_projection_,
                                                 &NextBatch.record_batch_reader));
@@ -128,6 +324,8 @@ class ParquetScanTask : public ScanTask {
   std::vector<int> pre_buffer_row_groups_;
   arrow::io::IOContext io_context_;
   arrow::io::CacheOptions cache_options_;
+  // nullptr unless the row group is read in two phases
+  std::shared_ptr<const LateMaterialization> late_materialization_;
 };
 
 parquet::ReaderProperties MakeReaderProperties(
@@ -166,6 +364,9 @@ Result<std::shared_ptr<SchemaManifest>> GetSchemaManifest(
   return manifest;
 }
 
+util::optional<compute::Expression> StatisticsAsExpression(
+    const SchemaField& schema_field, const parquet::Statistics& statistics);
+
 util::optional<compute::Expression> ColumnChunkStatisticsAsExpression(
     const SchemaField& schema_field, const parquet::RowGroupMetaData& metadata) {
   // For the remaining of this function, failure to extract/parse statistics
@@ -184,16 +385,21 @@ util::optional<compute::Expression> ColumnChunkStatisticsAsExpression(
     return util::nullopt;
   }
 
+  return StatisticsAsExpression(schema_field, *statistics);
+}
+
+util::optional<compute::Expression> StatisticsAsExpression(
+    const SchemaField& schema_field, const parquet::Statistics& statistics) {
   const auto& field = schema_field.field;
   auto field_expr = compute::field_ref(field->name());
 
   // Optimize for corner case where all values are nulls
-  if (statistics->num_values() == 0 && statistics->null_count() > 0) {
+  if (statistics.num_values() == 0 && statistics.null_count() > 0) {
     return is_null(std::move(field_expr));
   }
 
   std::shared_ptr<Scalar> min, max;
-  if (!StatisticsAsScalars(*statistics, &min, &max).ok()) {
+  if (!StatisticsAsScalars(statistics, &min, &max).ok()) {
     return util::nullopt;
   }
 
@@ -429,6 +635,13 @@ Result<ScanTaskIterator> ParquetFileFormat::ScanFile(
     if (row_groups.empty()) MakeEmpty();
   }
 
+  ARROW_ASSIGN_OR_RAISE(row_groups, parquet_fragment->ProbeBloomFilters(
+                                        options->filter, std::move(row_groups),
+                                        reader.get()));
+  ARROW_ASSIGN_OR_RAISE(row_groups, parquet_fragment->FilterPages(
+                                        options->filter, std::move(row_groups),
+                                        reader.get()));
+
   auto column_projection = InferColumnProjection(*reader, *options);
   ScanTaskVector tasks(row_groups.size());
 
@@ -440,13 +653,19 @@ Result<ScanTaskIterator> ParquetFileFormat::ScanFile(
   if (parquet_scan_options->arrow_reader_properties->pre_buffer()) {
     pre_buffer_once = std::make_shared<std::once_flag>();
   }
+  std::shared_ptr<const LateMaterialization> late_materialization;
+  if (parquet_scan_options->late_materialization) {
+    ARROW_ASSIGN_OR_RAISE(late_materialization,
+                          PlanLateMaterialization(reader.get(), *fragment, *options,
+                                                  column_projection));
+  }
 
   for (size_t i = 0; i < row_groups.size(); ++i) {
     tasks[i] = std::make_shared<ParquetScanTask>(
         row_groups[i], column_projection, reader, pre_buffer_once, row_groups,
         parquet_scan_options->arrow_reader_properties->io_context(),
-        parquet_scan_options->arrow_reader_properties->cache_options(), options,
-        fragment);
+        parquet_scan_options->arrow_reader_properties->cache_options(),
+        late_materialization, options, fragment);
   }
 
   return MakeVectorIterator(std::move(tasks));
@@ -479,11 +698,64 @@ Result<RecordBatchGenerator> ParquetFileFormat::ScanBatchesAsync(
                             parquet_fragment->FilterRowGroups(options->filter));
       if (row_groups.empty()) return MakeEmptyGenerator<std::shared_ptr<RecordBatch>>();
     }
+    ARROW_ASSIGN_OR_RAISE(row_groups,
+                          parquet_fragment->ProbeBloomFilters(
+                              options->filter, std::move(row_groups), reader.get()));
+    ARROW_ASSIGN_OR_RAISE(row_groups,
+                          parquet_fragment->FilterPages(
+                              options->filter, std::move(row_groups), reader.get()));
+    if (row_groups.empty()) return MakeEmptyGenerator<std::shared_ptr<RecordBatch>>();
     auto column_projection = InferColumnProjection(*reader, *options);
     ARROW_ASSIGN_OR_RAISE(
         auto parquet_scan_options,
         GetFragmentScanOptions<ParquetFragmentScanOptions>(
             kParquetTypeName, options.get(), default_fragment_scan_options));
+    if (parquet_scan_options->late_materialization) {
+      ARROW_ASSIGN_OR_RAISE(std::shared_ptr<const LateMaterialization> plan,
+                            PlanLateMaterialization(reader.get(), *parquet_fragment,
+                                                    *options, column_projection));
+      if (plan != nullptr) {
+        // ReadRowGroupLate does not pre-buffer by itself: do it once for the file, as
+        // ParquetScanTask does
+        const auto& arrow_properties = reader->properties();
+        const bool pre_buffer = arrow_properties.pre_buffer();
+        if (pre_buffer) {
+          BEGIN_PARQUET_CATCH_EXCEPTIONS
+          reader->parquet_reader()->PreBuffer(row_groups, column_projection,
+                                              arrow_properties.io_context(),
+                                              arrow_properties.cache_options());
+          END_PARQUET_CATCH_EXCEPTIONS
+        }
+        // As in the reader's own RowGroupGenerator, a pre-buffered row group is decoded
+        // and filtered on the CPU executor once its IO completes. Otherwise its reads
+        // and decoding interleave, and all of it runs on the CPU executor. The
+        // concatenated generator never pulls the next row group reentrantly.
+        auto cpu_executor = internal::GetCpuThreadPool();
+        auto next_row_group = std::make_shared<size_t>(0);
+        AsyncGenerator<RecordBatchGenerator> row_group_generator =
+            [=]() -> Future<RecordBatchGenerator> {
+          if (*next_row_group == row_groups.size()) {
+            return AsyncGeneratorEnd<RecordBatchGenerator>();
+          }
+          const int row_group = row_groups[(*next_row_group)++];
+          auto read_row_group = [=]() -> Result<RecordBatchGenerator> {
+            ARROW_ASSIGN_OR_RAISE(
+                auto table, ReadRowGroupLate(reader.get(), row_group, *plan, *options));
+            ARROW_ASSIGN_OR_RAISE(auto batches,
+                                  ToRecordBatches(table, options->batch_size));
+            return MakeVectorGenerator(std::move(batches));
+          };
+          if (!pre_buffer) {
+            return DeferNotOk(cpu_executor->Submit(std::move(read_row_group)));
+          }
+          auto ready = cpu_executor->TransferAlways(
+              reader->parquet_reader()->WhenBuffered({row_group}, column_projection));
+          return ready.Then(std::move(read_row_group));
+        };
+        auto generator = MakeConcatenatedGenerator(std::move(row_group_generator));
+        return MakeReadaheadGenerator(std::move(generator), options->batch_readahead);
+      }
+    }
     ARROW_ASSIGN_OR_RAISE(auto generator, reader->GetRecordBatchGenerator(
                                               reader, row_groups, column_projection,
                                               internal::GetCpuThreadPool()));
@@ -745,6 +1017,312 @@ Result<std::vector<compute::Expression>> ParquetFileFragment::TestRowGroups(
   return row_groups;
 }
 
+namespace {
+
+// Intersect two sorted lists of disjoint row ranges
+parquet::RowRanges IntersectRowRanges(const parquet::RowRanges& left,
+                                      const parquet::RowRanges& right) {
+  parquet::RowRanges result;
+  size_t l = 0, r = 0;
+  while (l < left.size() && r < right.size()) {
+    const int64_t first = std::max(left[l].first, right[r].first);
+    const int64_t last = std::min(left[l].last, right[r].last);
+    if (first <= last) result.push_back({first, last});
+    if (left[l].last < right[r].last) {
+      ++l;
+    } else {
+      ++r;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+Result<std::vector<int>> ParquetFileFragment::FilterPages(
+    compute::Expression predicate, std::vector<int> row_groups,
+    parquet::arrow::FileReader* reader) {
+  std::vector<const SchemaField*> schema_fields;
+  std::shared_ptr<Schema> physical_schema;
+  std::shared_ptr<parquet::arrow::SchemaManifest> manifest;
+  {
+    auto lock = physical_schema_mutex_.Lock();
+    physical_schema = physical_schema_;
+    manifest = manifest_;
+    ARROW_ASSIGN_OR_RAISE(
+        predicate, SimplifyWithGuarantee(std::move(predicate), partition_expression_));
+    for (const FieldRef& ref : FieldsInExpression(predicate)) {
+      ARROW_ASSIGN_OR_RAISE(auto match, ref.FindOneOrNone(*physical_schema));
+      if (match.empty()) continue;
+      const SchemaField& schema_field = manifest->schema_fields[match[0]];
+      // Only leaves without repetition have page indexes
+      if (!schema_field.is_leaf() || schema_field.level_info.rep_level > 0) continue;
+      schema_fields.push_back(&schema_field);
+    }
+  }
+  if (schema_fields.empty()) return row_groups;
+
+  std::vector<int> selected_row_groups;
+  BEGIN_PARQUET_CATCH_EXCEPTIONS
+  parquet::ParquetFileReader* parquet_reader = reader->parquet_reader();
+  for (int row_group : row_groups) {
+    auto row_group_reader = parquet_reader->RowGroup(row_group);
+    const parquet::RowGroupMetaData* row_group_metadata = row_group_reader->metadata();
+    const int64_t num_rows = row_group_metadata->num_rows();
+    if (num_rows == 0) {
+      selected_row_groups.push_back(row_group);
+      continue;
+    }
+
+    parquet::RowRanges row_ranges{{0, num_rows - 1}};
+    for (const SchemaField* schema_field : schema_fields) {
+      const int column = schema_field->column_index;
+      if (!row_group_metadata->ColumnChunk(column)->has_column_index()) continue;
+      std::unique_ptr<parquet::ColumnIndex> column_index =
+          row_group_reader->GetColumnIndex(column);
+      std::unique_ptr<parquet::OffsetIndex> offset_index =
+          row_group_reader->GetOffsetIndex(column);
+      if (column_index == nullptr || offset_index == nullptr ||
+          column_index->num_pages() != offset_index->num_pages()) {
+        continue;
+      }
+
+      // The rows of the pages whose statistics may satisfy the predicate
+      parquet::RowRanges page_ranges;
+      for (int i = 0; i < offset_index->num_pages(); ++i) {
+        const parquet::RowRange page = offset_index->page_row_range(i, num_rows);
+        if (page.length() <= 0) continue;
+        // Pages of a column without repetition hold one value per row
+        auto statistics = column_index->page_statistics(i, page.length());
+        if (auto expr = StatisticsAsExpression(*schema_field, *statistics)) {
+          ARROW_ASSIGN_OR_RAISE(auto page_guarantee, expr->Bind(*physical_schema));
+          ARROW_ASSIGN_OR_RAISE(auto page_predicate,
+                                SimplifyWithGuarantee(predicate, page_guarantee));
+          if (!page_predicate.IsSatisfiable()) continue;
+        }
+        if (!page_ranges.empty() && page_ranges.back().last + 1 == page.first) {
+          page_ranges.back().last = page.last;
+        } else {
+          page_ranges.push_back(page);
+        }
+      }
+      row_ranges = IntersectRowRanges(row_ranges, page_ranges);
+    }
+
+    if (row_ranges.empty()) continue;
+    if (parquet::RowRangesLength(row_ranges) < num_rows) {
+      reader->SetRowGroupRowRanges(row_group, std::move(row_ranges));
+    }
+    selected_row_groups.push_back(row_group);
+  }
+  END_PARQUET_CATCH_EXCEPTIONS
+  return selected_row_groups;
+}
+
+namespace {
+
+// Hash a scalar as the Parquet writer hashes the values of a column of the given
+// physical type, or return nullopt if the stored values may not be the scalar's own
+// (floating point values are skipped since -0.0 and 0.0 hash differently)
+util::optional<uint64_t> BloomFilterHash(const parquet::BloomFilter& bloom_filter,
+                                         const Scalar& scalar,
+                                         const parquet::ColumnDescriptor& descr) {
+  if (!scalar.is_valid) return util::nullopt;
+
+  switch (scalar.type->id()) {
+    case Type::INT8:
+    case Type::INT16:
+    case Type::INT32:
+    case Type::UINT8:
+    case Type::UINT16:
+    case Type::UINT32:
+    case Type::DATE32: {
+      if (descr.physical_type() != parquet::Type::INT32) break;
+      auto maybe_value = scalar.CastTo(int64());
+      if (!maybe_value.ok()) break;
+      // Unsigned 32 bit values are stored with the bit pattern of their signed
+      // counterpart
+      const auto value = checked_cast<const Int64Scalar&>(**maybe_value).value;
+      return bloom_filter.Hash(static_cast<int32_t>(value));
+    }
+    case Type::INT64:
+      if (descr.physical_type() != parquet::Type::INT64) break;
+      return bloom_filter.Hash(checked_cast<const Int64Scalar&>(scalar).value);
+    case Type::UINT64:
+      if (descr.physical_type() != parquet::Type::INT64) break;
+      return bloom_filter.Hash(
+          static_cast<int64_t>(checked_cast<const UInt64Scalar&>(scalar).value));
+    case Type::STRING:
+    case Type::BINARY:
+    case Type::LARGE_STRING:
+    case Type::LARGE_BINARY: {
+      if (descr.physical_type() != parquet::Type::BYTE_ARRAY) break;
+      const auto& value = *checked_cast<const BaseBinaryScalar&>(scalar).value;
+      parquet::ByteArray byte_array(static_cast<uint32_t>(value.size()), value.data());
+      return bloom_filter.Hash(&byte_array);
+    }
+    case Type::FIXED_SIZE_BINARY: {
+      if (descr.physical_type() != parquet::Type::FIXED_LEN_BYTE_ARRAY) break;
+      const auto& value = *checked_cast<const BaseBinaryScalar&>(scalar).value;
+      if (value.size() != descr.type_length()) break;
+      parquet::FixedLenByteArray flba(value.data());
+      return bloom_filter.Hash(&flba, descr.type_length());
+    }
+    default:
+      break;
+  }
+  return util::nullopt;
+}
+
+// Replace the equal and is_in calls which the Bloom filters prove false with literal
+// false. Only the operands of and/or are visited: as these are monotonic, the rewritten
+// predicate is still satisfied by every row satisfying the original one.
+class BloomFilterProbe {
+ public:
+  using BloomFilterGetter = std::function<const parquet::BloomFilter*(
+      const parquet::arrow::SchemaField&)>;
+
+  BloomFilterProbe(const Schema& physical_schema,
+                   const parquet::arrow::SchemaManifest& manifest,
+                   BloomFilterGetter get_bloom_filter)
+      : physical_schema_(physical_schema),
+        manifest_(manifest),
+        get_bloom_filter_(std::move(get_bloom_filter)) {}
+
+  Result<compute::Expression> Rewrite(const compute::Expression& expr) {
+    auto call = expr.call();
+    if (call == nullptr) return expr;
+
+    if (call->function_name == "and_kleene" || call->function_name == "or_kleene" ||
+        call->function_name == "and" || call->function_name == "or") {
+      bool modified = false;
+      auto modified_call = *call;
+      for (compute::Expression& argument : modified_call.arguments) {
+        ARROW_ASSIGN_OR_RAISE(auto modified_argument, Rewrite(argument));
+        if (Identical(modified_argument, argument)) continue;
+        argument = std::move(modified_argument);
+        modified = true;
+      }
+      return modified ? compute::Expression(std::move(modified_call)) : expr;
+    }
+
+    if (call->arguments.empty() || call->arguments[0].field_ref() == nullptr) {
+      return expr;
+    }
+    const FieldRef& ref = *call->arguments[0].field_ref();
+
+    if (call->function_name == "equal" && call->arguments.size() == 2 &&
+        call->arguments[1].literal() != nullptr &&
+        call->arguments[1].literal()->is_scalar()) {
+      ARROW_ASSIGN_OR_RAISE(
+          bool absent, AllAbsent(ref, {call->arguments[1].literal()->scalar()}));
+      return absent ? compute::literal(false) : expr;
+    }
+
+    if (call->function_name == "is_in" && call->options != nullptr) {
+      const auto& options =
+          checked_cast<const compute::SetLookupOptions&>(*call->options);
+      if (!options.value_set.is_array()) return expr;
+      std::shared_ptr<Array> value_set = options.value_set.make_array();
+      ScalarVector values(value_set->length());
+      for (int64_t i = 0; i < value_set->length(); ++i) {
+        ARROW_ASSIGN_OR_RAISE(values[i], value_set->GetScalar(i));
+      }
+      ARROW_ASSIGN_OR_RAISE(bool absent, AllAbsent(ref, values));
+      return absent ? compute::literal(false) : expr;
+    }
+
+    return expr;
+  }
+
+ private:
+  // Return true if the Bloom filter of the referenced column proves that none of the
+  // values is stored in it
+  Result<bool> AllAbsent(const FieldRef& ref, const ScalarVector& values) {
+    ARROW_ASSIGN_OR_RAISE(auto match, ref.FindOneOrNone(physical_schema_));
+    if (match.empty()) return false;
+    const parquet::arrow::SchemaField& schema_field = manifest_.schema_fields[match[0]];
+    if (!schema_field.is_leaf()) return false;
+
+    const parquet::BloomFilter* bloom_filter = get_bloom_filter_(schema_field);
+    if (bloom_filter == nullptr) return false;
+
+    const parquet::ColumnDescriptor* descr =
+        manifest_.descr->Column(schema_field.column_index);
+    for (const std::shared_ptr<Scalar>& value : values) {
+      if (!value->type->Equals(*schema_field.field->type())) return false;
+      auto hash = BloomFilterHash(*bloom_filter, *value, *descr);
+      if (!hash.has_value() || bloom_filter->FindHash(*hash)) return false;
+    }
+    return true;
+  }
+
+  const Schema& physical_schema_;
+  const parquet::arrow::SchemaManifest& manifest_;
+  BloomFilterGetter get_bloom_filter_;
+};
+
+}  // namespace
+
+Result<std::vector<int>> ParquetFileFragment::ProbeBloomFilters(
+    compute::Expression predicate, std::vector<int> row_groups,
+    parquet::arrow::FileReader* reader) {
+  std::shared_ptr<Schema> physical_schema;
+  std::shared_ptr<parquet::arrow::SchemaManifest> manifest;
+  {
+    auto lock = physical_schema_mutex_.Lock();
+    physical_schema = physical_schema_;
+    manifest = manifest_;
+    ARROW_ASSIGN_OR_RAISE(
+        predicate, SimplifyWithGuarantee(std::move(predicate), partition_expression_));
+  }
+  if (!predicate.IsSatisfiable()) return std::vector<int>{};
+
+  // Only files written with Bloom filters are worth probing
+  const parquet::FileMetaData* metadata = reader->parquet_reader()->metadata().get();
+  bool has_bloom_filters = false;
+  for (int row_group : row_groups) {
+    auto row_group_metadata = metadata->RowGroup(row_group);
+    for (int i = 0; i < row_group_metadata->num_columns(); ++i) {
+      has_bloom_filters |= row_group_metadata->ColumnChunk(i)->has_bloom_filter();
+    }
+    if (has_bloom_filters) break;
+  }
+  if (!has_bloom_filters) return row_groups;
+
+  std::vector<int> selected_row_groups;
+  BEGIN_PARQUET_CATCH_EXCEPTIONS
+  parquet::ParquetFileReader* parquet_reader = reader->parquet_reader();
+  for (int row_group : row_groups) {
+    auto row_group_reader = parquet_reader->RowGroup(row_group);
+    // Each Bloom filter is read at most once per row group, when first probed
+    std::unordered_map<int, std::unique_ptr<parquet::BloomFilter>> bloom_filters;
+    BloomFilterProbe probe(
+        *physical_schema, *manifest,
+        [&](const parquet::arrow::SchemaField& schema_field)
+            -> const parquet::BloomFilter* {
+          const int column = schema_field.column_index;
+          auto it = bloom_filters.find(column);
+          if (it == bloom_filters.end()) {
+            std::unique_ptr<parquet::BloomFilter> bloom_filter;
+            if (row_group_reader->metadata()->ColumnChunk(column)->has_bloom_filter()) {
+              bloom_filter = row_group_reader->GetBloomFilter(column);
+            }
+            it = bloom_filters.emplace(column, std::move(bloom_filter)).first;
+          }
+          return it->second.get();
+        });
+    ARROW_ASSIGN_OR_RAISE(auto row_group_predicate, probe.Rewrite(predicate));
+    ARROW_ASSIGN_OR_RAISE(row_group_predicate,
+                          FoldConstants(std::move(row_group_predicate)));
+    if (row_group_predicate.IsSatisfiable()) {
+      selected_row_groups.push_back(row_group);
+    }
+  }
+  END_PARQUET_CATCH_EXCEPTIONS
+  return selected_row_groups;
+}
+
 Result<util::optional<int64_t>> ParquetFileFragment::TryCountRows(
     compute::Expression predicate) {
   DCHECK_NE(metadata_, nullptr);
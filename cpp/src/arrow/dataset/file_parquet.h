@@ -186,6 +186,16 @@ class ARROW_DS_EXPORT ParquetFileFragment : public FileFragment {
   Result<std::vector<int>> FilterRowGroups(compute::Expression predicate);
   /// Simplify the predicate against the statistics of each row group.
   Result<std::vector<compute::Expression>> TestRowGroups(compute::Expression predicate);
+  /// Restrict the reader to the pages of the given row groups whose page index
+  /// statistics may satisfy the predicate, returning the row groups which keep any.
+  Result<std::vector<int>> FilterPages(compute::Expression predicate,
+                                       std::vector<int> row_groups,
+                                       parquet::arrow::FileReader* reader);
+  /// Drop the row groups whose Bloom filters prove that the predicate's equal and
+  /// is_in comparisons against a column can't be satisfied.
+  Result<std::vector<int>> ProbeBloomFilters(compute::Expression predicate,
+                                             std::vector<int> row_groups,
+                                             parquet::arrow::FileReader* reader);
   /// Try to count rows matching the predicate using metadata. Expects
   /// metadata to be present, and expects the predicate to have been
   /// simplified against the partition expression already.
@@ -226,6 +236,14 @@ class ARROW_DS_EXPORT ParquetFragmentScanOptions : public FragmentScanOptions {
   /// across files and columns. Only affects the threaded reader; the async reader
   /// will parallelize across columns if use_threads is enabled.
   bool enable_parallel_column_conversion = false;
+  /// EXPERIMENTAL: Read each row group in two phases: first the columns referenced by
+  /// the filter, which is evaluated on them, then the other columns only for the rows
+  /// it selects, skipping the pages and runs of values which hold none. Applies only
+  /// when the filter references no field missing from the file (such as a partition
+  /// field) and no projected column is repeated; other scans read as usual.
+  /// The filter columns of a whole row group are decoded at once regardless of the
+  /// scan's batch_size, so memory use grows with the row group size.
+  bool late_materialization = false;
 };
 
 class ARROW_DS_EXPORT ParquetFileWriteOptions : public FileWriteOptions {
@@ -378,6 +378,60 @@ class TestParquetFileFormatScan : public FileFormatScanMixin<ParquetFormatHelper
       EXPECT_EQ(SingleBatch(parquet_fragment)->num_rows(), expected + 1);
     }
   }
+
+  // A fragment of three row groups holding i64 = 0...999 in data pages of 50 rows,
+  // with f64 and str derived from i64, scanned with late materialization
+  std::shared_ptr<Fragment> MakeLateMaterializationFragment(bool pre_buffer) {
+    constexpr int64_t kNumRows = 1000;
+    std::vector<int64_t> i64_values(kNumRows);
+    std::vector<double> f64_values(kNumRows);
+    std::vector<std::string> str_values(kNumRows);
+    for (int64_t i = 0; i < kNumRows; ++i) {
+      i64_values[i] = i;
+      f64_values[i] = static_cast<double>(kNumRows - i);
+      str_values[i] = std::to_string(i);
+    }
+    std::shared_ptr<Array> i64, f64, str;
+    ArrayFromVector<Int64Type>(i64_values, &i64);
+    ArrayFromVector<DoubleType>(f64_values, &f64);
+    ArrayFromVector<StringType, std::string>(str_values, &str);
+    auto table = Table::Make(
+        schema({field("i64", int64()), field("f64", float64()), field("str", utf8())}),
+        {i64, f64, str});
+
+    auto sink = CreateOutputStream();
+    auto properties = WriterProperties::Builder()
+                          .write_batch_size(50)
+                          ->data_pagesize(1)
+                          ->enable_write_page_index()
+                          ->build();
+    ARROW_EXPECT_OK(WriteTable(*table, default_memory_pool(), sink, 400, properties));
+    EXPECT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+
+    SetSchema(table->schema()->fields());
+    EXPECT_OK_AND_ASSIGN(auto fragment, format_->MakeFragment(FileSource(buffer)));
+    auto fragment_scan_options = std::make_shared<ParquetFragmentScanOptions>();
+    fragment_scan_options->late_materialization = true;
+    fragment_scan_options->arrow_reader_properties->set_pre_buffer(pre_buffer);
+    opts_->fragment_scan_options = fragment_scan_options;
+    return fragment;
+  }
+
+  // Check a batch of a fragment made by MakeLateMaterializationFragment and append
+  // its i64 values to rows
+  void CheckLateMaterializedBatch(const RecordBatch& batch, std::vector<int64_t>* rows) {
+    AssertSchemaEqual(*batch.schema(), *opts_->dataset_schema,
+                      /*check_metadata=*/false);
+    const auto& batch_i64 = checked_cast<const Int64Array&>(*batch.column(0));
+    const auto& batch_f64 = checked_cast<const DoubleArray&>(*batch.column(1));
+    const auto& batch_str = checked_cast<const StringArray&>(*batch.column(2));
+    for (int64_t i = 0; i < batch.num_rows(); ++i) {
+      const int64_t value = batch_i64.Value(i);
+      ASSERT_EQ(batch_f64.Value(i), static_cast<double>(1000 - value));
+      ASSERT_EQ(batch_str.GetString(i), std::to_string(value));
+      rows->push_back(value);
+    }
+  }
 };
 
 TEST_P(TestParquetFileFormatScan, ScanRecordBatchReader) { TestScan(); }
@@ -604,6 +658,169 @@ TEST_P(TestParquetFileFormatScan, PredicatePushdownRowGroupFragmentsUsingStringC
   CountRowGroupsInFragment(fragment, {0, 3}, equal(field_ref("x"), literal("a")));
 }
 
+TEST_P(TestParquetFileFormatScan, PredicatePushdownPageIndex) {
+  // A single row group of 1000 rows, written in data pages of 100 rows
+  constexpr int64_t kNumRows = 1000;
+  std::vector<int64_t> i64_values(kNumRows);
+  std::vector<double> f64_values(kNumRows);
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    i64_values[i] = i;
+    f64_values[i] = static_cast<double>(kNumRows - i);
+  }
+  std::shared_ptr<Array> i64, f64;
+  ArrayFromVector<Int64Type>(i64_values, &i64);
+  ArrayFromVector<DoubleType>(f64_values, &f64);
+  auto table = Table::Make(schema({field("i64", int64()), field("f64", float64())}),
+                           {i64, f64});
+
+  auto sink = CreateOutputStream();
+  auto properties = WriterProperties::Builder()
+                        .write_batch_size(100)
+                        ->data_pagesize(1)
+                        ->disable_dictionary()
+                        ->enable_write_page_index()
+                        ->build();
+  ASSERT_OK(WriteTable(*table, default_memory_pool(), sink, kNumRows, properties));
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+  FileSource source(buffer);
+
+  SetSchema(table->schema()->fields());
+  ASSERT_OK_AND_ASSIGN(auto fragment, format_->MakeFragment(source));
+
+  // Only the pages which may hold matching rows are read
+  SetFilter(equal(field_ref("i64"), literal(int64_t(250))));
+  CountRowsAndBatchesInScan(fragment, 100, 1);
+
+  SetFilter(greater_equal(field_ref("i64"), literal(int64_t(750))));
+  CountRowsAndBatchesInScan(fragment, 300, 1);
+
+  // The candidate rows of every field are intersected
+  SetFilter(and_(less(field_ref("i64"), literal(int64_t(500))),
+                 less(field_ref("f64"), literal(700.0))));
+  CountRowsAndBatchesInScan(fragment, 200, 1);
+
+  SetFilter(and_(less(field_ref("i64"), literal(int64_t(300))),
+                 less(field_ref("f64"), literal(700.0))));
+  CountRowsAndBatchesInScan(fragment, 0, 0);
+}
+
+TEST_P(TestParquetFileFormatScan, PredicatePushdownBloomFilter) {
+  // Four row groups of scattered even IDs, whose min/max statistics overlap
+  constexpr int64_t kNumRows = 4000;
+  constexpr int64_t kRowGroupLength = 1000;
+  std::vector<int64_t> id_values(kNumRows);
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    id_values[i] = static_cast<int64_t>((i * 0x9E3779B97F4A7C15ULL) >> 2) * 2;
+  }
+  std::shared_ptr<Array> ids;
+  ArrayFromVector<Int64Type>(id_values, &ids);
+  auto table = Table::Make(schema({field("id", int64())}), {ids});
+
+  auto sink = CreateOutputStream();
+  auto properties = WriterProperties::Builder().enable_bloom_filter("id")->build();
+  ASSERT_OK(WriteTable(*table, default_memory_pool(), sink, kRowGroupLength, properties));
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+  FileSource source(buffer);
+
+  SetSchema(table->schema()->fields());
+  ASSERT_OK_AND_ASSIGN(auto fragment, format_->MakeFragment(source));
+
+  // Only the row groups which may hold the IDs are read
+  SetFilter(equal(field_ref("id"), literal(id_values[1500])));
+  CountRowsAndBatchesInScan(fragment, kRowGroupLength, 1);
+
+  SetFilter(equal(field_ref("id"), literal(id_values[1500] + 1)));
+  CountRowsAndBatchesInScan(fragment, 0, 0);
+
+  std::shared_ptr<Array> value_set;
+  ArrayFromVector<Int64Type>({id_values[10] + 1, id_values[3999], id_values[20] + 1},
+                             &value_set);
+  SetFilter(call("is_in", {field_ref("id")}, compute::SetLookupOptions{value_set}));
+  CountRowsAndBatchesInScan(fragment, kRowGroupLength, 1);
+
+  // A disjunction is dropped only if both sides are
+  SetFilter(or_(equal(field_ref("id"), literal(id_values[0])),
+                equal(field_ref("id"), literal(id_values[2000]))));
+  CountRowsAndBatchesInScan(fragment, 2 * kRowGroupLength, 2);
+
+  // Other comparisons are left to the statistics
+  SetFilter(not_equal(field_ref("id"), literal(id_values[0] + 1)));
+  CountRowsAndBatchesInScan(fragment, kNumRows, 4);
+}
+
+TEST_P(TestParquetFileFormatScan, LateMaterialization) {
+  auto fragment = MakeLateMaterializationFragment(/*pre_buffer=*/false);
+
+  // Only the selected rows are returned, whole and in order
+  auto expect_rows = [&](std::vector<int64_t> expected) {
+    std::vector<int64_t> actual;
+    for (auto maybe_batch : PhysicalBatches(fragment)) {
+      ASSERT_OK_AND_ASSIGN(auto batch, maybe_batch);
+      CheckLateMaterializedBatch(*batch, &actual);
+    }
+    EXPECT_EQ(actual, expected);
+  };
+
+  SetFilter(or_(less(field_ref("i64"), literal(int64_t(3))),
+                and_(greater_equal(field_ref("i64"), literal(int64_t(390))),
+                     less(field_ref("i64"), literal(int64_t(410))))));
+  std::vector<int64_t> expected{0, 1, 2};
+  for (int64_t i = 390; i < 410; ++i) expected.push_back(i);
+  expect_rows(expected);
+
+  // A filter over several fields
+  SetFilter(and_(equal(call("bit_wise_and", {field_ref("i64"), literal(int64_t(127))}),
+                       literal(int64_t(0))),
+                 greater(field_ref("f64"), literal(300.0))));
+  expect_rows({0, 128, 256, 384, 512, 640});
+
+  SetFilter(equal(field_ref("str"), literal("999")));
+  expect_rows({999});
+
+  SetFilter(equal(field_ref("str"), literal("1000")));
+  expect_rows({});
+}
+
+TEST_P(TestParquetFileFormatScan, LateMaterializationPreBufferThreaded) {
+  if (!GetParam().use_threads) {
+    GTEST_SKIP() << "Row groups are only read concurrently with threads";
+  }
+  auto fragment = MakeLateMaterializationFragment(/*pre_buffer=*/true);
+  opts_->use_threads = true;
+  SetFilter(or_(less(field_ref("i64"), literal(int64_t(3))),
+                greater_equal(field_ref("i64"), literal(int64_t(398)))));
+
+  // Read all the row groups at once, so that they share the pre-buffered reads
+  RecordBatchVector batches;
+  if (GetParam().use_async) {
+    ASSERT_OK_AND_ASSIGN(auto batch_gen, fragment->ScanBatchesAsync(opts_));
+    ASSERT_FINISHES_OK_AND_ASSIGN(batches, CollectAsyncGenerator(std::move(batch_gen)));
+  } else {
+    ASSERT_OK_AND_ASSIGN(auto scan_task_it, fragment->Scan(opts_));
+    ASSERT_OK_AND_ASSIGN(auto scan_tasks, scan_task_it.ToVector());
+    std::vector<Future<RecordBatchVector>> futures;
+    for (const auto& scan_task : scan_tasks) {
+      futures.push_back(DeferNotOk(internal::GetCpuThreadPool()->Submit(
+          [scan_task]() -> Result<RecordBatchVector> {
+            ARROW_ASSIGN_OR_RAISE(auto batch_it, scan_task->Execute());
+            return batch_it.ToVector();
+          })));
+    }
+    for (const auto& future : futures) {
+      ASSERT_FINISHES_OK_AND_ASSIGN(auto task_batches, future);
+      batches.insert(batches.end(), task_batches.begin(), task_batches.end());
+    }
+  }
+
+  std::vector<int64_t> actual;
+  for (const auto& batch : batches) {
+    CheckLateMaterializedBatch(*batch, &actual);
+  }
+  std::vector<int64_t> expected{0, 1, 2};
+  for (int64_t i = 398; i < 1000; ++i) expected.push_back(i);
+  EXPECT_EQ(actual, expected);
+}
+
 INSTANTIATE_TEST_SUITE_P(TestScan, TestParquetFileFormatScan,
                          ::testing::ValuesIn(TestFormatParams::Values()),
                          TestFormatParams::ToTestNameString);
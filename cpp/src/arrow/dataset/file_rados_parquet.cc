@@ -16,17 +16,30 @@
 // under the License.
 #include "arrow/dataset/file_rados_parquet.h"
 
+#include <stdlib.h>
+
+#include <algorithm>
+#include <thread>
+
 #include "arrow/api.h"
+#include "arrow/compute/api_aggregate.h"
+#include "arrow/compute/exec.h"
 #include "arrow/compute/exec/expression.h"
+#include "arrow/compute/kernel.h"
 #include "arrow/dataset/dataset_internal.h"
 #include "arrow/dataset/file_base.h"
+#include "arrow/dataset/file_ipc.h"
 #include "arrow/filesystem/filesystem.h"
 #include "arrow/filesystem/path_util.h"
 #include "arrow/filesystem/util_internal.h"
+#include "arrow/util/async_generator.h"
+#include "arrow/util/cache_internal.h"
 #include "arrow/util/checked_cast.h"
 #include "arrow/util/compression.h"
 #include "arrow/util/iterator.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/thread_pool.h"
+#include "arrow/util/value_parsing.h"
 #include "parquet/arrow/reader.h"
 #include "parquet/file_reader.h"
 
@@ -44,32 +57,277 @@ namespace dataset {
 class RadosParquetScanTask : public ScanTask {
  public:
   RadosParquetScanTask(std::shared_ptr<ScanOptions> options,
-                       std::shared_ptr<Fragment> fragment, FileSource source,
-                       std::shared_ptr<DirectObjectAccess> doa)
+                       std::shared_ptr<Fragment> fragment,
+                       std::shared_ptr<DirectObjectAccess> doa, const struct stat& st,
+                       std::vector<int> row_groups, std::string compression)
       : ScanTask(std::move(options), std::move(fragment)),
-        source_(std::move(source)),
-        doa_(std::move(doa)) {}
+        doa_(std::move(doa)),
+        st_(st),
+        row_groups_(std::move(row_groups)),
+        compression_(std::move(compression)) {}
 
   Result<RecordBatchIterator> Execute() override {
-    struct stat st {};
-    ARROW_RETURN_NOT_OK(doa_->Stat(source_.path(), st));
-
     ceph::bufferlist request;
-    ARROW_RETURN_NOT_OK(SerializeScanRequest(options_, st.st_size, request));
+    int64_t file_size = st_.st_size;
+    ARROW_RETURN_NOT_OK(SerializeScanRequest(options_, file_size, request, row_groups_,
+                                             {}, {}, compression_));
 
-    ceph::bufferlist result;
-    ARROW_RETURN_NOT_OK(doa_->Exec(st.st_ino, "scan_op", request, result));
+    auto result = std::make_shared<ceph::bufferlist>();
+    ARROW_RETURN_NOT_OK(doa_->Exec(st_.st_ino, "scan_op", request, *result));
 
-    RecordBatchVector batches;
-    ARROW_RETURN_NOT_OK(DeserializeTable(batches, result, !options_->use_threads));
-    return MakeVectorIterator(batches);
+    return DeserializeRecordBatches(std::move(result), !options_->use_threads);
   }
 
  protected:
-  FileSource source_;
   std::shared_ptr<DirectObjectAccess> doa_;
+  /// The result of stat on the file, shared by all the tasks of the file.
+  struct stat st_;
+  std::vector<int> row_groups_;
+  std::string compression_;
+};
+
+class RadosFileMetadataCache::Impl {
+ public:
+  explicit Impl(int32_t capacity) : entries_(capacity) {}
+
+  std::shared_ptr<ParquetFileFragment> Get(const struct stat& st) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.Find(static_cast<uint64_t>(st.st_ino));
+    if (entry == nullptr || !entry->Matches(st)) return nullptr;
+    return entry->fragment;
+  }
+
+  void Put(const struct stat& st, std::shared_ptr<ParquetFileFragment> fragment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.Replace(static_cast<uint64_t>(st.st_ino),
+                     Entry{st.st_mtim, st.st_size, std::move(fragment)});
+  }
+
+  int32_t size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    /// Whether the file is unchanged since the entry was cached.
+    bool Matches(const struct stat& st) const {
+      return mtime.tv_sec == st.st_mtim.tv_sec && mtime.tv_nsec == st.st_mtim.tv_nsec &&
+             file_size == st.st_size;
+    }
+
+    struct timespec mtime;
+    int64_t file_size;
+    std::shared_ptr<ParquetFileFragment> fragment;
+  };
+
+  std::mutex mutex_;
+  internal::LruCache<uint64_t, Entry> entries_;
+};
+
+RadosFileMetadataCache::RadosFileMetadataCache(int32_t capacity)
+    : impl_(new Impl(capacity)) {}
+
+RadosFileMetadataCache::~RadosFileMetadataCache() = default;
+
+std::shared_ptr<ParquetFileFragment> RadosFileMetadataCache::Get(const struct stat& st) {
+  return impl_->Get(st);
+}
+
+void RadosFileMetadataCache::Put(const struct stat& st,
+                                 std::shared_ptr<ParquetFileFragment> fragment) {
+  impl_->Put(st, std::move(fragment));
+}
+
+int32_t RadosFileMetadataCache::size() { return impl_->size(); }
+
+namespace connection {
+
+RadosConnection::RadosConnection(const RadosConnectionCtx& ctx)
+    : RadosConnection(ctx, [&] {
+        std::vector<std::unique_ptr<RadosHandle>> handles;
+        for (int32_t i = 0; i < std::max(ctx.num_handles, 1); ++i) {
+          handles.emplace_back(new RadosHandle());
+        }
+        return handles;
+      }()) {}
+
+RadosConnection::RadosConnection(const RadosConnectionCtx& ctx,
+                                 std::vector<std::unique_ptr<RadosHandle>> handles)
+    : Connection(),
+      ctx(ctx),
+      handles(std::move(handles)),
+      connected(false),
+      metadata_cache(
+          std::make_shared<RadosFileMetadataCache>(ctx.metadata_cache_capacity)) {
+  DCHECK(!this->handles.empty());
+  this->ctx.num_handles = static_cast<int32_t>(this->handles.size());
+}
+
+Status RadosConnection::connect() {
+  if (connected) {
+    return Status::OK();
+  }
+
+  // Locks the mutex. Only one thread can pass here at a time.
+  // Another thread handled the connection already.
+  std::unique_lock<std::mutex> lock(connection_mutex);
+  if (connected) {
+    return Status::OK();
+  }
+  connected = true;
+
+  for (const auto& handle : handles) {
+    if (handle->rados->init2(ctx.user_name.c_str(), ctx.cluster_name.c_str(), 0))
+      return Status::Invalid("librados::init2 returned non-zero exit code.");
+
+    if (handle->rados->conf_read_file(ctx.ceph_config_path.c_str()))
+      return Status::Invalid("librados::conf_read_file returned non-zero exit code.");
+
+    if (handle->rados->connect())
+      return Status::Invalid("librados::connect returned non-zero exit code.");
+
+    if (handle->rados->ioctx_create(ctx.data_pool.c_str(), handle->ioCtx.get()))
+      return Status::Invalid("librados::ioctx_create returned non-zero exit code.");
+  }
+
+  return Status::OK();
+}
+
+Status RadosConnection::shutdown() {
+  for (const auto& handle : handles) {
+    handle->rados->shutdown();
+  }
+  return Status::OK();
+}
+
+RadosHandle* RadosConnection::AcquireHandle() {
+  RadosHandle* handle;
+  if (handles.size() == 1) {
+    handle = handles[0].get();
+  } else if (ctx.handle_selection == HandleSelection::kLeastOutstandingOps) {
+    // Start from a rotating position so that ties are spread over the handles.
+    size_t start = next_handle_++ % handles.size();
+    handle = handles[start].get();
+    for (size_t i = 1; i < handles.size(); ++i) {
+      auto candidate = handles[(start + i) % handles.size()].get();
+      if (candidate->outstanding_ops < handle->outstanding_ops) {
+        handle = candidate;
+      }
+    }
+  } else {
+    handle = handles[next_handle_++ % handles.size()].get();
+  }
+  ++handle->outstanding_ops;
+  ++handle->total_ops;
+  return handle;
+}
+
+std::vector<RadosHandleStats> RadosConnection::handle_stats() const {
+  std::vector<RadosHandleStats> stats;
+  stats.reserve(handles.size());
+  for (const auto& handle : handles) {
+    stats.push_back({handle->outstanding_ops.load(), handle->total_ops.load()});
+  }
+  return stats;
+}
+
+}  // namespace connection
+
+struct DirectObjectAccess::AioExecState {
+  std::shared_ptr<DirectObjectAccess> doa;
+  std::string oid;
+  std::string fn;
+  ceph::bufferlist in;
+  std::shared_ptr<ceph::bufferlist> out;
+  /// The handle the call is issued on.
+  connection::RadosHandle* handle = NULLPTR;
+  Future<std::shared_ptr<ceph::bufferlist>> future;
 };
 
+DirectObjectAccess::DirectObjectAccess(
+    const std::shared_ptr<connection::RadosConnection>& connection)
+    : connection_(std::move(connection)) {}
+
+DirectObjectAccess::~DirectObjectAccess() = default;
+
+Future<std::shared_ptr<ceph::bufferlist>> DirectObjectAccess::ExecAsync(
+    uint64_t inode, const std::string& fn, ceph::bufferlist in) {
+  std::unique_ptr<AioExecState> state(new AioExecState());
+  state->doa = shared_from_this();
+  state->oid = ConvertFileInodeToObjectID(inode);
+  state->fn = fn;
+  state->in = std::move(in);
+  state->out = std::make_shared<ceph::bufferlist>();
+  state->future = Future<std::shared_ptr<ceph::bufferlist>>::Make();
+  auto future = state->future;
+
+  {
+    std::lock_guard<std::mutex> lock(throttle_mutex_);
+    if (outstanding_ops_ >= connection_->ctx.max_outstanding_ops) {
+      pending_ops_.push_back(std::move(state));
+      return future;
+    }
+    ++outstanding_ops_;
+  }
+  IssueExec(std::move(state));
+  return future;
+}
+
+void DirectObjectAccess::IssueExec(std::unique_ptr<AioExecState> state) {
+  // The callback takes ownership of the state, and it may be invoked before
+  // aio_exec returns.
+  auto handle = connection_->AcquireHandle();
+  state->handle = handle;
+  AioExecState* raw_state = state.release();
+  int e = handle->ioCtx->aio_exec(
+      raw_state->oid, connection_->ctx.cls_name.c_str(), raw_state->fn.c_str(),
+      raw_state->in, raw_state->out.get(),
+      [raw_state](int e) { OnExecComplete(raw_state, e); });
+  if (e < 0) {
+    state.reset(raw_state);
+    connection_->ReleaseHandle(handle);
+    auto future = std::move(state->future);
+    state.reset();
+    FinishExec();
+    future.MarkFinished(Status::IOError("librados::aio_exec returned error code ", e));
+  }
+}
+
+void DirectObjectAccess::FinishExec() {
+  std::unique_ptr<AioExecState> next;
+  {
+    std::lock_guard<std::mutex> lock(throttle_mutex_);
+    if (pending_ops_.empty()) {
+      --outstanding_ops_;
+      return;
+    }
+    // Hand the slot over to the next queued call.
+    next = std::move(pending_ops_.front());
+    pending_ops_.pop_front();
+  }
+  IssueExec(std::move(next));
+}
+
+void DirectObjectAccess::OnExecComplete(AioExecState* raw_state, int e) {
+  std::unique_ptr<AioExecState> state(raw_state);
+  Status status = ExecStatus(e);
+
+  auto doa = std::move(state->doa);
+  auto future = std::move(state->future);
+  auto out = std::move(state->out);
+  auto handle = state->handle;
+  state.reset();
+
+  doa->connection_->ReleaseHandle(handle);
+  doa->FinishExec();
+  if (status.ok()) {
+    future.MarkFinished(std::move(out));
+  } else {
+    future.MarkFinished(std::move(status));
+  }
+}
+
 RadosParquetFileFormat::RadosParquetFileFormat(const std::string& ceph_config_path,
                                                const std::string& data_pool,
                                                const std::string& user_name,
@@ -86,27 +344,289 @@ RadosParquetFileFormat::RadosParquetFileFormat(
   doa_ = doa;
 }
 
+std::shared_ptr<RadosFileMetadataCache> RadosParquetFileFormat::metadata_cache() const {
+  if (doa_ == nullptr || doa_->connection() == nullptr) return nullptr;
+  return doa_->connection()->metadata_cache;
+}
+
 Result<std::shared_ptr<Schema>> RadosParquetFileFormat::Inspect(
     const FileSource& source) const {
-  ARROW_ASSIGN_OR_RAISE(auto reader, GetReader(source));
-  std::shared_ptr<Schema> schema;
-  RETURN_NOT_OK(reader->GetSchema(&schema));
-  return schema;
+  auto cache = metadata_cache();
+  if (cache == nullptr || source.path().empty()) {
+    ARROW_ASSIGN_OR_RAISE(auto reader, GetReader(source));
+    std::shared_ptr<Schema> schema;
+    RETURN_NOT_OK(reader->GetSchema(&schema));
+    return schema;
+  }
+
+  struct stat st {};
+  ARROW_RETURN_NOT_OK(doa_->Stat(source.path(), st));
+  if (auto cached = cache->Get(st)) {
+    return cached->ReadPhysicalSchema();
+  }
+
+  // Read the footer through a fragment so that later scans of the file can reuse
+  // it. MakeFragment does not modify the format.
+  auto self = internal::checked_pointer_cast<ParquetFileFormat>(
+      std::const_pointer_cast<FileFormat>(shared_from_this()));
+  ARROW_ASSIGN_OR_RAISE(auto fragment, self->MakeFragment(source, compute::literal(true),
+                                                          /*physical_schema=*/nullptr));
+  auto parquet_fragment = internal::checked_pointer_cast<ParquetFileFragment>(fragment);
+  ARROW_RETURN_NOT_OK(parquet_fragment->EnsureCompleteMetadata());
+  cache->Put(st, parquet_fragment);
+  return parquet_fragment->ReadPhysicalSchema();
 }
 
+namespace {
+
+/// Split the scan of a file into the sets of row groups to request with separate
+/// scan_op calls. Row groups whose statistics cannot satisfy the filter are
+/// dropped, so the result is empty if no row group can match. Files which are
+/// not Parquet files are scanned with a single call over the whole file.
+///
+/// The footer of the file is taken from the metadata cache if possible, and
+/// cached otherwise.
+Result<std::vector<std::vector<int>>> SplitScanRequests(
+    const ScanOptions& options, const std::shared_ptr<FileFragment>& file,
+    const struct stat& st, const std::shared_ptr<RadosFileMetadataCache>& cache) {
+  auto parquet_fragment = std::dynamic_pointer_cast<ParquetFileFragment>(file);
+  if (options.file_format != 0 || parquet_fragment == nullptr) {
+    return std::vector<std::vector<int>>{{}};
+  }
+
+  auto fragment = parquet_fragment;
+  if (cache != nullptr && parquet_fragment->metadata() == nullptr) {
+    auto cached = cache->Get(st);
+    // The partition expression is used to prune row groups, so a fragment cached
+    // for another partitioning of the file can't be reused.
+    if (cached != nullptr &&
+        cached->partition_expression() == file->partition_expression()) {
+      if (parquet_fragment->row_groups().empty()) {
+        fragment = std::move(cached);
+      } else {
+        ARROW_ASSIGN_OR_RAISE(auto subset,
+                              cached->Subset(parquet_fragment->row_groups()));
+        fragment = internal::checked_pointer_cast<ParquetFileFragment>(subset);
+      }
+    }
+  }
+
+  // Reads the footer through the file system if it has not been read yet.
+  ARROW_ASSIGN_OR_RAISE(auto row_group_fragments,
+                        fragment->SplitByRowGroup(options.filter));
+
+  if (cache != nullptr && fragment == parquet_fragment &&
+      static_cast<int>(fragment->row_groups().size()) ==
+          fragment->metadata()->num_row_groups()) {
+    cache->Put(st, std::move(fragment));
+  }
+  std::vector<std::vector<int>> requests;
+  requests.reserve(row_group_fragments.size());
+  for (const auto& fragment : row_group_fragments) {
+    requests.push_back(
+        internal::checked_cast<const ParquetFileFragment&>(*fragment).row_groups());
+  }
+  return requests;
+}
+
+/// Issue a scan_op call for some row groups of a file and return a generator of
+/// the record batches in its result.
+RecordBatchGenerator ExecScanAsync(const std::shared_ptr<DirectObjectAccess>& doa,
+                                   std::shared_ptr<ScanOptions> options,
+                                   const struct stat& st,
+                                   const std::vector<int>& row_groups,
+                                   const std::string& compression) {
+  int64_t file_size = st.st_size;
+  ceph::bufferlist request;
+  auto status =
+      SerializeScanRequest(options, file_size, request, row_groups, {}, {}, compression);
+  if (!status.ok()) {
+    return MakeFailingGenerator<std::shared_ptr<RecordBatch>>(std::move(status));
+  }
+  // The result is delivered on a librados callback thread, so move the
+  // deserialization over to the CPU thread pool.
+  auto result_fut = internal::GetCpuThreadPool()->Transfer(
+      doa->ExecAsync(st.st_ino, "scan_op", std::move(request)));
+
+  bool use_threads = !options->use_threads;
+  auto generator_fut = result_fut.Then(
+      [use_threads](const std::shared_ptr<ceph::bufferlist>& result)
+          -> Result<RecordBatchGenerator> {
+        ARROW_ASSIGN_OR_RAISE(auto batch_it, DeserializeRecordBatches(result, use_threads));
+        // Decode each batch only when it is pulled by the consumer.
+        auto shared_batch_it = std::make_shared<RecordBatchIterator>(std::move(batch_it));
+        return RecordBatchGenerator(
+            [shared_batch_it]() -> Future<std::shared_ptr<RecordBatch>> {
+              return shared_batch_it->Next();
+            });
+      });
+  return MakeFromFuture(std::move(generator_fut));
+}
+
+/// The compression of a scan result.
+struct ResultCompression {
+  /// Whether to choose the codec of each batch, see SerializeScanResult.
+  bool adaptive = false;
+  Compression::type codec = Compression::LZ4_FRAME;
+  int level = util::kUseDefaultCompressionLevel;
+};
+
+Result<ResultCompression> ParseResultCompression(const std::string& spec) {
+  ResultCompression compression;
+  if (spec.empty() || spec == "lz4") {
+    return compression;
+  }
+  if (spec == "none") {
+    compression.codec = Compression::UNCOMPRESSED;
+    return compression;
+  }
+  if (spec == "auto") {
+    compression.adaptive = true;
+    return compression;
+  }
+  if (spec == "zstd") {
+    compression.codec = Compression::ZSTD;
+    return compression;
+  }
+  const std::string zstd_prefix = "zstd:";
+  if (spec.compare(0, zstd_prefix.size(), zstd_prefix) == 0) {
+    compression.codec = Compression::ZSTD;
+    auto level = spec.substr(zstd_prefix.size());
+    if (::arrow::internal::ParseValue<Int32Type>(level.data(), level.size(),
+                                                 &compression.level)) {
+      return compression;
+    }
+  }
+  return Status::Invalid("Invalid scan result compression: '", spec,
+                         "', expected none, lz4, zstd, zstd:<level> or auto");
+}
+
+/// The result of stat on a file and the row groups of each scan_op call to
+/// issue for it.
+struct ScanPlan {
+  struct stat st;
+  std::vector<std::vector<int>> requests;
+};
+
+Future<ScanPlan> PlanScanAsync(std::shared_ptr<DirectObjectAccess> doa,
+                               std::shared_ptr<RadosFileMetadataCache> cache,
+                               std::shared_ptr<ScanOptions> options,
+                               std::shared_ptr<FileFragment> file) {
+  // stat() and the footer read go through the CephFS mount, so keep them off the
+  // CPU thread pool.
+  auto executor = options->io_context.executor();
+  return DeferNotOk(executor->Submit([doa, cache, options, file]() -> Result<ScanPlan> {
+    ScanPlan plan;
+    ARROW_RETURN_NOT_OK(doa->Stat(file->source().path(), plan.st));
+    ARROW_ASSIGN_OR_RAISE(plan.requests,
+                          SplitScanRequests(*options, file, plan.st, cache));
+    return plan;
+  }));
+}
+
+}  // namespace
+
 Result<ScanTaskIterator> RadosParquetFileFormat::ScanFile(
     const std::shared_ptr<ScanOptions>& options,
     const std::shared_ptr<FileFragment>& file) const {
   std::shared_ptr<ScanOptions> options_ = std::make_shared<ScanOptions>(*options);
   options_->partition_expression = file->partition_expression();
   options_->dataset_schema = file->dataset_schema();
-  ScanTaskVector v{std::make_shared<RadosParquetScanTask>(
-      std::move(options_), std::move(file), file->source(), std::move(doa_))};
+
+  // Stat the file once for all of its scan tasks.
+  struct stat st {};
+  ARROW_RETURN_NOT_OK(doa_->Stat(file->source().path(), st));
+  ARROW_ASSIGN_OR_RAISE(auto requests,
+                        SplitScanRequests(*options_, file, st, metadata_cache()));
+
+  ScanTaskVector v;
+  v.reserve(requests.size());
+  for (auto& row_groups : requests) {
+    v.push_back(std::make_shared<RadosParquetScanTask>(
+        options_, file, doa_, st, std::move(row_groups), result_compression));
+  }
   return MakeVectorIterator(v);
 }
 
+Result<RecordBatchGenerator> RadosParquetFileFormat::ScanBatchesAsync(
+    const std::shared_ptr<ScanOptions>& options,
+    const std::shared_ptr<FileFragment>& file) const {
+  std::shared_ptr<ScanOptions> options_ = std::make_shared<ScanOptions>(*options);
+  options_->partition_expression = file->partition_expression();
+  options_->dataset_schema = file->dataset_schema();
+  auto doa = doa_;
+  auto plan_fut = PlanScanAsync(doa, metadata_cache(), options_, file);
+
+  auto compression = result_compression;
+  auto generator_fut = plan_fut.Then(
+      [doa, options_, compression](const ScanPlan& plan) -> RecordBatchGenerator {
+        // Issue all calls up front so that the row groups are scanned
+        // concurrently, but yield their batches in row group order.
+        std::vector<RecordBatchGenerator> generators;
+        generators.reserve(plan.requests.size());
+        for (const auto& row_groups : plan.requests) {
+          generators.push_back(
+              ExecScanAsync(doa, options_, plan.st, row_groups, compression));
+        }
+        return MakeConcatenatedGenerator(MakeVectorGenerator(std::move(generators)));
+      });
+  return MakeFromFuture(std::move(generator_fut));
+}
+
+Future<RecordBatchVector> RadosParquetFileFormat::AggregateFileAsync(
+    const std::shared_ptr<ScanOptions>& options,
+    const std::shared_ptr<FileFragment>& file,
+    const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys) const {
+  std::shared_ptr<ScanOptions> options_ = std::make_shared<ScanOptions>(*options);
+  options_->partition_expression = file->partition_expression();
+  options_->dataset_schema = file->dataset_schema();
+  auto doa = doa_;
+  auto plan_fut = PlanScanAsync(doa, metadata_cache(), options_, file);
+
+  auto compression = result_compression;
+  return plan_fut.Then([doa, options_, aggregates, keys,
+                        compression](const ScanPlan& plan) -> Future<RecordBatchVector> {
+    std::vector<Future<RecordBatchVector>> partials;
+    partials.reserve(plan.requests.size());
+    for (const auto& row_groups : plan.requests) {
+      auto scan_options = options_;
+      int64_t file_size = plan.st.st_size;
+      ceph::bufferlist request;
+      ARROW_RETURN_NOT_OK(SerializeScanRequest(scan_options, file_size, request,
+                                               row_groups, aggregates, keys,
+                                               compression));
+      auto result_fut = internal::GetCpuThreadPool()->Transfer(
+          doa->ExecAsync(plan.st.st_ino, "scan_op", std::move(request)));
+      partials.push_back(result_fut.Then(
+          [](const std::shared_ptr<ceph::bufferlist>& result)
+              -> Result<RecordBatchVector> {
+            ARROW_ASSIGN_OR_RAISE(auto batch_it,
+                                  DeserializeRecordBatches(result, /*use_threads=*/false));
+            return batch_it.ToVector();
+          }));
+    }
+
+    return All(std::move(partials))
+        .Then([](const std::vector<Result<RecordBatchVector>>& results)
+                  -> Result<RecordBatchVector> {
+          RecordBatchVector batches;
+          for (const auto& result : results) {
+            ARROW_ASSIGN_OR_RAISE(auto partial, result);
+            batches.insert(batches.end(), partial.begin(), partial.end());
+          }
+          return batches;
+        });
+  });
+}
+
 Status SerializeScanRequest(std::shared_ptr<ScanOptions>& options, int64_t& file_size,
-                            ceph::bufferlist& bl) {
+                            ceph::bufferlist& bl, const std::vector<int>& row_groups,
+                            const std::vector<PushdownAggregate>& aggregates,
+                            const std::vector<std::string>& keys,
+                            const std::string& compression) {
+  // Reject an invalid compression before it reaches the OSD.
+  ARROW_RETURN_NOT_OK(ParseResultCompression(compression).status());
   ARROW_ASSIGN_OR_RAISE(auto filter, compute::Serialize(options->filter));
   ARROW_ASSIGN_OR_RAISE(auto partition,
                         compute::Serialize(options->partition_expression));
@@ -123,10 +643,21 @@ Status SerializeScanRequest(std::shared_ptr<ScanOptions>& options, int64_t& file
       builder.CreateVector(projected_schema->data(), projected_schema->size());
   auto dataset_schema_vec =
       builder.CreateVector(dataset_schema->data(), dataset_schema->size());
+  auto row_groups_vec = builder.CreateVector(row_groups);
+  std::vector<flatbuffers::Offset<flatbuf::ScanAggregate>> aggregate_offsets;
+  aggregate_offsets.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    aggregate_offsets.push_back(flatbuf::CreateScanAggregateDirect(
+        builder, aggregate.function.c_str(), aggregate.target.c_str()));
+  }
+  auto aggregates_vec = builder.CreateVector(aggregate_offsets);
+  auto keys_vec = builder.CreateVectorOfStrings(keys);
+  auto compression_str = builder.CreateString(compression);
 
-  auto request =
-      flatbuf::CreateScanRequest(builder, file_size, options->file_format, filter_vec,
-                                 partition_vec, dataset_schema_vec, projected_schema_vec);
+  auto request = flatbuf::CreateScanRequest(
+      builder, file_size, options->file_format, filter_vec, partition_vec,
+      dataset_schema_vec, projected_schema_vec, row_groups_vec, aggregates_vec, keys_vec,
+      compression_str);
   builder.Finish(request);
   uint8_t* buf = builder.GetBufferPointer();
   int size = builder.GetSize();
@@ -138,7 +669,10 @@ Status SerializeScanRequest(std::shared_ptr<ScanOptions>& options, int64_t& file
 Status DeserializeScanRequest(compute::Expression* filter, compute::Expression* partition,
                               std::shared_ptr<Schema>* projected_schema,
                               std::shared_ptr<Schema>* dataset_schema, int64_t& file_size,
-                              int64_t& file_format, ceph::bufferlist& bl) {
+                              int64_t& file_format, ceph::bufferlist& bl,
+                              std::vector<int>* row_groups,
+                              std::vector<PushdownAggregate>* aggregates,
+                              std::vector<std::string>* keys, std::string* compression) {
   auto request = flatbuf::GetScanRequest((uint8_t*)bl.c_str());
 
   ARROW_ASSIGN_OR_RAISE(auto filter_,
@@ -167,46 +701,639 @@ Status DeserializeScanRequest(compute::Expression* filter, compute::Expression*
 
   file_size = request->file_size();
   file_format = request->file_format();
+
+  if (row_groups != nullptr) {
+    row_groups->clear();
+    if (request->row_groups() != nullptr) {
+      row_groups->assign(request->row_groups()->begin(), request->row_groups()->end());
+    }
+  }
+
+  if (aggregates != nullptr) {
+    aggregates->clear();
+    if (request->aggregates() != nullptr) {
+      for (const auto* aggregate : *request->aggregates()) {
+        if (aggregate->function() == nullptr || aggregate->target() == nullptr) {
+          return Status::Invalid("Incomplete aggregate in scan request");
+        }
+        aggregates->push_back({aggregate->function()->str(), aggregate->target()->str()});
+      }
+    }
+  }
+
+  if (keys != nullptr) {
+    keys->clear();
+    if (request->group_keys() != nullptr) {
+      for (const auto* key : *request->group_keys()) {
+        keys->push_back(key->str());
+      }
+    }
+  }
+
+  if (compression != nullptr) {
+    *compression = request->compression() != nullptr ? request->compression()->str() : "lz4";
+  }
   return Status::OK();
 }
 
-Status SerializeTable(std::shared_ptr<Table>& table, ceph::bufferlist& bl,
-                      bool aggressive) {
-  ARROW_ASSIGN_OR_RAISE(auto buffer_output_stream, io::BufferOutputStream::Create());
+namespace {
+
+/// The ZSTD level used in "auto" mode, favouring speed over ratio.
+constexpr int kAutoZstdLevel = 1;
+/// The number of bytes of a batch compressed to estimate its compressibility,
+/// and the most taken from any one buffer.
+constexpr int64_t kCompressionSampleSize = 64 * 1024;
+constexpr int64_t kCompressionSampleBufferSize = 8 * 1024;
+/// Batches whose sample does not shrink below this ratio are sent uncompressed.
+constexpr double kIncompressibleRatio = 0.9;
+/// Batches whose sample shrinks below this ratio are worth compressing harder.
+constexpr double kCompressibleRatio = 0.5;
+/// The load average per core above which the CPUs are considered busy.
+constexpr double kBusyCpuLoad = 0.8;
+
+/// Return the ratio of compressed to uncompressed size of a sample of the
+/// buffers of a batch.
+Result<double> SampleCompressionRatio(const RecordBatch& batch, util::Codec* codec,
+                                      MemoryPool* pool) {
+  ARROW_ASSIGN_OR_RAISE(
+      auto out, AllocateResizableBuffer(
+                    codec->MaxCompressedLen(kCompressionSampleBufferSize, nullptr), pool));
+
+  int64_t sampled = 0;
+  int64_t compressed = 0;
+  std::vector<const ArrayData*> pending;
+  for (const auto& column : batch.column_data()) pending.push_back(column.get());
+  while (!pending.empty() && sampled < kCompressionSampleSize) {
+    const ArrayData* data = pending.back();
+    pending.pop_back();
+    for (const auto& buffer : data->buffers) {
+      if (buffer == nullptr || buffer->size() == 0) continue;
+      int64_t length = std::min({buffer->size(), kCompressionSampleBufferSize,
+                                 kCompressionSampleSize - sampled});
+      if (length <= 0) break;
+      ARROW_ASSIGN_OR_RAISE(
+          auto compressed_length,
+          codec->Compress(length, buffer->data(), out->size(), out->mutable_data()));
+      sampled += length;
+      compressed += compressed_length;
+    }
+    for (const auto& child : data->child_data) pending.push_back(child.get());
+  }
+  return sampled == 0 ? 1.0 : static_cast<double>(compressed) / sampled;
+}
+
+/// Return the load average over the last minute per core.
+double CpuLoad() {
+  double load;
+  if (getloadavg(&load, 1) != 1) return 0;
+  return load / std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// \brief An IPC stream writer choosing the codec of each record batch, see
+/// SerializeScanResult.
+///
+/// IPC stream writers compress all batches with the same codec, so the messages
+/// are written one by one instead. The dictionaries of a stream are tied to the
+/// codec of its writer, so streams with dictionaries are compressed with the
+/// codec chosen for their first batch.
+class AdaptiveResultWriter : public ipc::RecordBatchWriter {
+ public:
+  static Result<std::shared_ptr<ipc::RecordBatchWriter>> Make(
+      std::shared_ptr<Schema> schema, ceph::bufferlist& bl) {
+    auto writer = std::shared_ptr<AdaptiveResultWriter>(new AdaptiveResultWriter());
+    writer->schema_ = std::move(schema);
+    writer->has_dictionaries_ = ipc::DictionaryFieldMapper(*writer->schema_).num_fields() > 0;
+    writer->pool_ = std::make_shared<BufferptrMemoryPool>();
+    writer->sink_ = std::make_shared<BufferlistOutputStream>(&bl, writer->pool_);
+    writer->options_ = ipc::IpcWriteOptions::Defaults();
+    writer->options_.memory_pool = writer->pool_.get();
+    ARROW_ASSIGN_OR_RAISE(writer->lz4_, util::Codec::Create(Compression::LZ4_FRAME));
+    ARROW_ASSIGN_OR_RAISE(writer->zstd_,
+                          util::Codec::Create(Compression::ZSTD, kAutoZstdLevel));
+    return writer;
+  }
+
+  Status WriteRecordBatch(const RecordBatch& batch) override {
+    if (!batch.schema()->Equals(*schema_, false /* check_metadata */)) {
+      return Status::Invalid("Tried to write record batch with different schema");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto codec, ChooseCodec(batch));
+
+    if (has_dictionaries_) {
+      if (dictionary_writer_ == nullptr) {
+        ARROW_RETURN_NOT_OK(OpenDictionaryWriter(std::move(codec)));
+      }
+      return dictionary_writer_->WriteRecordBatch(batch);
+    }
+
+    ARROW_RETURN_NOT_OK(Start());
+    auto options = options_;
+    options.codec = std::move(codec);
+    ipc::IpcPayload payload;
+    ARROW_RETURN_NOT_OK(ipc::GetRecordBatchPayload(batch, options, &payload));
+    ARROW_RETURN_NOT_OK(payload_writer_->WritePayload(payload));
+    ++stats_.num_messages;
+    ++stats_.num_record_batches;
+    return Status::OK();
+  }
+
+  Status Close() override {
+    if (has_dictionaries_) {
+      if (dictionary_writer_ == nullptr) {
+        ARROW_RETURN_NOT_OK(OpenDictionaryWriter(lz4_));
+      }
+      return dictionary_writer_->Close();
+    }
+    ARROW_RETURN_NOT_OK(Start());
+    return payload_writer_->Close();
+  }
+
+  ipc::WriteStats stats() const override {
+    return dictionary_writer_ != nullptr ? dictionary_writer_->stats() : stats_;
+  }
+
+ protected:
+  AdaptiveResultWriter() = default;
+
+  /// Write the schema message, if not written yet.
+  Status Start() {
+    if (payload_writer_ != nullptr) return Status::OK();
+    ARROW_ASSIGN_OR_RAISE(payload_writer_,
+                          ipc::internal::MakePayloadStreamWriter(sink_.get(), options_));
+    ipc::IpcPayload payload;
+    ARROW_RETURN_NOT_OK(ipc::GetSchemaPayload(
+        *schema_, options_, ipc::DictionaryFieldMapper(*schema_), &payload));
+    ARROW_RETURN_NOT_OK(payload_writer_->WritePayload(payload));
+    ++stats_.num_messages;
+    return Status::OK();
+  }
+
+  Status OpenDictionaryWriter(std::shared_ptr<util::Codec> codec) {
+    auto options = options_;
+    options.codec = std::move(codec);
+    ARROW_ASSIGN_OR_RAISE(dictionary_writer_,
+                          ipc::MakeStreamWriter(sink_, schema_, options));
+    return Status::OK();
+  }
+
+  /// Choose the codec of a batch, or null to send it uncompressed.
+  Result<std::shared_ptr<util::Codec>> ChooseCodec(const RecordBatch& batch) {
+    ARROW_ASSIGN_OR_RAISE(auto ratio,
+                          SampleCompressionRatio(batch, lz4_.get(), pool_.get()));
+    if (ratio >= kIncompressibleRatio) return nullptr;
+    if (CpuLoad() >= kBusyCpuLoad) {
+      // Only spend the scarce CPU on batches which shrink a lot.
+      return ratio < kCompressibleRatio ? lz4_ : nullptr;
+    }
+    return ratio < kCompressibleRatio ? zstd_ : lz4_;
+  }
+
+  std::shared_ptr<Schema> schema_;
+  bool has_dictionaries_ = false;
+  std::shared_ptr<BufferptrMemoryPool> pool_;
+  std::shared_ptr<BufferlistOutputStream> sink_;
+  ipc::IpcWriteOptions options_;
+  std::shared_ptr<util::Codec> lz4_;
+  std::shared_ptr<util::Codec> zstd_;
+  std::unique_ptr<ipc::internal::IpcPayloadWriter> payload_writer_;
+  std::shared_ptr<ipc::RecordBatchWriter> dictionary_writer_;
+  ipc::WriteStats stats_;
+};
+
+Result<std::shared_ptr<ipc::RecordBatchWriter>> MakeResultWriter(
+    const std::shared_ptr<Schema>& schema, ceph::bufferlist& bl,
+    const std::string& compression) {
+  ARROW_ASSIGN_OR_RAISE(auto result_compression, ParseResultCompression(compression));
+  if (result_compression.adaptive) {
+    return AdaptiveResultWriter::Make(schema, bl);
+  }
 
   ipc::IpcWriteOptions options = ipc::IpcWriteOptions::Defaults();
+  if (result_compression.codec != Compression::UNCOMPRESSED) {
+    ARROW_ASSIGN_OR_RAISE(options.codec, util::Codec::Create(result_compression.codec,
+                                                             result_compression.level));
+  }
 
-  Compression::type codec;
-  if (aggressive) {
-    codec = Compression::ZSTD;
-  } else {
-    codec = Compression::LZ4_FRAME;
+  // Allocate the compressed bodies as bufferptrs so that they are appended to
+  // the bufferlist without being copied.
+  auto pool = std::make_shared<BufferptrMemoryPool>();
+  options.memory_pool = pool.get();
+  return ipc::MakeStreamWriter(std::make_shared<BufferlistOutputStream>(&bl, pool),
+                               schema, options);
+}
+
+Result<std::shared_ptr<RecordBatchReader>> MakeResultReader(
+    std::shared_ptr<ceph::bufferlist> bl, bool use_threads) {
+  // Read straight from the bufferlist segments instead of flattening them into
+  // one contiguous copy.
+  auto file = std::make_shared<BufferlistRandomAccessFile>(std::move(bl));
+  auto options = ipc::IpcReadOptions::Defaults();
+  options.use_threads = use_threads;
+  return ipc::RecordBatchStreamReader::Open(file, options);
+}
+
+Status CheckPushdownAggregates(const std::vector<PushdownAggregate>& aggregates,
+                               const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    return Status::NotImplemented("Aggregation pushdown requires at least one key");
   }
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.function != "hash_count" && aggregate.function != "hash_sum" &&
+        aggregate.function != "hash_min_max") {
+      return Status::NotImplemented("Aggregate function ", aggregate.function,
+                                    " can't be pushed down");
+    }
+  }
+  return Status::OK();
+}
 
-  ARROW_ASSIGN_OR_RAISE(options.codec,
-                        util::Codec::Create(codec, std::numeric_limits<int>::min()));
-  ARROW_ASSIGN_OR_RAISE(
-      auto writer, ipc::MakeStreamWriter(buffer_output_stream, table->schema(), options));
+/// Return the name of the column holding an aggregate, e.g. "hash_sum(x)".
+std::string AggregateColumnName(const PushdownAggregate& aggregate) {
+  return aggregate.function + "(" + aggregate.target + ")";
+}
 
+Result<std::shared_ptr<StructArray>> GroupByColumns(
+    const std::vector<Datum>& arguments, const std::vector<Datum>& keys,
+    const std::vector<compute::internal::Aggregate>& functions) {
+  ARROW_ASSIGN_OR_RAISE(auto grouped, compute::internal::GroupBy(arguments, keys, functions));
+  return internal::checked_pointer_cast<StructArray>(grouped.make_array());
+}
+
+/// Computes hash aggregates one batch at a time, with one row per group, so that the
+/// rows aggregated never need to be held at once.
+class StreamingAggregator {
+ public:
+  static Result<std::unique_ptr<StreamingAggregator>> Make(
+      const Schema& schema, const std::vector<PushdownAggregate>& aggregates,
+      const std::vector<std::string>& keys) {
+    ARROW_RETURN_NOT_OK(CheckPushdownAggregates(aggregates, keys));
+    std::unique_ptr<StreamingAggregator> aggregator(new StreamingAggregator());
+
+    auto get_field_index = [&](const std::string& name) -> Result<int> {
+      int index = schema.GetFieldIndex(name);
+      if (index == -1) {
+        return Status::Invalid("No field named ", name, " to aggregate");
+      }
+      return index;
+    };
+
+    std::vector<ValueDescr> argument_descrs;
+    for (const auto& aggregate : aggregates) {
+      ARROW_ASSIGN_OR_RAISE(int index, get_field_index(aggregate.target));
+      aggregator->argument_indices_.push_back(index);
+      argument_descrs.push_back(ValueDescr::Array(schema.field(index)->type()));
+      aggregator->functions_.push_back({aggregate.function, /*options=*/nullptr});
+    }
+    std::vector<ValueDescr> key_descrs;
+    for (const auto& key : keys) {
+      ARROW_ASSIGN_OR_RAISE(int index, get_field_index(key));
+      aggregator->key_indices_.push_back(index);
+      key_descrs.push_back(ValueDescr::Array(schema.field(index)->type()));
+    }
+
+    compute::ExecContext* ctx = aggregator->ctx_;
+    ARROW_ASSIGN_OR_RAISE(
+        aggregator->kernels_,
+        compute::internal::GetKernels(ctx, aggregator->functions_, argument_descrs));
+    ARROW_ASSIGN_OR_RAISE(aggregator->states_,
+                          compute::internal::InitKernels(aggregator->kernels_, ctx,
+                                                         aggregator->functions_,
+                                                         argument_descrs));
+    ARROW_ASSIGN_OR_RAISE(
+        auto aggregate_fields,
+        compute::internal::ResolveKernels(aggregator->functions_, aggregator->kernels_,
+                                          aggregator->states_, ctx, argument_descrs));
+    ARROW_ASSIGN_OR_RAISE(aggregator->grouper_,
+                          compute::internal::Grouper::Make(key_descrs, ctx));
+
+    FieldVector fields;
+    for (size_t i = 0; i < aggregates.size(); ++i) {
+      fields.push_back(
+          field(AggregateColumnName(aggregates[i]), aggregate_fields[i]->type()));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      fields.push_back(field(keys[i], key_descrs[i].type));
+    }
+    aggregator->schema_ = arrow::schema(std::move(fields));
+    return std::move(aggregator);
+  }
+
+  /// Group the rows of a batch and update the aggregates of their groups.
+  Status Consume(const RecordBatch& batch) {
+    if (batch.num_rows() == 0) return Status::OK();
+
+    std::vector<Datum> key_columns;
+    for (int index : key_indices_) {
+      key_columns.emplace_back(batch.column(index));
+    }
+    ARROW_ASSIGN_OR_RAISE(auto key_batch, compute::ExecBatch::Make(key_columns));
+    ARROW_ASSIGN_OR_RAISE(Datum group_ids, grouper_->Consume(key_batch));
+
+    for (size_t i = 0; i < kernels_.size(); ++i) {
+      compute::KernelContext kernel_ctx{ctx_};
+      kernel_ctx.SetState(states_[i].get());
+      ARROW_ASSIGN_OR_RAISE(
+          auto argument_batch,
+          compute::ExecBatch::Make({batch.column(argument_indices_[i]), group_ids,
+                                    Datum(grouper_->num_groups())}));
+      ARROW_RETURN_NOT_OK(kernels_[i]->consume(&kernel_ctx, argument_batch));
+    }
+    return Status::OK();
+  }
+
+  /// Return the aggregates of every group seen, followed by the keys of the groups.
+  Result<std::shared_ptr<RecordBatch>> Finish() {
+    ArrayVector columns;
+    for (size_t i = 0; i < kernels_.size(); ++i) {
+      compute::KernelContext kernel_ctx{ctx_};
+      kernel_ctx.SetState(states_[i].get());
+      Datum aggregated;
+      ARROW_RETURN_NOT_OK(kernels_[i]->finalize(&kernel_ctx, &aggregated));
+      columns.push_back(aggregated.make_array());
+    }
+    ARROW_ASSIGN_OR_RAISE(auto uniques, grouper_->GetUniques());
+    for (const auto& key : uniques.values) {
+      columns.push_back(key.make_array());
+    }
+    return RecordBatch::Make(schema_, grouper_->num_groups(), std::move(columns));
+  }
+
+ private:
+  StreamingAggregator() = default;
+
+  compute::ExecContext* ctx_ = compute::default_exec_context();
+  std::vector<int> argument_indices_;
+  std::vector<int> key_indices_;
+  std::vector<compute::internal::Aggregate> functions_;
+  std::vector<const compute::HashAggregateKernel*> kernels_;
+  std::vector<std::unique_ptr<compute::KernelState>> states_;
+  std::unique_ptr<compute::internal::Grouper> grouper_;
+  std::shared_ptr<Schema> schema_;
+};
+
+/// Compute hash aggregates of a table, with one row per group.
+Result<std::shared_ptr<RecordBatch>> ComputeAggregates(
+    const Table& table, const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys) {
+  ARROW_ASSIGN_OR_RAISE(auto aggregator,
+                        StreamingAggregator::Make(*table.schema(), aggregates, keys));
+  TableBatchReader reader(table);
+  std::shared_ptr<RecordBatch> batch;
+  while (true) {
+    ARROW_RETURN_NOT_OK(reader.ReadNext(&batch));
+    if (batch == nullptr) break;
+    ARROW_RETURN_NOT_OK(aggregator->Consume(*batch));
+  }
+  return aggregator->Finish();
+}
+
+/// Return the chunks of a child of a struct column.
+Result<Datum> GetStructChild(const ChunkedArray& column, const std::string& name) {
+  ArrayVector chunks;
+  for (const auto& chunk : column.chunks()) {
+    auto child = internal::checked_cast<const StructArray&>(*chunk).GetFieldByName(name);
+    if (child == nullptr) {
+      return Status::Invalid("Partial aggregate has no field named ", name);
+    }
+    chunks.push_back(std::move(child));
+  }
+  auto type = internal::checked_cast<const StructType&>(*column.type())
+                  .GetFieldByName(name)
+                  ->type();
+  return Datum(std::make_shared<ChunkedArray>(std::move(chunks), std::move(type)));
+}
+
+}  // namespace
+
+Status SerializeTable(std::shared_ptr<Table>& table, ceph::bufferlist& bl,
+                      const std::string& compression) {
+  ARROW_ASSIGN_OR_RAISE(auto writer, MakeResultWriter(table->schema(), bl, compression));
   ARROW_RETURN_NOT_OK(writer->WriteTable(*table));
-  ARROW_RETURN_NOT_OK(writer->Close());
+  return writer->Close();
+}
 
-  ARROW_ASSIGN_OR_RAISE(auto buffer, buffer_output_stream->Finish());
-  bl.append((char*)buffer->data(), buffer->size());
-  return Status::OK();
+Status SerializeScanResult(const std::shared_ptr<Scanner>& scanner, ceph::bufferlist& bl,
+                           const std::string& compression) {
+  ARROW_ASSIGN_OR_RAISE(
+      auto writer,
+      MakeResultWriter(scanner->options()->projected_schema, bl, compression));
+
+  // The visitor may be invoked from several threads if the scanner uses threads.
+  std::mutex writer_mutex;
+  ARROW_RETURN_NOT_OK(scanner->Scan([&](TaggedRecordBatch batch) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return writer->WriteRecordBatch(*batch.record_batch);
+  }));
+  return writer->Close();
+}
+
+Status SerializeAggregateResult(const std::shared_ptr<Scanner>& scanner,
+                                const std::vector<PushdownAggregate>& aggregates,
+                                const std::vector<std::string>& keys,
+                                ceph::bufferlist& bl, const std::string& compression) {
+  // Each batch is aggregated as it is scanned, so only the groups are held in memory
+  ARROW_ASSIGN_OR_RAISE(
+      auto aggregator,
+      StreamingAggregator::Make(*scanner->options()->projected_schema, aggregates, keys));
+  ARROW_ASSIGN_OR_RAISE(auto batches, scanner->ScanBatches());
+  while (true) {
+    ARROW_ASSIGN_OR_RAISE(auto batch, batches.Next());
+    if (IsIterationEnd(batch)) break;
+    ARROW_RETURN_NOT_OK(aggregator->Consume(*batch.record_batch));
+  }
+  ARROW_ASSIGN_OR_RAISE(auto batch, aggregator->Finish());
+
+  ARROW_ASSIGN_OR_RAISE(auto writer, MakeResultWriter(batch->schema(), bl, compression));
+  ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
+  return writer->Close();
+}
+
+Status ScanObject(const std::shared_ptr<io::RandomAccessFile>& file,
+                  const compute::Expression& filter,
+                  const compute::Expression& partition_expression,
+                  const std::shared_ptr<Schema>& projected_schema,
+                  const std::shared_ptr<Schema>& dataset_schema, int64_t file_format,
+                  const std::vector<int>& row_groups,
+                  const std::vector<PushdownAggregate>& aggregates,
+                  const std::vector<std::string>& keys, const std::string& compression,
+                  ceph::bufferlist& result) {
+  std::shared_ptr<FileFragment> fragment;
+  auto options = std::make_shared<ScanOptions>();
+  if (file_format == 0) {
+    auto format = std::make_shared<ParquetFileFormat>();
+
+    // Coalesce the many small column chunk reads into a few large object reads.
+    auto fragment_scan_options = std::make_shared<ParquetFragmentScanOptions>();
+    fragment_scan_options->arrow_reader_properties->set_pre_buffer(true);
+    options->fragment_scan_options = fragment_scan_options;
+
+    // Only read the requested row groups, if any; an empty list means all of them.
+    if (row_groups.empty()) {
+      ARROW_ASSIGN_OR_RAISE(fragment,
+                            format->MakeFragment(FileSource(file), partition_expression));
+    } else {
+      ARROW_ASSIGN_OR_RAISE(fragment,
+                            format->MakeFragment(FileSource(file), partition_expression,
+                                                 nullptr, row_groups));
+    }
+  } else if (file_format == 1) {
+    auto format = std::make_shared<IpcFileFormat>();
+    ARROW_ASSIGN_OR_RAISE(
+        fragment, format->MakeFragment(FileSource(file, Compression::LZ4_FRAME),
+                                       partition_expression));
+  } else {
+    return Status::Invalid("Invalid file format");
+  }
+
+  ScannerBuilder builder(dataset_schema, fragment, options);
+  ARROW_RETURN_NOT_OK(builder.Filter(filter));
+  ARROW_RETURN_NOT_OK(builder.Project(projected_schema->field_names()));
+  ARROW_RETURN_NOT_OK(builder.UseThreads(false));
+  ARROW_ASSIGN_OR_RAISE(auto scanner, builder.Finish());
+
+  if (aggregates.empty()) {
+    return SerializeScanResult(scanner, result, compression);
+  }
+  return SerializeAggregateResult(scanner, aggregates, keys, result, compression);
+}
+
+Result<std::shared_ptr<RecordBatch>> MergePartialAggregates(
+    const RecordBatchVector& partials, const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys) {
+  ARROW_RETURN_NOT_OK(CheckPushdownAggregates(aggregates, keys));
+  if (partials.empty()) {
+    return Status::Invalid("No partial aggregates to merge");
+  }
+  ARROW_ASSIGN_OR_RAISE(auto table, Table::FromRecordBatches(partials));
+  if (static_cast<size_t>(table->num_columns()) != aggregates.size() + keys.size()) {
+    return Status::Invalid("Partial aggregates have ", table->num_columns(),
+                           " columns, expected ", aggregates.size() + keys.size());
+  }
+
+  // Counts and sums are merged by summing them. Minimums and maximums are merged
+  // separately, by taking the minimum of the minimums and the maximum of the
+  // maximums.
+  std::vector<Datum> arguments;
+  std::vector<compute::internal::Aggregate> functions;
+  for (size_t i = 0; i < aggregates.size(); ++i) {
+    const auto& column = table->column(static_cast<int>(i));
+    if (aggregates[i].function == "hash_min_max") {
+      ARROW_ASSIGN_OR_RAISE(auto mins, GetStructChild(*column, "min"));
+      ARROW_ASSIGN_OR_RAISE(auto maxes, GetStructChild(*column, "max"));
+      arguments.push_back(std::move(mins));
+      arguments.push_back(std::move(maxes));
+      functions.push_back({"hash_min_max", /*options=*/nullptr});
+      functions.push_back({"hash_min_max", /*options=*/nullptr});
+    } else {
+      arguments.emplace_back(column);
+      functions.push_back({"hash_sum", /*options=*/nullptr});
+    }
+  }
+  std::vector<Datum> key_columns;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    key_columns.emplace_back(table->column(static_cast<int>(aggregates.size() + i)));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(auto grouped, GroupByColumns(arguments, key_columns, functions));
+
+  ArrayVector columns;
+  int field_index = 0;
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.function == "hash_min_max") {
+      const auto& mins = internal::checked_cast<const StructArray&>(
+          *grouped->field(field_index++));
+      const auto& maxes = internal::checked_cast<const StructArray&>(
+          *grouped->field(field_index++));
+      ARROW_ASSIGN_OR_RAISE(
+          auto min_max,
+          StructArray::Make({mins.GetFieldByName("min"), maxes.GetFieldByName("max")},
+                            std::vector<std::string>{"min", "max"}));
+      columns.push_back(std::move(min_max));
+    } else {
+      columns.push_back(grouped->field(field_index++));
+    }
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    columns.push_back(grouped->field(field_index++));
+  }
+  return RecordBatch::Make(table->schema(), grouped->length(), std::move(columns));
+}
+
+Result<std::shared_ptr<Table>> AggregateDataset(
+    const std::shared_ptr<Dataset>& dataset, compute::Expression filter,
+    const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys) {
+  ARROW_RETURN_NOT_OK(CheckPushdownAggregates(aggregates, keys));
+
+  // Only scan the aggregated fields and the keys.
+  std::vector<std::string> columns;
+  auto add_column = [&](const std::string& name) {
+    if (std::find(columns.begin(), columns.end(), name) == columns.end()) {
+      columns.push_back(name);
+    }
+  };
+  for (const auto& aggregate : aggregates) add_column(aggregate.target);
+  for (const auto& key : keys) add_column(key);
+
+  ScannerBuilder builder(dataset);
+  ARROW_RETURN_NOT_OK(builder.Filter(std::move(filter)));
+  ARROW_RETURN_NOT_OK(builder.Project(columns));
+  ARROW_ASSIGN_OR_RAISE(auto scanner, builder.Finish());
+  const auto& options = scanner->options();
+
+  // Issue the calls for all the fragments before waiting for any of them.
+  ARROW_ASSIGN_OR_RAISE(auto fragments, dataset->GetFragments(options->filter));
+  std::vector<Future<RecordBatchVector>> partial_futs;
+  for (auto maybe_fragment : fragments) {
+    ARROW_ASSIGN_OR_RAISE(auto fragment, maybe_fragment);
+    auto file = std::dynamic_pointer_cast<FileFragment>(fragment);
+    auto format = file == nullptr ? nullptr
+                                  : std::dynamic_pointer_cast<RadosParquetFileFormat>(
+                                        file->format());
+    if (format == nullptr) {
+      return Status::NotImplemented("Aggregation pushdown requires ",
+                                    "RadosParquetFileFormat fragments, got ",
+                                    fragment->type_name());
+    }
+    partial_futs.push_back(format->AggregateFileAsync(options, file, aggregates, keys));
+  }
+
+  RecordBatchVector partials;
+  for (auto& partial_fut : partial_futs) {
+    ARROW_ASSIGN_OR_RAISE(auto batches, partial_fut.result());
+    partials.insert(partials.end(), batches.begin(), batches.end());
+  }
+  if (partials.empty()) {
+    // Aggregate an empty table to get an empty result of the right schema.
+    ArrayVector empty_columns;
+    for (const auto& field : options->projected_schema->fields()) {
+      ARROW_ASSIGN_OR_RAISE(auto empty_column, MakeArrayOfNull(field->type(), 0));
+      empty_columns.push_back(std::move(empty_column));
+    }
+    auto empty = Table::Make(options->projected_schema, empty_columns);
+    ARROW_ASSIGN_OR_RAISE(auto batch, ComputeAggregates(*empty, aggregates, keys));
+    partials.push_back(std::move(batch));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(auto merged, MergePartialAggregates(partials, aggregates, keys));
+  return Table::FromRecordBatches({std::move(merged)});
 }
 
 Status DeserializeTable(RecordBatchVector& batches, ceph::bufferlist& bl,
                         bool use_threads) {
-  auto buffer = std::make_shared<Buffer>((uint8_t*)bl.c_str(), bl.length());
-  auto buffer_reader = std::make_shared<io::BufferReader>(buffer);
-  auto options = ipc::IpcReadOptions::Defaults();
-  options.use_threads = use_threads;
+  // Copying a bufferlist only copies references to its segments.
   ARROW_ASSIGN_OR_RAISE(
-      auto reader, arrow::ipc::RecordBatchStreamReader::Open(buffer_reader, options));
+      auto reader, MakeResultReader(std::make_shared<ceph::bufferlist>(bl), use_threads));
   ARROW_RETURN_NOT_OK(reader->ReadAll(&batches));
   return Status::OK();
 }
 
+Result<RecordBatchIterator> DeserializeRecordBatches(std::shared_ptr<ceph::bufferlist> bl,
+                                                     bool use_threads) {
+  ARROW_ASSIGN_OR_RAISE(auto reader, MakeResultReader(std::move(bl), use_threads));
+  return MakeFunctionIterator(
+      [reader]() -> Result<std::shared_ptr<RecordBatch>> { return reader->Next(); });
+}
+
 }  // namespace dataset
 }  // namespace arrow
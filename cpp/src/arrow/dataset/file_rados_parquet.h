@@ -24,6 +24,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -46,6 +48,7 @@
 #include "arrow/filesystem/path_util.h"
 #include "arrow/io/api.h"
 #include "arrow/ipc/api.h"
+#include "arrow/util/future.h"
 #include "arrow/util/iterator.h"
 #include "arrow/util/macros.h"
 #include "parquet/arrow/writer.h"
@@ -67,6 +70,49 @@ namespace dataset {
 ///
 /// @{
 
+/// \brief An aggregate computed by the OSDs for each group of a scan result.
+struct ARROW_DS_EXPORT PushdownAggregate {
+  /// The hash aggregate function: "hash_count", "hash_sum" or "hash_min_max".
+  std::string function;
+  /// The name of the field to aggregate.
+  std::string target;
+};
+
+/// \class RadosFileMetadataCache
+/// \brief A bounded, thread-safe cache of the metadata of the Parquet files
+/// scanned through RADOS, keyed by inode and modification time.
+///
+/// Each entry holds the size of a file and a ParquetFileFragment over all of its
+/// row groups whose footer has been read. The fragment also memoizes the row
+/// group statistics expressions used to prune row groups, so repeated scans of
+/// an unmodified file need neither a footer read nor statistics conversion. The
+/// least recently used entries are evicted once the capacity is reached.
+class ARROW_DS_EXPORT RadosFileMetadataCache {
+ public:
+  explicit RadosFileMetadataCache(int32_t capacity);
+
+  ~RadosFileMetadataCache();
+
+  /// \brief Return the cached fragment of a file.
+  /// \param[in] st The result of stat on the file.
+  /// \return The cached fragment, or null if the file is not cached or has been
+  /// modified since it was cached.
+  std::shared_ptr<ParquetFileFragment> Get(const struct stat& st);
+
+  /// \brief Cache the fragment of a file.
+  /// \param[in] st The result of stat on the file.
+  /// \param[in] fragment A fragment over all the row groups of the file, with
+  /// its metadata loaded.
+  void Put(const struct stat& st, std::shared_ptr<ParquetFileFragment> fragment);
+
+  /// \brief Return the number of cached files.
+  int32_t size();
+
+ protected:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 namespace connection {
 /// \brief An interface for general connections.
 class ARROW_DS_EXPORT Connection {
@@ -77,78 +123,121 @@ class ARROW_DS_EXPORT Connection {
   virtual ~Connection() = default;
 };
 
+/// \brief A Rados client instance and an IoCtx on the data pool, along with
+/// counters of the operations issued through them.
+struct ARROW_DS_EXPORT RadosHandle {
+  RadosHandle() : rados(new RadosWrapper()), ioCtx(new IoCtxWrapper()) {}
+
+  RadosHandle(std::unique_ptr<RadosInterface> rados,
+              std::unique_ptr<IoCtxInterface> ioCtx)
+      : rados(std::move(rados)), ioCtx(std::move(ioCtx)) {}
+
+  std::unique_ptr<RadosInterface> rados;
+  std::unique_ptr<IoCtxInterface> ioCtx;
+  /// The number of operations currently in flight on this handle.
+  std::atomic<int64_t> outstanding_ops{0};
+  /// The number of operations issued on this handle so far.
+  std::atomic<int64_t> total_ops{0};
+};
+
+/// \brief A snapshot of the operation counters of a RadosHandle.
+struct ARROW_DS_EXPORT RadosHandleStats {
+  int64_t outstanding_ops;
+  int64_t total_ops;
+};
+
 /// \class RadosConnection
 /// \brief An interface to connect to a Rados cluster and hold the connection
 /// information for usage in later stages.
+///
+/// A single librados client saturates well below the bandwidth of a fast
+/// network, so the connection holds a pool of handles, each with its own Rados
+/// client instance, and spreads the operations over them.
 class ARROW_DS_EXPORT RadosConnection : public Connection {
  public:
+  /// \brief How the handle of each operation is chosen.
+  enum class HandleSelection {
+    /// Cycle through the handles.
+    kRoundRobin,
+    /// Pick the handle with the fewest operations in flight.
+    kLeastOutstandingOps,
+  };
+
+  static constexpr int64_t kDefaultMaxOutstandingOps = 256;
+  static constexpr int32_t kDefaultMetadataCacheCapacity = 65536;
+  static constexpr int32_t kDefaultNumHandles = 1;
+
   struct RadosConnectionCtx {
     std::string ceph_config_path;
     std::string data_pool;
     std::string user_name;
     std::string cluster_name;
     std::string cls_name;
+    /// The maximum number of asynchronous CLS calls in flight at once. Calls
+    /// issued beyond this limit are queued until an earlier call completes.
+    int64_t max_outstanding_ops;
+    /// The maximum number of files whose metadata is cached by the connection.
+    int32_t metadata_cache_capacity;
+    /// The number of Rados client instances to spread the operations over.
+    int32_t num_handles;
+    /// How the handle of each operation is chosen.
+    HandleSelection handle_selection;
 
     RadosConnectionCtx(const std::string& ceph_config_path, const std::string& data_pool,
                        const std::string& user_name, const std::string& cluster_name,
-                       const std::string& cls_name)
+                       const std::string& cls_name,
+                       int64_t max_outstanding_ops = kDefaultMaxOutstandingOps,
+                       int32_t metadata_cache_capacity = kDefaultMetadataCacheCapacity,
+                       int32_t num_handles = kDefaultNumHandles,
+                       HandleSelection handle_selection = HandleSelection::kRoundRobin)
         : ceph_config_path(ceph_config_path),
           data_pool(data_pool),
           user_name(user_name),
           cluster_name(cluster_name),
-          cls_name(cls_name) {}
+          cls_name(cls_name),
+          max_outstanding_ops(max_outstanding_ops),
+          metadata_cache_capacity(metadata_cache_capacity),
+          num_handles(num_handles),
+          handle_selection(handle_selection) {}
   };
-  explicit RadosConnection(const RadosConnectionCtx& ctx)
-      : Connection(),
-        ctx(ctx),
-        rados(new RadosWrapper()),
-        ioCtx(new IoCtxWrapper()),
-        connected(false) {}
 
-  ~RadosConnection() override { shutdown(); }
+  /// \brief Create a connection with ctx.num_handles handles, and at least one.
+  explicit RadosConnection(const RadosConnectionCtx& ctx);
 
-  /// \brief Connect to the Rados cluster.
-  /// \return Status.
-  Status connect() override {
-    if (connected) {
-      return Status::OK();
-    }
+  /// \brief Create a connection over the given handles, which must not be
+  /// empty. Their number overrides ctx.num_handles.
+  RadosConnection(const RadosConnectionCtx& ctx,
+                  std::vector<std::unique_ptr<RadosHandle>> handles);
 
-    // Locks the mutex. Only one thread can pass here at a time.
-    // Another thread handled the connection already.
-    std::unique_lock<std::mutex> lock(connection_mutex);
-    if (connected) {
-      return Status::OK();
-    }
-    connected = true;
-
-    if (rados->init2(ctx.user_name.c_str(), ctx.cluster_name.c_str(), 0))
-      return Status::Invalid("librados::init2 returned non-zero exit code.");
+  ~RadosConnection() override { shutdown(); }
 
-    if (rados->conf_read_file(ctx.ceph_config_path.c_str()))
-      return Status::Invalid("librados::conf_read_file returned non-zero exit code.");
+  /// \brief Connect all the handles to the Rados cluster.
+  /// \return Status.
+  Status connect() override;
 
-    if (rados->connect())
-      return Status::Invalid("librados::connect returned non-zero exit code.");
+  /// \brief Shutdown the connection to the Rados cluster.
+  /// \return Status.
+  Status shutdown();
 
-    if (rados->ioctx_create(ctx.data_pool.c_str(), ioCtx))
-      return Status::Invalid("librados::ioctx_create returned non-zero exit code.");
+  /// \brief Choose the handle to issue an operation on and count the operation
+  /// as in flight on it. Every call must be paired with ReleaseHandle.
+  RadosHandle* AcquireHandle();
 
-    return Status::OK();
-  }
+  /// \brief Count an operation issued by AcquireHandle as finished.
+  void ReleaseHandle(RadosHandle* handle) { --handle->outstanding_ops; }
 
-  /// \brief Shutdown the connection to the Rados cluster.
-  /// \return Status.
-  Status shutdown() {
-    rados->shutdown();
-    return Status::OK();
-  }
+  /// \brief Return the operation counters of each handle.
+  std::vector<RadosHandleStats> handle_stats() const;
 
   RadosConnectionCtx ctx;
-  RadosInterface* rados;
-  IoCtxInterface* ioCtx;
+  std::vector<std::unique_ptr<RadosHandle>> handles;
   bool connected;
   std::mutex connection_mutex;
+  /// The file metadata cache shared by all the formats using this connection.
+  std::shared_ptr<RadosFileMetadataCache> metadata_cache;
+
+ protected:
+  std::atomic<uint64_t> next_handle_{0};
 };
 }  // namespace connection
 
@@ -156,11 +245,18 @@ class ARROW_DS_EXPORT RadosConnection : public Connection {
 /// \brief Interface for translating the name of a file in CephFS to its
 /// corresponding object ID in RADOS assuming 1:1 mapping between a file
 /// and its underlying object.
-class ARROW_DS_EXPORT DirectObjectAccess {
+class ARROW_DS_EXPORT DirectObjectAccess
+    : public std::enable_shared_from_this<DirectObjectAccess> {
  public:
   explicit DirectObjectAccess(
-      const std::shared_ptr<connection::RadosConnection>& connection)
-      : connection_(std::move(connection)) {}
+      const std::shared_ptr<connection::RadosConnection>& connection);
+
+  ~DirectObjectAccess();
+
+  /// \brief Return the connection used to execute queries.
+  const std::shared_ptr<connection::RadosConnection>& connection() const {
+    return connection_;
+  }
 
   /// \brief Executes the POSIX stat call on a file.
   /// \param[in] path Path of the file.
@@ -176,7 +272,7 @@ class ARROW_DS_EXPORT DirectObjectAccess {
 
   // Helper function to convert Inode to ObjectID because Rados calls work with
   // ObjectIDs.
-  std::string ConvertFileInodeToObjectID(uint64_t inode) {
+  static std::string ConvertFileInodeToObjectID(uint64_t inode) {
     std::stringstream ss;
     ss << std::hex << inode;
     std::string oid(ss.str() + ".00000000");
@@ -193,16 +289,60 @@ class ARROW_DS_EXPORT DirectObjectAccess {
   Status Exec(uint64_t inode, const std::string& fn, ceph::bufferlist& in,
               ceph::bufferlist& out) {
     std::string oid = ConvertFileInodeToObjectID(inode);
-    int e = connection_->ioCtx->exec(oid.c_str(), connection_->ctx.cls_name.c_str(),
-                                     fn.c_str(), in, out);
+    auto handle = connection_->AcquireHandle();
+    int e = handle->ioCtx->exec(oid.c_str(), connection_->ctx.cls_name.c_str(),
+                                fn.c_str(), in, out);
+    connection_->ReleaseHandle(handle);
+    return ExecStatus(e);
+  }
+
+  /// \brief Executes query on the librados node without blocking the calling
+  /// thread. It uses the librados::aio_exec API and the returned future is
+  /// completed from the IoCtxInterface::aio_exec callback, so continuations
+  /// should be transferred to another executor before doing any heavy work.
+  ///
+  /// At most ctx.max_outstanding_ops calls issued through this object are in
+  /// flight at once; any further calls are queued and issued as earlier ones
+  /// complete.
+  /// \param[in] inode inode of the file.
+  /// \param[in] fn The function to be executed by the librados::aio_exec call.
+  /// \param[in] in The input bufferlist.
+  /// \return A future of the output bufferlist.
+  Future<std::shared_ptr<ceph::bufferlist>> ExecAsync(uint64_t inode,
+                                                      const std::string& fn,
+                                                      ceph::bufferlist in);
+
+  /// \brief Return the number of asynchronous calls currently in flight.
+  int64_t outstanding_ops() {
+    std::lock_guard<std::mutex> lock(throttle_mutex_);
+    return outstanding_ops_;
+  }
+
+  /// \brief Convert the return code of a CLS function to a Status.
+  static Status ExecStatus(int e) {
     if (e == SCAN_ERR_CODE) return Status::Invalid(SCAN_ERR_MSG);
     if (e == SCAN_REQ_DESER_ERR_CODE) return Status::Invalid(SCAN_REQ_DESER_ERR_MSG);
     if (e == SCAN_RES_SER_ERR_CODE) return Status::Invalid(SCAN_RES_SER_ERR_MSG);
+    if (e < 0) return Status::IOError("librados::exec returned error code ", e);
     return Status::OK();
   }
 
  protected:
+  struct AioExecState;
+
+  static void OnExecComplete(AioExecState* state, int e);
+
+  /// Issue a queued call, or release its slot if the call failed to be issued.
+  void IssueExec(std::unique_ptr<AioExecState> state);
+
+  /// Release an in-flight slot and issue the next queued call, if any.
+  void FinishExec();
+
   std::shared_ptr<connection::RadosConnection> connection_;
+
+  std::mutex throttle_mutex_;
+  int64_t outstanding_ops_ = 0;
+  std::deque<std::unique_ptr<AioExecState>> pending_ops_;
 };
 
 /// \class RadosParquetFileFormat
@@ -230,12 +370,17 @@ class ARROW_DS_EXPORT RadosParquetFileFormat : public ParquetFileFormat {
 
   Result<bool> IsSupported(const FileSource& source) const override { return true; }
 
-  /// \brief Return the schema of the file fragment.
+  /// \brief Return the schema of the file fragment. The footer of the file is
+  /// only read if it is not in the metadata cache of the connection.
   /// \param[in] source The source of the file fragment.
   /// \return The schema of the file fragment.
   Result<std::shared_ptr<Schema>> Inspect(const FileSource& source) const override;
 
   /// \brief Scan a file fragment.
+  ///
+  /// Parquet files are split into one scan task per row group, each scanned by
+  /// a separate scan_op call. Row groups whose statistics cannot satisfy the
+  /// filter are skipped without contacting the OSD.
   /// \param[in] options Options to pass.
   /// \param[in] file The file fragment.
   /// \return The scanned file fragment.
@@ -243,6 +388,33 @@ class ARROW_DS_EXPORT RadosParquetFileFormat : public ParquetFileFormat {
       const std::shared_ptr<ScanOptions>& options,
       const std::shared_ptr<FileFragment>& file) const override;
 
+  /// \brief Scan a file fragment asynchronously.
+  ///
+  /// The scan request is issued with DirectObjectAccess::ExecAsync so that no
+  /// thread is blocked while the OSD scans the object, allowing many objects to
+  /// be scanned concurrently from a small number of threads. Like ScanFile, the
+  /// row groups of a Parquet file are scanned by separate, concurrent calls.
+  /// \param[in] options Options to pass.
+  /// \param[in] file The file fragment.
+  /// \return A generator of the scanned record batches.
+  Result<RecordBatchGenerator> ScanBatchesAsync(
+      const std::shared_ptr<ScanOptions>& options,
+      const std::shared_ptr<FileFragment>& file) const override;
+
+  /// \brief Compute partial aggregates of a file fragment on its OSD.
+  /// \param[in] options Options to pass. The projected schema must contain the
+  /// aggregated fields and the keys.
+  /// \param[in] file The file fragment.
+  /// \param[in] aggregates The aggregates to compute.
+  /// \param[in] keys The names of the fields to group by.
+  /// \return A future of the partial aggregates of the fragment, as record
+  /// batches with one column per aggregate followed by the key columns.
+  Future<RecordBatchVector> AggregateFileAsync(
+      const std::shared_ptr<ScanOptions>& options,
+      const std::shared_ptr<FileFragment>& file,
+      const std::vector<PushdownAggregate>& aggregates,
+      const std::vector<std::string>& keys) const;
+
   Result<std::shared_ptr<FileWriter>> MakeWriter(
       std::shared_ptr<io::OutputStream> destination, std::shared_ptr<Schema> schema,
       std::shared_ptr<FileWriteOptions> options) const {
@@ -251,7 +423,14 @@ class ARROW_DS_EXPORT RadosParquetFileFormat : public ParquetFileFormat {
 
   std::shared_ptr<FileWriteOptions> DefaultWriteOptions() override { return NULLPTR; }
 
+  /// The compression the OSDs should apply to the scan results they send back:
+  /// "none", "lz4", "zstd", "zstd:<level>" or "auto". See SerializeScanResult.
+  std::string result_compression = "lz4";
+
  protected:
+  /// Return the metadata cache of the connection, or null if there is none.
+  std::shared_ptr<RadosFileMetadataCache> metadata_cache() const;
+
   std::shared_ptr<DirectObjectAccess> doa_;
 };
 
@@ -259,9 +438,18 @@ class ARROW_DS_EXPORT RadosParquetFileFormat : public ParquetFileFormat {
 /// \param[in] options The scan options to use to build a ScanRequest.
 /// \param[in] file_size The size of the file fragment.
 /// \param[out] bl Output bufferlist.
+/// \param[in] row_groups The row groups to scan, or empty to scan the whole file.
+/// \param[in] aggregates The partial aggregates to compute, or empty to return
+/// the scanned rows.
+/// \param[in] keys The names of the fields to group the aggregates by.
+/// \param[in] compression The compression of the scan result, see
+/// SerializeScanResult.
 /// \return Status.
-ARROW_DS_EXPORT Status SerializeScanRequest(std::shared_ptr<ScanOptions>& options,
-                                            int64_t& file_size, ceph::bufferlist& bl);
+ARROW_DS_EXPORT Status SerializeScanRequest(
+    std::shared_ptr<ScanOptions>& options, int64_t& file_size, ceph::bufferlist& bl,
+    const std::vector<int>& row_groups = {},
+    const std::vector<PushdownAggregate>& aggregates = {},
+    const std::vector<std::string>& keys = {}, const std::string& compression = "lz4");
 
 /// \brief Deserialize scan request from bufferlist.
 /// \param[out] filter The filter expression to apply.
@@ -271,21 +459,110 @@ ARROW_DS_EXPORT Status SerializeScanRequest(std::shared_ptr<ScanOptions>& option
 /// \param[out] file_size The size of the file.
 /// \param[out] file_format The file format to use.
 /// \param[in] bl Input Ceph bufferlist.
+/// \param[out] row_groups The row groups to scan, empty if the whole file is to
+/// be scanned.
+/// \param[out] aggregates The partial aggregates to compute, empty if the
+/// scanned rows are to be returned.
+/// \param[out] keys The names of the fields to group the aggregates by.
+/// \param[out] compression The compression of the scan result.
 /// \return Status.
-ARROW_DS_EXPORT Status DeserializeScanRequest(compute::Expression* filter,
-                                              compute::Expression* partition,
-                                              std::shared_ptr<Schema>* projected_schema,
-                                              std::shared_ptr<Schema>* dataset_schema,
-                                              int64_t& file_size, int64_t& file_format,
-                                              ceph::bufferlist& bl);
+ARROW_DS_EXPORT Status DeserializeScanRequest(
+    compute::Expression* filter, compute::Expression* partition,
+    std::shared_ptr<Schema>* projected_schema, std::shared_ptr<Schema>* dataset_schema,
+    int64_t& file_size, int64_t& file_format, ceph::bufferlist& bl,
+    std::vector<int>* row_groups = NULLPTR,
+    std::vector<PushdownAggregate>* aggregates = NULLPTR,
+    std::vector<std::string>* keys = NULLPTR, std::string* compression = NULLPTR);
 
 /// \brief Serialize the result Table to a bufferlist.
 /// \param[in] table The table to serialize.
-/// \param[in] aggressive If true, use ZSTD compression instead of LZ4.
 /// \param[out] bl Output bufferlist.
+/// \param[in] compression The compression to use, see SerializeScanResult.
 /// \return Status.
 ARROW_DS_EXPORT Status SerializeTable(std::shared_ptr<Table>& table, ceph::bufferlist& bl,
-                                      bool aggressive = false);
+                                      const std::string& compression = "lz4");
+
+/// \brief Scan a Scanner and serialize the resulting record batches to a
+/// bufferlist as an IPC stream. Each batch is written out as soon as it is
+/// produced, so the full result is never materialized as a Table.
+///
+/// The compression is one of "none", "lz4", "zstd", "zstd:<level>" or "auto". In
+/// "auto" mode, the codec of each batch is chosen from how well a sample of the
+/// batch compresses and how loaded the CPUs are: incompressible batches and
+/// batches produced while the CPUs are busy are sent uncompressed or with LZ4,
+/// and compressible batches produced while the CPUs are idle are compressed with
+/// ZSTD. The codec of every batch is recorded in its IPC message, so the result
+/// is read the same way whatever the codecs used.
+/// \param[in] scanner The scanner to consume.
+/// \param[out] bl Output bufferlist.
+/// \param[in] compression The compression to use.
+/// \return Status.
+ARROW_DS_EXPORT Status SerializeScanResult(const std::shared_ptr<Scanner>& scanner,
+                                           ceph::bufferlist& bl,
+                                           const std::string& compression = "lz4");
+
+/// \brief Scan a Scanner, compute hash aggregates of the result and serialize
+/// them to a bufferlist as an IPC stream with one row per group.
+/// \param[in] scanner The scanner to consume.
+/// \param[in] aggregates The aggregates to compute.
+/// \param[in] keys The names of the fields to group by.
+/// \param[out] bl Output bufferlist.
+/// \param[in] compression The compression to use, see SerializeScanResult.
+/// \return Status.
+ARROW_DS_EXPORT Status SerializeAggregateResult(
+    const std::shared_ptr<Scanner>& scanner,
+    const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys, ceph::bufferlist& bl,
+    const std::string& compression = "lz4");
+
+/// \brief Scan a file as requested by a scan request and serialize the result
+/// to a bufferlist. This is what the scan_op CLS function runs on the object of
+/// the file; the parameters are those returned by DeserializeScanRequest.
+/// \param[in] file The file to scan.
+/// \param[in] filter The filter expression to apply.
+/// \param[in] partition_expression The partition expression of the file.
+/// \param[in] projected_schema The projected schema.
+/// \param[in] dataset_schema The dataset schema.
+/// \param[in] file_format The format of the file: 0 for Parquet, 1 for IPC.
+/// \param[in] row_groups The row groups to scan, or empty to scan all of them.
+/// \param[in] aggregates The partial aggregates to compute, if any.
+/// \param[in] keys The names of the fields to group the aggregates by.
+/// \param[in] compression The compression of the result, see SerializeScanResult.
+/// \param[out] result Bufferlist to serialize the result to.
+/// \return Status.
+ARROW_DS_EXPORT Status ScanObject(
+    const std::shared_ptr<io::RandomAccessFile>& file, const compute::Expression& filter,
+    const compute::Expression& partition_expression,
+    const std::shared_ptr<Schema>& projected_schema,
+    const std::shared_ptr<Schema>& dataset_schema, int64_t file_format,
+    const std::vector<int>& row_groups, const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys, const std::string& compression,
+    ceph::bufferlist& result);
+
+/// \brief Merge the partial aggregates computed for several fragments.
+/// \param[in] partials The partial aggregates, as produced by
+/// SerializeAggregateResult. There must be at least one batch.
+/// \param[in] aggregates The aggregates the partials were computed for.
+/// \param[in] keys The names of the fields grouped by.
+/// \return The merged aggregates, with one row per group.
+ARROW_DS_EXPORT Result<std::shared_ptr<RecordBatch>> MergePartialAggregates(
+    const RecordBatchVector& partials, const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys);
+
+/// \brief Compute grouped aggregates of a dataset of RadosParquetFileFormat
+/// fragments. Every object is aggregated on its OSD, so only one row per group
+/// and object is sent back to be merged on the client.
+/// \param[in] dataset The dataset to aggregate.
+/// \param[in] filter The filter to apply before aggregating.
+/// \param[in] aggregates The aggregates to compute.
+/// \param[in] keys The names of the fields to group by. At least one key is
+/// required.
+/// \return A table with one column per aggregate followed by the key columns,
+/// and one row per group.
+ARROW_DS_EXPORT Result<std::shared_ptr<Table>> AggregateDataset(
+    const std::shared_ptr<Dataset>& dataset, compute::Expression filter,
+    const std::vector<PushdownAggregate>& aggregates,
+    const std::vector<std::string>& keys);
 
 /// \brief Deserialize the result table from bufferlist.
 /// \param[out] batches Output record batches.
@@ -295,6 +572,14 @@ ARROW_DS_EXPORT Status SerializeTable(std::shared_ptr<Table>& table, ceph::buffe
 ARROW_DS_EXPORT Status DeserializeTable(RecordBatchVector& batches, ceph::bufferlist& bl,
                                         bool use_threads);
 
+/// \brief Deserialize the result record batches from a bufferlist lazily. A
+/// record batch is only decoded when the returned iterator is advanced.
+/// \param[in] bl Input bufferlist. It is kept alive by the iterator.
+/// \param[in] use_threads If true, use threads to decode each record batch.
+/// \return An iterator over the result record batches.
+ARROW_DS_EXPORT Result<RecordBatchIterator> DeserializeRecordBatches(
+    std::shared_ptr<ceph::bufferlist> bl, bool use_threads);
+
 /// @}
 
 }  // namespace dataset
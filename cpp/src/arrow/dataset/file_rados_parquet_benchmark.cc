@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Benchmarks of the RADOS offload path against a mock object store, which runs
+// the scan_op logic in-process on local files instead of on the OSDs.
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+
+#include "arrow/api.h"
+#include "arrow/compute/exec/expression.h"
+#include "arrow/dataset/file_rados_parquet.h"
+#include "arrow/dataset/scanner.h"
+#include "arrow/dataset/test_util_rados.h"
+#include "arrow/testing/gtest_util.h"
+#include "arrow/testing/random.h"
+
+namespace arrow {
+namespace dataset {
+
+using compute::field_ref;
+using compute::literal;
+
+// The size of the files of the mock object store
+static const int64_t kRowsPerFile = MockObjectStoreOptions().rows_per_file;
+
+static void ScanDataset(benchmark::State& state, const std::shared_ptr<Dataset>& dataset,
+                        compute::Expression filter, int64_t total_bytes) {
+  for (auto _ : state) {
+    ASSERT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+    ASSERT_OK(builder->Filter(filter));
+    ASSERT_OK(builder->UseThreads(true));
+    ASSERT_OK(builder->UseAsync(true));
+    ASSERT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+    ASSERT_OK_AND_ASSIGN(auto table, scanner->ToTable());
+    benchmark::DoNotOptimize(table);
+  }
+  state.SetBytesProcessed(state.iterations() * total_bytes);
+}
+
+// A benchmark of the cost of building and parsing a scan request.
+static void ScanRequestSerializeDeserialize(benchmark::State& state) {
+  auto dataset_schema = schema({field("a", int64()), field("b", float64()),
+                                field("c", int64())});
+  auto options = std::make_shared<ScanOptions>();
+  options->dataset_schema = dataset_schema;
+  options->projected_schema = dataset_schema;
+  ASSERT_OK_AND_ASSIGN(options->filter,
+                       less(field_ref("a"), literal(int64_t(1000))).Bind(*dataset_schema));
+  int64_t file_size = kRowsPerFile;
+  std::vector<int> row_groups{0, 1, 2, 3};
+
+  for (auto _ : state) {
+    ceph::bufferlist bl;
+    ABORT_NOT_OK(SerializeScanRequest(options, file_size, bl, row_groups));
+
+    compute::Expression filter;
+    compute::Expression partition_expression;
+    std::shared_ptr<Schema> projected_schema;
+    std::shared_ptr<Schema> deserialized_dataset_schema;
+    int64_t deserialized_file_size;
+    int64_t file_format;
+    std::vector<int> deserialized_row_groups;
+    ABORT_NOT_OK(DeserializeScanRequest(&filter, &partition_expression,
+                                        &projected_schema, &deserialized_dataset_schema,
+                                        deserialized_file_size, file_format, bl,
+                                        &deserialized_row_groups));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static const std::vector<std::string> kCompressions = {"none", "lz4", "zstd", "auto"};
+
+// A benchmark of the cost of sending a scan result back, by compression.
+static void ScanResultSerializeDeserialize(benchmark::State& state) {
+  const auto& compression = kCompressions[state.range(0)];
+  random::RandomArrayGenerator rng(42);
+  auto table = Table::Make(
+      schema({field("a", int64()), field("b", float64())}),
+      {rng.Int64(kRowsPerFile, 0, 1000), rng.Float64(kRowsPerFile, 0, 1)});
+  auto dataset = std::make_shared<InMemoryDataset>(table);
+  ASSERT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+  ASSERT_OK(builder->UseThreads(false));
+  ASSERT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+
+  int64_t result_size = 0;
+  for (auto _ : state) {
+    auto bl = std::make_shared<ceph::bufferlist>();
+    ABORT_NOT_OK(SerializeScanResult(scanner, *bl, compression));
+    result_size = bl->length();
+    ASSERT_OK_AND_ASSIGN(auto batches, DeserializeRecordBatches(bl, false));
+    ABORT_NOT_OK(batches.Visit([](std::shared_ptr<RecordBatch>) { return Status::OK(); }));
+  }
+  state.SetLabel(compression);
+  state.counters["result_size"] = static_cast<double>(result_size);
+  state.SetBytesProcessed(state.iterations() * kRowsPerFile *
+                          (sizeof(int64_t) + sizeof(double)));
+}
+
+// A benchmark of offloaded scans by the share of the rows selected, in percent.
+static void RadosScanSelectivity(benchmark::State& state) {
+  auto selectivity = state.range(0);
+  auto store = MockObjectStore::Make({});
+  auto dataset = MakeMockRadosDataset(store, /*num_handles=*/1);
+  auto filter = less(field_ref("a"), literal(kRowsPerFile * selectivity / 100));
+  ScanDataset(state, dataset, filter, store->total_bytes());
+}
+
+// A benchmark of offloaded scans by the number of Rados handles and OSD threads,
+// with some latency and a limited bandwidth to make the concurrency matter.
+static void RadosScanConcurrency(benchmark::State& state) {
+  MockObjectStoreOptions options;
+  options.num_threads = static_cast<int>(state.range(1));
+  options.latency = std::chrono::microseconds(500);
+  options.bandwidth = 1e9;
+  auto store = MockObjectStore::Make(options);
+  auto dataset = MakeMockRadosDataset(store, static_cast<int>(state.range(0)));
+  ScanDataset(state, dataset, literal(true), store->total_bytes());
+}
+
+static void ScanResultSerializeDeserialize_Customize(benchmark::internal::Benchmark* b) {
+  for (size_t i = 0; i < kCompressions.size(); ++i) {
+    b->Args({static_cast<int64_t>(i)});
+  }
+  b->ArgNames({"compression"});
+}
+
+static void RadosScanSelectivity_Customize(benchmark::internal::Benchmark* b) {
+  for (const int64_t selectivity : {1, 10, 50, 100}) {
+    b->Args({selectivity});
+  }
+  b->ArgNames({"selectivity"});
+  b->UseRealTime();
+}
+
+static void RadosScanConcurrency_Customize(benchmark::internal::Benchmark* b) {
+  for (const int64_t handles : {1, 4}) {
+    for (const int64_t threads : {1, 2, 4, 8}) {
+      b->Args({handles, threads});
+    }
+  }
+  b->ArgNames({"handles", "osd_threads"});
+  b->UseRealTime();
+}
+
+BENCHMARK(ScanRequestSerializeDeserialize);
+BENCHMARK(ScanResultSerializeDeserialize)
+    ->Apply(ScanResultSerializeDeserialize_Customize);
+BENCHMARK(RadosScanSelectivity)->Apply(RadosScanSelectivity_Customize);
+BENCHMARK(RadosScanConcurrency)->Apply(RadosScanConcurrency_Customize);
+
+}  // namespace dataset
+}  // namespace arrow
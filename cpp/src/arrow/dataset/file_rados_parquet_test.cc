@@ -16,10 +16,17 @@
 // under the License.
 
 #include "arrow/dataset/file_rados_parquet.h"
+
+#include <cerrno>
+#include <chrono>
+
 #include "arrow/api.h"
+#include "arrow/compute/api_vector.h"
 #include "arrow/compute/exec/expression.h"
 #include "arrow/dataset/scanner.h"
 #include "arrow/dataset/test_util.h"
+#include "arrow/dataset/test_util_rados.h"
+#include "arrow/testing/future_util.h"
 
 #define ABORT_ON_FAILURE(expr)                     \
   do {                                             \
@@ -79,6 +86,68 @@ TEST(TestRadosParquetFileFormat, ScanRequestSerializeDeserialize) {
   ASSERT_EQ(file_format_, options->file_format);
 }
 
+TEST(TestRadosParquetFileFormat, ScanRequestRowGroups) {
+  std::shared_ptr<ScanOptions> options = std::make_shared<ScanOptions>();
+  options->projected_schema = arrow::schema({arrow::field("a", arrow::int64())});
+  options->dataset_schema = arrow::schema({arrow::field("a", arrow::int64())});
+
+  compute::Expression filter_;
+  compute::Expression partition_expression_;
+  std::shared_ptr<Schema> projected_schema_;
+  std::shared_ptr<Schema> dataset_schema_;
+  int64_t file_size_;
+  int64_t file_format_;
+  int64_t file_size = 1000000;
+
+  ceph::bufferlist bl;
+  std::vector<int> row_groups{1, 3, 4};
+  ASSERT_OK(SerializeScanRequest(options, file_size, bl, row_groups));
+  std::vector<int> row_groups_;
+  ASSERT_OK(DeserializeScanRequest(&filter_, &partition_expression_, &projected_schema_,
+                                   &dataset_schema_, file_size_, file_format_, bl,
+                                   &row_groups_));
+  ASSERT_EQ(row_groups_, row_groups);
+
+  // A request without row groups scans the whole file.
+  ceph::bufferlist whole_file_bl;
+  ASSERT_OK(SerializeScanRequest(options, file_size, whole_file_bl));
+  ASSERT_OK(DeserializeScanRequest(&filter_, &partition_expression_, &projected_schema_,
+                                   &dataset_schema_, file_size_, file_format_,
+                                   whole_file_bl, &row_groups_));
+  ASSERT_TRUE(row_groups_.empty());
+
+  // Aggregates and group keys are carried along.
+  ceph::bufferlist aggregate_bl;
+  std::vector<PushdownAggregate> aggregates{{"hash_sum", "a"}, {"hash_count", "b"}};
+  ASSERT_OK(SerializeScanRequest(options, file_size, aggregate_bl, {}, aggregates,
+                                 {"c"}));
+  std::vector<PushdownAggregate> aggregates_;
+  std::vector<std::string> keys_;
+  ASSERT_OK(DeserializeScanRequest(&filter_, &partition_expression_, &projected_schema_,
+                                   &dataset_schema_, file_size_, file_format_,
+                                   aggregate_bl, &row_groups_, &aggregates_, &keys_));
+  ASSERT_EQ(aggregates_.size(), 2);
+  ASSERT_EQ(aggregates_[1].function, "hash_count");
+  ASSERT_EQ(aggregates_[1].target, "b");
+  ASSERT_EQ(keys_, std::vector<std::string>{"c"});
+
+  // The result compression is carried along and validated.
+  ceph::bufferlist compression_bl;
+  ASSERT_OK(
+      SerializeScanRequest(options, file_size, compression_bl, {}, {}, {}, "zstd:3"));
+  std::string compression_;
+  ASSERT_OK(DeserializeScanRequest(&filter_, &partition_expression_, &projected_schema_,
+                                   &dataset_schema_, file_size_, file_format_,
+                                   compression_bl, &row_groups_, &aggregates_, &keys_,
+                                   &compression_));
+  ASSERT_EQ(compression_, "zstd:3");
+  ceph::bufferlist invalid_bl;
+  ASSERT_RAISES(Invalid,
+                SerializeScanRequest(options, file_size, invalid_bl, {}, {}, {}, "gzip"));
+  ASSERT_RAISES(Invalid, SerializeScanRequest(options, file_size, invalid_bl, {}, {},
+                                              {}, "zstd:fast"));
+}
+
 TEST(TestRadosParquetFileFormat, SerializeDeserializeTable) {
   std::shared_ptr<Table> table = CreateTable();
   ceph::bufferlist bl;
@@ -91,5 +160,476 @@ TEST(TestRadosParquetFileFormat, SerializeDeserializeTable) {
   ASSERT_EQ(table->Equals(*materialized_table), 1);
 }
 
+TEST(TestRadosParquetFileFormat, SerializeScanResultDeserializeRecordBatches) {
+  std::shared_ptr<Table> table = CreateTable();
+  auto dataset = std::make_shared<InMemoryDataset>(table);
+  ASSERT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+  ASSERT_OK(builder->BatchSize(3));
+  ASSERT_OK(builder->UseThreads(false));
+  ASSERT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+
+  auto bl = std::make_shared<ceph::bufferlist>();
+  ASSERT_OK(SerializeScanResult(scanner, *bl));
+
+  ASSERT_OK_AND_ASSIGN(auto batch_it, DeserializeRecordBatches(bl, false));
+  ASSERT_OK_AND_ASSIGN(auto batches, batch_it.ToVector());
+  ASSERT_EQ(batches.size(), 4);
+  ASSERT_OK_AND_ASSIGN(auto materialized_table, arrow::Table::FromRecordBatches(batches));
+
+  ASSERT_EQ(table->Equals(*materialized_table), 1);
+}
+
+TEST(TestRadosParquetFileFormat, SerializeScanResultCompression) {
+  std::shared_ptr<Table> table = CreateTable();
+  auto dataset = std::make_shared<InMemoryDataset>(table);
+  ASSERT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+  ASSERT_OK(builder->BatchSize(3));
+  ASSERT_OK(builder->UseThreads(false));
+  ASSERT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+
+  for (const std::string compression : {"none", "lz4", "zstd", "zstd:3", "auto"}) {
+    ARROW_SCOPED_TRACE("compression = ", compression);
+    auto bl = std::make_shared<ceph::bufferlist>();
+    ASSERT_OK(SerializeScanResult(scanner, *bl, compression));
+
+    ASSERT_OK_AND_ASSIGN(auto batch_it, DeserializeRecordBatches(bl, false));
+    ASSERT_OK_AND_ASSIGN(auto batches, batch_it.ToVector());
+    ASSERT_EQ(batches.size(), 4);
+    ASSERT_OK_AND_ASSIGN(auto materialized_table,
+                         arrow::Table::FromRecordBatches(batches));
+    ASSERT_EQ(table->Equals(*materialized_table), 1);
+  }
+
+  ceph::bufferlist bl;
+  ASSERT_RAISES(Invalid, SerializeScanResult(scanner, bl, "brotli"));
+}
+
+TEST(TestRadosParquetFileFormat, SerializeAggregateResultMergePartialAggregates) {
+  std::shared_ptr<Table> table = CreateTable();
+  auto dataset = std::make_shared<InMemoryDataset>(table);
+  std::vector<PushdownAggregate> aggregates{
+      {"hash_sum", "a"}, {"hash_count", "b"}, {"hash_min_max", "b"}};
+  std::vector<std::string> keys{"c"};
+
+  ASSERT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+  ASSERT_OK(builder->BatchSize(3));
+  ASSERT_OK(builder->UseThreads(false));
+  ASSERT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+
+  auto bl = std::make_shared<ceph::bufferlist>();
+  ASSERT_OK(SerializeAggregateResult(scanner, aggregates, keys, *bl));
+  ASSERT_OK_AND_ASSIGN(auto batch_it, DeserializeRecordBatches(bl, false));
+  ASSERT_OK_AND_ASSIGN(auto partials, batch_it.ToVector());
+  ASSERT_EQ(partials.size(), 1);
+
+  auto min_max_type = struct_({field("min", int64()), field("max", int64())});
+  auto result_schema = schema({field("hash_sum(a)", int64()),
+                               field("hash_count(b)", int64()),
+                               field("hash_min_max(b)", min_max_type), field("c", int64())});
+  auto expected_partial = RecordBatchFromJSON(result_schema, R"([
+    [20, 5, {"min": 1, "max": 9}, 1],
+    [25, 5, {"min": 0, "max": 8}, 2]
+  ])");
+  AssertBatchesEqual(*expected_partial, *partials[0]);
+
+  // Merge the partial aggregates of two fragments holding the same rows.
+  ASSERT_OK_AND_ASSIGN(auto merged, MergePartialAggregates({partials[0], partials[0]},
+                                                           aggregates, keys));
+  auto expected_merged = RecordBatchFromJSON(result_schema, R"([
+    [40, 10, {"min": 1, "max": 9}, 1],
+    [50, 10, {"min": 0, "max": 8}, 2]
+  ])");
+  AssertBatchesEqual(*expected_merged, *merged);
+
+  ASSERT_RAISES(NotImplemented, SerializeAggregateResult(
+                                    scanner, {{"hash_mean", "a"}}, keys, *bl));
+  ASSERT_RAISES(NotImplemented, SerializeAggregateResult(scanner, aggregates, {}, *bl));
+}
+
+TEST(TestRadosParquetFileFormat, BufferlistRandomAccessFile) {
+  auto bl = std::make_shared<ceph::bufferlist>();
+  bl->append(ceph::bufferptr("abcd", 4));
+  bl->append(ceph::bufferptr("efghij", 6));
+
+  BufferlistRandomAccessFile file(bl);
+  ASSERT_OK_AND_EQ(10, file.GetSize());
+
+  // Within a single segment
+  ASSERT_OK_AND_ASSIGN(auto buffer, file.ReadAt(5, 3));
+  ASSERT_EQ("fgh", buffer->ToString());
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<BufferptrBuffer>(buffer));
+
+  // Spanning both segments
+  ASSERT_OK_AND_ASSIGN(buffer, file.ReadAt(2, 5));
+  ASSERT_EQ("cdefg", buffer->ToString());
+
+  char out[10];
+  ASSERT_OK_AND_EQ(10, file.Read(10, out));
+  ASSERT_EQ("abcdefghij", std::string(out, 10));
+  ASSERT_OK_AND_ASSIGN(buffer, file.Read(1));
+  ASSERT_EQ(0, buffer->size());
+}
+
+TEST(TestRadosParquetFileFormat, RadosFileMetadataCache) {
+  auto format = std::make_shared<ParquetFileFormat>();
+  auto make_fragment = [&]() -> std::shared_ptr<ParquetFileFragment> {
+    EXPECT_OK_AND_ASSIGN(auto fragment,
+                         format->MakeFragment(FileSource(std::make_shared<Buffer>("")),
+                                              compute::literal(true), nullptr));
+    return internal::checked_pointer_cast<ParquetFileFragment>(fragment);
+  };
+
+  RadosFileMetadataCache cache(1);
+  struct stat st {};
+  st.st_ino = 1;
+  st.st_size = 100;
+  st.st_mtim.tv_sec = 10;
+  ASSERT_EQ(nullptr, cache.Get(st));
+
+  auto fragment = make_fragment();
+  cache.Put(st, fragment);
+  ASSERT_EQ(fragment, cache.Get(st));
+
+  // A modified file is not served from the cache.
+  struct stat modified_st = st;
+  modified_st.st_mtim.tv_nsec = 1;
+  ASSERT_EQ(nullptr, cache.Get(modified_st));
+  modified_st = st;
+  modified_st.st_size = 200;
+  ASSERT_EQ(nullptr, cache.Get(modified_st));
+
+  // The least recently used file is evicted.
+  struct stat other_st = st;
+  other_st.st_ino = 2;
+  cache.Put(other_st, make_fragment());
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(nullptr, cache.Get(st));
+  ASSERT_NE(nullptr, cache.Get(other_st));
+}
+
+class CountingRados : public RadosInterface {
+ public:
+  int init2(const char* const name, const char* const clustername,
+            uint64_t flags) override {
+    return 0;
+  }
+  int ioctx_create(const char* name, IoCtxInterface* pioctx) override { return 0; }
+  int conf_read_file(const char* const path) override { return 0; }
+  int connect() override {
+    ++connects;
+    return 0;
+  }
+  void shutdown() override {}
+
+  int connects = 0;
+};
+
+class NullIoCtx : public IoCtxInterface {
+ public:
+  int write_full(const std::string& oid, ceph::bufferlist& bl) override { return 0; }
+  int read(const std::string& oid, ceph::bufferlist& bl, size_t len,
+           uint64_t offset) override {
+    return 0;
+  }
+  int exec(const std::string& oid, const char* cls, const char* method,
+           ceph::bufferlist& in, ceph::bufferlist& out) override {
+    return 0;
+  }
+  int aio_exec(const std::string& oid, const char* cls, const char* method,
+               ceph::bufferlist& in, ceph::bufferlist* out,
+               AioCallback callback) override {
+    callback(0);
+    return 0;
+  }
+  std::vector<std::string> list() override { return {}; }
+  int stat(const std::string& oid, uint64_t* psize) override { return 0; }
+
+ private:
+  void setIoCtx(librados::IoCtx* ioCtx_) override {}
+};
+
+std::shared_ptr<connection::RadosConnection> MakeMockConnection(
+    int num_handles, connection::RadosConnection::HandleSelection selection,
+    std::vector<CountingRados*>* rados = nullptr) {
+  std::vector<std::unique_ptr<connection::RadosHandle>> handles;
+  for (int i = 0; i < num_handles; ++i) {
+    auto handle_rados = new CountingRados();
+    if (rados != nullptr) rados->push_back(handle_rados);
+    handles.emplace_back(new connection::RadosHandle(
+        std::unique_ptr<RadosInterface>(handle_rados),
+        std::unique_ptr<IoCtxInterface>(new NullIoCtx())));
+  }
+  connection::RadosConnection::RadosConnectionCtx ctx("", "", "", "", "");
+  ctx.handle_selection = selection;
+  return std::make_shared<connection::RadosConnection>(ctx, std::move(handles));
+}
+
+TEST(TestRadosParquetFileFormat, RadosConnectionRoundRobin) {
+  std::vector<CountingRados*> rados;
+  auto connection = MakeMockConnection(
+      3, connection::RadosConnection::HandleSelection::kRoundRobin, &rados);
+  ASSERT_EQ(connection->ctx.num_handles, 3);
+  ASSERT_OK(connection->connect());
+  ASSERT_OK(connection->connect());
+  for (auto handle_rados : rados) {
+    ASSERT_EQ(handle_rados->connects, 1);
+  }
+
+  std::vector<connection::RadosHandle*> acquired;
+  for (int i = 0; i < 6; ++i) {
+    acquired.push_back(connection->AcquireHandle());
+  }
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_NE(acquired[i], acquired[(i + 1) % 3]);
+    ASSERT_EQ(acquired[i], acquired[i + 3]);
+  }
+  for (const auto& stats : connection->handle_stats()) {
+    ASSERT_EQ(stats.outstanding_ops, 2);
+    ASSERT_EQ(stats.total_ops, 2);
+  }
+
+  for (auto handle : acquired) {
+    connection->ReleaseHandle(handle);
+  }
+  for (const auto& stats : connection->handle_stats()) {
+    ASSERT_EQ(stats.outstanding_ops, 0);
+    ASSERT_EQ(stats.total_ops, 2);
+  }
+}
+
+TEST(TestRadosParquetFileFormat, RadosConnectionLeastOutstandingOps) {
+  auto connection = MakeMockConnection(
+      2, connection::RadosConnection::HandleSelection::kLeastOutstandingOps);
+
+  auto first = connection->AcquireHandle();
+  auto second = connection->AcquireHandle();
+  ASSERT_NE(first, second);
+
+  // The handle whose operation finished is preferred while the other is busy.
+  connection->ReleaseHandle(first);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(connection->AcquireHandle(), first);
+    connection->ReleaseHandle(first);
+  }
+  ASSERT_EQ(first->total_ops, 4);
+  ASSERT_EQ(second->total_ops, 1);
+  ASSERT_EQ(second->outstanding_ops, 1);
+}
+
+TEST(TestRadosParquetFileFormat, RadosConnectionDefaultHandles) {
+  connection::RadosConnection::RadosConnectionCtx ctx("", "", "", "", "");
+  ctx.num_handles = 4;
+  connection::RadosConnection connection(ctx);
+  ASSERT_EQ(connection.handles.size(), 4);
+  ASSERT_EQ(connection.handle_stats().size(), 4);
+}
+
+// Issue a scan_op call for a row group of a file of a mock object store.
+Future<std::shared_ptr<ceph::bufferlist>> ExecScanRowGroup(
+    DirectObjectAccess* doa, const MockObjectStore& store, int file_index,
+    int row_group) {
+  auto options = std::make_shared<ScanOptions>();
+  options->dataset_schema = arrow::schema({arrow::field("a", arrow::int64()),
+                                           arrow::field("b", arrow::float64()),
+                                           arrow::field("c", arrow::int64())});
+  options->projected_schema = options->dataset_schema;
+  int64_t file_size = 0;
+  ceph::bufferlist request;
+  ARROW_EXPECT_OK(SerializeScanRequest(options, file_size, request, {row_group}));
+  return doa->ExecAsync(store.inodes()[file_index], "scan_op", std::move(request));
+}
+
+MockObjectStoreOptions SmallMockObjectStoreOptions(int num_files) {
+  MockObjectStoreOptions options;
+  options.num_threads = 8;
+  options.latency = std::chrono::milliseconds(5);
+  options.num_files = num_files;
+  options.rows_per_file = 400;
+  options.rows_per_row_group = 100;
+  return options;
+}
+
+TEST(TestRadosParquetFileFormat, ExecAsyncMaxOutstandingOps) {
+  auto store = MockObjectStore::Make(SmallMockObjectStoreOptions(2));
+  auto doa = std::make_shared<DirectObjectAccess>(
+      MakeMockRadosConnection(store, /*num_handles=*/2, /*max_outstanding_ops=*/3));
+
+  std::vector<Future<std::shared_ptr<ceph::bufferlist>>> futures;
+  for (int file_index = 0; file_index < 2; ++file_index) {
+    for (int row_group = 0; row_group < 4; ++row_group) {
+      futures.push_back(ExecScanRowGroup(doa.get(), *store, file_index, row_group));
+    }
+  }
+  // The calls beyond the limit are queued rather than issued.
+  ASSERT_EQ(doa->outstanding_ops(), 3);
+
+  for (const auto& future : futures) {
+    ASSERT_FINISHES_OK_AND_ASSIGN(auto result, future);
+    ASSERT_OK_AND_ASSIGN(auto batch_it, DeserializeRecordBatches(result, false));
+    ASSERT_OK_AND_ASSIGN(auto batches, batch_it.ToVector());
+    int64_t num_rows = 0;
+    for (const auto& batch : batches) num_rows += batch->num_rows();
+    ASSERT_EQ(num_rows, 100);
+  }
+  ASSERT_EQ(store->requests().size(), futures.size());
+  ASSERT_EQ(store->max_in_flight(), 3);
+  ASSERT_EQ(doa->outstanding_ops(), 0);
+  for (const auto& stats : doa->connection()->handle_stats()) {
+    ASSERT_EQ(stats.outstanding_ops, 0);
+  }
+}
+
+TEST(TestRadosParquetFileFormat, ExecAsyncQueuedOpsInOrder) {
+  auto store = MockObjectStore::Make(SmallMockObjectStoreOptions(1));
+  auto doa = std::make_shared<DirectObjectAccess>(
+      MakeMockRadosConnection(store, /*num_handles=*/1, /*max_outstanding_ops=*/1));
+
+  // Each completion issues the call queued first.
+  std::vector<Future<std::shared_ptr<ceph::bufferlist>>> futures;
+  std::vector<std::vector<int>> expected_requests;
+  for (int row_group : {3, 0, 2, 1}) {
+    futures.push_back(ExecScanRowGroup(doa.get(), *store, 0, row_group));
+    expected_requests.push_back({row_group});
+  }
+  for (const auto& future : futures) {
+    ASSERT_FINISHES_OK(future);
+  }
+  ASSERT_EQ(store->requests(), expected_requests);
+  ASSERT_EQ(store->max_in_flight(), 1);
+}
+
+TEST(TestRadosParquetFileFormat, ExecAsyncErrors) {
+  auto store = MockObjectStore::Make(SmallMockObjectStoreOptions(3));
+  // The call on the first file fails on the OSD, the one on the second file
+  // can't even be issued.
+  store->Fail(0, SCAN_ERR_CODE);
+  store->Fail(1, -EIO);
+  auto doa = std::make_shared<DirectObjectAccess>(
+      MakeMockRadosConnection(store, /*num_handles=*/1, /*max_outstanding_ops=*/1));
+
+  // All but the first call are queued, so the failures are handed over from the
+  // completion of the previous call.
+  auto ok_before = ExecScanRowGroup(doa.get(), *store, 2, 0);
+  auto scan_error = ExecScanRowGroup(doa.get(), *store, 0, 0);
+  auto issue_error = ExecScanRowGroup(doa.get(), *store, 1, 0);
+  auto ok_after = ExecScanRowGroup(doa.get(), *store, 2, 1);
+
+  ASSERT_FINISHES_OK(ok_before);
+  EXPECT_FINISHES_AND_RAISES_WITH_MESSAGE_THAT(
+      Invalid, ::testing::HasSubstr(SCAN_ERR_MSG), scan_error);
+  ASSERT_FINISHES_AND_RAISES(IOError, issue_error);
+  ASSERT_FINISHES_OK(ok_after);
+  ASSERT_EQ(doa->outstanding_ops(), 0);
+  for (const auto& stats : doa->connection()->handle_stats()) {
+    ASSERT_EQ(stats.outstanding_ops, 0);
+  }
+}
+
+// Scan a dataset with the async scanner, returning its rows sorted.
+Result<std::shared_ptr<Table>> ScanSorted(const std::shared_ptr<Dataset>& dataset,
+                                          compute::Expression filter) {
+  ARROW_ASSIGN_OR_RAISE(auto builder, dataset->NewScan());
+  RETURN_NOT_OK(builder->Filter(filter));
+  RETURN_NOT_OK(builder->UseThreads(true));
+  RETURN_NOT_OK(builder->UseAsync(true));
+  ARROW_ASSIGN_OR_RAISE(auto scanner, builder->Finish());
+  ARROW_ASSIGN_OR_RAISE(auto table, scanner->ToTable());
+  ARROW_ASSIGN_OR_RAISE(
+      auto indices,
+      compute::SortIndices(
+          table, compute::SortOptions({compute::SortKey("a"), compute::SortKey("b")})));
+  ARROW_ASSIGN_OR_RAISE(Datum sorted, compute::Take(table, indices));
+  return sorted.table();
+}
+
+TEST(TestRadosParquetFileFormat, ScanBatchesAsync) {
+  MockObjectStoreOptions store_options = SmallMockObjectStoreOptions(3);
+  store_options.rows_per_file = 1000;
+  auto store = MockObjectStore::Make(store_options);
+  auto dataset = MakeMockRadosDataset(store, /*num_handles=*/2,
+                                      /*max_outstanding_ops=*/2);
+  ASSERT_OK_AND_ASSIGN(
+      auto factory,
+      FileSystemDatasetFactory::Make(std::make_shared<fs::LocalFileSystem>(),
+                                     store->paths(),
+                                     std::make_shared<ParquetFileFormat>(), {}));
+  ASSERT_OK_AND_ASSIGN(auto local_dataset, factory->Finish());
+
+  // Three row groups of each file are scanned, by calls issued at most two at once.
+  auto filter = compute::less(compute::field_ref("a"), compute::literal(int64_t(250)));
+  ASSERT_OK_AND_ASSIGN(auto expected, ScanSorted(local_dataset, filter));
+  ASSERT_OK_AND_ASSIGN(auto actual, ScanSorted(dataset, filter));
+  ASSERT_EQ(actual->num_rows(), 750);
+  AssertTablesEqual(*expected, *actual, /*same_chunk_layout=*/false);
+  ASSERT_EQ(store->requests().size(), 9);
+  ASSERT_LE(store->max_in_flight(), 2);
+
+  // A failed call fails the scan.
+  store->Fail(1, SCAN_ERR_CODE);
+  EXPECT_RAISES_WITH_MESSAGE_THAT(Invalid, ::testing::HasSubstr(SCAN_ERR_MSG),
+                                  ScanSorted(dataset, filter));
+}
+
+// Run the scan tasks of the files of a dataset, returning the row groups
+// requested by the scan_op call of each task.
+std::vector<std::vector<int>> ScanTaskRowGroups(const std::shared_ptr<Dataset>& dataset,
+                                                MockObjectStore* store,
+                                                compute::Expression filter) {
+  EXPECT_OK_AND_ASSIGN(auto builder, dataset->NewScan());
+  ARROW_EXPECT_OK(builder->Filter(filter));
+  EXPECT_OK_AND_ASSIGN(auto scanner, builder->Finish());
+  EXPECT_OK_AND_ASSIGN(auto fragments, dataset->GetFragments());
+
+  const size_t num_requests = store->requests().size();
+  size_t num_tasks = 0;
+  for (auto maybe_fragment : fragments) {
+    EXPECT_OK_AND_ASSIGN(auto fragment, maybe_fragment);
+    EXPECT_OK_AND_ASSIGN(auto scan_task_it, fragment->Scan(scanner->options()));
+    for (auto maybe_scan_task : scan_task_it) {
+      EXPECT_OK_AND_ASSIGN(auto scan_task, maybe_scan_task);
+      EXPECT_OK_AND_ASSIGN(auto batch_it, scan_task->Execute());
+      ARROW_EXPECT_OK(batch_it.ToVector().status());
+      ++num_tasks;
+    }
+  }
+
+  auto requests = store->requests();
+  requests.erase(requests.begin(), requests.begin() + num_requests);
+  EXPECT_EQ(requests.size(), num_tasks);
+  return requests;
+}
+
+TEST(TestRadosParquetFileFormat, ScanFileSplitsRowGroups) {
+  MockObjectStoreOptions store_options;
+  store_options.num_files = 1;
+  store_options.rows_per_file = 1000;
+  store_options.rows_per_row_group = 100;
+  auto store = MockObjectStore::Make(store_options);
+  auto dataset = MakeMockRadosDataset(store, /*num_handles=*/1);
+  auto a = compute::field_ref("a");
+
+  // Every row group is scanned by a task of its own.
+  std::vector<std::vector<int>> expected;
+  for (int row_group = 0; row_group < 10; ++row_group) expected.push_back({row_group});
+  ASSERT_EQ(ScanTaskRowGroups(dataset, store.get(), compute::literal(true)), expected);
+
+  // The row groups whose statistics rule out the filter get no task.
+  expected = {{2}, {3}, {4}};
+  ASSERT_EQ(ScanTaskRowGroups(
+                dataset, store.get(),
+                compute::and_(compute::greater_equal(a, compute::literal(int64_t(250))),
+                              compute::less(a, compute::literal(int64_t(420))))),
+            expected);
+  expected = {{9}};
+  ASSERT_EQ(ScanTaskRowGroups(dataset, store.get(),
+                              compute::equal(a, compute::literal(int64_t(999)))),
+            expected);
+
+  // No task at all if every row group is pruned.
+  ASSERT_TRUE(ScanTaskRowGroups(dataset, store.get(),
+                                compute::greater(a, compute::literal(int64_t(5000))))
+                  .empty());
+}
+
 }  // namespace dataset
 }  // namespace arrow
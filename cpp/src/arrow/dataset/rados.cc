@@ -17,9 +17,15 @@
 
 #include "arrow/dataset/rados.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <vector>
 
+#include "arrow/io/util_internal.h"
+#include "arrow/util/logging.h"
+
 namespace arrow {
 namespace dataset {
 
@@ -37,6 +43,38 @@ int IoCtxWrapper::exec(const std::string& oid, const char* cls, const char* meth
   return this->ioCtx->exec(oid, cls, method, in, out);
 }
 
+namespace {
+
+struct AioExecCompletion {
+  IoCtxInterface::AioCallback callback;
+  librados::AioCompletion* completion;
+};
+
+void OnAioExecComplete(librados::completion_t cb, void* arg) {
+  std::unique_ptr<AioExecCompletion> state(static_cast<AioExecCompletion*>(arg));
+  int e = state->completion->get_return_value();
+  state->completion->release();
+  state->callback(e);
+}
+
+}  // namespace
+
+int IoCtxWrapper::aio_exec(const std::string& oid, const char* cls, const char* method,
+                           ceph::bufferlist& in, ceph::bufferlist* out,
+                           AioCallback callback) {
+  // The completion callback takes ownership of the state, and it may fire before
+  // aio_exec returns.
+  auto state = new AioExecCompletion{std::move(callback), NULLPTR};
+  auto completion = librados::Rados::aio_create_completion(state, &OnAioExecComplete);
+  state->completion = completion;
+  int e = this->ioCtx->aio_exec(oid, completion, cls, method, in, out);
+  if (e < 0) {
+    completion->release();
+    delete state;
+  }
+  return e;
+}
+
 int IoCtxWrapper::stat(const std::string& oid, uint64_t* psize) {
   return this->ioCtx->stat(oid, psize, NULL);
 }
@@ -71,5 +109,211 @@ int RadosWrapper::connect() { return this->cluster->connect(); }
 
 void RadosWrapper::shutdown() { return this->cluster->shutdown(); }
 
+BufferlistRandomAccessFile::BufferlistRandomAccessFile(
+    std::shared_ptr<ceph::bufferlist> bl, MemoryPool* pool)
+    : bl_(std::move(bl)), pool_(pool) {
+  for (const auto& segment : bl_->buffers()) {
+    if (segment.length() == 0) continue;
+    segments_.push_back(segment);
+    segment_offsets_.push_back(size_);
+    size_ += segment.length();
+  }
+}
+
+Status BufferlistRandomAccessFile::DoClose() {
+  is_open_ = false;
+  return Status::OK();
+}
+
+Result<int64_t> BufferlistRandomAccessFile::DoTell() const {
+  RETURN_NOT_OK(CheckClosed());
+  return position_;
+}
+
+Status BufferlistRandomAccessFile::DoSeek(int64_t position) {
+  RETURN_NOT_OK(CheckClosed());
+
+  if (position < 0 || position > size_) {
+    return Status::IOError("Seek out of bounds");
+  }
+
+  position_ = position;
+  return Status::OK();
+}
+
+Result<int64_t> BufferlistRandomAccessFile::DoGetSize() {
+  RETURN_NOT_OK(CheckClosed());
+  return size_;
+}
+
+size_t BufferlistRandomAccessFile::FindSegment(int64_t position) const {
+  auto it =
+      std::upper_bound(segment_offsets_.begin(), segment_offsets_.end(), position);
+  return static_cast<size_t>(std::distance(segment_offsets_.begin(), it)) - 1;
+}
+
+Result<int64_t> BufferlistRandomAccessFile::DoReadAt(int64_t position, int64_t nbytes,
+                                                     void* out) {
+  RETURN_NOT_OK(CheckClosed());
+
+  ARROW_ASSIGN_OR_RAISE(nbytes, io::internal::ValidateReadRange(position, nbytes, size_));
+  DCHECK_GE(nbytes, 0);
+
+  auto dest = reinterpret_cast<uint8_t*>(out);
+  int64_t remaining = nbytes;
+  size_t i = remaining > 0 ? FindSegment(position) : segments_.size();
+  int64_t segment_position = position - (remaining > 0 ? segment_offsets_[i] : 0);
+  for (; remaining > 0; ++i, segment_position = 0) {
+    const auto& segment = segments_[i];
+    int64_t to_copy = std::min<int64_t>(remaining, segment.length() - segment_position);
+    std::memcpy(dest, segment.c_str() + segment_position, to_copy);
+    dest += to_copy;
+    remaining -= to_copy;
+  }
+  return nbytes;
+}
+
+Result<std::shared_ptr<Buffer>> BufferlistRandomAccessFile::DoReadAt(int64_t position,
+                                                                     int64_t nbytes) {
+  RETURN_NOT_OK(CheckClosed());
+
+  ARROW_ASSIGN_OR_RAISE(nbytes, io::internal::ValidateReadRange(position, nbytes, size_));
+  DCHECK_GE(nbytes, 0);
+
+  if (nbytes == 0) {
+    return std::make_shared<Buffer>(nullptr, 0);
+  }
+
+  size_t i = FindSegment(position);
+  int64_t segment_position = position - segment_offsets_[i];
+  if (segment_position + nbytes <= segments_[i].length()) {
+    // The range lies within a single segment: reference it instead of copying.
+    return std::make_shared<BufferptrBuffer>(ceph::bufferptr(
+        segments_[i], static_cast<unsigned>(segment_position),
+        static_cast<unsigned>(nbytes)));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(auto buffer, AllocateBuffer(nbytes, pool_));
+  ARROW_ASSIGN_OR_RAISE(int64_t bytes_read,
+                        DoReadAt(position, nbytes, buffer->mutable_data()));
+  DCHECK_EQ(bytes_read, nbytes);
+  return std::move(buffer);
+}
+
+Result<int64_t> BufferlistRandomAccessFile::DoRead(int64_t nbytes, void* out) {
+  RETURN_NOT_OK(CheckClosed());
+  ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, DoReadAt(position_, nbytes, out));
+  position_ += bytes_read;
+  return bytes_read;
+}
+
+Result<std::shared_ptr<Buffer>> BufferlistRandomAccessFile::DoRead(int64_t nbytes) {
+  RETURN_NOT_OK(CheckClosed());
+  ARROW_ASSIGN_OR_RAISE(auto buffer, DoReadAt(position_, nbytes));
+  position_ += buffer->size();
+  return buffer;
+}
+
+namespace {
+
+// Arrow requires 64-byte aligned allocations.
+constexpr unsigned kAlignment = 64;
+
+// Ceph buffers may not be larger than what fits in an unsigned int.
+Status CheckBufferptrSize(int64_t size) {
+  if (size < 0 || size > static_cast<int64_t>(std::numeric_limits<unsigned>::max())) {
+    return Status::CapacityError("Cannot allocate a ceph::bufferptr of ", size,
+                                 " bytes");
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status BufferptrMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  RETURN_NOT_OK(CheckBufferptrSize(size));
+  // Always allocate at least one byte so that every allocation has a distinct
+  // address to be looked up by.
+  ceph::bufferptr ptr(ceph::buffer::create_aligned(
+      static_cast<unsigned>(std::max<int64_t>(size, 1)), kAlignment));
+  *out = reinterpret_cast<uint8_t*>(ptr.c_str());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  allocations_.emplace(*out, std::move(ptr));
+  bytes_allocated_ += size;
+  max_memory_ = std::max(max_memory_, bytes_allocated_);
+  return Status::OK();
+}
+
+Status BufferptrMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                       uint8_t** ptr) {
+  if (new_size <= old_size) {
+    // Shrink in place, so that the region keeps being backed by the same
+    // bufferptr and can still be appended by reference.
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_allocated_ -= old_size - new_size;
+    return Status::OK();
+  }
+  uint8_t* new_ptr;
+  RETURN_NOT_OK(Allocate(new_size, &new_ptr));
+  std::memcpy(new_ptr, *ptr, static_cast<size_t>(old_size));
+  Free(*ptr, old_size);
+  *ptr = new_ptr;
+  return Status::OK();
+}
+
+void BufferptrMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Buffers already appended to a bufferlist keep their own reference.
+  allocations_.erase(buffer);
+  bytes_allocated_ -= size;
+}
+
+int64_t BufferptrMemoryPool::bytes_allocated() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_allocated_;
+}
+
+int64_t BufferptrMemoryPool::max_memory() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_memory_;
+}
+
+bool BufferptrMemoryPool::Find(const uint8_t* data, int64_t size,
+                               ceph::bufferptr* out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = allocations_.upper_bound(data);
+  if (it == allocations_.begin()) return false;
+  --it;
+  const auto& ptr = it->second;
+  int64_t offset = data - it->first;
+  if (offset + size > ptr.length()) return false;
+  *out = ceph::bufferptr(ptr, static_cast<unsigned>(offset), static_cast<unsigned>(size));
+  return true;
+}
+
+Status BufferlistOutputStream::Write(const void* data, int64_t nbytes) {
+  if (closed_) {
+    return Status::Invalid("Operation on closed stream");
+  }
+  bl_->append(reinterpret_cast<const char*>(data), static_cast<unsigned>(nbytes));
+  position_ += nbytes;
+  return Status::OK();
+}
+
+Status BufferlistOutputStream::Write(const std::shared_ptr<Buffer>& data) {
+  if (closed_) {
+    return Status::Invalid("Operation on closed stream");
+  }
+  ceph::bufferptr ptr;
+  if (pool_ == nullptr || data->size() == 0 ||
+      !pool_->Find(data->data(), data->size(), &ptr)) {
+    return Write(data->data(), data->size());
+  }
+  bl_->append(std::move(ptr));
+  position_ += data->size();
+  return Status::OK();
+}
+
 }  // namespace dataset
 }  // namespace arrow
@@ -19,8 +19,21 @@
 
 #include <rados/librados.hpp>
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
 #include "arrow/dataset/type_fwd.h"
 #include "arrow/dataset/visibility.h"
+#include "arrow/io/concurrency.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/memory_pool.h"
+#include "arrow/result.h"
+#include "arrow/status.h"
 #include "arrow/util/macros.h"
 
 namespace arrow {
@@ -28,7 +41,11 @@ namespace dataset {
 
 class ARROW_DS_EXPORT IoCtxInterface {
  public:
+  /// \brief A callback receiving the return code of an asynchronous operation.
+  using AioCallback = std::function<void(int)>;
+
   IoCtxInterface() {}
+  virtual ~IoCtxInterface() = default;
 
   /// \brief Write data to an object.
   ///
@@ -55,6 +72,21 @@ class ARROW_DS_EXPORT IoCtxInterface {
   virtual int exec(const std::string& oid, const char* cls, const char* method,
                    ceph::bufferlist& in, ceph::bufferlist& out) = 0;
 
+  /// \brief Asynchronously executes a CLS function.
+  ///
+  /// \param[in] oid the object ID on which to execute the CLS function.
+  /// \param[in] cls the name of the CLS.
+  /// \param[in] method the name of the CLS function.
+  /// \param[in] in a bufferlist to send data to the CLS function.
+  /// \param[in] out a bufferlist to recieve data from the CLS function. It must
+  /// stay alive until the callback is invoked.
+  /// \param[in] callback the callback to invoke with the return code of the CLS
+  /// function. It is only invoked if the call was issued, i.e. if aio_exec
+  /// returns zero, and may be invoked from any thread.
+  virtual int aio_exec(const std::string& oid, const char* cls, const char* method,
+                       ceph::bufferlist& in, ceph::bufferlist* out,
+                       AioCallback callback) = 0;
+
   virtual std::vector<std::string> list() = 0;
 
   virtual int stat(const std::string& oid, uint64_t* psize) = 0;
@@ -74,6 +106,9 @@ class ARROW_DS_EXPORT IoCtxWrapper : public IoCtxInterface {
            uint64_t offset) override;
   int exec(const std::string& oid, const char* cls, const char* method,
            ceph::bufferlist& in, ceph::bufferlist& out) override;
+  int aio_exec(const std::string& oid, const char* cls, const char* method,
+               ceph::bufferlist& in, ceph::bufferlist* out,
+               AioCallback callback) override;
   std::vector<std::string> list() override;
 
   int stat(const std::string& oid, uint64_t* psize) override;
@@ -86,6 +121,7 @@ class ARROW_DS_EXPORT IoCtxWrapper : public IoCtxInterface {
 class ARROW_DS_EXPORT RadosInterface {
  public:
   RadosInterface() {}
+  virtual ~RadosInterface() = default;
 
   /// \brief Initializes a cluster handle.
   ///
@@ -128,5 +164,138 @@ class ARROW_DS_EXPORT RadosWrapper : public RadosInterface {
   librados::Rados* cluster;
 };
 
+/// \class BufferptrBuffer
+/// \brief A Buffer viewing the memory of a ceph::bufferptr. The Buffer holds a
+/// reference to the bufferptr, which keeps the underlying Ceph memory alive for
+/// as long as the Buffer (or any slice of it) is.
+class ARROW_DS_EXPORT BufferptrBuffer : public Buffer {
+ public:
+  explicit BufferptrBuffer(ceph::bufferptr ptr)
+      : Buffer(reinterpret_cast<const uint8_t*>(ptr.c_str()), ptr.length()),
+        ptr_(std::move(ptr)) {}
+
+  const ceph::bufferptr& ptr() const { return ptr_; }
+
+ private:
+  ceph::bufferptr ptr_;
+};
+
+/// \class BufferlistRandomAccessFile
+/// \brief A RandomAccessFile over the segments of a ceph::bufferlist.
+///
+/// Reads that fall within a single segment of the bufferlist return a
+/// BufferptrBuffer over that segment without copying. Only reads spanning
+/// several segments are copied into a newly allocated Buffer.
+class ARROW_DS_EXPORT BufferlistRandomAccessFile
+    : public io::internal::RandomAccessFileConcurrencyWrapper<
+          BufferlistRandomAccessFile> {
+ public:
+  explicit BufferlistRandomAccessFile(std::shared_ptr<ceph::bufferlist> bl,
+                                      MemoryPool* pool = default_memory_pool());
+
+  bool closed() const override { return !is_open_; }
+
+  bool supports_zero_copy() const override { return true; }
+
+ protected:
+  friend RandomAccessFileConcurrencyWrapper<BufferlistRandomAccessFile>;
+
+  Status DoClose();
+
+  Result<int64_t> DoRead(int64_t nbytes, void* out);
+  Result<std::shared_ptr<Buffer>> DoRead(int64_t nbytes);
+  Result<int64_t> DoReadAt(int64_t position, int64_t nbytes, void* out);
+  Result<std::shared_ptr<Buffer>> DoReadAt(int64_t position, int64_t nbytes);
+
+  Result<int64_t> DoTell() const;
+  Status DoSeek(int64_t position);
+  Result<int64_t> DoGetSize();
+
+  Status CheckClosed() const {
+    if (!is_open_) {
+      return Status::Invalid("Operation forbidden on closed BufferlistRandomAccessFile");
+    }
+    return Status::OK();
+  }
+
+  /// Return the index of the segment containing the given position.
+  size_t FindSegment(int64_t position) const;
+
+  std::shared_ptr<ceph::bufferlist> bl_;
+  MemoryPool* pool_;
+  std::vector<ceph::bufferptr> segments_;
+  /// The offset of each segment from the beginning of the bufferlist.
+  std::vector<int64_t> segment_offsets_;
+  int64_t size_ = 0;
+  int64_t position_ = 0;
+  bool is_open_ = true;
+};
+
+/// \class BufferptrMemoryPool
+/// \brief A MemoryPool whose allocations are backed by ceph::bufferptr.
+///
+/// Buffers allocated from this pool can be appended to a ceph::bufferlist by
+/// reference instead of by copy, see BufferlistOutputStream.
+class ARROW_DS_EXPORT BufferptrMemoryPool : public MemoryPool {
+ public:
+  BufferptrMemoryPool() = default;
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+  Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  std::string backend_name() const override { return "ceph_bufferptr"; }
+
+  /// \brief Look up the bufferptr backing a memory region.
+  ///
+  /// \param[in] data the start of the region.
+  /// \param[in] size the length of the region.
+  /// \param[out] out a bufferptr referencing exactly the region.
+  /// \return true if the region lies within a live allocation of this pool.
+  bool Find(const uint8_t* data, int64_t size, ceph::bufferptr* out) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<const uint8_t*, ceph::bufferptr> allocations_;
+  int64_t bytes_allocated_ = 0;
+  int64_t max_memory_ = 0;
+};
+
+/// \class BufferlistOutputStream
+/// \brief An OutputStream that appends everything written to it to a
+/// ceph::bufferlist, so that IPC messages can be written straight into the
+/// bufferlist sent back to the client.
+///
+/// Buffers written through Write(const std::shared_ptr<Buffer>&) that were
+/// allocated from the stream's BufferptrMemoryPool are appended by reference;
+/// everything else is copied.
+class ARROW_DS_EXPORT BufferlistOutputStream : public io::OutputStream {
+ public:
+  explicit BufferlistOutputStream(
+      ceph::bufferlist* bl, std::shared_ptr<BufferptrMemoryPool> pool = NULLPTR)
+      : bl_(bl), pool_(std::move(pool)) {}
+
+  Status Close() override {
+    closed_ = true;
+    return Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  Result<int64_t> Tell() const override { return position_; }
+
+  Status Write(const void* data, int64_t nbytes) override;
+
+  Status Write(const std::shared_ptr<Buffer>& data) override;
+
+ protected:
+  ceph::bufferlist* bl_;
+  std::shared_ptr<BufferptrMemoryPool> pool_;
+  bool closed_ = false;
+  int64_t position_ = 0;
+};
+
 }  // namespace dataset
 }  // namespace arrow
@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// A mock object store for the tests and benchmarks of the RADOS offload path,
+// which runs the scan_op logic in-process on local files instead of on the OSDs.
+
+#pragma once
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/dataset/discovery.h"
+#include "arrow/dataset/file_rados_parquet.h"
+#include "arrow/filesystem/localfs.h"
+#include "arrow/io/file.h"
+#include "arrow/testing/gtest_util.h"
+#include "arrow/testing/random.h"
+#include "arrow/util/io_util.h"
+#include "arrow/util/thread_pool.h"
+#include "parquet/arrow/writer.h"
+
+namespace arrow {
+namespace dataset {
+
+struct MockObjectStoreOptions {
+  /// The number of scan_op calls the OSDs run at once.
+  int num_threads = 4;
+  /// The round trip time added to every call.
+  std::chrono::microseconds latency{0};
+  /// The bandwidth of the link shared by all the calls, in bytes per second,
+  /// or 0 for an unlimited bandwidth.
+  double bandwidth = 0;
+  /// The number of files, each holding the same number of rows.
+  int num_files = 8;
+  int64_t rows_per_file = 1 << 17;
+  int64_t rows_per_row_group = 1 << 15;
+};
+
+/// \brief An object store backed by local Parquet files, whose objects are named
+/// as DirectObjectAccess expects from the inodes of the files.
+///
+/// Column "a" of a file holds the index of each row, so that a filter on it
+/// selects known rows and row groups, "b" random doubles and "c" a few groups.
+class MockObjectStore {
+ public:
+  static std::shared_ptr<MockObjectStore> Make(MockObjectStoreOptions options) {
+    auto store = std::make_shared<MockObjectStore>();
+    store->options_ = options;
+    ABORT_NOT_OK(store->WriteFiles());
+    store->pool_ = *::arrow::internal::ThreadPool::Make(options.num_threads);
+    return store;
+  }
+
+  /// Run the scan_op CLS function on an object, returning its return code.
+  int Exec(const std::string& oid, ceph::bufferlist& in, ceph::bufferlist* out) {
+    int error_code = ErrorCode(oid);
+    if (error_code > 0) return error_code;
+
+    compute::Expression filter;
+    compute::Expression partition_expression;
+    std::shared_ptr<Schema> projected_schema;
+    std::shared_ptr<Schema> dataset_schema;
+    int64_t file_size;
+    int64_t file_format = 0;
+    std::vector<int> row_groups;
+    std::vector<PushdownAggregate> aggregates;
+    std::vector<std::string> keys;
+    std::string compression;
+    if (!DeserializeScanRequest(&filter, &partition_expression, &projected_schema,
+                                &dataset_schema, file_size, file_format, in, &row_groups,
+                                &aggregates, &keys, &compression)
+             .ok()) {
+      return SCAN_REQ_DESER_ERR_CODE;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_.push_back(row_groups);
+    }
+
+    auto file = io::ReadableFile::Open(objects_.at(oid));
+    if (!file.ok() ||
+        !ScanObject(*file, filter, partition_expression, projected_schema,
+                    dataset_schema, file_format, row_groups, aggregates, keys,
+                    compression, *out)
+             .ok()) {
+      return SCAN_ERR_CODE;
+    }
+
+    Transfer(in.length() + out->length());
+    return 0;
+  }
+
+  /// Run the scan_op CLS function on an object on the OSD threads, returning
+  /// whether the call was issued like IoCtxInterface::aio_exec.
+  int ExecAsync(const std::string& oid, ceph::bufferlist& in, ceph::bufferlist* out,
+                IoCtxInterface::AioCallback callback) {
+    int error_code = ErrorCode(oid);
+    if (error_code < 0) return error_code;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      max_in_flight_ = std::max(max_in_flight_, ++in_flight_);
+    }
+    ABORT_NOT_OK(pool_->Spawn([=, &in] {
+      int e = Exec(oid, in, out);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+      }
+      callback(e);
+    }));
+    return 0;
+  }
+
+  /// Make the calls on the object of a file fail: a positive code is returned
+  /// by the scan_op CLS function, a negative one by aio_exec itself.
+  void Fail(int file_index, int error_code) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_codes_[oids_[file_index]] = error_code;
+  }
+
+  /// Return the row groups requested by each scan_op call so far, in the order
+  /// in which the calls were run.
+  std::vector<std::vector<int>> requests() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_;
+  }
+
+  /// Return the largest number of asynchronous calls which were in flight at once.
+  int64_t max_in_flight() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_in_flight_;
+  }
+
+  const std::vector<std::string>& paths() const { return paths_; }
+
+  const std::vector<uint64_t>& inodes() const { return inodes_; }
+
+  int64_t total_bytes() const { return total_bytes_; }
+
+ protected:
+  Status WriteFiles() {
+    ARROW_ASSIGN_OR_RAISE(dir_, ::arrow::internal::TemporaryDir::Make("rados-mock-"));
+    random::RandomArrayGenerator rng(42);
+    auto schema = arrow::schema({field("a", int64()), field("b", float64()),
+                                 field("c", int64())});
+    const int64_t num_rows = options_.rows_per_file;
+    for (int i = 0; i < options_.num_files; ++i) {
+      std::shared_ptr<Array> a;
+      Int64Builder builder;
+      for (int64_t row = 0; row < num_rows; ++row) {
+        ARROW_RETURN_NOT_OK(builder.Append(row));
+      }
+      ARROW_RETURN_NOT_OK(builder.Finish(&a));
+      auto table = Table::Make(
+          schema, {a, rng.Float64(num_rows, 0, 1), rng.Int64(num_rows, 0, 15)});
+
+      auto path = dir_->path().ToString() + "file" + std::to_string(i) + ".parquet";
+      ARROW_ASSIGN_OR_RAISE(auto sink, io::FileOutputStream::Open(path));
+      ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, default_memory_pool(), sink,
+                                                     options_.rows_per_row_group));
+      ARROW_RETURN_NOT_OK(sink->Close());
+
+      struct stat st;
+      if (stat(path.c_str(), &st) < 0) return Status::IOError("Failed to stat ", path);
+      auto oid = DirectObjectAccess::ConvertFileInodeToObjectID(st.st_ino);
+      objects_[oid] = path;
+      oids_.push_back(oid);
+      paths_.push_back(path);
+      inodes_.push_back(st.st_ino);
+      total_bytes_ += st.st_size;
+    }
+    return Status::OK();
+  }
+
+  int ErrorCode(const std::string& oid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = error_codes_.find(oid);
+    return it == error_codes_.end() ? 0 : it->second;
+  }
+
+  /// Wait until some bytes have crossed the link and the latency has elapsed.
+  void Transfer(int64_t nbytes) {
+    auto done = std::chrono::steady_clock::now() + options_.latency;
+    if (options_.bandwidth > 0) {
+      auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(nbytes / options_.bandwidth));
+      std::lock_guard<std::mutex> lock(link_mutex_);
+      link_free_ = std::max(link_free_, std::chrono::steady_clock::now()) + duration;
+      done = std::max(done, link_free_);
+    }
+    std::this_thread::sleep_until(done);
+  }
+
+  MockObjectStoreOptions options_;
+  std::unique_ptr<::arrow::internal::TemporaryDir> dir_;
+  std::map<std::string, std::string> objects_;
+  std::vector<std::string> oids_;
+  std::vector<std::string> paths_;
+  std::vector<uint64_t> inodes_;
+  int64_t total_bytes_ = 0;
+  std::shared_ptr<::arrow::internal::ThreadPool> pool_;
+  std::mutex link_mutex_;
+  std::chrono::steady_clock::time_point link_free_;
+
+  std::mutex mutex_;
+  std::map<std::string, int> error_codes_;
+  std::vector<std::vector<int>> requests_;
+  int64_t in_flight_ = 0;
+  int64_t max_in_flight_ = 0;
+};
+
+class MockIoCtx : public IoCtxInterface {
+ public:
+  explicit MockIoCtx(std::shared_ptr<MockObjectStore> store) : store_(std::move(store)) {}
+
+  int write_full(const std::string& oid, ceph::bufferlist& bl) override { return -1; }
+  int read(const std::string& oid, ceph::bufferlist& bl, size_t len,
+           uint64_t offset) override {
+    return -1;
+  }
+  int exec(const std::string& oid, const char* cls, const char* method,
+           ceph::bufferlist& in, ceph::bufferlist& out) override {
+    return store_->Exec(oid, in, &out);
+  }
+  int aio_exec(const std::string& oid, const char* cls, const char* method,
+               ceph::bufferlist& in, ceph::bufferlist* out,
+               AioCallback callback) override {
+    return store_->ExecAsync(oid, in, out, std::move(callback));
+  }
+  std::vector<std::string> list() override { return {}; }
+  int stat(const std::string& oid, uint64_t* psize) override { return -1; }
+
+ private:
+  void setIoCtx(librados::IoCtx* ioCtx_) override {}
+
+  std::shared_ptr<MockObjectStore> store_;
+};
+
+class MockRados : public RadosInterface {
+ public:
+  int init2(const char* const name, const char* const clustername,
+            uint64_t flags) override {
+    return 0;
+  }
+  int ioctx_create(const char* name, IoCtxInterface* pioctx) override { return 0; }
+  int conf_read_file(const char* const path) override { return 0; }
+  int connect() override { return 0; }
+  void shutdown() override {}
+};
+
+/// Make a connection whose handles all run their calls on a mock object store.
+inline std::shared_ptr<connection::RadosConnection> MakeMockRadosConnection(
+    const std::shared_ptr<MockObjectStore>& store, int num_handles,
+    int64_t max_outstanding_ops =
+        connection::RadosConnection::kDefaultMaxOutstandingOps) {
+  std::vector<std::unique_ptr<connection::RadosHandle>> handles;
+  for (int i = 0; i < num_handles; ++i) {
+    handles.emplace_back(new connection::RadosHandle(
+        std::unique_ptr<RadosInterface>(new MockRados()),
+        std::unique_ptr<IoCtxInterface>(new MockIoCtx(store))));
+  }
+  connection::RadosConnection::RadosConnectionCtx ctx("", "", "", "", "",
+                                                      max_outstanding_ops);
+  return std::make_shared<connection::RadosConnection>(ctx, std::move(handles));
+}
+
+/// Make a dataset of the files of a mock object store, scanned through RADOS.
+inline std::shared_ptr<Dataset> MakeMockRadosDataset(
+    const std::shared_ptr<MockObjectStore>& store, int num_handles,
+    int64_t max_outstanding_ops =
+        connection::RadosConnection::kDefaultMaxOutstandingOps) {
+  auto format = std::make_shared<RadosParquetFileFormat>(
+      MakeMockRadosConnection(store, num_handles, max_outstanding_ops));
+
+  EXPECT_OK_AND_ASSIGN(auto factory, FileSystemDatasetFactory::Make(
+                                         std::make_shared<fs::LocalFileSystem>(),
+                                         store->paths(), format, {}));
+  EXPECT_OK_AND_ASSIGN(auto dataset, factory->Finish());
+  return dataset;
+}
+
+}  // namespace dataset
+}  // namespace arrow
@@ -73,9 +73,11 @@ class BitWriter {
   /// For more details on vlq:
   /// en.wikipedia.org/wiki/Variable-length_quantity
   bool PutVlqInt(uint32_t v);
+  bool PutVlqInt(uint64_t v);
 
   // Writes an int zigzag encoded.
   bool PutZigZagVlqInt(int32_t v);
+  bool PutZigZagVlqInt(int64_t v);
 
   /// Get a pointer to the next aligned byte and advance the underlying buffer
   /// by num_bytes.
@@ -130,7 +132,7 @@ class BitReader {
   }
 
   /// Gets the next value from the buffer.  Returns true if 'v' could be read or false if
-  /// there are not enough bytes left. num_bits must be <= 32.
+  /// there are not enough bytes left. num_bits must be <= 64.
   template <typename T>
   bool GetValue(int num_bits, T* v);
 
@@ -151,9 +153,15 @@ class BitReader {
   /// the beginning of a byte. Return false if there were not enough bytes in
   /// the buffer.
   bool GetVlqInt(uint32_t* v);
+  bool GetVlqInt(uint64_t* v);
 
   // Reads a zigzag encoded int `into` v.
   bool GetZigZagVlqInt(int32_t* v);
+  bool GetZigZagVlqInt(int64_t* v);
+
+  /// Skip num_bits bits of the stream. Return false if there were not enough bits
+  /// left.
+  bool Advance(int64_t num_bits);
 
   /// Returns the number of bytes left in the stream, not including the current
   /// byte (i.e., there may be an additional fraction of a byte).
@@ -164,6 +172,8 @@ class BitReader {
 
   /// Maximum byte length of a vlq encoded int
   static constexpr int kMaxVlqByteLength = 5;
+  /// Maximum byte length of a vlq encoded 64 bit int
+  static constexpr int kMaxVlqByteLengthForInt64 = 10;
 
  private:
   const uint8_t* buffer_;
@@ -263,8 +273,10 @@ inline void GetValue_(int num_bits, T* v, int max_bytes, const uint8_t* buffer,
 #pragma warning(disable : 4800 4805)
 #endif
     // Read bits of v that crossed into new buffered_values_
-    *v = *v | static_cast<T>(BitUtil::TrailingBits(*buffered_values, *bit_offset)
-                             << (num_bits - *bit_offset));
+    if (*bit_offset != 0) {
+      *v = *v | static_cast<T>(BitUtil::TrailingBits(*buffered_values, *bit_offset)
+                               << (num_bits - *bit_offset));
+    }
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -282,8 +294,7 @@ inline bool BitReader::GetValue(int num_bits, T* v) {
 template <typename T>
 inline int BitReader::GetBatch(int num_bits, T* v, int batch_size) {
   DCHECK(buffer_ != NULL);
-  // TODO: revisit this limit if necessary
-  DCHECK_LE(num_bits, 32);
+  DCHECK_LE(num_bits, 64);
   DCHECK_LE(num_bits, static_cast<int>(sizeof(T) * 8));
 
   int bit_offset = bit_offset_;
@@ -313,7 +324,8 @@ inline int BitReader::GetBatch(int num_bits, T* v, int batch_size) {
                            reinterpret_cast<uint32_t*>(v + i), batch_size - i, num_bits);
     i += num_unpacked;
     byte_offset += num_unpacked * num_bits / 8;
-  } else {
+  } else if (num_bits <= 32) {
+    // Values wider than 32 bits are all read one by one below
     const int buffer_size = 1024;
     uint32_t unpack_buffer[buffer_size];
     while (i < batch_size) {
@@ -419,13 +431,76 @@ inline bool BitReader::GetVlqInt(uint32_t* v) {
 
 inline bool BitWriter::PutZigZagVlqInt(int32_t v) {
   auto u_v = ::arrow::util::SafeCopy<uint32_t>(v);
-  return PutVlqInt((u_v << 1) ^ (u_v >> 31));
+  // The arithmetic shift spreads the sign bit over the whole value
+  u_v = (u_v << 1) ^ static_cast<uint32_t>(v >> 31);
+  return PutVlqInt(u_v);
 }
 
 inline bool BitReader::GetZigZagVlqInt(int32_t* v) {
   uint32_t u;
   if (!GetVlqInt(&u)) return false;
-  *v = ::arrow::util::SafeCopy<int32_t>((u >> 1) ^ (u << 31));
+  u = (u >> 1) ^ (~(u & 1) + 1);
+  *v = ::arrow::util::SafeCopy<int32_t>(u);
+  return true;
+}
+
+inline bool BitWriter::PutVlqInt(uint64_t v) {
+  bool result = true;
+  while ((v & 0xFFFFFFFFFFFFFF80ULL) != 0ULL) {
+    result &= PutAligned<uint8_t>(static_cast<uint8_t>((v & 0x7F) | 0x80), 1);
+    v >>= 7;
+  }
+  result &= PutAligned<uint8_t>(static_cast<uint8_t>(v & 0x7F), 1);
+  return result;
+}
+
+inline bool BitReader::GetVlqInt(uint64_t* v) {
+  uint64_t tmp = 0;
+
+  for (int i = 0; i < kMaxVlqByteLengthForInt64; i++) {
+    uint8_t byte = 0;
+    if (ARROW_PREDICT_FALSE(!GetAligned<uint8_t>(1, &byte))) {
+      return false;
+    }
+    tmp |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+
+    if ((byte & 0x80) == 0) {
+      *v = tmp;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline bool BitWriter::PutZigZagVlqInt(int64_t v) {
+  auto u_v = ::arrow::util::SafeCopy<uint64_t>(v);
+  u_v = (u_v << 1) ^ static_cast<uint64_t>(v >> 63);
+  return PutVlqInt(u_v);
+}
+
+inline bool BitReader::GetZigZagVlqInt(int64_t* v) {
+  uint64_t u;
+  if (!GetVlqInt(&u)) return false;
+  u = (u >> 1) ^ (~(u & 1) + 1);
+  *v = ::arrow::util::SafeCopy<int64_t>(u);
+  return true;
+}
+
+inline bool BitReader::Advance(int64_t num_bits) {
+  const int64_t bits_required = bit_offset_ + num_bits;
+  if (ARROW_PREDICT_FALSE(BitUtil::BytesForBits(bits_required) >
+                          max_bytes_ - byte_offset_)) {
+    return false;
+  }
+  byte_offset_ += static_cast<int>(bits_required >> 3);
+  bit_offset_ = static_cast<int>(bits_required & 7);
+
+  // Reset buffered_values_ to the bytes following the new byte offset
+  buffered_values_ = 0;
+  const int bytes_remaining = max_bytes_ - byte_offset_;
+  memcpy(&buffered_values_, buffer_ + byte_offset_, std::min(8, bytes_remaining));
+  buffered_values_ = arrow::BitUtil::FromLittleEndian(buffered_values_);
   return true;
 }
 
@@ -1939,24 +1939,81 @@ TEST(BitUtil, RoundUpToPowerOf2) {
 #undef U64
 #undef S64
 
-static void TestZigZag(int32_t v) {
+static void TestZigZag(int32_t v, std::vector<uint8_t> expected_bytes) {
   uint8_t buffer[BitUtil::BitReader::kMaxVlqByteLength] = {};
   BitUtil::BitWriter writer(buffer, sizeof(buffer));
   BitUtil::BitReader reader(buffer, sizeof(buffer));
   writer.PutZigZagVlqInt(v);
+  writer.Flush();
+  EXPECT_EQ(static_cast<int>(expected_bytes.size()), writer.bytes_written());
+  EXPECT_EQ(expected_bytes,
+            std::vector<uint8_t>(buffer, buffer + writer.bytes_written()));
   int32_t result;
   EXPECT_TRUE(reader.GetZigZagVlqInt(&result));
   EXPECT_EQ(v, result);
 }
 
 TEST(BitStreamUtil, ZigZag) {
-  TestZigZag(0);
-  TestZigZag(1);
-  TestZigZag(1234);
-  TestZigZag(-1);
-  TestZigZag(-1234);
-  TestZigZag(std::numeric_limits<int32_t>::max());
-  TestZigZag(-std::numeric_limits<int32_t>::max());
+  TestZigZag(0, {0});
+  TestZigZag(1, {2});
+  TestZigZag(1234, {0xa4, 0x13});
+  TestZigZag(-1, {1});
+  TestZigZag(-1234, {0xa3, 0x13});
+  TestZigZag(std::numeric_limits<int32_t>::max(), {0xfe, 0xff, 0xff, 0xff, 0x0f});
+  TestZigZag(-std::numeric_limits<int32_t>::max(), {0xfd, 0xff, 0xff, 0xff, 0x0f});
+}
+
+static void TestZigZag64(int64_t v, std::vector<uint8_t> expected_bytes) {
+  uint8_t buffer[BitUtil::BitReader::kMaxVlqByteLengthForInt64] = {};
+  BitUtil::BitWriter writer(buffer, sizeof(buffer));
+  BitUtil::BitReader reader(buffer, sizeof(buffer));
+  writer.PutZigZagVlqInt(v);
+  writer.Flush();
+  EXPECT_EQ(static_cast<int>(expected_bytes.size()), writer.bytes_written());
+  EXPECT_EQ(expected_bytes,
+            std::vector<uint8_t>(buffer, buffer + writer.bytes_written()));
+  int64_t result;
+  EXPECT_TRUE(reader.GetZigZagVlqInt(&result));
+  EXPECT_EQ(v, result);
+}
+
+TEST(BitStreamUtil, ZigZag64) {
+  TestZigZag64(0, {0});
+  TestZigZag64(1, {2});
+  TestZigZag64(1234, {0xa4, 0x13});
+  TestZigZag64(-1, {1});
+  TestZigZag64(-1234, {0xa3, 0x13});
+  TestZigZag64(std::numeric_limits<int64_t>::max(),
+               {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01});
+  TestZigZag64(std::numeric_limits<int64_t>::min(),
+               {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01});
+}
+
+TEST(BitStreamUtil, GetBatchWide) {
+  // Values wider than 32 bits, packed by halves
+  constexpr int kNumValues = 37;
+  constexpr int kNumBits = 61;
+  std::vector<uint64_t> values(kNumValues);
+  for (int i = 0; i < kNumValues; ++i) {
+    values[i] = (static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ULL) >> (64 - kNumBits);
+  }
+  std::vector<uint8_t> buffer(BitUtil::BytesForBits(kNumValues * kNumBits));
+  BitUtil::BitWriter writer(buffer.data(), static_cast<int>(buffer.size()));
+  for (uint64_t value : values) {
+    ASSERT_TRUE(writer.PutValue(value & 0xFFFFFFFFULL, 32));
+    ASSERT_TRUE(writer.PutValue(value >> 32, kNumBits - 32));
+  }
+  writer.Flush();
+
+  BitUtil::BitReader reader(buffer.data(), static_cast<int>(buffer.size()));
+  uint64_t first;
+  ASSERT_TRUE(reader.GetValue(kNumBits, &first));
+  ASSERT_EQ(values[0], first);
+  std::vector<uint64_t> result(kNumValues - 1);
+  ASSERT_EQ(kNumValues - 1, reader.GetBatch(kNumBits, result.data(), kNumValues - 1));
+  for (int i = 1; i < kNumValues; ++i) {
+    ASSERT_EQ(values[i], result[i - 1]) << i;
+  }
 }
 
 TEST(BitUtil, RoundTripLittleEndianTest) {
@@ -1584,6 +1584,25 @@ Result<std::unique_ptr<TemporaryDir>> TemporaryDir::Make(const std::string& pref
       "of the platform temporary directories");
 }
 
+Result<std::unique_ptr<TemporaryDir>> TemporaryDir::Make(
+    const std::string& prefix, const PlatformFilename& base_dir) {
+  const int kNumChars = 8;
+
+  Status st;
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    // Join() does not add a separator if base_dir already ends with one
+    ARROW_ASSIGN_OR_RAISE(auto fn, base_dir.Join(prefix + MakeRandomName(kNumChars)));
+    fn = PlatformFilename(fn.ToNative() + kNativeSep);
+    ARROW_ASSIGN_OR_RAISE(bool created, CreateDir(fn));
+    if (created) {
+      return std::unique_ptr<TemporaryDir>(new TemporaryDir(std::move(fn)));
+    }
+    // The random name already exists in base_dir, try with another name
+    st = Status::IOError("Path already exists: '", fn.ToString(), "'");
+  }
+  return st;
+}
+
 TemporaryDir::TemporaryDir(PlatformFilename&& path) : path_(std::move(path)) {}
 
 TemporaryDir::~TemporaryDir() {
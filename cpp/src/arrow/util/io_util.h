@@ -329,6 +329,10 @@ class ARROW_EXPORT TemporaryDir {
   /// named starting with `prefix`.
   static Result<std::unique_ptr<TemporaryDir>> Make(const std::string& prefix);
 
+  /// Create a temporary subdirectory in `base_dir`, named starting with `prefix`.
+  static Result<std::unique_ptr<TemporaryDir>> Make(const std::string& prefix,
+                                                    const PlatformFilename& base_dir);
+
  private:
   PlatformFilename path_;
 
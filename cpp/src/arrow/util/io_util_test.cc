@@ -512,6 +512,26 @@ TEST(TemporaryDir, Basics) {
   AssertNotExists(child);
 }
 
+TEST(TemporaryDir, BaseDir) {
+  std::unique_ptr<TemporaryDir> base_dir, temp_dir;
+  ASSERT_OK_AND_ASSIGN(base_dir, TemporaryDir::Make("some-base-"));
+  ASSERT_OK_AND_ASSIGN(temp_dir, TemporaryDir::Make("some-prefix-", base_dir->path()));
+  PlatformFilename fn = temp_dir->path();
+  AssertExists(fn);
+  ASSERT_EQ(fn.ToString().find(base_dir->path().ToString()), 0);
+  ASSERT_NE(fn.ToString().find("some-prefix-"), std::string::npos);
+  // base_dir->path() is '/'-terminated, which must not be doubled
+  ASSERT_EQ(fn.ToString().find("//"), std::string::npos);
+
+  temp_dir.reset();
+  AssertNotExists(fn);
+  AssertExists(base_dir->path());
+
+  // The base directory must exist
+  ASSERT_OK_AND_ASSIGN(fn, base_dir->path().Join("nonexistent"));
+  ASSERT_RAISES(IOError, TemporaryDir::Make("some-prefix-", fn));
+}
+
 TEST(CreateDirTree, Basics) {
   std::unique_ptr<TemporaryDir> temp_dir;
   PlatformFilename fn;
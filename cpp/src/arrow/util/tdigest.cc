@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <queue>
 #include <tuple>
 #include <vector>
@@ -340,6 +341,50 @@ class TDigest::TDigestImpl {
     return total_weight_ == 0 ? NAN : sum / total_weight_;
   }
 
+  void GetCentroids(std::vector<double>* means, std::vector<double>* weights,
+                    double* min, double* max) const {
+    const auto& td = tdigests_[current_];
+    means->resize(td.size());
+    weights->resize(td.size());
+    for (size_t i = 0; i < td.size(); ++i) {
+      (*means)[i] = td[i].mean;
+      (*weights)[i] = td[i].weight;
+    }
+    *min = min_;
+    *max = max_;
+  }
+
+  Status SetCentroids(const std::vector<double>& means,
+                      const std::vector<double>& weights, double min, double max) {
+    Reset();
+    if (means.size() != weights.size()) {
+      return Status::Invalid("tdigest centroid means and weights differ in length");
+    }
+    double prev_mean = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < means.size(); ++i) {
+      if (std::isnan(means[i]) || means[i] < prev_mean || !(weights[i] >= 1)) {
+        return Status::Invalid("invalid tdigest centroids");
+      }
+      prev_mean = means[i];
+      total_weight_ += weights[i];
+    }
+    if (means.empty()) {
+      return Status::OK();
+    }
+    min_ = min;
+    max_ = max;
+
+    // the centroids may come from a tdigest with another delta, compress them
+    // to the delta of this one
+    merger_.Reset(total_weight_, &tdigests_[1 - current_]);
+    for (size_t i = 0; i < means.size(); ++i) {
+      merger_.Add(Centroid{means[i], weights[i]});
+    }
+    merger_.Reset(0, nullptr);
+    current_ = 1 - current_;
+    return Status::OK();
+  }
+
   double total_weight() const { return total_weight_; }
 
  private:
@@ -392,6 +437,23 @@ void TDigest::Merge(std::vector<TDigest>* tdigests) {
   impl_->Merge(tdigest_impls);
 }
 
+void TDigest::GetCentroids(std::vector<double>* means, std::vector<double>* weights,
+                           double* min, double* max) {
+  MergeInput();
+  impl_->GetCentroids(means, weights, min, max);
+}
+
+Status TDigest::SetCentroids(const std::vector<double>& means,
+                             const std::vector<double>& weights, double min,
+                             double max) {
+  input_.resize(0);
+  Status st = impl_->SetCentroids(means, weights, min, max);
+  if (!st.ok()) {
+    impl_->Reset();
+  }
+  return st;
+}
+
 double TDigest::Quantile(double q) {
   MergeInput();
   return impl_->Quantile(q);
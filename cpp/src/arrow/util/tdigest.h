@@ -77,6 +77,15 @@ class ARROW_EXPORT TDigest {
   // merge with other t-digests, called infrequently
   void Merge(std::vector<TDigest>* tdigests);
 
+  // export the centroids (sorted by mean) and the extrema of this tdigest,
+  // e.g. to merge it with a tdigest living in another process
+  void GetCentroids(std::vector<double>* means, std::vector<double>* weights,
+                    double* min, double* max);
+
+  // reset this tdigest to centroids exported by GetCentroids
+  Status SetCentroids(const std::vector<double>& means,
+                      const std::vector<double>& weights, double min, double max);
+
   // calculate quantile
   double Quantile(double q);
 
@@ -178,6 +178,27 @@ void TestMerge(const std::vector<std::vector<double>>& values_vector, uint32_t d
     }
   }
 
+  // merge tdigests rebuilt from their exported centroids
+  {
+    std::vector<TDigest> imported;
+    for (auto& other : tds) {
+      std::vector<double> means, weights;
+      double min, max;
+      other.GetCentroids(&means, &weights, &min, &max);
+      TDigest td(delta);
+      ASSERT_OK(td.SetCentroids(means, weights, min, max));
+      ASSERT_OK(td.Validate());
+      imported.push_back(std::move(td));
+    }
+    TDigest td(delta);
+    td.Merge(&imported);
+    ASSERT_OK(td.Validate());
+    for (size_t i = 0; i < quantiles.size(); ++i) {
+      const double tolerance = std::max(std::fabs(expected[i]) * error_ratio, 0.1);
+      EXPECT_NEAR(td.Quantile(quantiles[i]), expected[i], tolerance) << quantiles[i];
+    }
+  }
+
   // merge into a non empty tdigest
   {
     TDigest td = std::move(tds[0]);
@@ -231,6 +252,23 @@ TEST(TDigestTest, MergeNonUniform) {
 #endif
 }
 
+TEST(TDigestTest, SetCentroids) {
+  TDigest td;
+  ASSERT_OK(td.SetCentroids({}, {}, 0, 0));
+  ASSERT_TRUE(td.is_empty());
+
+  ASSERT_OK(td.SetCentroids({1, 2, 6}, {1, 1, 1}, 1, 6));
+  ASSERT_OK(td.Validate());
+  EXPECT_EQ(td.Quantile(0), 1);
+  EXPECT_EQ(td.Quantile(1), 6);
+  EXPECT_EQ(td.Mean(), 3);
+
+  ASSERT_RAISES(Invalid, td.SetCentroids({1, 2}, {1}, 1, 2));
+  ASSERT_RAISES(Invalid, td.SetCentroids({2, 1}, {1, 1}, 1, 2));
+  ASSERT_RAISES(Invalid, td.SetCentroids({1, 2}, {1, 0}, 1, 2));
+  ASSERT_TRUE(td.is_empty());
+}
+
 TEST(TDigestTest, Misc) {
   const size_t size = 100000;
   const double min = -1000, max = 1000;
@@ -11,9 +11,81 @@ namespace apache {
 namespace arrow {
 namespace flatbuf {
 
+struct ScanAggregate;
+struct ScanAggregateBuilder;
+
 struct ScanRequest;
 struct ScanRequestBuilder;
 
+/// An aggregate computed by the OSD for each group of the scan result.
+struct ScanAggregate FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ScanAggregateBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_FUNCTION = 4,
+    VT_TARGET = 6
+  };
+  /// The hash aggregate function, e.g. "hash_sum".
+  const flatbuffers::String *function() const {
+    return GetPointer<const flatbuffers::String *>(VT_FUNCTION);
+  }
+  /// The name of the field to aggregate.
+  const flatbuffers::String *target() const {
+    return GetPointer<const flatbuffers::String *>(VT_TARGET);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_FUNCTION) &&
+           verifier.VerifyString(function()) &&
+           VerifyOffset(verifier, VT_TARGET) &&
+           verifier.VerifyString(target()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ScanAggregateBuilder {
+  typedef ScanAggregate Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_function(flatbuffers::Offset<flatbuffers::String> function) {
+    fbb_.AddOffset(ScanAggregate::VT_FUNCTION, function);
+  }
+  void add_target(flatbuffers::Offset<flatbuffers::String> target) {
+    fbb_.AddOffset(ScanAggregate::VT_TARGET, target);
+  }
+  explicit ScanAggregateBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ScanAggregateBuilder &operator=(const ScanAggregateBuilder &);
+  flatbuffers::Offset<ScanAggregate> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ScanAggregate>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ScanAggregate> CreateScanAggregate(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> function = 0,
+    flatbuffers::Offset<flatbuffers::String> target = 0) {
+  ScanAggregateBuilder builder_(_fbb);
+  builder_.add_target(target);
+  builder_.add_function(function);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ScanAggregate> CreateScanAggregateDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *function = nullptr,
+    const char *target = nullptr) {
+  auto function__ = function ? _fbb.CreateString(function) : 0;
+  auto target__ = target ? _fbb.CreateString(target) : 0;
+  return org::apache::arrow::flatbuf::CreateScanAggregate(
+      _fbb,
+      function__,
+      target__);
+}
+
 struct ScanRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef ScanRequestBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -22,7 +94,11 @@ struct ScanRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_FILTER = 8,
     VT_PARTITION = 10,
     VT_DATASET_SCHEMA = 12,
-    VT_PROJECTION_SCHEMA = 14
+    VT_PROJECTION_SCHEMA = 14,
+    VT_ROW_GROUPS = 16,
+    VT_AGGREGATES = 18,
+    VT_GROUP_KEYS = 20,
+    VT_COMPRESSION = 22
   };
   int64_t file_size() const {
     return GetField<int64_t>(VT_FILE_SIZE, 0);
@@ -42,6 +118,24 @@ struct ScanRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<uint8_t> *projection_schema() const {
     return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PROJECTION_SCHEMA);
   }
+  /// The indices of the row groups to scan. Absent or empty to scan the
+  /// whole file. Only meaningful for Parquet files.
+  const flatbuffers::Vector<int32_t> *row_groups() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_ROW_GROUPS);
+  }
+  /// The partial aggregates to compute instead of returning the scanned rows.
+  const flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>> *aggregates() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>> *>(VT_AGGREGATES);
+  }
+  /// The names of the fields to group the aggregates by.
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *group_keys() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_GROUP_KEYS);
+  }
+  /// The compression of the scan result: "none", "lz4", "zstd", "zstd:<level>"
+  /// or "auto". Absent to use "lz4".
+  const flatbuffers::String *compression() const {
+    return GetPointer<const flatbuffers::String *>(VT_COMPRESSION);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_FILE_SIZE) &&
@@ -54,6 +148,16 @@ struct ScanRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyVector(dataset_schema()) &&
            VerifyOffset(verifier, VT_PROJECTION_SCHEMA) &&
            verifier.VerifyVector(projection_schema()) &&
+           VerifyOffset(verifier, VT_ROW_GROUPS) &&
+           verifier.VerifyVector(row_groups()) &&
+           VerifyOffset(verifier, VT_AGGREGATES) &&
+           verifier.VerifyVector(aggregates()) &&
+           verifier.VerifyVectorOfTables(aggregates()) &&
+           VerifyOffset(verifier, VT_GROUP_KEYS) &&
+           verifier.VerifyVector(group_keys()) &&
+           verifier.VerifyVectorOfStrings(group_keys()) &&
+           VerifyOffset(verifier, VT_COMPRESSION) &&
+           verifier.VerifyString(compression()) &&
            verifier.EndTable();
   }
 };
@@ -80,6 +184,18 @@ struct ScanRequestBuilder {
   void add_projection_schema(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> projection_schema) {
     fbb_.AddOffset(ScanRequest::VT_PROJECTION_SCHEMA, projection_schema);
   }
+  void add_row_groups(flatbuffers::Offset<flatbuffers::Vector<int32_t>> row_groups) {
+    fbb_.AddOffset(ScanRequest::VT_ROW_GROUPS, row_groups);
+  }
+  void add_aggregates(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>>> aggregates) {
+    fbb_.AddOffset(ScanRequest::VT_AGGREGATES, aggregates);
+  }
+  void add_group_keys(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> group_keys) {
+    fbb_.AddOffset(ScanRequest::VT_GROUP_KEYS, group_keys);
+  }
+  void add_compression(flatbuffers::Offset<flatbuffers::String> compression) {
+    fbb_.AddOffset(ScanRequest::VT_COMPRESSION, compression);
+  }
   explicit ScanRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -99,10 +215,18 @@ inline flatbuffers::Offset<ScanRequest> CreateScanRequest(
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> filter = 0,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> partition = 0,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dataset_schema = 0,
-    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> projection_schema = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> projection_schema = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> row_groups = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>>> aggregates = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> group_keys = 0,
+    flatbuffers::Offset<flatbuffers::String> compression = 0) {
   ScanRequestBuilder builder_(_fbb);
   builder_.add_file_format(file_format);
   builder_.add_file_size(file_size);
+  builder_.add_compression(compression);
+  builder_.add_group_keys(group_keys);
+  builder_.add_aggregates(aggregates);
+  builder_.add_row_groups(row_groups);
   builder_.add_projection_schema(projection_schema);
   builder_.add_dataset_schema(dataset_schema);
   builder_.add_partition(partition);
@@ -117,11 +241,19 @@ inline flatbuffers::Offset<ScanRequest> CreateScanRequestDirect(
     const std::vector<uint8_t> *filter = nullptr,
     const std::vector<uint8_t> *partition = nullptr,
     const std::vector<uint8_t> *dataset_schema = nullptr,
-    const std::vector<uint8_t> *projection_schema = nullptr) {
+    const std::vector<uint8_t> *projection_schema = nullptr,
+    const std::vector<int32_t> *row_groups = nullptr,
+    const std::vector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>> *aggregates = nullptr,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *group_keys = nullptr,
+    const char *compression = nullptr) {
   auto filter__ = filter ? _fbb.CreateVector<uint8_t>(*filter) : 0;
   auto partition__ = partition ? _fbb.CreateVector<uint8_t>(*partition) : 0;
   auto dataset_schema__ = dataset_schema ? _fbb.CreateVector<uint8_t>(*dataset_schema) : 0;
   auto projection_schema__ = projection_schema ? _fbb.CreateVector<uint8_t>(*projection_schema) : 0;
+  auto row_groups__ = row_groups ? _fbb.CreateVector<int32_t>(*row_groups) : 0;
+  auto aggregates__ = aggregates ? _fbb.CreateVector<flatbuffers::Offset<org::apache::arrow::flatbuf::ScanAggregate>>(*aggregates) : 0;
+  auto group_keys__ = group_keys ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*group_keys) : 0;
+  auto compression__ = compression ? _fbb.CreateString(compression) : 0;
   return org::apache::arrow::flatbuf::CreateScanRequest(
       _fbb,
       file_size,
@@ -129,7 +261,11 @@ inline flatbuffers::Offset<ScanRequest> CreateScanRequestDirect(
       filter__,
       partition__,
       dataset_schema__,
-      projection_schema__);
+      projection_schema__,
+      row_groups__,
+      aggregates__,
+      group_keys__,
+      compression__);
 }
 
 inline const org::apache::arrow::flatbuf::ScanRequest *GetScanRequest(const void *buf) {
@@ -57,6 +57,7 @@
 #include "parquet/arrow/schema.h"
 #include "parquet/arrow/test_util.h"
 #include "parquet/arrow/writer.h"
+#include "parquet/bloom_filter.h"
 #include "parquet/column_writer.h"
 #include "parquet/file_writer.h"
 #include "parquet/test_util.h"
@@ -2216,6 +2217,262 @@ TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   AssertTablesEqual(*table, *concatenated, /*same_chunk_layout=*/false);
 }
 
+// A table of two columns holding the row index, written in data pages of 100 rows
+// with a page index
+void MakePageIndexedTable(int64_t num_rows, std::shared_ptr<Table>* table,
+                          std::shared_ptr<Buffer>* buffer) {
+  ::arrow::Int64Builder x_builder;
+  ::arrow::DoubleBuilder y_builder;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    ASSERT_OK(x_builder.Append(i));
+    if (i % 10 == 0) {
+      ASSERT_OK(y_builder.AppendNull());
+    } else {
+      ASSERT_OK(y_builder.Append(static_cast<double>(i)));
+    }
+  }
+  std::shared_ptr<Array> x, y;
+  ASSERT_OK(x_builder.Finish(&x));
+  ASSERT_OK(y_builder.Finish(&y));
+  *table = Table::Make(::arrow::schema({::arrow::field("x", ::arrow::int64()),
+                                        ::arrow::field("y", ::arrow::float64())}),
+                       {x, y});
+
+  auto sink = CreateOutputStream();
+  auto write_props = WriterProperties::Builder()
+                         .write_batch_size(100)
+                         ->data_pagesize(1)
+                         ->disable_dictionary()
+                         ->enable_write_page_index()
+                         ->build();
+  ASSERT_OK_NO_THROW(WriteTable(**table, ::arrow::default_memory_pool(), sink, num_rows,
+                                write_props, default_arrow_writer_properties()));
+  ASSERT_OK_AND_ASSIGN(*buffer, sink->Finish());
+}
+
+TEST(TestArrowReadWrite, PageIndexRoundTrip) {
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(MakePageIndexedTable(1000, &table, &buffer));
+
+  auto reader = ParquetFileReader::Open(std::make_shared<BufferReader>(buffer));
+  auto row_group = reader->RowGroup(0);
+  ASSERT_TRUE(row_group->metadata()->ColumnChunk(0)->has_column_index());
+  ASSERT_TRUE(row_group->metadata()->ColumnChunk(1)->has_offset_index());
+
+  std::unique_ptr<OffsetIndex> offset_index = row_group->GetOffsetIndex(0);
+  ASSERT_NE(nullptr, offset_index);
+  ASSERT_EQ(10, offset_index->num_pages());
+  for (int i = 0; i < offset_index->num_pages(); ++i) {
+    ASSERT_EQ(i * 100, offset_index->page_locations()[i].first_row_index);
+  }
+
+  std::unique_ptr<ColumnIndex> column_index = row_group->GetColumnIndex(0);
+  ASSERT_NE(nullptr, column_index);
+  ASSERT_EQ(10, column_index->num_pages());
+  auto stats =
+      checked_pointer_cast<Int64Statistics>(column_index->page_statistics(3, 100));
+  ASSERT_EQ(300, stats->min());
+  ASSERT_EQ(399, stats->max());
+
+  column_index = row_group->GetColumnIndex(1);
+  ASSERT_NE(nullptr, column_index);
+  ASSERT_TRUE(column_index->has_null_counts());
+  ASSERT_EQ(10, column_index->null_counts()[3]);
+  ASSERT_FALSE(column_index->null_pages()[3]);
+}
+
+TEST(TestArrowReadWrite, SetRowGroupRowRanges) {
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(MakePageIndexedTable(1000, &table, &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(), &reader));
+  // The ranges are widened to the pages holding rows [200, 400) and [700, 800)
+  reader->SetRowGroupRowRanges(0, {{250, 349}, {705, 710}});
+
+  ASSERT_OK_AND_ASSIGN(auto expected,
+                       ::arrow::ConcatenateTables({table->Slice(200, 200),
+                                                   table->Slice(700, 100)}));
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, &result));
+  AssertTablesEqual(*expected, *result, /*same_chunk_layout=*/false);
+
+  std::unique_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader({0}, {1}, &batch_reader));
+  ASSERT_OK_AND_ASSIGN(result, Table::FromRecordBatchReader(batch_reader.get()));
+  ASSERT_OK_AND_ASSIGN(expected, expected->SelectColumns({1}));
+  AssertTablesEqual(*expected, *result, /*same_chunk_layout=*/false);
+}
+
+TEST(TestArrowReadWrite, ReadRowGroupRowRanges) {
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(MakePageIndexedTable(1000, &table, &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(), &reader));
+  // Ranges set for page pruning do not apply
+  reader->SetRowGroupRowRanges(0, {{0, 99}});
+
+  // Exactly the rows of the ranges are read, whether or not their pages are
+  // adjacent
+  const RowRanges row_ranges = {{0, 0}, {5, 17}, {250, 349}, {705, 710}, {999, 999}};
+  std::vector<std::shared_ptr<Table>> slices;
+  for (const RowRange& range : row_ranges) {
+    slices.push_back(table->Slice(range.first, range.length()));
+  }
+  ASSERT_OK_AND_ASSIGN(auto expected, ::arrow::ConcatenateTables(slices));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0, 1}, row_ranges, &result));
+  AssertTablesEqual(*expected, *result, /*same_chunk_layout=*/false);
+
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {1}, row_ranges, &result));
+  ASSERT_OK_AND_ASSIGN(expected, expected->SelectColumns({1}));
+  AssertTablesEqual(*expected, *result, /*same_chunk_layout=*/false);
+
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0, 1}, {}, &result));
+  ASSERT_EQ(0, result->num_rows());
+
+  ASSERT_RAISES(Invalid, reader->ReadRowGroup(0, {0}, {{5, 10}, {8, 20}}, &result));
+  ASSERT_RAISES(Invalid, reader->ReadRowGroup(0, {0}, {{990, 1000}}, &result));
+}
+
+TEST(TestArrowReadWrite, ReadRowGroupRowRangesWithoutPageIndex) {
+  constexpr int64_t kNumRows = 2000;
+  ::arrow::random::RandomArrayGenerator rag(0);
+  auto strings = rag.StringWithRepeats(kNumRows, /*unique=*/50, /*min_length=*/1,
+                                       /*max_length=*/10, /*null_probability=*/0.3);
+  auto booleans = rag.Boolean(kNumRows, /*true_probability=*/0.5,
+                              /*null_probability=*/0.1);
+  auto table = Table::Make(::arrow::schema({::arrow::field("s", ::arrow::utf8()),
+                                            ::arrow::field("b", ::arrow::boolean())}),
+                           {strings, booleans});
+
+  // Dictionary and plain encoded pages of a few hundred rows
+  auto sink = CreateOutputStream();
+  auto write_props = WriterProperties::Builder()
+                         .write_batch_size(300)
+                         ->data_pagesize(1)
+                         ->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink, kNumRows,
+                                write_props, default_arrow_writer_properties()));
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(), &reader));
+  for (const RowRanges& row_ranges :
+       std::vector<RowRanges>{{{0, kNumRows - 1}},
+                              {{3, 3}, {299, 301}, {1000, 1899}},
+                              {{1, 1}, {1500, 1500}, {kNumRows - 1, kNumRows - 1}}}) {
+    std::vector<std::shared_ptr<Table>> slices;
+    for (const RowRange& range : row_ranges) {
+      slices.push_back(table->Slice(range.first, range.length()));
+    }
+    ASSERT_OK_AND_ASSIGN(auto expected, ::arrow::ConcatenateTables(slices));
+
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0, 1}, row_ranges, &result));
+    AssertTablesEqual(*expected, *result, /*same_chunk_layout=*/false);
+  }
+}
+
+TEST(TestArrowReadWrite, BloomFilterRoundTrip) {
+  constexpr int64_t kNumRows = 1000;
+  ::arrow::Int64Builder x_builder;
+  ::arrow::StringBuilder s_builder;
+  ::arrow::BooleanBuilder b_builder;
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    ASSERT_OK(x_builder.Append(i * 7));
+    if (i % 10 == 0) {
+      ASSERT_OK(s_builder.AppendNull());
+    } else {
+      ASSERT_OK(s_builder.Append("value" + std::to_string(i)));
+    }
+    ASSERT_OK(b_builder.Append(i % 2 == 0));
+  }
+  std::shared_ptr<Array> x, s, b;
+  ASSERT_OK(x_builder.Finish(&x));
+  ASSERT_OK(s_builder.Finish(&s));
+  ASSERT_OK(b_builder.Finish(&b));
+  auto table = Table::Make(::arrow::schema({::arrow::field("x", ::arrow::int64()),
+                                            ::arrow::field("s", ::arrow::utf8()),
+                                            ::arrow::field("b", ::arrow::boolean())}),
+                           {x, s, b});
+
+  BloomFilterOptions x_options;
+  x_options.ndv = kNumRows;
+  x_options.fpp = 0.01;
+  auto sink = CreateOutputStream();
+  auto write_props = WriterProperties::Builder()
+                         .enable_bloom_filter("x", x_options)
+                         ->enable_bloom_filter("s")
+                         ->enable_bloom_filter("b")
+                         ->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                kNumRows / 2, write_props,
+                                default_arrow_writer_properties()));
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+
+  auto reader = ParquetFileReader::Open(std::make_shared<BufferReader>(buffer));
+  ASSERT_EQ(2, reader->metadata()->num_row_groups());
+  for (int rg = 0; rg < 2; ++rg) {
+    auto row_group = reader->RowGroup(rg);
+    const int64_t first_row = rg * kNumRows / 2;
+    // No Bloom filter is written for boolean columns
+    ASSERT_FALSE(row_group->metadata()->ColumnChunk(2)->has_bloom_filter());
+    ASSERT_EQ(nullptr, row_group->GetBloomFilter(2));
+
+    ASSERT_TRUE(row_group->metadata()->ColumnChunk(0)->has_bloom_filter());
+    std::unique_ptr<BloomFilter> x_filter = row_group->GetBloomFilter(0);
+    ASSERT_NE(nullptr, x_filter);
+    int64_t false_positives = 0;
+    for (int64_t i = 0; i < kNumRows / 2; ++i) {
+      ASSERT_TRUE(x_filter->FindHash(x_filter->Hash((first_row + i) * 7)));
+      false_positives += x_filter->FindHash(x_filter->Hash((first_row + i) * 7 + 1));
+    }
+    ASSERT_LT(false_positives, kNumRows / 20);
+
+    std::unique_ptr<BloomFilter> s_filter = row_group->GetBloomFilter(1);
+    ASSERT_NE(nullptr, s_filter);
+    for (int64_t i = first_row + 1; i < first_row + kNumRows / 2; i += 10) {
+      const std::string value = "value" + std::to_string(i);
+      ByteArray byte_array(static_cast<uint32_t>(value.size()),
+                           reinterpret_cast<const uint8_t*>(value.data()));
+      ASSERT_TRUE(s_filter->FindHash(s_filter->Hash(&byte_array)));
+    }
+  }
+}
+
+TEST(TestArrowReadWrite, BloomFilterOfDictionary) {
+  // Dictionary values of any physical type go into the filter, which is sized for the
+  // distinct values of its column chunk rather than for the NDV option
+  auto d = ::arrow::DictArrayFromJSON(
+      ::arrow::dictionary(::arrow::int8(), ::arrow::int32()), "[0, 1, null, 1, 0]",
+      "[42, 7, 1000]");
+  auto table = Table::Make(::arrow::schema({::arrow::field("d", d->type())}), {d});
+
+  auto sink = CreateOutputStream();
+  auto write_props = WriterProperties::Builder().enable_bloom_filter("d")->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                table->num_rows(), write_props,
+                                default_arrow_writer_properties()));
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+
+  auto reader = ParquetFileReader::Open(std::make_shared<BufferReader>(buffer));
+  std::unique_ptr<BloomFilter> d_filter = reader->RowGroup(0)->GetBloomFilter(0);
+  ASSERT_NE(nullptr, d_filter);
+  for (int32_t value : {42, 7, 1000}) {
+    ASSERT_TRUE(d_filter->FindHash(d_filter->Hash(value)));
+  }
+  ASSERT_EQ(BlockSplitBloomFilter::kMinimumBloomFilterBytes, d_filter->GetBitsetSize());
+}
+
 //  Exercise reading table manually with nested RowGroup and Column loops, i.e.
 //
 //  for (int i = 0; i < n_row_groups; i++)
@@ -3897,6 +4154,59 @@ TEST_P(TestArrowReadDictionary, ReadWholeFileDict) {
   CheckReadWholeFile(*ex_table);
 }
 
+TEST_P(TestArrowReadDictionary, ReadWholeFileUnifiedDict) {
+  properties_.set_read_dictionary(0, true);
+  properties_.set_unify_dictionaries(true);
+
+  WriteSimple();
+
+  // Every row group's dictionary is merged into a single one, whose values are
+  // in order of first appearance in the file
+  std::shared_ptr<Array> expected;
+  AsDictionary32Encoded(*dense_values_, &expected);
+  auto ex_table = MakeSimpleTable(std::make_shared<ChunkedArray>(expected),
+                                  /*nullable=*/true);
+  CheckReadWholeFile(*ex_table);
+}
+
+TEST_P(TestArrowReadDictionary, StreamReadUnifiedDict) {
+  properties_.set_read_dictionary(0, true);
+  properties_.set_unify_dictionaries(true);
+  // Batches straddle row group boundaries
+  const int64_t batch_size = options.num_rows / options.num_row_groups * 3 / 2;
+  properties_.set_batch_size(batch_size);
+
+  WriteSimple();
+
+  ASSERT_OK_AND_ASSIGN(auto reader, GetReader());
+  std::unique_ptr<::arrow::RecordBatchReader> rb;
+  ASSERT_OK(reader->GetRecordBatchReader(
+      ::arrow::internal::Iota(options.num_row_groups), &rb));
+
+  int64_t offset = 0;
+  std::shared_ptr<Array> previous_dictionary;
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  while (true) {
+    ASSERT_OK(rb->ReadNext(&batch));
+    if (batch == nullptr) break;
+
+    const auto& column = checked_cast<const ::arrow::DictionaryArray&>(*batch->column(0));
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<Array> dense,
+                         ::arrow::compute::Cast(column, ::arrow::utf8()));
+    AssertArraysEqual(*dense_values_->Slice(offset, batch->num_rows()), *dense);
+    offset += batch->num_rows();
+
+    // Each batch's dictionary extends the previous one
+    if (previous_dictionary != nullptr) {
+      ASSERT_GE(column.dictionary()->length(), previous_dictionary->length());
+      ASSERT_TRUE(column.dictionary()->RangeEquals(*previous_dictionary, 0,
+                                                   previous_dictionary->length(), 0));
+    }
+    previous_dictionary = column.dictionary();
+  }
+  ASSERT_EQ(options.num_rows, offset);
+}
+
 TEST_P(TestArrowReadDictionary, ZeroChunksListOfDictionary) {
   // ARROW-8799
   properties_.set_read_dictionary(0, true);
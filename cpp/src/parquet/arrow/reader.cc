@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -43,6 +44,7 @@
 #include "parquet/exception.h"
 #include "parquet/file_reader.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
 
@@ -115,6 +117,12 @@ class ColumnReaderImpl : public ColumnReader {
 
   virtual ::arrow::Status LoadBatch(int64_t num_records) = 0;
 
+  // Load the records of the given ranges, counted from the current position of the
+  // reader, and skip the records between them
+  virtual ::arrow::Status LoadRowRanges(const RowRanges& ranges) {
+    return Status::NotImplemented("Reading row ranges of repeated columns");
+  }
+
   virtual ::arrow::Status BuildArray(int64_t length_upper_bound,
                                      std::shared_ptr<::arrow::ChunkedArray>* out) = 0;
   virtual bool IsOrHasRepeatedChild() const = 0;
@@ -150,9 +158,11 @@ class FileReaderImpl : public FileReader {
                                 reader_properties_, &manifest_);
   }
 
-  FileColumnIteratorFactory SomeRowGroupsFactory(std::vector<int> row_groups) {
-    return [row_groups](int i, ParquetFileReader* reader) {
-      return new FileColumnIterator(i, reader, row_groups);
+  FileColumnIteratorFactory SomeRowGroupsFactory(
+      std::vector<int> row_groups,
+      std::shared_ptr<const PageSelections> page_selections = nullptr) {
+    return [row_groups, page_selections](int i, ParquetFileReader* reader) {
+      return new FileColumnIterator(i, reader, row_groups, page_selections);
     };
   }
 
@@ -201,18 +211,33 @@ class FileReaderImpl : public FileReader {
   Status GetFieldReader(int i,
                         const std::shared_ptr<std::unordered_set<int>>& included_leaves,
                         const std::vector<int>& row_groups,
-                        std::unique_ptr<ColumnReaderImpl>* out) {
+                        std::unique_ptr<ColumnReaderImpl>* out,
+                        std::shared_ptr<const PageSelections> page_selections = nullptr) {
     auto ctx = std::make_shared<ReaderContext>();
     ctx->reader = reader_.get();
     ctx->pool = pool_;
-    ctx->iterator_factory = SomeRowGroupsFactory(row_groups);
+    ctx->iterator_factory = SomeRowGroupsFactory(row_groups, std::move(page_selections));
     ctx->filter_leaves = true;
     ctx->included_leaves = included_leaves;
+    ctx->unify_dictionaries = reader_properties_.unify_dictionaries();
     return GetReader(manifest_.schema_fields[i], ctx, out);
   }
 
+  Status GetFieldReaders(
+      const std::vector<int>& column_indices, const std::vector<int>& row_groups,
+      std::vector<std::shared_ptr<ColumnReaderImpl>>* out,
+      std::shared_ptr<::arrow::Schema>* out_schema,
+      std::shared_ptr<const PageSelections>* out_selections = nullptr) {
+    std::shared_ptr<const PageSelections> page_selections;
+    RETURN_NOT_OK(SelectPages(row_ranges_, row_groups, column_indices, &page_selections));
+    if (out_selections != nullptr) *out_selections = page_selections;
+    return GetFieldReaders(column_indices, row_groups, std::move(page_selections), out,
+                           out_schema);
+  }
+
   Status GetFieldReaders(const std::vector<int>& column_indices,
                          const std::vector<int>& row_groups,
+                         std::shared_ptr<const PageSelections> page_selections,
                          std::vector<std::shared_ptr<ColumnReaderImpl>>* out,
                          std::shared_ptr<::arrow::Schema>* out_schema) {
     // We only need to read schema fields which have columns indicated
@@ -226,8 +251,8 @@ class FileReaderImpl : public FileReader {
     ::arrow::FieldVector out_fields(field_indices.size());
     for (size_t i = 0; i < out->size(); ++i) {
       std::unique_ptr<ColumnReaderImpl> reader;
-      RETURN_NOT_OK(
-          GetFieldReader(field_indices[i], included_leaves, row_groups, &reader));
+      RETURN_NOT_OK(GetFieldReader(field_indices[i], included_leaves, row_groups,
+                                   &reader, page_selections));
 
       out_fields[i] = reader->field();
       out->at(i) = std::move(reader);
@@ -237,6 +262,30 @@ class FileReaderImpl : public FileReader {
     return Status::OK();
   }
 
+  // Align the row ranges of the given row groups to the data pages of the given
+  // leaf columns, so that the pages selected from every column hold the same rows
+  Status SelectPages(const std::unordered_map<int, RowRanges>& row_ranges,
+                     const std::vector<int>& row_groups,
+                     const std::vector<int>& column_indices,
+                     std::shared_ptr<const PageSelections>* out);
+
+  // The number of rows which reading the given row groups yields
+  int64_t NumRowsToRead(const std::vector<int>& row_groups,
+                        const PageSelections* page_selections) const {
+    int64_t num_rows = 0;
+    for (int row_group : row_groups) {
+      if (page_selections != nullptr) {
+        auto selection = page_selections->find(row_group);
+        if (selection != page_selections->end()) {
+          num_rows += RowRangesLength(selection->second.row_ranges);
+          continue;
+        }
+      }
+      num_rows += reader_->metadata()->RowGroup(row_group)->num_rows();
+    }
+    return num_rows;
+  }
+
   Status GetColumn(int i, FileColumnIteratorFactory iterator_factory,
                    std::unique_ptr<ColumnReader>* out);
 
@@ -314,6 +363,9 @@ class FileReaderImpl : public FileReader {
     return ReadRowGroup(i, Iota(reader_->metadata()->num_columns()), table);
   }
 
+  Status ReadRowGroup(int i, const std::vector<int>& column_indices,
+                      const RowRanges& row_ranges, std::shared_ptr<Table>* out) override;
+
   Status GetRecordBatchReader(const std::vector<int>& row_group_indices,
                               const std::vector<int>& column_indices,
                               std::unique_ptr<RecordBatchReader>* out) override;
@@ -344,6 +396,20 @@ class FileReaderImpl : public FileReader {
     reader_properties_.set_batch_size(batch_size);
   }
 
+  void SetRowGroupRowRanges(int row_group, RowRanges row_ranges) override {
+    row_ranges_[row_group] = std::move(row_ranges);
+  }
+
+  RowRanges GetRowGroupRowRanges(int row_group) const override {
+    auto row_ranges = row_ranges_.find(row_group);
+    if (row_ranges != row_ranges_.end()) {
+      return row_ranges->second;
+    }
+    const int64_t num_rows = reader_->metadata()->RowGroup(row_group)->num_rows();
+    if (num_rows == 0) return {};
+    return {{0, num_rows - 1}};
+  }
+
   const ArrowReaderProperties& properties() const override { return reader_properties_; }
 
   const SchemaManifest& manifest() const override { return manifest_; }
@@ -361,6 +427,9 @@ class FileReaderImpl : public FileReader {
   ArrowReaderProperties reader_properties_;
 
   SchemaManifest manifest_;
+
+  // Row ranges to read by row group, see SetRowGroupRowRanges
+  std::unordered_map<int, RowRanges> row_ranges_;
 };
 
 class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
@@ -435,7 +504,8 @@ class LeafReader : public ColumnReaderImpl {
         input_(std::move(input)),
         descr_(input_->descr()) {
     record_reader_ = RecordReader::Make(
-        descr_, leaf_info, ctx_->pool, field_->type()->id() == ::arrow::Type::DICTIONARY);
+        descr_, leaf_info, ctx_->pool, field_->type()->id() == ::arrow::Type::DICTIONARY,
+        ctx_->unify_dictionaries);
     NextRowGroup();
   }
 
@@ -475,6 +545,37 @@ class LeafReader : public ColumnReaderImpl {
     END_PARQUET_CATCH_EXCEPTIONS
   }
 
+  Status LoadRowRanges(const RowRanges& ranges) final {
+    BEGIN_PARQUET_CATCH_EXCEPTIONS
+    out_ = nullptr;
+    record_reader_->Reset();
+    record_reader_->Reserve(RowRangesLength(ranges));
+    int64_t position = 0;
+    for (const RowRange& range : ranges) {
+      int64_t records_to_skip = range.first - position;
+      while (records_to_skip > 0 && record_reader_->HasMoreData()) {
+        int64_t records_skipped = record_reader_->SkipRecords(records_to_skip);
+        records_to_skip -= records_skipped;
+        if (records_skipped == 0) {
+          NextRowGroup();
+        }
+      }
+      int64_t records_to_read = range.length();
+      while (records_to_read > 0 && record_reader_->HasMoreData()) {
+        int64_t records_read = record_reader_->ReadRecords(records_to_read);
+        records_to_read -= records_read;
+        if (records_read == 0) {
+          NextRowGroup();
+        }
+      }
+      position = range.last + 1;
+    }
+    RETURN_NOT_OK(TransferColumnData(record_reader_.get(), field_->type(), descr_,
+                                     ctx_->pool, &out_));
+    return Status::OK();
+    END_PARQUET_CATCH_EXCEPTIONS
+  }
+
   ::arrow::Status BuildArray(int64_t length_upper_bound,
                              std::shared_ptr<::arrow::ChunkedArray>* out) final {
     *out = out_;
@@ -516,6 +617,10 @@ class ExtensionReader : public ColumnReaderImpl {
     return storage_reader_->LoadBatch(number_of_records);
   }
 
+  Status LoadRowRanges(const RowRanges& ranges) final {
+    return storage_reader_->LoadRowRanges(ranges);
+  }
+
   Status BuildArray(int64_t length_upper_bound,
                     std::shared_ptr<ChunkedArray>* out) override {
     std::shared_ptr<ChunkedArray> storage;
@@ -693,6 +798,12 @@ class PARQUET_NO_EXPORT StructReader : public ColumnReaderImpl {
     }
     return Status::OK();
   }
+  Status LoadRowRanges(const RowRanges& ranges) override {
+    for (const std::unique_ptr<ColumnReaderImpl>& reader : children_) {
+      RETURN_NOT_OK(reader->LoadRowRanges(ranges));
+    }
+    return Status::OK();
+  }
   Status BuildArray(int64_t length_upper_bound,
                     std::shared_ptr<ChunkedArray>* out) override;
   Status GetDefLevels(const int16_t** data, int64_t* length) override;
@@ -912,7 +1023,9 @@ Status FileReaderImpl::GetRecordBatchReader(const std::vector<int>& row_groups,
 
   std::vector<std::shared_ptr<ColumnReaderImpl>> readers;
   std::shared_ptr<::arrow::Schema> batch_schema;
-  RETURN_NOT_OK(GetFieldReaders(column_indices, row_groups, &readers, &batch_schema));
+  std::shared_ptr<const PageSelections> page_selections;
+  RETURN_NOT_OK(GetFieldReaders(column_indices, row_groups, &readers, &batch_schema,
+                                &page_selections));
 
   if (readers.empty()) {
     // Just generate all batches right now; they're cheap since they have no columns.
@@ -938,10 +1051,7 @@ Status FileReaderImpl::GetRecordBatchReader(const std::vector<int>& row_groups,
     return Status::OK();
   }
 
-  int64_t num_rows = 0;
-  for (int row_group : row_groups) {
-    num_rows += parquet_reader()->metadata()->RowGroup(row_group)->num_rows();
-  }
+  int64_t num_rows = NumRowsToRead(row_groups, page_selections.get());
 
   using ::arrow::RecordBatchIterator;
 
@@ -1071,6 +1181,71 @@ FileReaderImpl::GetRecordBatchGenerator(std::shared_ptr<FileReader> reader,
   return ::arrow::MakeConcatenatedGenerator(std::move(row_group_generator));
 }
 
+Status FileReaderImpl::SelectPages(const std::unordered_map<int, RowRanges>& row_ranges,
+                                   const std::vector<int>& row_groups,
+                                   const std::vector<int>& column_indices,
+                                   std::shared_ptr<const PageSelections>* out) {
+  *out = nullptr;
+  // Without any column the ranges cannot be aligned to pages, so rows are not pruned
+  if (row_ranges.empty() || column_indices.empty()) {
+    return Status::OK();
+  }
+
+  auto same_ranges = [](const RowRanges& left, const RowRanges& right) {
+    return left.size() == right.size() &&
+           std::equal(left.begin(), left.end(), right.begin(),
+                      [](const RowRange& l, const RowRange& r) {
+                        return l.first == r.first && l.last == r.last;
+                      });
+  };
+
+  BEGIN_PARQUET_CATCH_EXCEPTIONS
+  auto selections = std::make_shared<PageSelections>();
+  for (int row_group : row_groups) {
+    auto group_ranges = row_ranges.find(row_group);
+    if (group_ranges == row_ranges.end()) continue;
+
+    auto row_group_reader = reader_->RowGroup(row_group);
+    const int64_t num_rows = row_group_reader->metadata()->num_rows();
+
+    PageSelection selection;
+    bool prunable = true;
+    for (int i : column_indices) {
+      if (reader_->metadata()->schema()->Column(i)->max_repetition_level() > 0) {
+        prunable = false;
+        break;
+      }
+      std::shared_ptr<OffsetIndex> offset_index = row_group_reader->GetOffsetIndex(i);
+      if (offset_index == nullptr) {
+        prunable = false;
+        break;
+      }
+      selection.offset_indexes[i] = std::move(offset_index);
+    }
+    if (!prunable) continue;
+
+    // Widening the ranges to the pages of one column may cross page boundaries of
+    // another, so repeat until no column widens them any further
+    selection.row_ranges = group_ranges->second;
+    bool widened = true;
+    while (widened) {
+      widened = false;
+      for (const auto& offset_index : selection.offset_indexes) {
+        RowRanges expanded =
+            offset_index.second->ExpandToPages(selection.row_ranges, num_rows);
+        if (!same_ranges(expanded, selection.row_ranges)) {
+          selection.row_ranges = std::move(expanded);
+          widened = true;
+        }
+      }
+    }
+    (*selections)[row_group] = std::move(selection);
+  }
+  *out = std::move(selections);
+  END_PARQUET_CATCH_EXCEPTIONS
+  return Status::OK();
+}
+
 Status FileReaderImpl::GetColumn(int i, FileColumnIteratorFactory iterator_factory,
                                  std::unique_ptr<ColumnReader>* out) {
   RETURN_NOT_OK(BoundsCheckColumn(i));
@@ -1079,6 +1254,7 @@ Status FileReaderImpl::GetColumn(int i, FileColumnIteratorFactory iterator_facto
   ctx->pool = pool_;
   ctx->iterator_factory = iterator_factory;
   ctx->filter_leaves = false;
+  ctx->unify_dictionaries = reader_properties_.unify_dictionaries();
   std::unique_ptr<ColumnReaderImpl> result;
   RETURN_NOT_OK(GetReader(manifest_.schema_fields[i], ctx, &result));
   out->reset(result.release());
@@ -1105,6 +1281,75 @@ Status FileReaderImpl::ReadRowGroups(const std::vector<int>& row_groups,
   return Status::OK();
 }
 
+namespace {
+
+// Translate sorted row ranges of a row group to positions among the rows of the
+// selected pages, which hold them and are the only rows the column readers see
+RowRanges RowRangesInPages(const RowRanges& ranges, const RowRanges& pages) {
+  RowRanges result;
+  result.reserve(ranges.size());
+  int64_t pages_position = 0;
+  size_t p = 0;
+  for (const RowRange& range : ranges) {
+    while (pages[p].last < range.first) {
+      pages_position += pages[p].length();
+      ++p;
+    }
+    const int64_t shift = pages[p].first - pages_position;
+    result.push_back({range.first - shift, range.last - shift});
+  }
+  return result;
+}
+
+}  // namespace
+
+Status FileReaderImpl::ReadRowGroup(int i, const std::vector<int>& column_indices,
+                                    const RowRanges& row_ranges,
+                                    std::shared_ptr<Table>* out) {
+  RETURN_NOT_OK(BoundsCheck({i}, column_indices));
+  const int64_t num_rows = reader_->metadata()->RowGroup(i)->num_rows();
+  for (size_t r = 0; r < row_ranges.size(); ++r) {
+    if (row_ranges[r].first < 0 || row_ranges[r].last < row_ranges[r].first ||
+        row_ranges[r].last >= num_rows ||
+        (r > 0 && row_ranges[r].first <= row_ranges[r - 1].last)) {
+      return Status::Invalid("Row ranges must be sorted, disjoint and within the ",
+                             num_rows, " rows of the row group");
+    }
+  }
+  for (int column : column_indices) {
+    if (reader_->metadata()->schema()->Column(column)->max_repetition_level() > 0) {
+      return Status::NotImplemented("Reading row ranges of repeated columns");
+    }
+  }
+
+  // Pages holding none of the rows are not read
+  std::shared_ptr<const PageSelections> page_selections;
+  RETURN_NOT_OK(SelectPages({{i, row_ranges}}, {i}, column_indices, &page_selections));
+  RowRanges ranges_to_load = row_ranges;
+  if (page_selections != nullptr) {
+    auto selection = page_selections->find(i);
+    if (selection != page_selections->end()) {
+      ranges_to_load = RowRangesInPages(row_ranges, selection->second.row_ranges);
+    }
+  }
+
+  std::vector<std::shared_ptr<ColumnReaderImpl>> readers;
+  std::shared_ptr<::arrow::Schema> result_schema;
+  RETURN_NOT_OK(GetFieldReaders(column_indices, {i}, std::move(page_selections),
+                                &readers, &result_schema));
+
+  const int64_t num_rows_to_read = RowRangesLength(row_ranges);
+  ::arrow::ChunkedArrayVector columns(readers.size());
+  RETURN_NOT_OK(::arrow::internal::OptionalParallelFor(
+      reader_properties_.use_threads(), static_cast<int>(readers.size()), [&](int j) {
+        RETURN_NOT_OK(readers[j]->LoadRowRanges(ranges_to_load));
+        return readers[j]->BuildArray(num_rows_to_read, &columns[j]);
+      }));
+
+  *out = Table::Make(std::move(result_schema), std::move(columns), num_rows_to_read);
+  return Status::OK();
+}
+
 Future<std::shared_ptr<Table>> FileReaderImpl::DecodeRowGroups(
     std::shared_ptr<FileReaderImpl> self, const std::vector<int>& row_groups,
     const std::vector<int>& column_indices, ::arrow::internal::Executor* cpu_executor) {
@@ -1112,7 +1357,9 @@ Future<std::shared_ptr<Table>> FileReaderImpl::DecodeRowGroups(
   // in a sync context too so use `this` over `self`
   std::vector<std::shared_ptr<ColumnReaderImpl>> readers;
   std::shared_ptr<::arrow::Schema> result_schema;
-  RETURN_NOT_OK(GetFieldReaders(column_indices, row_groups, &readers, &result_schema));
+  std::shared_ptr<const PageSelections> page_selections;
+  RETURN_NOT_OK(GetFieldReaders(column_indices, row_groups, &readers, &result_schema,
+                                &page_selections));
   // OptionalParallelForAsync requires an executor
   if (!cpu_executor) cpu_executor = ::arrow::internal::GetCpuThreadPool();
 
@@ -1123,16 +1370,14 @@ Future<std::shared_ptr<Table>> FileReaderImpl::DecodeRowGroups(
     RETURN_NOT_OK(ReadColumn(static_cast<int>(i), row_groups, reader.get(), &column));
     return column;
   };
-  auto make_table = [result_schema, row_groups, self,
+  auto make_table = [result_schema, row_groups, page_selections, self,
                      this](const ::arrow::ChunkedArrayVector& columns)
       -> ::arrow::Result<std::shared_ptr<Table>> {
     int64_t num_rows = 0;
     if (!columns.empty()) {
       num_rows = columns[0]->length();
     } else {
-      for (int i : row_groups) {
-        num_rows += parquet_reader()->metadata()->RowGroup(i)->num_rows();
-      }
+      num_rows = NumRowsToRead(row_groups, page_selections.get());
     }
     auto table = Table::Make(std::move(result_schema), columns, num_rows);
     RETURN_NOT_OK(table->Validate());
@@ -212,6 +212,26 @@ class PARQUET_EXPORT FileReader {
 
   virtual ::arrow::Status ReadRowGroup(int i, std::shared_ptr<::arrow::Table>* out) = 0;
 
+  /// \brief Read exactly the given rows of a row group for the given leaf columns
+  ///
+  /// The rows are given as sorted, disjoint ranges of row indices of the row group.
+  /// Data pages holding none of them are located through the page index of the file
+  /// and are neither read nor decoded; the other rows are skipped within pages
+  /// without being materialized. This allows reading the columns of a filter first
+  /// and then only the selected rows of the other columns. Ranges set with
+  /// SetRowGroupRowRanges are ignored. Repeated columns are not supported.
+  ///
+  /// Unlike the other read methods, this does not pre-buffer even if pre_buffer is
+  /// set in the reader properties, since pre-buffering replaces the cache shared by
+  /// every read of the file, including concurrent ones. To coalesce its reads, call
+  /// ParquetFileReader::PreBuffer once beforehand for all the row groups and columns
+  /// to be read.
+  ///
+  /// \note API EXPERIMENTAL
+  virtual ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
+                                       const RowRanges& row_ranges,
+                                       std::shared_ptr<::arrow::Table>* out) = 0;
+
   virtual ::arrow::Status ReadRowGroups(const std::vector<int>& row_groups,
                                         const std::vector<int>& column_indices,
                                         std::shared_ptr<::arrow::Table>* out) = 0;
@@ -240,6 +260,23 @@ class PARQUET_EXPORT FileReader {
   /// Set number of records to read per batch for the RecordBatchReader.
   virtual void set_batch_size(int64_t batch_size) = 0;
 
+  /// \brief Only read the given rows of a row group in subsequent reads.
+  ///
+  /// Data pages holding no row of the ranges are located through the page index of
+  /// the file and are neither read nor decoded. Pages are read whole and the ranges
+  /// are widened to the page boundaries of every column read, so the row group yields
+  /// every row within the ranges but may yield others too. The ranges are ignored if
+  /// some column read is repeated or lacks an OffsetIndex.
+  ///
+  /// \note API EXPERIMENTAL
+  virtual void SetRowGroupRowRanges(int row_group, RowRanges row_ranges) = 0;
+
+  /// \brief Return the row ranges set for a row group with SetRowGroupRowRanges, or
+  /// all its rows if none were set.
+  ///
+  /// \note API EXPERIMENTAL
+  virtual RowRanges GetRowGroupRowRanges(int row_group) const = 0;
+
   virtual const ArrowReaderProperties& properties() const = 0;
 
   virtual const SchemaManifest& manifest() const = 0;
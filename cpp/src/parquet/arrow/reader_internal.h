@@ -22,6 +22,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -30,6 +31,7 @@
 #include "parquet/column_reader.h"
 #include "parquet/file_reader.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/platform.h"
 #include "parquet/schema.h"
 
@@ -57,16 +59,29 @@ class ColumnReaderImpl;
 // ----------------------------------------------------------------------
 // Iteration utilities
 
+// The data pages to read from a row group, see FileReader::SetRowGroupRowRanges
+struct PageSelection {
+  // The rows to read, aligned to the page boundaries of every column read
+  RowRanges row_ranges;
+  // The OffsetIndex of every column read, by column index
+  std::unordered_map<int, std::shared_ptr<OffsetIndex>> offset_indexes;
+};
+
+// Page selections by row group index
+using PageSelections = std::unordered_map<int, PageSelection>;
+
 // Abstraction to decouple row group iteration details from the ColumnReader,
 // so we can read only a single row group if we want
 class FileColumnIterator {
  public:
-  explicit FileColumnIterator(int column_index, ParquetFileReader* reader,
-                              std::vector<int> row_groups)
+  explicit FileColumnIterator(
+      int column_index, ParquetFileReader* reader, std::vector<int> row_groups,
+      std::shared_ptr<const PageSelections> page_selections = NULLPTR)
       : column_index_(column_index),
         reader_(reader),
         schema_(reader->metadata()->schema()),
-        row_groups_(row_groups.begin(), row_groups.end()) {}
+        row_groups_(row_groups.begin(), row_groups.end()),
+        page_selections_(std::move(page_selections)) {}
 
   virtual ~FileColumnIterator() {}
 
@@ -75,8 +90,19 @@ class FileColumnIterator {
       return nullptr;
     }
 
-    auto row_group_reader = reader_->RowGroup(row_groups_.front());
+    const int row_group = row_groups_.front();
+    auto row_group_reader = reader_->RowGroup(row_group);
     row_groups_.pop_front();
+    if (page_selections_ != NULLPTR) {
+      auto selection = page_selections_->find(row_group);
+      if (selection != page_selections_->end()) {
+        auto offset_index = selection->second.offset_indexes.find(column_index_);
+        if (offset_index != selection->second.offset_indexes.end()) {
+          return row_group_reader->GetColumnPageReader(
+              column_index_, *offset_index->second, selection->second.row_ranges);
+        }
+      }
+    }
     return row_group_reader->GetColumnPageReader(column_index_);
   }
 
@@ -93,6 +119,7 @@ class FileColumnIterator {
   ParquetFileReader* reader_;
   const SchemaDescriptor* schema_;
   std::deque<int> row_groups_;
+  std::shared_ptr<const PageSelections> page_selections_;
 };
 
 using FileColumnIteratorFactory =
@@ -109,6 +136,7 @@ struct ReaderContext {
   FileColumnIteratorFactory iterator_factory;
   bool filter_leaves;
   std::shared_ptr<std::unordered_set<int>> included_leaves;
+  bool unify_dictionaries;
 
   bool IncludesLeaf(int leaf_index) const {
     if (this->filter_leaves) {
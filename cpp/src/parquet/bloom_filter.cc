@@ -15,22 +15,39 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <vector>
 
 #include "arrow/result.h"
 #include "arrow/util/logging.h"
 #include "parquet/bloom_filter.h"
 #include "parquet/exception.h"
+#include "parquet/metadata.h"
 #include "parquet/murmur3.h"
+#include "parquet/properties.h"
+#include "parquet/schema.h"
+#include "parquet/thrift_internal.h"
+#include "parquet/xxhasher.h"
 
 namespace parquet {
 constexpr uint32_t BlockSplitBloomFilter::SALT[kBitsSetPerBlock];
 
 BlockSplitBloomFilter::BlockSplitBloomFilter()
+    : BlockSplitBloomFilter(HashStrategy::MURMUR3_X64_128) {}
+
+BlockSplitBloomFilter::BlockSplitBloomFilter(HashStrategy hash_strategy)
     : pool_(::arrow::default_memory_pool()),
-      hash_strategy_(HashStrategy::MURMUR3_X64_128),
-      algorithm_(Algorithm::BLOCK) {}
+      hash_strategy_(hash_strategy),
+      algorithm_(Algorithm::BLOCK) {
+  if (hash_strategy_ == HashStrategy::XXHASH) {
+    hasher_.reset(new XxHasher());
+  } else {
+    hasher_.reset(new MurmurHash3());
+  }
+}
 
 void BlockSplitBloomFilter::Init(uint32_t num_bytes) {
   if (num_bytes < kMinimumBloomFilterBytes) {
@@ -49,8 +66,6 @@ void BlockSplitBloomFilter::Init(uint32_t num_bytes) {
   num_bytes_ = num_bytes;
   PARQUET_ASSIGN_OR_THROW(data_, ::arrow::AllocateBuffer(num_bytes_, pool_));
   memset(data_->mutable_data(), 0, num_bytes_);
-
-  this->hasher_.reset(new MurmurHash3());
 }
 
 void BlockSplitBloomFilter::Init(const uint8_t* bitset, uint32_t num_bytes) {
@@ -64,8 +79,6 @@ void BlockSplitBloomFilter::Init(const uint8_t* bitset, uint32_t num_bytes) {
   num_bytes_ = num_bytes;
   PARQUET_ASSIGN_OR_THROW(data_, ::arrow::AllocateBuffer(num_bytes_, pool_));
   memcpy(data_->mutable_data(), bitset, num_bytes_);
-
-  this->hasher_.reset(new MurmurHash3());
 }
 
 BlockSplitBloomFilter BlockSplitBloomFilter::Deserialize(ArrowInputStream* input) {
@@ -100,9 +113,41 @@ BlockSplitBloomFilter BlockSplitBloomFilter::Deserialize(ArrowInputStream* input
   return bloom_filter;
 }
 
+uint32_t BlockSplitBloomFilter::DeserializeHeader(const uint8_t* data,
+                                                  uint32_t* header_length) {
+  format::BloomFilterHeader header;
+  DeserializeThriftMsg(data, header_length, &header);
+  if (!header.algorithm.__isset.BLOCK) {
+    throw ParquetException("Unsupported Bloom filter algorithm");
+  }
+  if (!header.hash.__isset.XXHASH) {
+    throw ParquetException("Unsupported Bloom filter hash strategy");
+  }
+  if (!header.compression.__isset.UNCOMPRESSED) {
+    throw ParquetException("Unsupported Bloom filter compression");
+  }
+  if (header.numBytes <= 0 ||
+      static_cast<uint32_t>(header.numBytes) > kMaximumBloomFilterBytes) {
+    throw ParquetException("Invalid Bloom filter size: ", header.numBytes);
+  }
+  return static_cast<uint32_t>(header.numBytes);
+}
+
 void BlockSplitBloomFilter::WriteTo(ArrowOutputStream* sink) const {
   DCHECK(sink != nullptr);
 
+  if (hash_strategy_ == HashStrategy::XXHASH) {
+    format::BloomFilterHeader header;
+    header.__set_numBytes(static_cast<int32_t>(num_bytes_));
+    header.algorithm.__set_BLOCK(format::SplitBlockAlgorithm());
+    header.hash.__set_XXHASH(format::XxHash());
+    header.compression.__set_UNCOMPRESSED(format::Uncompressed());
+    ThriftSerializer serializer;
+    serializer.Serialize(&header, sink);
+    PARQUET_THROW_NOT_OK(sink->Write(data_->data(), num_bytes_));
+    return;
+  }
+
   PARQUET_THROW_NOT_OK(
       sink->Write(reinterpret_cast<const uint8_t*>(&num_bytes_), sizeof(num_bytes_)));
   PARQUET_THROW_NOT_OK(sink->Write(reinterpret_cast<const uint8_t*>(&hash_strategy_),
@@ -126,9 +171,16 @@ void BlockSplitBloomFilter::SetMask(uint32_t key, BlockMask& block_mask) const {
   }
 }
 
+uint32_t BlockSplitBloomFilter::BlockIndex(uint64_t hash) const {
+  const uint32_t num_blocks = num_bytes_ / kBytesPerFilterBlock;
+  if (hash_strategy_ == HashStrategy::XXHASH) {
+    return static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+  }
+  return static_cast<uint32_t>((hash >> 32) & (num_blocks - 1));
+}
+
 bool BlockSplitBloomFilter::FindHash(uint64_t hash) const {
-  const uint32_t bucket_index =
-      static_cast<uint32_t>((hash >> 32) & (num_bytes_ / kBytesPerFilterBlock - 1));
+  const uint32_t bucket_index = BlockIndex(hash);
   uint32_t key = static_cast<uint32_t>(hash);
   uint32_t* bitset32 = reinterpret_cast<uint32_t*>(data_->mutable_data());
 
@@ -145,8 +197,7 @@ bool BlockSplitBloomFilter::FindHash(uint64_t hash) const {
 }
 
 void BlockSplitBloomFilter::InsertHash(uint64_t hash) {
-  const uint32_t bucket_index =
-      static_cast<uint32_t>(hash >> 32) & (num_bytes_ / kBytesPerFilterBlock - 1);
+  const uint32_t bucket_index = BlockIndex(hash);
   uint32_t key = static_cast<uint32_t>(hash);
   uint32_t* bitset32 = reinterpret_cast<uint32_t*>(data_->mutable_data());
 
@@ -159,4 +210,130 @@ void BlockSplitBloomFilter::InsertHash(uint64_t hash) {
   }
 }
 
+// The Bloom filter of a column chunk being written. The hashes inserted are buffered,
+// and deduplicated from time to time, until the chunk is written or they exceed
+// max_ndv. The bitset is then sized for their number of distinct values.
+class BloomFilterBuilder::ChunkBloomFilter : public BloomFilter {
+ public:
+  ChunkBloomFilter(int64_t max_ndv, double fpp) : max_ndv_(max_ndv), fpp_(fpp) {}
+
+  bool FindHash(uint64_t hash) const override {
+    if (filter_) return filter_->FindHash(hash);
+    return std::find(hashes_.begin(), hashes_.end(), hash) != hashes_.end();
+  }
+
+  void InsertHash(uint64_t hash) override {
+    if (filter_) {
+      filter_->InsertHash(hash);
+      return;
+    }
+    hashes_.push_back(hash);
+    if (hashes_.size() >= 2 * std::max<size_t>(num_distinct_, kMinDeduplicatedHashes)) {
+      Deduplicate();
+      if (static_cast<int64_t>(hashes_.size()) > max_ndv_) {
+        MakeFilter(max_ndv_);
+      }
+    }
+  }
+
+  // Size the bitset, if not done yet, and insert the buffered hashes
+  void Finish() {
+    if (filter_) return;
+    Deduplicate();
+    MakeFilter(static_cast<int64_t>(hashes_.size()));
+  }
+
+  void WriteTo(ArrowOutputStream* sink) const override {
+    DCHECK(filter_) << "Finish() must be called before WriteTo()";
+    filter_->WriteTo(sink);
+  }
+
+  uint32_t GetBitsetSize() const override {
+    return filter_ ? filter_->GetBitsetSize() : 0;
+  }
+
+  uint64_t Hash(int64_t value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(float value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(double value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(const Int96* value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(const ByteArray* value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(int32_t value) const override { return hasher_.Hash(value); }
+  uint64_t Hash(const FLBA* value, uint32_t len) const override {
+    return hasher_.Hash(value, len);
+  }
+
+ private:
+  static constexpr size_t kMinDeduplicatedHashes = 1024;
+
+  void Deduplicate() {
+    std::sort(hashes_.begin(), hashes_.end());
+    hashes_.erase(std::unique(hashes_.begin(), hashes_.end()), hashes_.end());
+    num_distinct_ = hashes_.size();
+  }
+
+  void MakeFilter(int64_t ndv) {
+    const uint32_t num_bits = BlockSplitBloomFilter::OptimalNumOfBits(
+        static_cast<uint32_t>(std::max<int64_t>(ndv, 1)), fpp_);
+    filter_.reset(new BlockSplitBloomFilter(HashStrategy::XXHASH));
+    filter_->Init(num_bits / 8);
+    for (uint64_t hash : hashes_) {
+      filter_->InsertHash(hash);
+    }
+    std::vector<uint64_t>().swap(hashes_);
+  }
+
+  const int64_t max_ndv_;
+  const double fpp_;
+  // Must hash like the BlockSplitBloomFilter it ends up as
+  XxHasher hasher_;
+  std::vector<uint64_t> hashes_;
+  size_t num_distinct_ = 0;
+  std::unique_ptr<BlockSplitBloomFilter> filter_;
+};
+
+constexpr size_t BloomFilterBuilder::ChunkBloomFilter::kMinDeduplicatedHashes;
+
+BloomFilterBuilder::BloomFilterBuilder(const SchemaDescriptor* schema,
+                                       const WriterProperties* properties)
+    : schema_(schema), properties_(properties) {}
+
+BloomFilterBuilder::~BloomFilterBuilder() = default;
+
+void BloomFilterBuilder::AppendRowGroup() {
+  DCHECK(bloom_filters_.empty());
+  ++row_group_;
+}
+
+BloomFilter* BloomFilterBuilder::GetOrCreateBloomFilter(int i) {
+  const ColumnDescriptor* descr = schema_->Column(i);
+  // There is no hash of booleans, which would hardly benefit from a filter anyway
+  if (row_group_ < 0 || descr->physical_type() == Type::BOOLEAN ||
+      !properties_->bloom_filter_enabled(descr->path())) {
+    return nullptr;
+  }
+  auto& bloom_filter = bloom_filters_[i];
+  if (bloom_filter == nullptr) {
+    const BloomFilterOptions& options = properties_->bloom_filter_options(descr->path());
+    if (!(options.fpp > 0.0 && options.fpp < 1.0)) {
+      throw ParquetException("Bloom filter false positive probability must be in (0, 1)");
+    }
+    // A column chunk cannot hold more distinct values than a row group holds rows
+    const int64_t max_ndv = std::min<int64_t>(
+        std::min(options.ndv, properties_->max_row_group_length()),
+        std::numeric_limits<uint32_t>::max());
+    bloom_filter.reset(new ChunkBloomFilter(max_ndv, options.fpp));
+  }
+  return bloom_filter.get();
+}
+
+void BloomFilterBuilder::WriteTo(ArrowOutputStream* sink, FileMetaDataBuilder* metadata) {
+  for (const auto& bloom_filter : bloom_filters_) {
+    bloom_filter.second->Finish();
+    PARQUET_ASSIGN_OR_THROW(int64_t offset, sink->Tell());
+    bloom_filter.second->WriteTo(sink);
+    metadata->SetBloomFilterOffset(row_group_, bloom_filter.first, offset);
+  }
+  bloom_filters_.clear();
+}
+
 }  // namespace parquet
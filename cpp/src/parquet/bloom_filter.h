@@ -19,6 +19,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <map>
 #include <memory>
 
 #include "arrow/util/bit_util.h"
@@ -29,6 +30,10 @@
 
 namespace parquet {
 
+class FileMetaDataBuilder;
+class SchemaDescriptor;
+class WriterProperties;
+
 // A Bloom filter is a compact structure to indicate whether an item is not in a set or
 // probably in a set. The Bloom filter usually consists of a bit set that represents a
 // set of elements, a hash strategy and a Bloom filter algorithm.
@@ -50,7 +55,8 @@ class PARQUET_EXPORT BloomFilter {
   virtual void InsertHash(uint64_t hash) = 0;
 
   /// Write this Bloom filter to an output stream. A Bloom filter structure should
-  /// include bitset length, hash strategy, algorithm, and bitset.
+  /// include bitset length, hash strategy, algorithm, and bitset, the first three
+  /// making up a header whose layout depends on the hash strategy.
   ///
   /// @param sink the output stream to write
   virtual void WriteTo(ArrowOutputStream* sink) const = 0;
@@ -103,10 +109,12 @@ class PARQUET_EXPORT BloomFilter {
 
   virtual ~BloomFilter() {}
 
- protected:
-  // Hash strategy available for Bloom filter.
-  enum class HashStrategy : uint32_t { MURMUR3_X64_128 = 0 };
+  // Hash strategy available for Bloom filter. MURMUR3_X64_128 is the legacy strategy of
+  // parquet-mr before the Bloom filter was specified, XXHASH the one the Parquet format
+  // specifies.
+  enum class HashStrategy : uint32_t { MURMUR3_X64_128 = 0, XXHASH = 1 };
 
+ protected:
   // Bloom filter algorithm.
   enum class Algorithm : uint32_t { BLOCK = 0 };
 };
@@ -122,6 +130,12 @@ class PARQUET_EXPORT BlockSplitBloomFilter : public BloomFilter {
   /// The constructor of BlockSplitBloomFilter. It uses murmur3_x64_128 as hash function.
   BlockSplitBloomFilter();
 
+  /// Construct a BlockSplitBloomFilter using the given hash strategy. Filters using
+  /// XXHASH follow the Parquet format specification: the block of a hash is picked by
+  /// multiplying its upper 32 bits with the number of blocks rather than by masking
+  /// them, and WriteTo() precedes the bitset with a thrift BloomFilterHeader.
+  explicit BlockSplitBloomFilter(HashStrategy hash_strategy);
+
   /// Initialize the BlockSplitBloomFilter. The range of num_bytes should be within
   /// [kMinimumBloomFilterBytes, kMaximumBloomFilterBytes], it will be
   /// rounded up/down to lower/upper bound if num_bytes is out of range and also
@@ -202,7 +216,20 @@ class PARQUET_EXPORT BlockSplitBloomFilter : public BloomFilter {
   /// @return The BlockSplitBloomFilter.
   static BlockSplitBloomFilter Deserialize(ArrowInputStream* input_stream);
 
+  /// Deserialize the thrift BloomFilterHeader which precedes the bitset of a Bloom
+  /// filter stored in a Parquet file. Throws if it is malformed or describes a filter
+  /// other than an uncompressed split block filter hashed with xxHash.
+  ///
+  /// @param data The serialized header, possibly followed by other bytes.
+  /// @param[in,out] header_length The number of bytes available at data, set to the
+  /// length of the header.
+  /// @return The number of bytes of the bitset following the header.
+  static uint32_t DeserializeHeader(const uint8_t* data, uint32_t* header_length);
+
  private:
+  // Return the index of the block a hash falls into
+  uint32_t BlockIndex(uint64_t hash) const;
+
   // Bytes in a tiny Bloom filter block.
   static constexpr int kBytesPerFilterBlock = 32;
 
@@ -244,4 +271,35 @@ class PARQUET_EXPORT BlockSplitBloomFilter : public BloomFilter {
   std::unique_ptr<Hasher> hasher_;
 };
 
+// Collects the Bloom filters of the column chunks of a row group as they are written,
+// for the columns which have Bloom filters enabled in the writer properties.
+class PARQUET_EXPORT BloomFilterBuilder {
+ public:
+  BloomFilterBuilder(const SchemaDescriptor* schema, const WriterProperties* properties);
+  ~BloomFilterBuilder();
+
+  /// Start collecting the Bloom filters of a new row group. The filters of the
+  /// previous row group must have been written.
+  void AppendRowGroup();
+
+  /// Return the Bloom filter of the i-th column of the current row group, or nullptr
+  /// if the column does not get one. Its bitset is only sized when the row group is
+  /// written, from the number of distinct values inserted, so it buffers their hashes
+  /// until then or until they exceed the NDV of the column's BloomFilterOptions.
+  BloomFilter* GetOrCreateBloomFilter(int i);
+
+  /// Write the Bloom filters of the current row group to the sink and record their
+  /// offsets in the file metadata.
+  void WriteTo(ArrowOutputStream* sink, FileMetaDataBuilder* metadata);
+
+ private:
+  class ChunkBloomFilter;
+
+  const SchemaDescriptor* schema_;
+  const WriterProperties* properties_;
+  int row_group_ = -1;
+  // Bloom filters of the current row group by column index
+  std::map<int, std::unique_ptr<ChunkBloomFilter>> bloom_filters_;
+};
+
 }  // namespace parquet
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -35,6 +36,7 @@
 #include "parquet/platform.h"
 #include "parquet/test_util.h"
 #include "parquet/types.h"
+#include "parquet/xxhasher.h"
 
 namespace parquet {
 namespace test {
@@ -48,6 +50,13 @@ TEST(Murmur3Test, TestBloomFilter) {
   EXPECT_EQ(result, UINT64_C(913737700387071329));
 }
 
+TEST(XxHashTest, TestBloomFilter) {
+  // The XXH64 digest of the empty input with a seed of 0
+  const ByteArray empty(0, nullptr);
+  XxHasher hasher;
+  EXPECT_EQ(hasher.Hash(&empty), UINT64_C(0xEF46DB3751D8E999));
+}
+
 TEST(ConstructorTest, TestBloomFilter) {
   BlockSplitBloomFilter bloom_filter;
   EXPECT_NO_THROW(bloom_filter.Init(1000));
@@ -203,6 +212,52 @@ TEST(CompatibilityTest, TestBloomFilter) {
   EXPECT_TRUE((*buffer1).Equals(*buffer2));
 }
 
+// The filters stored in Parquet files follow the format specification: a thrift
+// BloomFilterHeader in the compact protocol followed by the bitset, whose blocks are
+// picked by multiplying the upper half of the hash with the number of blocks.
+TEST(FormatCompatibilityTest, TestBloomFilter) {
+  BlockSplitBloomFilter bloom_filter(BloomFilter::HashStrategy::XXHASH);
+  bloom_filter.Init(64);
+  // The upper half of the hash falls in the second of two blocks
+  bloom_filter.InsertHash(UINT64_C(0x8000000000000001));
+
+  auto sink = CreateOutputStream();
+  bloom_filter.WriteTo(sink.get());
+  ASSERT_OK_AND_ASSIGN(auto buffer, sink->Finish());
+
+  // numBytes: 64, algorithm: BLOCK, hash: XXHASH, compression: UNCOMPRESSED
+  const std::vector<uint8_t> expected_header = {0x15, 0x80, 0x01, 0x1c, 0x1c, 0x00,
+                                                0x00, 0x1c, 0x1c, 0x00, 0x00, 0x1c,
+                                                0x1c, 0x00, 0x00, 0x00};
+  ASSERT_EQ(buffer->size(), static_cast<int64_t>(expected_header.size()) + 64);
+  EXPECT_EQ(std::vector<uint8_t>(buffer->data(), buffer->data() + expected_header.size()),
+            expected_header);
+
+  const uint8_t* bitset = buffer->data() + expected_header.size();
+  EXPECT_TRUE(std::all_of(bitset, bitset + 32, [](uint8_t byte) { return byte == 0; }));
+  EXPECT_FALSE(
+      std::all_of(bitset + 32, bitset + 64, [](uint8_t byte) { return byte == 0; }));
+
+  uint32_t header_length = static_cast<uint32_t>(buffer->size());
+  EXPECT_EQ(BlockSplitBloomFilter::DeserializeHeader(buffer->data(), &header_length),
+            64);
+  EXPECT_EQ(header_length, expected_header.size());
+
+  BlockSplitBloomFilter de_bloom(BloomFilter::HashStrategy::XXHASH);
+  de_bloom.Init(bitset, 64);
+  EXPECT_TRUE(de_bloom.FindHash(UINT64_C(0x8000000000000001)));
+
+  // Filters with a legacy header are rejected
+  BlockSplitBloomFilter legacy;
+  legacy.Init(64);
+  sink = CreateOutputStream();
+  legacy.WriteTo(sink.get());
+  ASSERT_OK_AND_ASSIGN(buffer, sink->Finish());
+  header_length = static_cast<uint32_t>(buffer->size());
+  EXPECT_THROW(BlockSplitBloomFilter::DeserializeHeader(buffer->data(), &header_length),
+               ParquetException);
+}
+
 // OptimalValueTest is used to test whether OptimalNumOfBits returns expected
 // numbers according to formula:
 //     num_of_bits = -8.0 * ndv / log(1 - pow(fpp, 1.0 / 8.0))
@@ -36,11 +36,13 @@
 #include "arrow/type.h"
 #include "arrow/util/bit_stream_utils.h"
 #include "arrow/util/bit_util.h"
+#include "arrow/util/bitmap_reader.h"
 #include "arrow/util/checked_cast.h"
 #include "arrow/util/compression.h"
 #include "arrow/util/int_util_internal.h"
 #include "arrow/util/logging.h"
 #include "arrow/util/rle_encoding.h"
+#include "arrow/util/spaced.h"
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/encryption/encryption_internal.h"
@@ -765,8 +767,11 @@ class ColumnReaderImplBase {
           decoders_[static_cast<int>(encoding)] = std::move(decoder);
           break;
         }
-        case Encoding::BYTE_STREAM_SPLIT: {
-          auto decoder = MakeTypedDecoder<DType>(Encoding::BYTE_STREAM_SPLIT, descr_);
+        case Encoding::BYTE_STREAM_SPLIT:
+        case Encoding::DELTA_BINARY_PACKED:
+        case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        case Encoding::DELTA_BYTE_ARRAY: {
+          auto decoder = MakeTypedDecoder<DType>(encoding, descr_);
           current_decoder_ = decoder.get();
           decoders_[static_cast<int>(encoding)] = std::move(decoder);
           break;
@@ -774,11 +779,6 @@ class ColumnReaderImplBase {
         case Encoding::RLE_DICTIONARY:
           throw ParquetException("Dictionary page must be before data page.");
 
-        case Encoding::DELTA_BINARY_PACKED:
-        case Encoding::DELTA_LENGTH_BYTE_ARRAY:
-        case Encoding::DELTA_BYTE_ARRAY:
-          ParquetException::NYI("Unsupported encoding");
-
         default:
           throw ParquetException("Unknown encoding type.");
       }
@@ -1182,6 +1182,7 @@ class TypedRecordReader : public ColumnReaderImplBase<DType>,
     valid_bits_ = AllocateBuffer(pool);
     def_levels_ = AllocateBuffer(pool);
     rep_levels_ = AllocateBuffer(pool);
+    skip_scratch_ = AllocateBuffer(pool);
     Reset();
   }
 
@@ -1268,6 +1269,50 @@ class TypedRecordReader : public ColumnReaderImplBase<DType>,
     return records_read;
   }
 
+  int64_t SkipRecords(int64_t num_records) override {
+    if (this->max_rep_level_ > 0) {
+      ParquetException::NYI("Skipping records of repeated columns");
+    }
+    int64_t records_skipped = 0;
+
+    // Levels decoded ahead by ReadRecords come first. Drop them from the level
+    // buffers, so that the levels of the records read stay contiguous.
+    if (levels_position_ < levels_written_) {
+      records_skipped = std::min(num_records, levels_written_ - levels_position_);
+      int16_t* def_data = def_levels() + levels_position_;
+      SkipValues(std::count(def_data, def_data + records_skipped, this->max_def_level_));
+      std::copy(def_data + records_skipped, def_levels() + levels_written_, def_data);
+      levels_written_ -= records_skipped;
+      this->ConsumeBufferedValues(records_skipped);
+    }
+
+    while (records_skipped < num_records && this->HasNextInternal()) {
+      const int64_t records_to_skip = num_records - records_skipped;
+      const int64_t available = available_values_current_page();
+      if (records_to_skip >= available) {
+        // Drop the rest of the page, without decoding its levels or values
+        this->ConsumeBufferedValues(available);
+        records_skipped += available;
+        continue;
+      }
+
+      int64_t batch_size = std::min(records_to_skip, kMinLevelBatchSize);
+      int64_t values_to_skip = batch_size;
+      if (this->max_def_level_ > 0) {
+        PARQUET_THROW_NOT_OK(skip_scratch_->Resize(batch_size * sizeof(int16_t),
+                                                   /*shrink_to_fit=*/false));
+        auto levels = reinterpret_cast<int16_t*>(skip_scratch_->mutable_data());
+        batch_size = this->ReadDefinitionLevels(batch_size, levels);
+        if (batch_size == 0) break;
+        values_to_skip = std::count(levels, levels + batch_size, this->max_def_level_);
+      }
+      SkipValues(values_to_skip);
+      this->ConsumeBufferedValues(batch_size);
+      records_skipped += batch_size;
+    }
+    return records_skipped;
+  }
+
   // We may outwardly have the appearance of having exhausted a column chunk
   // when in fact we are in the middle of processing the last batch
   bool has_values_to_process() const { return levels_position_ < levels_written_; }
@@ -1465,6 +1510,21 @@ class TypedRecordReader : public ColumnReaderImplBase<DType>,
     DCHECK_EQ(num_decoded, values_to_read);
   }
 
+  // Decode and discard the next values of the current page
+  void SkipValues(int64_t num_values) {
+    const int64_t batch_size = std::min(num_values, kMinLevelBatchSize);
+    PARQUET_THROW_NOT_OK(
+        skip_scratch_->Resize(batch_size * sizeof(T), /*shrink_to_fit=*/false));
+    auto values = reinterpret_cast<T*>(skip_scratch_->mutable_data());
+    while (num_values > 0) {
+      const int batch = static_cast<int>(std::min(num_values, batch_size));
+      if (this->current_decoder_->Decode(values, batch) != batch) {
+        ParquetException::EofException();
+      }
+      num_values -= batch;
+    }
+  }
+
   // Return number of logical records read
   int64_t ReadRecordData(int64_t num_records) {
     // Conservative upper bound
@@ -1566,6 +1626,8 @@ class TypedRecordReader : public ColumnReaderImplBase<DType>,
     return reinterpret_cast<T*>(values_->mutable_data()) + values_written_;
   }
   LevelInfo leaf_info_;
+  // Levels and values decoded by SkipRecords
+  std::shared_ptr<ResizableBuffer> skip_scratch_;
 };
 
 class FLBARecordReader : public TypedRecordReader<FLBAType>,
@@ -1667,8 +1729,11 @@ class ByteArrayDictionaryRecordReader : public TypedRecordReader<ByteArrayType>,
                                         virtual public DictionaryRecordReader {
  public:
   ByteArrayDictionaryRecordReader(const ColumnDescriptor* descr, LevelInfo leaf_info,
-                                  ::arrow::MemoryPool* pool)
-      : TypedRecordReader<ByteArrayType>(descr, leaf_info, pool), builder_(pool) {
+                                  ::arrow::MemoryPool* pool, bool unify_dictionaries)
+      : TypedRecordReader<ByteArrayType>(descr, leaf_info, pool),
+        builder_(pool),
+        unify_dictionaries_(unify_dictionaries),
+        indices_scratch_(AllocateBuffer(pool)) {
     this->read_dictionary_ = true;
   }
 
@@ -1692,19 +1757,81 @@ class ByteArrayDictionaryRecordReader : public TypedRecordReader<ByteArrayType>,
 
   void MaybeWriteNewDictionary() {
     if (this->new_dictionary_) {
-      /// If there is a new dictionary, we may need to flush the builder, then
-      /// insert the new dictionary values
-      FlushBuilder();
-      builder_.ResetFull();
-      auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
-      decoder->InsertDictionary(&builder_);
+      if (unify_dictionaries_) {
+        MergeDictionary();
+      } else {
+        /// If there is a new dictionary, we may need to flush the builder, then
+        /// insert the new dictionary values
+        FlushBuilder();
+        builder_.ResetFull();
+        auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
+        decoder->InsertDictionary(&builder_);
+      }
       this->new_dictionary_ = false;
     }
   }
 
+  /// Add the values of the decoder's dictionary to the builder's memo and record
+  /// the memo index of each of them, so that the indices of the following pages
+  /// can be translated instead of starting a new chunk
+  void MergeDictionary() {
+    auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
+    const ByteArray* dictionary;
+    int32_t dictionary_length;
+    decoder->GetDictionary(&dictionary, &dictionary_length);
+
+    dictionary_remap_.resize(dictionary_length);
+    remap_is_identity_ = true;
+    for (int32_t i = 0; i < dictionary_length; ++i) {
+      const ::arrow::util::string_view value(
+          reinterpret_cast<const char*>(dictionary[i].ptr), dictionary[i].len);
+      PARQUET_THROW_NOT_OK(builder_.GetOrInsertMemoValue(value, &dictionary_remap_[i]));
+      remap_is_identity_ &= dictionary_remap_[i] == i;
+    }
+  }
+
+  /// Decode num_values non-null indices of the current page, translated to the
+  /// builder's memo indices, into the scratch space, which is sized for
+  /// scratch_size indices
+  int32_t* DecodeRemappedIndices(int num_values, int64_t scratch_size) {
+    PARQUET_THROW_NOT_OK(indices_scratch_->Resize(scratch_size * sizeof(int32_t),
+                                                  /*shrink_to_fit=*/false));
+    auto indices = reinterpret_cast<int32_t*>(indices_scratch_->mutable_data());
+    auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
+    if (decoder->DecodeIndices(num_values, indices) != num_values) {
+      ParquetException::EofException();
+    }
+
+    // The bounds checks are kept apart from the gather so that both loops can be
+    // vectorized
+    const auto dictionary_length = static_cast<uint32_t>(dictionary_remap_.size());
+    uint32_t out_of_bounds = 0;
+    for (int i = 0; i < num_values; ++i) {
+      out_of_bounds |= static_cast<uint32_t>(indices[i]) >= dictionary_length;
+    }
+    if (ARROW_PREDICT_FALSE(out_of_bounds)) {
+      throw ParquetException("Dictionary index out of bounds (corrupt file?)");
+    }
+    // Nothing to translate when the page's dictionary is a prefix of the one built
+    // so far, as when all row groups were written with the same dictionary
+    if (!remap_is_identity_) {
+      const int32_t* remap = dictionary_remap_.data();
+      for (int i = 0; i < num_values; ++i) {
+        indices[i] = remap[indices[i]];
+      }
+    }
+    return indices;
+  }
+
   void ReadValuesDense(int64_t values_to_read) override {
     int64_t num_decoded = 0;
-    if (current_encoding_ == Encoding::RLE_DICTIONARY) {
+    if (current_encoding_ == Encoding::RLE_DICTIONARY && unify_dictionaries_) {
+      MaybeWriteNewDictionary();
+      const int32_t* indices =
+          DecodeRemappedIndices(static_cast<int>(values_to_read), values_to_read);
+      PARQUET_THROW_NOT_OK(builder_.AppendIndices(indices, values_to_read));
+      num_decoded = values_to_read;
+    } else if (current_encoding_ == Encoding::RLE_DICTIONARY) {
       MaybeWriteNewDictionary();
       auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
       num_decoded = decoder->DecodeIndices(static_cast<int>(values_to_read), &builder_);
@@ -1720,7 +1847,25 @@ class ByteArrayDictionaryRecordReader : public TypedRecordReader<ByteArrayType>,
 
   void ReadValuesSpaced(int64_t values_to_read, int64_t null_count) override {
     int64_t num_decoded = 0;
-    if (current_encoding_ == Encoding::RLE_DICTIONARY) {
+    if (current_encoding_ == Encoding::RLE_DICTIONARY && unify_dictionaries_) {
+      MaybeWriteNewDictionary();
+      const int num_values = static_cast<int>(values_to_read);
+      const int num_nulls = static_cast<int>(null_count);
+      int32_t* indices = DecodeRemappedIndices(num_values - num_nulls, values_to_read);
+      ::arrow::util::internal::SpacedExpand<int32_t>(
+          indices, num_values, num_nulls, valid_bits_->mutable_data(), values_written_);
+
+      std::vector<uint8_t> valid_bytes(num_values);
+      ::arrow::internal::BitmapReader bit_reader(valid_bits_->mutable_data(),
+                                                 values_written_, num_values);
+      for (int i = 0; i < num_values; ++i) {
+        valid_bytes[i] = static_cast<uint8_t>(bit_reader.IsSet());
+        bit_reader.Next();
+      }
+      PARQUET_THROW_NOT_OK(
+          builder_.AppendIndices(indices, values_to_read, valid_bytes.data()));
+      num_decoded = values_to_read - null_count;
+    } else if (current_encoding_ == Encoding::RLE_DICTIONARY) {
       MaybeWriteNewDictionary();
       auto decoder = dynamic_cast<BinaryDictDecoder*>(this->current_decoder_);
       num_decoded = decoder->DecodeIndicesSpaced(
@@ -1742,6 +1887,13 @@ class ByteArrayDictionaryRecordReader : public TypedRecordReader<ByteArrayType>,
 
   ::arrow::BinaryDictionary32Builder builder_;
   std::vector<std::shared_ptr<::arrow::Array>> result_chunks_;
+
+  // See ArrowReaderProperties::set_unify_dictionaries
+  const bool unify_dictionaries_;
+  // Memo index in builder_ of each value of the current dictionary page
+  std::vector<int32_t> dictionary_remap_;
+  bool remap_is_identity_ = true;
+  std::shared_ptr<ResizableBuffer> indices_scratch_;
 };
 
 // TODO(wesm): Implement these to some satisfaction
@@ -1757,9 +1909,11 @@ void TypedRecordReader<FLBAType>::DebugPrintState() {}
 std::shared_ptr<RecordReader> MakeByteArrayRecordReader(const ColumnDescriptor* descr,
                                                         LevelInfo leaf_info,
                                                         ::arrow::MemoryPool* pool,
-                                                        bool read_dictionary) {
+                                                        bool read_dictionary,
+                                                        bool unify_dictionaries) {
   if (read_dictionary) {
-    return std::make_shared<ByteArrayDictionaryRecordReader>(descr, leaf_info, pool);
+    return std::make_shared<ByteArrayDictionaryRecordReader>(descr, leaf_info, pool,
+                                                             unify_dictionaries);
   } else {
     return std::make_shared<ByteArrayChunkedRecordReader>(descr, leaf_info, pool);
   }
@@ -1769,7 +1923,8 @@ std::shared_ptr<RecordReader> MakeByteArrayRecordReader(const ColumnDescriptor*
 
 std::shared_ptr<RecordReader> RecordReader::Make(const ColumnDescriptor* descr,
                                                  LevelInfo leaf_info, MemoryPool* pool,
-                                                 const bool read_dictionary) {
+                                                 const bool read_dictionary,
+                                                 const bool unify_dictionaries) {
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::make_shared<TypedRecordReader<BooleanType>>(descr, leaf_info, pool);
@@ -1784,7 +1939,8 @@ std::shared_ptr<RecordReader> RecordReader::Make(const ColumnDescriptor* descr,
     case Type::DOUBLE:
       return std::make_shared<TypedRecordReader<DoubleType>>(descr, leaf_info, pool);
     case Type::BYTE_ARRAY:
-      return MakeByteArrayRecordReader(descr, leaf_info, pool, read_dictionary);
+      return MakeByteArrayRecordReader(descr, leaf_info, pool, read_dictionary,
+                                       unify_dictionaries);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<FLBARecordReader>(descr, leaf_info, pool);
     default: {
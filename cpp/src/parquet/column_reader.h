@@ -258,7 +258,7 @@ class RecordReader {
   static std::shared_ptr<RecordReader> Make(
       const ColumnDescriptor* descr, LevelInfo leaf_info,
       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
-      const bool read_dictionary = false);
+      const bool read_dictionary = false, const bool unify_dictionaries = false);
 
   virtual ~RecordReader() = default;
 
@@ -266,6 +266,14 @@ class RecordReader {
   /// \return number of records read
   virtual int64_t ReadRecords(int64_t num_records) = 0;
 
+  /// \brief Skip the indicated number of records of the column chunk, without
+  /// adding them to the buffers
+  ///
+  /// Pages all of whose remaining records are skipped are not decoded at all.
+  /// Only supported for columns without repetition.
+  /// \return number of records skipped
+  virtual int64_t SkipRecords(int64_t num_records) = 0;
+
   /// \brief Pre-allocate space for data. Results in better flat read performance
   virtual void Reserve(int64_t num_values) = 0;
 
@@ -33,6 +33,7 @@
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bit_run_reader.h"
 #include "arrow/util/bit_stream_utils.h"
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_ops.h"
@@ -42,12 +43,14 @@
 #include "arrow/util/logging.h"
 #include "arrow/util/rle_encoding.h"
 #include "arrow/visitor_inline.h"
+#include "parquet/bloom_filter.h"
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/encryption/encryption_internal.h"
 #include "parquet/encryption/internal_file_encryptor.h"
 #include "parquet/level_conversion.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/platform.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
@@ -249,9 +252,13 @@ class SerializedPageWriter : public PageWriter {
                        int16_t row_group_ordinal, int16_t column_chunk_ordinal,
                        MemoryPool* pool = ::arrow::default_memory_pool(),
                        std::shared_ptr<Encryptor> meta_encryptor = nullptr,
-                       std::shared_ptr<Encryptor> data_encryptor = nullptr)
+                       std::shared_ptr<Encryptor> data_encryptor = nullptr,
+                       ColumnIndexBuilder* column_index_builder = nullptr,
+                       OffsetIndexBuilder* offset_index_builder = nullptr)
       : sink_(std::move(sink)),
         metadata_(metadata),
+        column_index_builder_(column_index_builder),
+        offset_index_builder_(offset_index_builder),
         pool_(pool),
         num_values_(0),
         dictionary_page_offset_(0),
@@ -402,6 +409,15 @@ class SerializedPageWriter : public PageWriter {
         thrift_serializer_->Serialize(&page_header, sink_.get(), meta_encryptor_);
     PARQUET_THROW_NOT_OK(sink_->Write(output_data_buffer, output_data_len));
 
+    if (column_index_builder_ != nullptr) {
+      column_index_builder_->AddPage(page.statistics(), page.num_values());
+    }
+    if (offset_index_builder_ != nullptr) {
+      offset_index_builder_->AddPage(start_pos,
+                                     static_cast<int32_t>(header_size + output_data_len),
+                                     page.first_row_index());
+    }
+
     total_uncompressed_size_ += uncompressed_size + header_size;
     total_compressed_size_ += output_data_len + header_size;
     num_values_ += page.num_values();
@@ -510,6 +526,8 @@ class SerializedPageWriter : public PageWriter {
 
   std::shared_ptr<ArrowOutputStream> sink_;
   ColumnChunkMetaDataBuilder* metadata_;
+  ColumnIndexBuilder* column_index_builder_;
+  OffsetIndexBuilder* offset_index_builder_;
   MemoryPool* pool_;
   int64_t num_values_;
   int64_t dictionary_page_offset_;
@@ -545,13 +563,18 @@ class BufferedPageWriter : public PageWriter {
                      int16_t row_group_ordinal, int16_t current_column_ordinal,
                      MemoryPool* pool = ::arrow::default_memory_pool(),
                      std::shared_ptr<Encryptor> meta_encryptor = nullptr,
-                     std::shared_ptr<Encryptor> data_encryptor = nullptr)
-      : final_sink_(std::move(sink)), metadata_(metadata), has_dictionary_pages_(false) {
+                     std::shared_ptr<Encryptor> data_encryptor = nullptr,
+                     ColumnIndexBuilder* column_index_builder = nullptr,
+                     OffsetIndexBuilder* offset_index_builder = nullptr)
+      : final_sink_(std::move(sink)),
+        metadata_(metadata),
+        offset_index_builder_(offset_index_builder),
+        has_dictionary_pages_(false) {
     in_memory_sink_ = CreateOutputStream(pool);
-    pager_ = std::unique_ptr<SerializedPageWriter>(
-        new SerializedPageWriter(in_memory_sink_, codec, compression_level, metadata,
-                                 row_group_ordinal, current_column_ordinal, pool,
-                                 std::move(meta_encryptor), std::move(data_encryptor)));
+    pager_ = std::unique_ptr<SerializedPageWriter>(new SerializedPageWriter(
+        in_memory_sink_, codec, compression_level, metadata, row_group_ordinal,
+        current_column_ordinal, pool, std::move(meta_encryptor),
+        std::move(data_encryptor), column_index_builder, offset_index_builder));
   }
 
   int64_t WriteDictionaryPage(const DictionaryPage& page) override {
@@ -573,6 +596,10 @@ class BufferedPageWriter : public PageWriter {
                       pager_->total_compressed_size(), pager_->total_uncompressed_size(),
                       has_dictionary, fallback, pager_->dict_encoding_stats_,
                       pager_->data_encoding_stats_, pager_->meta_encryptor_);
+    if (offset_index_builder_ != nullptr) {
+      // Page offsets were recorded relative to the in-memory sink
+      offset_index_builder_->Finish(final_position);
+    }
 
     // Write metadata at end of column chunk
     metadata_->WriteTo(in_memory_sink_.get());
@@ -595,6 +622,7 @@ class BufferedPageWriter : public PageWriter {
  private:
   std::shared_ptr<ArrowOutputStream> final_sink_;
   ColumnChunkMetaDataBuilder* metadata_;
+  OffsetIndexBuilder* offset_index_builder_;
   std::shared_ptr<::arrow::io::BufferOutputStream> in_memory_sink_;
   std::unique_ptr<SerializedPageWriter> pager_;
   bool has_dictionary_pages_;
@@ -605,17 +633,18 @@ std::unique_ptr<PageWriter> PageWriter::Open(
     int compression_level, ColumnChunkMetaDataBuilder* metadata,
     int16_t row_group_ordinal, int16_t column_chunk_ordinal, MemoryPool* pool,
     bool buffered_row_group, std::shared_ptr<Encryptor> meta_encryptor,
-    std::shared_ptr<Encryptor> data_encryptor) {
+    std::shared_ptr<Encryptor> data_encryptor, ColumnIndexBuilder* column_index_builder,
+    OffsetIndexBuilder* offset_index_builder) {
   if (buffered_row_group) {
-    return std::unique_ptr<PageWriter>(
-        new BufferedPageWriter(std::move(sink), codec, compression_level, metadata,
-                               row_group_ordinal, column_chunk_ordinal, pool,
-                               std::move(meta_encryptor), std::move(data_encryptor)));
+    return std::unique_ptr<PageWriter>(new BufferedPageWriter(
+        std::move(sink), codec, compression_level, metadata, row_group_ordinal,
+        column_chunk_ordinal, pool, std::move(meta_encryptor), std::move(data_encryptor),
+        column_index_builder, offset_index_builder));
   } else {
-    return std::unique_ptr<PageWriter>(
-        new SerializedPageWriter(std::move(sink), codec, compression_level, metadata,
-                                 row_group_ordinal, column_chunk_ordinal, pool,
-                                 std::move(meta_encryptor), std::move(data_encryptor)));
+    return std::unique_ptr<PageWriter>(new SerializedPageWriter(
+        std::move(sink), codec, compression_level, metadata, row_group_ordinal,
+        column_chunk_ordinal, pool, std::move(meta_encryptor), std::move(data_encryptor),
+        column_index_builder, offset_index_builder));
   }
 }
 
@@ -644,6 +673,7 @@ class ColumnWriterImpl {
         num_buffered_values_(0),
         num_buffered_encoded_values_(0),
         rows_written_(0),
+        page_first_row_index_(0),
         total_bytes_written_(0),
         total_compressed_bytes_(0),
         closed_(false),
@@ -750,6 +780,9 @@ class ColumnWriterImpl {
   // Total number of rows written with this ColumnWriter
   int rows_written_;
 
+  // Index of the first row of the data page being buffered
+  int64_t page_first_row_index_;
+
   // Records the total number of uncompressed bytes written by the serializer
   int64_t total_bytes_written_;
 
@@ -855,6 +888,7 @@ void ColumnWriterImpl::AddDataPage() {
   InitSinks();
   num_buffered_values_ = 0;
   num_buffered_encoded_values_ = 0;
+  page_first_row_index_ = rows_written_;
 }
 
 void ColumnWriterImpl::BuildDataPageV1(int64_t definition_levels_rle_size,
@@ -888,14 +922,15 @@ void ColumnWriterImpl::BuildDataPageV1(int64_t definition_levels_rle_size,
         compressed_data->CopySlice(0, compressed_data->size(), allocator_));
     std::unique_ptr<DataPage> page_ptr(new DataPageV1(
         compressed_data_copy, static_cast<int32_t>(num_buffered_values_), encoding_,
-        Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats));
+        Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats,
+        page_first_row_index_));
     total_compressed_bytes_ += page_ptr->size() + sizeof(format::PageHeader);
 
     data_pages_.push_back(std::move(page_ptr));
   } else {  // Eagerly write pages
     DataPageV1 page(compressed_data, static_cast<int32_t>(num_buffered_values_),
                     encoding_, Encoding::RLE, Encoding::RLE, uncompressed_size,
-                    page_stats);
+                    page_stats, page_first_row_index_);
     WriteDataPage(page);
   }
 }
@@ -939,13 +974,14 @@ void ColumnWriterImpl::BuildDataPageV2(int64_t definition_levels_rle_size,
                             combined->CopySlice(0, combined->size(), allocator_));
     std::unique_ptr<DataPage> page_ptr(new DataPageV2(
         combined, num_values, null_count, num_values, encoding_, def_levels_byte_length,
-        rep_levels_byte_length, uncompressed_size, pager_->has_compressor()));
+        rep_levels_byte_length, uncompressed_size, pager_->has_compressor(), page_stats,
+        page_first_row_index_));
     total_compressed_bytes_ += page_ptr->size() + sizeof(format::PageHeader);
     data_pages_.push_back(std::move(page_ptr));
   } else {
     DataPageV2 page(combined, num_values, null_count, num_values, encoding_,
                     def_levels_byte_length, rep_levels_byte_length, uncompressed_size,
-                    pager_->has_compressor());
+                    pager_->has_compressor(), page_stats, page_first_row_index_);
     WriteDataPage(page);
   }
 }
@@ -1025,6 +1061,51 @@ static inline bool IsDictionaryEncoding(Encoding::type encoding) {
   return encoding == Encoding::PLAIN_DICTIONARY;
 }
 
+// Hash a physical value for insertion into a Bloom filter
+template <typename T>
+inline uint64_t BloomFilterHash(const BloomFilter& bloom_filter, const T& value,
+                                int32_t type_length) {
+  return bloom_filter.Hash(value);
+}
+
+template <>
+inline uint64_t BloomFilterHash(const BloomFilter& bloom_filter, const bool& value,
+                                int32_t type_length) {
+  // Boolean columns have no Bloom filter
+  DCHECK(false);
+  return 0;
+}
+
+template <>
+inline uint64_t BloomFilterHash(const BloomFilter& bloom_filter, const Int96& value,
+                                int32_t type_length) {
+  return bloom_filter.Hash(&value);
+}
+
+template <>
+inline uint64_t BloomFilterHash(const BloomFilter& bloom_filter, const ByteArray& value,
+                                int32_t type_length) {
+  return bloom_filter.Hash(&value);
+}
+
+template <>
+inline uint64_t BloomFilterHash(const BloomFilter& bloom_filter, const FLBA& value,
+                                int32_t type_length) {
+  return bloom_filter.Hash(&value, static_cast<uint32_t>(type_length));
+}
+
+template <typename ArrayType>
+void InsertBinaryValues(const ArrayType& values, BloomFilter* bloom_filter) {
+  for (int64_t i = 0; i < values.length(); ++i) {
+    if (values.IsValid(i)) {
+      const auto view = values.GetView(i);
+      const ByteArray value(static_cast<uint32_t>(view.size()),
+                            reinterpret_cast<const uint8_t*>(view.data()));
+      bloom_filter->InsertHash(bloom_filter->Hash(&value));
+    }
+  }
+}
+
 template <typename DType>
 class TypedColumnWriterImpl : public ColumnWriterImpl, public TypedColumnWriter<DType> {
  public:
@@ -1032,9 +1113,11 @@ class TypedColumnWriterImpl : public ColumnWriterImpl, public TypedColumnWriter<
 
   TypedColumnWriterImpl(ColumnChunkMetaDataBuilder* metadata,
                         std::unique_ptr<PageWriter> pager, const bool use_dictionary,
-                        Encoding::type encoding, const WriterProperties* properties)
+                        Encoding::type encoding, const WriterProperties* properties,
+                        BloomFilter* bloom_filter = nullptr)
       : ColumnWriterImpl(metadata, std::move(pager), use_dictionary, encoding,
-                         properties) {
+                         properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(DType::type_num, encoding, use_dictionary, descr_,
                                    properties->memory_pool());
 
@@ -1209,6 +1292,7 @@ class TypedColumnWriterImpl : public ColumnWriterImpl, public TypedColumnWriter<
   std::unique_ptr<Encoder> current_encoder_;
   std::shared_ptr<TypedStats> page_statistics_;
   std::shared_ptr<TypedStats> chunk_statistics_;
+  BloomFilter* bloom_filter_;
 
   // If writing a sequence of ::arrow::DictionaryArray to the writer, we keep the
   // dictionary passed to DictEncoder<T>::PutDictionary so we can check
@@ -1389,6 +1473,9 @@ class TypedColumnWriterImpl : public ColumnWriterImpl, public TypedColumnWriter<
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    if (bloom_filter_ != nullptr) {
+      UpdateBloomFilter(values, num_values);
+    }
   }
 
   void WriteValuesSpaced(const T* values, int64_t num_values, int64_t num_spaced_values,
@@ -1406,9 +1493,62 @@ class TypedColumnWriterImpl : public ColumnWriterImpl, public TypedColumnWriter<
       page_statistics_->UpdateSpaced(values, valid_bits, valid_bits_offset, num_values,
                                      num_nulls);
     }
+    if (bloom_filter_ != nullptr) {
+      ::arrow::internal::VisitSetBitRunsVoid(
+          num_values != num_spaced_values ? valid_bits : nullptr, valid_bits_offset,
+          num_spaced_values, [&](int64_t position, int64_t length) {
+            UpdateBloomFilter(values + position, length);
+          });
+    }
   }
+
+  void UpdateBloomFilter(const T* values, int64_t num_values) {
+    const int32_t type_length = descr_->type_length();
+    for (int64_t i = 0; i < num_values; ++i) {
+      bloom_filter_->InsertHash(BloomFilterHash(*bloom_filter_, values[i], type_length));
+    }
+  }
+
+  // Insert the values of the dictionary of an encoder into the Bloom filter. They are
+  // read back from its plain encoding, so as to hash them in their physical type
+  // whatever the Arrow type they were converted from.
+  void UpdateBloomFilterDictionary(DictEncoder<DType>* dict_encoder) {
+    std::shared_ptr<ResizableBuffer> buffer =
+        AllocateBuffer(properties_->memory_pool(), dict_encoder->dict_encoded_size());
+    dict_encoder->WriteDict(buffer->mutable_data());
+    const int num_entries = dict_encoder->num_entries();
+
+    auto decoder = MakeTypedDecoder<DType>(Encoding::PLAIN, descr_);
+    decoder->SetData(num_entries, buffer->data(), static_cast<int>(buffer->size()));
+    std::shared_ptr<ResizableBuffer> values_buffer =
+        AllocateBuffer(properties_->memory_pool(), num_entries * sizeof(T));
+    T* values = reinterpret_cast<T*>(values_buffer->mutable_data());
+    if (decoder->Decode(values, num_entries) != num_entries) {
+      throw ParquetException("Could not read back the dictionary for the Bloom filter");
+    }
+    UpdateBloomFilter(values, num_entries);
+  }
+
+  // Insert the non-null values of an Arrow array into the Bloom filter, returning false
+  // if arrays of its type are not handled here
+  bool UpdateBloomFilterArray(const ::arrow::Array& values) { return false; }
 };
 
+template <>
+bool TypedColumnWriterImpl<ByteArrayType>::UpdateBloomFilterArray(
+    const ::arrow::Array& values) {
+  if (::arrow::is_binary_like(values.type_id())) {
+    InsertBinaryValues(checked_cast<const ::arrow::BinaryArray&>(values), bloom_filter_);
+    return true;
+  }
+  if (::arrow::is_large_binary_like(values.type_id())) {
+    InsertBinaryValues(checked_cast<const ::arrow::LargeBinaryArray&>(values),
+                       bloom_filter_);
+    return true;
+  }
+  return false;
+}
+
 template <typename DType>
 Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
     const int16_t* def_levels, const int16_t* rep_levels, int64_t num_levels,
@@ -1487,6 +1627,11 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
       return WriteDense();
     }
 
+    // Every dictionary value goes into the Bloom filter, whether referenced or not
+    if (bloom_filter_ != nullptr) {
+      PARQUET_CATCH_NOT_OK(UpdateBloomFilterDictionary(dict_encoder));
+    }
+
     // TODO(wesm): If some dictionary values are unobserved, then the
     // statistics will be inaccurate. Do we care enough to fix it?
     if (page_statistics_ != nullptr) {
@@ -1901,6 +2046,9 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(*data_slice);
     }
+    if (bloom_filter_ != nullptr) {
+      UpdateBloomFilterArray(*data_slice);
+    }
     CommitWriteAndCheckPageLimit(batch_size, batch_num_values);
     CheckDictionarySizeLimit();
     value_offset += batch_num_spaced_values;
@@ -2024,7 +2172,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(ColumnChunkMetaDataBuilder* metadata,
                                                  std::unique_ptr<PageWriter> pager,
-                                                 const WriterProperties* properties) {
+                                                 const WriterProperties* properties,
+                                                 BloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
                               descr->physical_type() != Type::BOOLEAN;
@@ -2035,28 +2184,28 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(ColumnChunkMetaDataBuilder* met
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::make_shared<TypedColumnWriterImpl<BooleanType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata, std::move(pager), use_dictionary, encoding, properties, bloom_filter);
     default:
       ParquetException::NYI("type reader not implemented");
   }
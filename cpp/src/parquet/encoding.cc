@@ -935,6 +935,411 @@ void ByteStreamSplitEncoder<DType>::PutSpaced(const T* src, int num_values,
   }
 }
 
+// ----------------------------------------------------------------------
+// DeltaBitPackEncoder
+
+// The block layout written by DeltaBitPackEncoder, which is also the one written by
+// parquet-mr: blocks of 128 values made of 4 miniblocks of 32 values.
+constexpr uint32_t kDeltaValuesPerBlock = 128;
+constexpr uint32_t kDeltaMiniBlocksPerBlock = 4;
+constexpr uint32_t kDeltaValuesPerMiniBlock =
+    kDeltaValuesPerBlock / kDeltaMiniBlocksPerBlock;
+
+// Bit pack a value of up to 64 bits, BitWriter::PutValue taking at most 32 at a time
+inline void PutDeltaValue(::arrow::BitUtil::BitWriter* writer, uint64_t value,
+                          int bit_width) {
+  if (bit_width > 32) {
+    writer->PutValue(value & 0xFFFFFFFFU, 32);
+    writer->PutValue(value >> 32, bit_width - 32);
+  } else {
+    writer->PutValue(value, bit_width);
+  }
+}
+
+// The values of a page are written as a header holding the first value, followed by
+// blocks of the deltas between consecutive values. Each block stores its minimum
+// delta and the deltas relative to it, bit packed with the width of the largest one
+// of each miniblock. Deltas are buffered a whole block at a time so that the loops
+// computing them work on fixed size arrays which the compiler can vectorize.
+template <typename DType>
+class DeltaBitPackEncoder : public EncoderImpl, virtual public TypedEncoder<DType> {
+ public:
+  using T = typename DType::c_type;
+  using UT = typename std::make_unsigned<T>::type;
+  using TypedEncoder<DType>::Put;
+
+  explicit DeltaBitPackEncoder(const ColumnDescriptor* descr,
+                               MemoryPool* pool = ::arrow::default_memory_pool())
+      : EncoderImpl(descr, Encoding::DELTA_BINARY_PACKED, pool), sink_(pool) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return kMaxHeaderLength + sink_.length() + values_current_block_ * sizeof(T);
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override;
+
+  void Put(const T* src, int num_values) override;
+  void Put(const ::arrow::Array& values) override;
+  void PutSpaced(const T* src, int num_values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset) override;
+
+ private:
+  // Block size, miniblock count, value count and first value
+  static constexpr int kMaxHeaderLength =
+      3 * ::arrow::BitUtil::BitReader::kMaxVlqByteLength +
+      ::arrow::BitUtil::BitReader::kMaxVlqByteLengthForInt64;
+  // Minimum delta, miniblock bit widths and miniblocks of full width deltas
+  static constexpr int kMaxBlockLength =
+      ::arrow::BitUtil::BitReader::kMaxVlqByteLengthForInt64 +
+      kDeltaMiniBlocksPerBlock + kDeltaValuesPerBlock * sizeof(T);
+
+  void FlushBlock();
+
+  ::arrow::BufferBuilder sink_;
+  int64_t total_value_count_ = 0;
+  T first_value_ = 0;
+  T current_value_ = 0;
+  uint32_t values_current_block_ = 0;
+  UT deltas_[kDeltaValuesPerBlock];
+  uint8_t block_buffer_[kMaxBlockLength];
+};
+
+template <typename DType>
+void DeltaBitPackEncoder<DType>::Put(const T* src, int num_values) {
+  if (num_values == 0) return;
+
+  int idx = 0;
+  if (total_value_count_ == 0) {
+    first_value_ = src[0];
+    current_value_ = src[0];
+    idx = 1;
+  }
+  total_value_count_ += num_values;
+
+  while (idx < num_values) {
+    const int batch_size =
+        std::min(num_values - idx, static_cast<int>(kDeltaValuesPerBlock -
+                                                     values_current_block_));
+    const T* values = src + idx;
+    UT* deltas = deltas_ + values_current_block_;
+    // Deltas wrap around on overflow, as the decoder adds them back the same way
+    deltas[0] = static_cast<UT>(values[0]) - static_cast<UT>(current_value_);
+    for (int i = 1; i < batch_size; ++i) {
+      deltas[i] = static_cast<UT>(values[i]) - static_cast<UT>(values[i - 1]);
+    }
+    current_value_ = values[batch_size - 1];
+    values_current_block_ += batch_size;
+    idx += batch_size;
+
+    if (values_current_block_ == kDeltaValuesPerBlock) {
+      FlushBlock();
+    }
+  }
+}
+
+template <typename DType>
+void DeltaBitPackEncoder<DType>::FlushBlock() {
+  if (values_current_block_ == 0) return;
+
+  T min_delta = std::numeric_limits<T>::max();
+  for (uint32_t i = 0; i < values_current_block_; ++i) {
+    min_delta = std::min(min_delta, static_cast<T>(deltas_[i]));
+  }
+  for (uint32_t i = 0; i < values_current_block_; ++i) {
+    deltas_[i] -= static_cast<UT>(min_delta);
+  }
+  // The last miniblock is padded with zeros to its full size
+  const uint32_t num_mini_blocks = static_cast<uint32_t>(
+      BitUtil::CeilDiv(values_current_block_, kDeltaValuesPerMiniBlock));
+  std::fill(deltas_ + values_current_block_,
+            deltas_ + num_mini_blocks * kDeltaValuesPerMiniBlock, 0);
+
+  ::arrow::BitUtil::BitWriter writer(block_buffer_, kMaxBlockLength);
+  writer.PutZigZagVlqInt(min_delta);
+  uint8_t* bit_widths = writer.GetNextBytePtr(kDeltaMiniBlocksPerBlock);
+  for (uint32_t m = 0; m < kDeltaMiniBlocksPerBlock; ++m) {
+    // Miniblocks past the last value have no data, but still get a bit width
+    if (m >= num_mini_blocks) {
+      bit_widths[m] = 0;
+      continue;
+    }
+    const UT* mini_block = deltas_ + m * kDeltaValuesPerMiniBlock;
+    // OR-ing the deltas gives the bit width of the largest one without branching
+    UT max_delta_bits = 0;
+    for (uint32_t i = 0; i < kDeltaValuesPerMiniBlock; ++i) {
+      max_delta_bits |= mini_block[i];
+    }
+    const int bit_width = BitUtil::NumRequiredBits(max_delta_bits);
+    bit_widths[m] = static_cast<uint8_t>(bit_width);
+    if (bit_width == 0) continue;
+    for (uint32_t i = 0; i < kDeltaValuesPerMiniBlock; ++i) {
+      PutDeltaValue(&writer, mini_block[i], bit_width);
+    }
+  }
+  writer.Flush();
+  PARQUET_THROW_NOT_OK(sink_.Append(block_buffer_, writer.bytes_written()));
+  values_current_block_ = 0;
+}
+
+template <typename DType>
+std::shared_ptr<Buffer> DeltaBitPackEncoder<DType>::FlushValues() {
+  FlushBlock();
+
+  uint8_t header_buffer[kMaxHeaderLength];
+  ::arrow::BitUtil::BitWriter header_writer(header_buffer, kMaxHeaderLength);
+  header_writer.PutVlqInt(kDeltaValuesPerBlock);
+  header_writer.PutVlqInt(kDeltaMiniBlocksPerBlock);
+  header_writer.PutVlqInt(static_cast<uint32_t>(total_value_count_));
+  header_writer.PutZigZagVlqInt(first_value_);
+  header_writer.Flush();
+  const int header_length = header_writer.bytes_written();
+
+  std::shared_ptr<ResizableBuffer> output_buffer =
+      AllocateBuffer(this->memory_pool(), header_length + sink_.length());
+  memcpy(output_buffer->mutable_data(), header_buffer, header_length);
+  if (sink_.length() > 0) {
+    memcpy(output_buffer->mutable_data() + header_length, sink_.data(),
+           sink_.length());
+  }
+  sink_.Reset();
+  total_value_count_ = 0;
+  first_value_ = 0;
+  current_value_ = 0;
+  return std::move(output_buffer);
+}
+
+template <typename DType>
+void DeltaBitPackEncoder<DType>::Put(const ::arrow::Array& values) {
+  using ArrowType = typename ::arrow::CTypeTraits<T>::ArrowType;
+  if (values.type_id() != ArrowType::type_id) {
+    throw ParquetException(std::string() + "direct put to " + ArrowType::type_name() +
+                           " from " + values.type()->ToString() + " not supported");
+  }
+  const auto& data = *values.data();
+  if (values.null_count() == 0) {
+    Put(data.GetValues<T>(1), static_cast<int>(data.length));
+  } else {
+    PutSpaced(data.GetValues<T>(1), static_cast<int>(data.length),
+              data.GetValues<uint8_t>(0, 0), data.offset);
+  }
+}
+
+template <typename DType>
+void DeltaBitPackEncoder<DType>::PutSpaced(const T* src, int num_values,
+                                           const uint8_t* valid_bits,
+                                           int64_t valid_bits_offset) {
+  if (valid_bits != NULLPTR) {
+    PARQUET_ASSIGN_OR_THROW(auto buffer, ::arrow::AllocateBuffer(num_values * sizeof(T),
+                                                                 this->memory_pool()));
+    T* data = reinterpret_cast<T*>(buffer->mutable_data());
+    int num_valid_values = ::arrow::util::internal::SpacedCompress<T>(
+        src, num_values, valid_bits, valid_bits_offset, data);
+    Put(data, num_valid_values);
+  } else {
+    Put(src, num_values);
+  }
+}
+
+// ----------------------------------------------------------------------
+// DeltaLengthByteArrayEncoder
+
+// The lengths of all values, DELTA_BINARY_PACKED, followed by their concatenated bytes
+class DeltaLengthByteArrayEncoder : public EncoderImpl,
+                                    virtual public TypedEncoder<ByteArrayType> {
+ public:
+  using TypedEncoder<ByteArrayType>::Put;
+
+  explicit DeltaLengthByteArrayEncoder(const ColumnDescriptor* descr,
+                                       MemoryPool* pool = ::arrow::default_memory_pool())
+      : EncoderImpl(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY, pool),
+        sink_(pool),
+        length_encoder_(nullptr, pool) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return length_encoder_.EstimatedDataEncodedSize() + sink_.length();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> lengths = length_encoder_.FlushValues();
+    std::shared_ptr<ResizableBuffer> output_buffer =
+        AllocateBuffer(this->memory_pool(), lengths->size() + sink_.length());
+    memcpy(output_buffer->mutable_data(), lengths->data(), lengths->size());
+    if (sink_.length() > 0) {
+      memcpy(output_buffer->mutable_data() + lengths->size(), sink_.data(),
+             sink_.length());
+    }
+    sink_.Reset();
+    return std::move(output_buffer);
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    if (num_values == 0) return;
+    std::vector<int32_t> lengths(num_values);
+    int64_t total_length = 0;
+    for (int i = 0; i < num_values; ++i) {
+      lengths[i] = static_cast<int32_t>(src[i].len);
+      total_length += src[i].len;
+    }
+    length_encoder_.Put(lengths.data(), num_values);
+    PARQUET_THROW_NOT_OK(sink_.Reserve(total_length));
+    for (int i = 0; i < num_values; ++i) {
+      sink_.UnsafeAppend(src[i].ptr, src[i].len);
+    }
+  }
+
+  void Put(const ::arrow::Array& values) override {
+    AssertBaseBinary(values);
+    if (::arrow::is_binary_like(values.type_id())) {
+      PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+    } else {
+      DCHECK(::arrow::is_large_binary_like(values.type_id()));
+      PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
+    }
+  }
+
+  void PutSpaced(const ByteArray* src, int num_values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset) override {
+    if (valid_bits != NULLPTR) {
+      PARQUET_ASSIGN_OR_THROW(
+          auto buffer, ::arrow::AllocateBuffer(num_values * sizeof(ByteArray),
+                                               this->memory_pool()));
+      ByteArray* data = reinterpret_cast<ByteArray*>(buffer->mutable_data());
+      int num_valid_values = ::arrow::util::internal::SpacedCompress<ByteArray>(
+          src, num_values, valid_bits, valid_bits_offset, data);
+      Put(data, num_valid_values);
+    } else {
+      Put(src, num_values);
+    }
+  }
+
+ private:
+  template <typename ArrayType>
+  void PutBinaryArray(const ArrayType& array) {
+    std::vector<int32_t> lengths;
+    lengths.reserve(array.length() - array.null_count());
+    PARQUET_THROW_NOT_OK(::arrow::VisitArrayDataInline<typename ArrayType::TypeClass>(
+        *array.data(),
+        [&](::arrow::util::string_view view) {
+          if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
+            return Status::Invalid("Parquet cannot store strings with size 2GB or more");
+          }
+          lengths.push_back(static_cast<int32_t>(view.size()));
+          return sink_.Append(view.data(), static_cast<int64_t>(view.size()));
+        },
+        []() { return Status::OK(); }));
+    length_encoder_.Put(lengths.data(), static_cast<int>(lengths.size()));
+  }
+
+  ::arrow::BufferBuilder sink_;
+  DeltaBitPackEncoder<Int32Type> length_encoder_;
+};
+
+// ----------------------------------------------------------------------
+// DeltaByteArrayEncoder
+
+// The length of the prefix each value shares with the previous one,
+// DELTA_BINARY_PACKED, followed by the remaining suffixes, DELTA_LENGTH_BYTE_ARRAY
+class DeltaByteArrayEncoder : public EncoderImpl,
+                              virtual public TypedEncoder<ByteArrayType> {
+ public:
+  using TypedEncoder<ByteArrayType>::Put;
+
+  explicit DeltaByteArrayEncoder(const ColumnDescriptor* descr,
+                                 MemoryPool* pool = ::arrow::default_memory_pool())
+      : EncoderImpl(descr, Encoding::DELTA_BYTE_ARRAY, pool),
+        prefix_length_encoder_(nullptr, pool),
+        suffix_encoder_(nullptr, pool) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return prefix_length_encoder_.EstimatedDataEncodedSize() +
+           suffix_encoder_.EstimatedDataEncodedSize();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> prefix_lengths = prefix_length_encoder_.FlushValues();
+    std::shared_ptr<Buffer> suffixes = suffix_encoder_.FlushValues();
+    std::shared_ptr<ResizableBuffer> output_buffer = AllocateBuffer(
+        this->memory_pool(), prefix_lengths->size() + suffixes->size());
+    memcpy(output_buffer->mutable_data(), prefix_lengths->data(),
+           prefix_lengths->size());
+    memcpy(output_buffer->mutable_data() + prefix_lengths->size(), suffixes->data(),
+           suffixes->size());
+    // Each page is decoded on its own
+    last_value_.clear();
+    return std::move(output_buffer);
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    if (num_values == 0) return;
+    std::vector<int32_t> prefix_lengths(num_values);
+    std::vector<ByteArray> suffixes(num_values);
+    for (int i = 0; i < num_values; ++i) {
+      const uint8_t* value = src[i].ptr;
+      const uint32_t length = src[i].len;
+      const uint32_t max_prefix_length =
+          std::min(length, static_cast<uint32_t>(last_value_.size()));
+      uint32_t prefix_length = 0;
+      while (prefix_length < max_prefix_length &&
+             value[prefix_length] ==
+                 static_cast<uint8_t>(last_value_[prefix_length])) {
+        ++prefix_length;
+      }
+      prefix_lengths[i] = static_cast<int32_t>(prefix_length);
+      suffixes[i] = ByteArray(length - prefix_length, value + prefix_length);
+      last_value_.assign(reinterpret_cast<const char*>(value), length);
+    }
+    prefix_length_encoder_.Put(prefix_lengths.data(), num_values);
+    suffix_encoder_.Put(suffixes.data(), num_values);
+  }
+
+  void Put(const ::arrow::Array& values) override {
+    AssertBaseBinary(values);
+    if (::arrow::is_binary_like(values.type_id())) {
+      PutBinaryArray(checked_cast<const ::arrow::BinaryArray&>(values));
+    } else {
+      DCHECK(::arrow::is_large_binary_like(values.type_id()));
+      PutBinaryArray(checked_cast<const ::arrow::LargeBinaryArray&>(values));
+    }
+  }
+
+  void PutSpaced(const ByteArray* src, int num_values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset) override {
+    if (valid_bits != NULLPTR) {
+      PARQUET_ASSIGN_OR_THROW(
+          auto buffer, ::arrow::AllocateBuffer(num_values * sizeof(ByteArray),
+                                               this->memory_pool()));
+      ByteArray* data = reinterpret_cast<ByteArray*>(buffer->mutable_data());
+      int num_valid_values = ::arrow::util::internal::SpacedCompress<ByteArray>(
+          src, num_values, valid_bits, valid_bits_offset, data);
+      Put(data, num_valid_values);
+    } else {
+      Put(src, num_values);
+    }
+  }
+
+ private:
+  template <typename ArrayType>
+  void PutBinaryArray(const ArrayType& array) {
+    std::vector<ByteArray> values;
+    values.reserve(array.length() - array.null_count());
+    PARQUET_THROW_NOT_OK(::arrow::VisitArrayDataInline<typename ArrayType::TypeClass>(
+        *array.data(),
+        [&](::arrow::util::string_view view) {
+          if (ARROW_PREDICT_FALSE(view.size() > kMaxByteArraySize)) {
+            return Status::Invalid("Parquet cannot store strings with size 2GB or more");
+          }
+          values.emplace_back(view);
+          return Status::OK();
+        },
+        []() { return Status::OK(); }));
+    Put(values.data(), static_cast<int>(values.size()));
+  }
+
+  DeltaBitPackEncoder<Int32Type> prefix_length_encoder_;
+  DeltaLengthByteArrayEncoder suffix_encoder_;
+  std::string last_value_;
+};
+
 class DecoderImpl : virtual public Decoder {
  public:
   void SetData(int num_values, const uint8_t* data, int len) override {
@@ -2059,10 +2464,12 @@ template <typename DType>
 class DeltaBitPackDecoder : public DecoderImpl, virtual public TypedDecoder<DType> {
  public:
   typedef typename DType::c_type T;
+  typedef typename std::make_unsigned<T>::type UT;
 
   explicit DeltaBitPackDecoder(const ColumnDescriptor* descr,
                                MemoryPool* pool = ::arrow::default_memory_pool())
-      : DecoderImpl(descr, Encoding::DELTA_BINARY_PACKED), pool_(pool) {
+      : DecoderImpl(descr, Encoding::DELTA_BINARY_PACKED),
+        delta_bit_widths_(AllocateBuffer(pool, 0)) {
     if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
       throw ParquetException("Delta bit pack encoding should only be for integer data.");
     }
@@ -2071,10 +2478,16 @@ class DeltaBitPackDecoder : public DecoderImpl, virtual public TypedDecoder<DTyp
   void SetData(int num_values, const uint8_t* data, int len) override {
     this->num_values_ = num_values;
     decoder_ = ::arrow::BitUtil::BitReader(data, len);
-    values_current_block_ = 0;
-    values_current_mini_block_ = 0;
+    InitHeader();
   }
 
+  // The number of values stored in the page, which doesn't count nulls
+  int ValidValuesCount() const { return static_cast<int>(total_value_count_); }
+
+  // The number of bytes past the values decoded so far, which is what follows the
+  // encoded data once all values were decoded
+  int bytes_left() { return decoder_.bytes_left(); }
+
   int Decode(T* buffer, int max_values) override {
     return GetInternal(buffer, max_values);
   }
@@ -2082,103 +2495,193 @@ class DeltaBitPackDecoder : public DecoderImpl, virtual public TypedDecoder<DTyp
   int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
                   int64_t valid_bits_offset,
                   typename EncodingTraits<DType>::Accumulator* out) override {
-    if (null_count != 0) {
-      ParquetException::NYI("Delta bit pack DecodeArrow with null slots");
+    const int values_decoded = num_values - null_count;
+    std::vector<T> values(values_decoded);
+    if (GetInternal(values.data(), values_decoded) != values_decoded) {
+      ParquetException::EofException();
     }
-    std::vector<T> values(num_values);
-    GetInternal(values.data(), num_values);
-    PARQUET_THROW_NOT_OK(out->AppendValues(values));
-    return num_values;
+    PARQUET_THROW_NOT_OK(out->Reserve(num_values));
+    int value_idx = 0;
+    VisitNullBitmapInline(
+        valid_bits, valid_bits_offset, num_values, null_count,
+        [&]() { out->UnsafeAppend(values[value_idx++]); },
+        [&]() { out->UnsafeAppendNull(); });
+    return values_decoded;
   }
 
   int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
                   int64_t valid_bits_offset,
                   typename EncodingTraits<DType>::DictAccumulator* out) override {
-    if (null_count != 0) {
-      ParquetException::NYI("Delta bit pack DecodeArrow with null slots");
+    const int values_decoded = num_values - null_count;
+    std::vector<T> values(values_decoded);
+    if (GetInternal(values.data(), values_decoded) != values_decoded) {
+      ParquetException::EofException();
     }
-    std::vector<T> values(num_values);
-    GetInternal(values.data(), num_values);
     PARQUET_THROW_NOT_OK(out->Reserve(num_values));
-    for (T value : values) {
-      PARQUET_THROW_NOT_OK(out->Append(value));
-    }
-    return num_values;
+    int value_idx = 0;
+    VisitNullBitmapInline(
+        valid_bits, valid_bits_offset, num_values, null_count,
+        [&]() { PARQUET_THROW_NOT_OK(out->Append(values[value_idx++])); },
+        [&]() { PARQUET_THROW_NOT_OK(out->AppendNull()); });
+    return values_decoded;
   }
 
  private:
-  void InitBlock() {
-    // The number of values per block.
-    uint32_t block_size;
-    if (!decoder_.GetVlqInt(&block_size)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&num_mini_blocks_)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&values_current_block_)) {
+  static constexpr int kMaxDeltaBitWidth = static_cast<int>(sizeof(T) * 8);
+
+  void InitHeader() {
+    if (!decoder_.GetVlqInt(&values_per_block_) ||
+        !decoder_.GetVlqInt(&mini_blocks_per_block_) ||
+        !decoder_.GetVlqInt(&total_value_count_) ||
+        !decoder_.GetZigZagVlqInt(&last_value_)) {
       ParquetException::EofException();
     }
-    if (!decoder_.GetZigZagVlqInt(&last_value_)) ParquetException::EofException();
+    if (values_per_block_ == 0 || values_per_block_ % 128 != 0) {
+      throw ParquetException("the number of values in a block must be multiple of 128");
+    }
+    if (mini_blocks_per_block_ == 0 || values_per_block_ % mini_blocks_per_block_ != 0) {
+      throw ParquetException("cannot split a block into the given number of miniblocks");
+    }
+    values_per_mini_block_ = values_per_block_ / mini_blocks_per_block_;
+    if (values_per_mini_block_ % 32 != 0) {
+      throw ParquetException(
+          "the number of values in a miniblock must be multiple of 32");
+    }
+    PARQUET_THROW_NOT_OK(delta_bit_widths_->Resize(mini_blocks_per_block_, false));
 
-    delta_bit_widths_ = AllocateBuffer(pool_, num_mini_blocks_);
-    uint8_t* bit_width_data = delta_bit_widths_->mutable_data();
+    total_values_remaining_ = total_value_count_;
+    first_value_read_ = false;
+    // The first block is read after the first value
+    mini_block_idx_ = mini_blocks_per_block_;
+    delta_bit_width_ = 0;
+    values_remaining_current_mini_block_ = 0;
+  }
 
+  void InitBlock() {
     if (!decoder_.GetZigZagVlqInt(&min_delta_)) ParquetException::EofException();
-    for (uint32_t i = 0; i < num_mini_blocks_; ++i) {
+    uint8_t* bit_width_data = delta_bit_widths_->mutable_data();
+    for (uint32_t i = 0; i < mini_blocks_per_block_; ++i) {
       if (!decoder_.GetAligned<uint8_t>(1, bit_width_data + i)) {
         ParquetException::EofException();
       }
     }
-    values_per_mini_block_ = block_size / num_mini_blocks_;
     mini_block_idx_ = 0;
-    delta_bit_width_ = bit_width_data[0];
-    values_current_mini_block_ = values_per_mini_block_;
+    InitMiniBlock(bit_width_data[0]);
+  }
+
+  void InitMiniBlock(int bit_width) {
+    if (ARROW_PREDICT_FALSE(bit_width > kMaxDeltaBitWidth)) {
+      throw ParquetException("delta bit width larger than integer bit width");
+    }
+    delta_bit_width_ = bit_width;
+    values_remaining_current_mini_block_ = values_per_mini_block_;
   }
 
-  template <typename T>
   int GetInternal(T* buffer, int max_values) {
-    max_values = std::min(max_values, this->num_values_);
-    const uint8_t* bit_width_data = delta_bit_widths_->data();
-    for (int i = 0; i < max_values; ++i) {
-      if (ARROW_PREDICT_FALSE(values_current_mini_block_ == 0)) {
+    max_values = static_cast<int>(
+        std::min<int64_t>(max_values, static_cast<int64_t>(total_values_remaining_)));
+    if (max_values == 0) return 0;
+
+    int i = 0;
+    while (i < max_values) {
+      if (ARROW_PREDICT_FALSE(values_remaining_current_mini_block_ == 0)) {
+        if (ARROW_PREDICT_FALSE(!first_value_read_)) {
+          // The first value is stored in the header
+          first_value_read_ = true;
+          buffer[i++] = last_value_;
+          continue;
+        }
         ++mini_block_idx_;
-        if (mini_block_idx_ < static_cast<size_t>(delta_bit_widths_->size())) {
-          delta_bit_width_ = bit_width_data[mini_block_idx_];
-          values_current_mini_block_ = values_per_mini_block_;
+        if (mini_block_idx_ < mini_blocks_per_block_) {
+          InitMiniBlock(delta_bit_widths_->data()[mini_block_idx_]);
         } else {
           InitBlock();
-          buffer[i] = last_value_;
-          continue;
         }
       }
 
-      // TODO: the key to this algorithm is to decode the entire miniblock at once.
-      int64_t delta;
-      if (!decoder_.GetValue(delta_bit_width_, &delta)) ParquetException::EofException();
-      delta += min_delta_;
-      last_value_ += static_cast<int32_t>(delta);
-      buffer[i] = last_value_;
-      --values_current_mini_block_;
+      // Unpack as many deltas of the miniblock as needed at once
+      const int values_decode = static_cast<int>(std::min<uint32_t>(
+          values_remaining_current_mini_block_, static_cast<uint32_t>(max_values - i)));
+      if (decoder_.GetBatch(delta_bit_width_, buffer + i, values_decode) !=
+          values_decode) {
+        ParquetException::EofException();
+      }
+      for (int j = 0; j < values_decode; ++j) {
+        // Addition wraps around on overflow, as in the encoder
+        last_value_ = static_cast<T>(static_cast<UT>(min_delta_) +
+                                     static_cast<UT>(buffer[i + j]) +
+                                     static_cast<UT>(last_value_));
+        buffer[i + j] = last_value_;
+      }
+      values_remaining_current_mini_block_ -= values_decode;
+      i += values_decode;
     }
+    total_values_remaining_ -= max_values;
     this->num_values_ -= max_values;
+
+    if (ARROW_PREDICT_FALSE(total_values_remaining_ == 0)) {
+      // Skip the padding of the last miniblock, so that bytes_left() points past the
+      // encoded data
+      if (!decoder_.Advance(static_cast<int64_t>(delta_bit_width_) *
+                            values_remaining_current_mini_block_)) {
+        ParquetException::EofException();
+      }
+      values_remaining_current_mini_block_ = 0;
+    }
     return max_values;
   }
 
-  MemoryPool* pool_;
   ::arrow::BitUtil::BitReader decoder_;
-  uint32_t values_current_block_;
-  uint32_t num_mini_blocks_;
-  uint64_t values_per_mini_block_;
-  uint64_t values_current_mini_block_;
-
-  int32_t min_delta_;
-  size_t mini_block_idx_;
+  uint32_t values_per_block_;
+  uint32_t mini_blocks_per_block_;
+  uint32_t values_per_mini_block_;
+  uint32_t total_value_count_;
+
+  uint32_t total_values_remaining_;
+  bool first_value_read_;
+  uint32_t mini_block_idx_;
   std::shared_ptr<ResizableBuffer> delta_bit_widths_;
   int delta_bit_width_;
+  uint32_t values_remaining_current_mini_block_;
 
-  int32_t last_value_;
+  T min_delta_;
+  T last_value_;
 };
 
 // ----------------------------------------------------------------------
 // DELTA_LENGTH_BYTE_ARRAY
 
+// Append decoded values to an Arrow binary builder, leaving a slot for each null
+void AppendByteArrays(const ByteArray* values, int num_values, int null_count,
+                      const uint8_t* valid_bits, int64_t valid_bits_offset,
+                      typename EncodingTraits<ByteArrayType>::Accumulator* out) {
+  ArrowBinaryHelper helper(out);
+  int value_idx = 0;
+  PARQUET_THROW_NOT_OK(VisitNullBitmapInline(
+      valid_bits, valid_bits_offset, num_values, null_count,
+      [&]() {
+        const ByteArray& value = values[value_idx++];
+        if (ARROW_PREDICT_FALSE(!helper.CanFit(value.len))) {
+          RETURN_NOT_OK(helper.PushChunk());
+        }
+        return helper.Append(value.ptr, static_cast<int32_t>(value.len));
+      },
+      [&]() { return helper.AppendNull(); }));
+}
+
+void AppendByteArrays(const ByteArray* values, int num_values, int null_count,
+                      const uint8_t* valid_bits, int64_t valid_bits_offset,
+                      typename EncodingTraits<ByteArrayType>::DictAccumulator* out) {
+  int value_idx = 0;
+  PARQUET_THROW_NOT_OK(VisitNullBitmapInline(
+      valid_bits, valid_bits_offset, num_values, null_count,
+      [&]() {
+        const ByteArray& value = values[value_idx++];
+        return out->Append(value.ptr, static_cast<int32_t>(value.len));
+      },
+      [&]() { return out->AppendNull(); }));
+}
+
 class DeltaLengthByteArrayDecoder : public DecoderImpl,
                                     virtual public TypedDecoder<ByteArrayType> {
  public:
@@ -2186,29 +2689,39 @@ class DeltaLengthByteArrayDecoder : public DecoderImpl,
                                        MemoryPool* pool = ::arrow::default_memory_pool())
       : DecoderImpl(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY),
         len_decoder_(nullptr, pool),
-        pool_(pool) {}
+        buffered_length_(AllocateBuffer(pool, 0)) {}
 
   void SetData(int num_values, const uint8_t* data, int len) override {
-    num_values_ = num_values;
-    if (len == 0) return;
-    int total_lengths_len = ::arrow::util::SafeLoadAs<int32_t>(data);
-    data += 4;
-    this->len_decoder_.SetData(num_values, data, total_lengths_len);
-    data_ = data + total_lengths_len;
-    this->len_ = len - 4 - total_lengths_len;
+    DecoderImpl::SetData(num_values, data, len);
+    len_decoder_.SetData(num_values, data, len);
+    DecodeLengths();
   }
 
+  // The number of values stored in the page, which doesn't count nulls
+  int ValidValuesCount() const { return num_valid_values_; }
+
   int Decode(ByteArray* buffer, int max_values) override {
-    using VectorT = ArrowPoolVector<int>;
-    max_values = std::min(max_values, num_values_);
-    VectorT lengths(max_values, 0, ::arrow::stl::allocator<int>(pool_));
-    len_decoder_.Decode(lengths.data(), max_values);
+    max_values = std::min(max_values, num_valid_values_);
+    const int32_t* lengths =
+        reinterpret_cast<const int32_t*>(buffered_length_->data()) + length_idx_;
+    int64_t data_size = 0;
+    for (int i = 0; i < max_values; ++i) {
+      if (ARROW_PREDICT_FALSE(lengths[i] < 0)) {
+        throw ParquetException("negative string delta length");
+      }
+      buffer[i].len = static_cast<uint32_t>(lengths[i]);
+      data_size += lengths[i];
+    }
+    if (ARROW_PREDICT_FALSE(data_size > len_)) {
+      ParquetException::EofException();
+    }
     for (int i = 0; i < max_values; ++i) {
-      buffer[i].len = lengths[i];
       buffer[i].ptr = data_;
-      this->data_ += lengths[i];
-      this->len_ -= lengths[i];
+      data_ += buffer[i].len;
     }
+    len_ -= static_cast<int>(data_size);
+    length_idx_ += max_values;
+    num_valid_values_ -= max_values;
     this->num_values_ -= max_values;
     return max_values;
   }
@@ -2216,18 +2729,49 @@ class DeltaLengthByteArrayDecoder : public DecoderImpl,
   int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
                   int64_t valid_bits_offset,
                   typename EncodingTraits<ByteArrayType>::Accumulator* out) override {
-    ParquetException::NYI("DecodeArrow for DeltaLengthByteArrayDecoder");
+    return DecodeArrowImpl(num_values, null_count, valid_bits, valid_bits_offset, out);
   }
 
   int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
                   int64_t valid_bits_offset,
                   typename EncodingTraits<ByteArrayType>::DictAccumulator* out) override {
-    ParquetException::NYI("DecodeArrow for DeltaLengthByteArrayDecoder");
+    return DecodeArrowImpl(num_values, null_count, valid_bits, valid_bits_offset, out);
   }
 
  private:
+  // The values follow all the lengths, so these are decoded up front
+  void DecodeLengths() {
+    num_valid_values_ = len_decoder_.ValidValuesCount();
+    PARQUET_THROW_NOT_OK(
+        buffered_length_->Resize(num_valid_values_ * sizeof(int32_t), false));
+    int32_t* lengths = reinterpret_cast<int32_t*>(buffered_length_->mutable_data());
+    if (len_decoder_.Decode(lengths, num_valid_values_) != num_valid_values_) {
+      ParquetException::EofException();
+    }
+    length_idx_ = 0;
+
+    const int bytes_consumed = len_ - len_decoder_.bytes_left();
+    data_ += bytes_consumed;
+    len_ -= bytes_consumed;
+  }
+
+  template <typename Builder>
+  int DecodeArrowImpl(int num_values, int null_count, const uint8_t* valid_bits,
+                      int64_t valid_bits_offset, Builder* out) {
+    const int values_decoded = num_values - null_count;
+    std::vector<ByteArray> values(values_decoded);
+    if (Decode(values.data(), values_decoded) != values_decoded) {
+      ParquetException::EofException();
+    }
+    AppendByteArrays(values.data(), num_values, null_count, valid_bits,
+                     valid_bits_offset, out);
+    return values_decoded;
+  }
+
   DeltaBitPackDecoder<Int32Type> len_decoder_;
-  ::arrow::MemoryPool* pool_;
+  int num_valid_values_ = 0;
+  int length_idx_ = 0;
+  std::shared_ptr<ResizableBuffer> buffered_length_;
 };
 
 // ----------------------------------------------------------------------
@@ -2241,46 +2785,113 @@ class DeltaByteArrayDecoder : public DecoderImpl,
       : DecoderImpl(descr, Encoding::DELTA_BYTE_ARRAY),
         prefix_len_decoder_(nullptr, pool),
         suffix_decoder_(nullptr, pool),
-        last_value_(0, nullptr) {}
-
-  virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
-    if (len == 0) return;
-    int prefix_len_length = ::arrow::util::SafeLoadAs<int32_t>(data);
-    data += 4;
-    len -= 4;
-    prefix_len_decoder_.SetData(num_values, data, prefix_len_length);
-    data += prefix_len_length;
-    len -= prefix_len_length;
-    suffix_decoder_.SetData(num_values, data, len);
-  }
-
-  // TODO: this doesn't work and requires memory management. We need to allocate
-  // new strings to store the results.
-  virtual int Decode(ByteArray* buffer, int max_values) {
-    max_values = std::min(max_values, this->num_values_);
-    for (int i = 0; i < max_values; ++i) {
-      int prefix_len = 0;
-      prefix_len_decoder_.Decode(&prefix_len, 1);
-      ByteArray suffix = {0, nullptr};
-      suffix_decoder_.Decode(&suffix, 1);
-      buffer[i].len = prefix_len + suffix.len;
-
-      uint8_t* result = reinterpret_cast<uint8_t*>(malloc(buffer[i].len));
-      memcpy(result, last_value_.ptr, prefix_len);
-      memcpy(result + prefix_len, suffix.ptr, suffix.len);
+        buffered_prefix_length_(AllocateBuffer(pool, 0)),
+        buffered_data_(AllocateBuffer(pool, 0)) {}
 
-      buffer[i].ptr = result;
-      last_value_ = buffer[i];
+  void SetData(int num_values, const uint8_t* data, int len) override {
+    DecoderImpl::SetData(num_values, data, len);
+    prefix_len_decoder_.SetData(num_values, data, len);
+    const int num_prefix_lengths = prefix_len_decoder_.ValidValuesCount();
+    PARQUET_THROW_NOT_OK(
+        buffered_prefix_length_->Resize(num_prefix_lengths * sizeof(int32_t), false));
+    int32_t* prefix_lengths =
+        reinterpret_cast<int32_t*>(buffered_prefix_length_->mutable_data());
+    if (prefix_len_decoder_.Decode(prefix_lengths, num_prefix_lengths) !=
+        num_prefix_lengths) {
+      ParquetException::EofException();
+    }
+    const int bytes_consumed = len - prefix_len_decoder_.bytes_left();
+    suffix_decoder_.SetData(num_values, data + bytes_consumed, len - bytes_consumed);
+    if (suffix_decoder_.ValidValuesCount() != num_prefix_lengths) {
+      throw ParquetException("wrong number of suffixes in DELTA_BYTE_ARRAY data");
     }
+    DecodeValues(prefix_lengths, num_prefix_lengths);
+  }
+
+  int Decode(ByteArray* buffer, int max_values) override {
+    max_values = std::min(max_values, num_valid_values_);
+    std::copy(values_.begin() + value_idx_, values_.begin() + value_idx_ + max_values,
+              buffer);
+    value_idx_ += max_values;
+    num_valid_values_ -= max_values;
     this->num_values_ -= max_values;
     return max_values;
   }
 
+  int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset,
+                  typename EncodingTraits<ByteArrayType>::Accumulator* out) override {
+    return DecodeArrowImpl(num_values, null_count, valid_bits, valid_bits_offset, out);
+  }
+
+  int DecodeArrow(int num_values, int null_count, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset,
+                  typename EncodingTraits<ByteArrayType>::DictAccumulator* out) override {
+    return DecodeArrowImpl(num_values, null_count, valid_bits, valid_bits_offset, out);
+  }
+
  private:
+  // Rebuild all values of the page into buffered_data_, so that the returned
+  // ByteArrays stay valid as long as the page data does
+  void DecodeValues(const int32_t* prefix_lengths, int num_values) {
+    std::vector<ByteArray> suffixes(num_values);
+    if (suffix_decoder_.Decode(suffixes.data(), num_values) != num_values) {
+      ParquetException::EofException();
+    }
+    int64_t data_size = 0;
+    uint32_t previous_length = 0;
+    for (int i = 0; i < num_values; ++i) {
+      if (ARROW_PREDICT_FALSE(prefix_lengths[i] < 0 ||
+                              static_cast<uint32_t>(prefix_lengths[i]) >
+                                  previous_length)) {
+        throw ParquetException("invalid prefix length in DELTA_BYTE_ARRAY data");
+      }
+      previous_length = static_cast<uint32_t>(prefix_lengths[i]) + suffixes[i].len;
+      data_size += previous_length;
+    }
+    PARQUET_THROW_NOT_OK(buffered_data_->Resize(data_size, false));
+
+    values_.resize(num_values);
+    uint8_t* out = buffered_data_->mutable_data();
+    const uint8_t* previous = out;
+    for (int i = 0; i < num_values; ++i) {
+      const uint32_t prefix_length = static_cast<uint32_t>(prefix_lengths[i]);
+      if (prefix_length > 0) {
+        memcpy(out, previous, prefix_length);
+      }
+      if (suffixes[i].len > 0) {
+        memcpy(out + prefix_length, suffixes[i].ptr, suffixes[i].len);
+      }
+      values_[i] = ByteArray(prefix_length + suffixes[i].len, out);
+      previous = out;
+      out += values_[i].len;
+    }
+    value_idx_ = 0;
+    num_valid_values_ = num_values;
+  }
+
+  template <typename Builder>
+  int DecodeArrowImpl(int num_values, int null_count, const uint8_t* valid_bits,
+                      int64_t valid_bits_offset, Builder* out) {
+    const int values_decoded = num_values - null_count;
+    if (ARROW_PREDICT_FALSE(values_decoded > num_valid_values_)) {
+      ParquetException::EofException();
+    }
+    AppendByteArrays(values_.data() + value_idx_, num_values, null_count, valid_bits,
+                     valid_bits_offset, out);
+    value_idx_ += values_decoded;
+    num_valid_values_ -= values_decoded;
+    this->num_values_ -= values_decoded;
+    return values_decoded;
+  }
+
   DeltaBitPackDecoder<Int32Type> prefix_len_decoder_;
   DeltaLengthByteArrayDecoder suffix_decoder_;
-  ByteArray last_value_;
+  std::shared_ptr<ResizableBuffer> buffered_prefix_length_;
+  std::shared_ptr<ResizableBuffer> buffered_data_;
+  std::vector<ByteArray> values_;
+  int value_idx_ = 0;
+  int num_valid_values_ = 0;
 };
 
 // ----------------------------------------------------------------------
@@ -2468,6 +3079,26 @@ std::unique_ptr<Encoder> MakeEncoder(Type::type type_num, Encoding::type encodin
         throw ParquetException("BYTE_STREAM_SPLIT only supports FLOAT and DOUBLE");
         break;
     }
+  } else if (encoding == Encoding::DELTA_BINARY_PACKED) {
+    switch (type_num) {
+      case Type::INT32:
+        return std::unique_ptr<Encoder>(new DeltaBitPackEncoder<Int32Type>(descr, pool));
+      case Type::INT64:
+        return std::unique_ptr<Encoder>(new DeltaBitPackEncoder<Int64Type>(descr, pool));
+      default:
+        throw ParquetException("DELTA_BINARY_PACKED only supports INT32 and INT64");
+        break;
+    }
+  } else if (encoding == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    if (type_num == Type::BYTE_ARRAY) {
+      return std::unique_ptr<Encoder>(new DeltaLengthByteArrayEncoder(descr, pool));
+    }
+    throw ParquetException("DELTA_LENGTH_BYTE_ARRAY only supports BYTE_ARRAY");
+  } else if (encoding == Encoding::DELTA_BYTE_ARRAY) {
+    if (type_num == Type::BYTE_ARRAY) {
+      return std::unique_ptr<Encoder>(new DeltaByteArrayEncoder(descr, pool));
+    }
+    throw ParquetException("DELTA_BYTE_ARRAY only supports BYTE_ARRAY");
   } else {
     ParquetException::NYI("Selected encoding is not supported");
   }
@@ -2508,6 +3139,26 @@ std::unique_ptr<Decoder> MakeDecoder(Type::type type_num, Encoding::type encodin
         throw ParquetException("BYTE_STREAM_SPLIT only supports FLOAT and DOUBLE");
         break;
     }
+  } else if (encoding == Encoding::DELTA_BINARY_PACKED) {
+    switch (type_num) {
+      case Type::INT32:
+        return std::unique_ptr<Decoder>(new DeltaBitPackDecoder<Int32Type>(descr));
+      case Type::INT64:
+        return std::unique_ptr<Decoder>(new DeltaBitPackDecoder<Int64Type>(descr));
+      default:
+        throw ParquetException("DELTA_BINARY_PACKED only supports INT32 and INT64");
+        break;
+    }
+  } else if (encoding == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    if (type_num == Type::BYTE_ARRAY) {
+      return std::unique_ptr<Decoder>(new DeltaLengthByteArrayDecoder(descr));
+    }
+    throw ParquetException("DELTA_LENGTH_BYTE_ARRAY only supports BYTE_ARRAY");
+  } else if (encoding == Encoding::DELTA_BYTE_ARRAY) {
+    if (type_num == Type::BYTE_ARRAY) {
+      return std::unique_ptr<Decoder>(new DeltaByteArrayDecoder(descr));
+    }
+    throw ParquetException("DELTA_BYTE_ARRAY only supports BYTE_ARRAY");
   } else {
     ParquetException::NYI("Selected encoding is not supported");
   }
@@ -517,6 +517,55 @@ static void BM_DictDecodingInt64_literals(benchmark::State& state) {
 
 BENCHMARK(BM_DictDecodingInt64_literals)->Range(MIN_RANGE, MAX_RANGE);
 
+// Mostly increasing values, as timestamps or sorted keys, which DELTA_BINARY_PACKED
+// stores with few bits
+template <typename T>
+static std::vector<T> DeltaBitPackValues(int64_t num_values) {
+  std::vector<T> values(num_values);
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<int> d(0, 1000);
+  T value = 1000000;
+  for (auto& v : values) {
+    value += static_cast<T>(d(gen));
+    v = value;
+  }
+  return values;
+}
+
+template <typename Type>
+static void BM_DeltaBitPackEncoding(benchmark::State& state) {
+  using T = typename Type::c_type;
+  const auto values = DeltaBitPackValues<T>(state.range(0));
+  auto encoder = MakeTypedEncoder<Type>(Encoding::DELTA_BINARY_PACKED);
+  for (auto _ : state) {
+    encoder->Put(values.data(), static_cast<int>(values.size()));
+    encoder->FlushValues();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template <typename Type>
+static void BM_DeltaBitPackDecoding(benchmark::State& state) {
+  using T = typename Type::c_type;
+  auto values = DeltaBitPackValues<T>(state.range(0));
+  auto encoder = MakeTypedEncoder<Type>(Encoding::DELTA_BINARY_PACKED);
+  encoder->Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buf = encoder->FlushValues();
+
+  for (auto _ : state) {
+    auto decoder = MakeTypedDecoder<Type>(Encoding::DELTA_BINARY_PACKED);
+    decoder->SetData(static_cast<int>(values.size()), buf->data(),
+                     static_cast<int>(buf->size()));
+    decoder->Decode(values.data(), static_cast<int>(values.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_DeltaBitPackEncoding, Int32Type)->Range(MIN_RANGE, MAX_RANGE);
+BENCHMARK_TEMPLATE(BM_DeltaBitPackEncoding, Int64Type)->Range(MIN_RANGE, MAX_RANGE);
+BENCHMARK_TEMPLATE(BM_DeltaBitPackDecoding, Int32Type)->Range(MIN_RANGE, MAX_RANGE);
+BENCHMARK_TEMPLATE(BM_DeltaBitPackDecoding, Int64Type)->Range(MIN_RANGE, MAX_RANGE);
+
 // ----------------------------------------------------------------------
 // Shared benchmarks for decoding using arrow builders
 
@@ -675,6 +724,49 @@ BENCHMARK_DEFINE_F(BM_ArrowBinaryPlain, DecodeArrowNonNull_Dict)
 BENCHMARK_REGISTER_F(BM_ArrowBinaryPlain, DecodeArrowNonNull_Dict)
     ->Range(MIN_RANGE, MAX_RANGE);
 
+// ----------------------------------------------------------------------
+// Benchmark Decoding from Delta Byte Array Encoding
+class BM_ArrowBinaryDeltaByteArray : public BenchmarkDecodeArrow {
+ public:
+  void DoEncodeArrow() override {
+    auto encoder = MakeTypedEncoder<ByteArrayType>(Encoding::DELTA_BYTE_ARRAY);
+    encoder->Put(*input_array_);
+    buffer_ = encoder->FlushValues();
+  }
+
+  void DoEncodeLowLevel() override {
+    auto encoder = MakeTypedEncoder<ByteArrayType>(Encoding::DELTA_BYTE_ARRAY);
+    encoder->Put(values_.data(), num_values_);
+    buffer_ = encoder->FlushValues();
+  }
+
+  std::unique_ptr<ByteArrayDecoder> InitializeDecoder() override {
+    auto decoder = MakeTypedDecoder<ByteArrayType>(Encoding::DELTA_BYTE_ARRAY);
+    decoder->SetData(num_values_, buffer_->data(), static_cast<int>(buffer_->size()));
+    return decoder;
+  }
+};
+
+BENCHMARK_DEFINE_F(BM_ArrowBinaryDeltaByteArray, EncodeArrow)
+(benchmark::State& state) { EncodeArrowBenchmark(state); }
+BENCHMARK_REGISTER_F(BM_ArrowBinaryDeltaByteArray, EncodeArrow)
+    ->Range(1 << 18, 1 << 20);
+
+BENCHMARK_DEFINE_F(BM_ArrowBinaryDeltaByteArray, EncodeLowLevel)
+(benchmark::State& state) { EncodeLowLevelBenchmark(state); }
+BENCHMARK_REGISTER_F(BM_ArrowBinaryDeltaByteArray, EncodeLowLevel)
+    ->Range(1 << 18, 1 << 20);
+
+BENCHMARK_DEFINE_F(BM_ArrowBinaryDeltaByteArray, DecodeArrow_Dense)
+(benchmark::State& state) { DecodeArrowDenseBenchmark(state); }
+BENCHMARK_REGISTER_F(BM_ArrowBinaryDeltaByteArray, DecodeArrow_Dense)
+    ->Range(MIN_RANGE, MAX_RANGE);
+
+BENCHMARK_DEFINE_F(BM_ArrowBinaryDeltaByteArray, DecodeArrow_Dict)
+(benchmark::State& state) { DecodeArrowDictBenchmark(state); }
+BENCHMARK_REGISTER_F(BM_ArrowBinaryDeltaByteArray, DecodeArrow_Dict)
+    ->Range(MIN_RANGE, MAX_RANGE);
+
 // ----------------------------------------------------------------------
 // Benchmark Decoding from Dictionary Encoding
 class BM_ArrowBinaryDict : public BenchmarkDecodeArrow {
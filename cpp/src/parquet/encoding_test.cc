@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -701,6 +702,35 @@ class EncodingAdHocTyped : public ::testing::Test {
     ::arrow::AssertArraysEqual(*values, *result);
   }
 
+  void DeltaBitPack(int seed) {
+    if (!std::is_same<ParquetType, Int32Type>::value &&
+        !std::is_same<ParquetType, Int64Type>::value) {
+      return;
+    }
+    auto values = GetValues(seed);
+    auto encoder = MakeTypedEncoder<ParquetType>(
+        Encoding::DELTA_BINARY_PACKED, /*use_dictionary=*/false, column_descr());
+    auto decoder =
+        MakeTypedDecoder<ParquetType>(Encoding::DELTA_BINARY_PACKED, column_descr());
+
+    ASSERT_NO_THROW(encoder->Put(*values));
+    auto buf = encoder->FlushValues();
+
+    int num_values = static_cast<int>(values->length() - values->null_count());
+    decoder->SetData(num_values, buf->data(), static_cast<int>(buf->size()));
+
+    BuilderType acc(arrow_type(), ::arrow::default_memory_pool());
+    ASSERT_EQ(num_values,
+              decoder->DecodeArrow(static_cast<int>(values->length()),
+                                   static_cast<int>(values->null_count()),
+                                   values->null_bitmap_data(), values->offset(), &acc));
+
+    std::shared_ptr<::arrow::Array> result;
+    ASSERT_OK(acc.Finish(&result));
+    ASSERT_EQ(50, result->length());
+    ::arrow::AssertArraysEqual(*values, *result);
+  }
+
   void Dict(int seed) {
     if (std::is_same<ParquetType, BooleanType>::value) {
       return;
@@ -839,6 +869,12 @@ TYPED_TEST(EncodingAdHocTyped, ByteStreamSplitArrowDirectPut) {
   }
 }
 
+TYPED_TEST(EncodingAdHocTyped, DeltaBitPackArrowDirectPut) {
+  for (auto seed : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}) {
+    this->DeltaBitPack(seed);
+  }
+}
+
 TEST(DictEncodingAdHoc, ArrowBinaryDirectPut) {
   // Implemented as part of ARROW-3246
   const int64_t size = 50;
@@ -1243,5 +1279,302 @@ TEST(ByteStreamSplitEncodeDecode, InvalidDataTypes) {
   ASSERT_THROW(MakeTypedDecoder<FLBAType>(Encoding::BYTE_STREAM_SPLIT), ParquetException);
 }
 
+
+// ----------------------------------------------------------------------
+// DELTA_BINARY_PACKED encode/decode tests.
+
+template <typename Type>
+class TestDeltaBitPackEncoding : public TestEncodingBase<Type> {
+ public:
+  using c_type = typename Type::c_type;
+  static constexpr int TYPE = Type::type_num;
+
+  void CheckRoundtrip() override {
+    auto encoder =
+        MakeTypedEncoder<Type>(Encoding::DELTA_BINARY_PACKED, false, descr_.get());
+    auto decoder = MakeTypedDecoder<Type>(Encoding::DELTA_BINARY_PACKED, descr_.get());
+    encoder->Put(draws_, num_values_);
+    encode_buffer_ = encoder->FlushValues();
+
+    {
+      decoder->SetData(num_values_, encode_buffer_->data(),
+                       static_cast<int>(encode_buffer_->size()));
+      int values_decoded = decoder->Decode(decode_buf_, num_values_);
+      ASSERT_EQ(num_values_, values_decoded);
+      ASSERT_NO_FATAL_FAILURE(VerifyResults<c_type>(decode_buf_, draws_, num_values_));
+    }
+
+    {
+      // Try again but with a small step, which doesn't line up with miniblocks.
+      decoder->SetData(num_values_, encode_buffer_->data(),
+                       static_cast<int>(encode_buffer_->size()));
+      int step = 131;
+      int remaining = num_values_;
+      for (int i = 0; i < num_values_; i += step) {
+        int num_decoded = decoder->Decode(decode_buf_, step);
+        ASSERT_EQ(num_decoded, std::min(step, remaining));
+        ASSERT_NO_FATAL_FAILURE(
+            VerifyResults<c_type>(decode_buf_, &draws_[i], num_decoded));
+        remaining -= num_decoded;
+      }
+    }
+
+    {
+      std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(num_values_), 0);
+      std::vector<c_type> expected_filtered_output;
+      const int every_nth = 5;
+      expected_filtered_output.reserve((num_values_ + every_nth - 1) / every_nth);
+      ::arrow::internal::BitmapWriter writer{valid_bits.data(), 0, num_values_};
+      // Set every fifth bit.
+      for (int i = 0; i < num_values_; ++i) {
+        if (i % every_nth == 0) {
+          writer.Set();
+          expected_filtered_output.push_back(draws_[i]);
+        }
+        writer.Next();
+      }
+      writer.Finish();
+      const int expected_size = static_cast<int>(expected_filtered_output.size());
+      ASSERT_NO_THROW(encoder->PutSpaced(draws_, num_values_, valid_bits.data(), 0));
+      encode_buffer_ = encoder->FlushValues();
+
+      decoder->SetData(expected_size, encode_buffer_->data(),
+                       static_cast<int>(encode_buffer_->size()));
+      int values_decoded = decoder->Decode(decode_buf_, num_values_);
+      ASSERT_EQ(expected_size, values_decoded);
+      ASSERT_NO_FATAL_FAILURE(VerifyResults<c_type>(
+          decode_buf_, expected_filtered_output.data(), expected_size));
+    }
+  }
+
+  // Round trip an arithmetic sequence, whose deltas are all equal
+  void ExecuteSequence(int nvalues, c_type first, c_type step) {
+    this->InitData(nvalues, 1);
+    for (int i = 0; i < nvalues; ++i) {
+      draws_[i] = static_cast<c_type>(first + step * i);
+    }
+    CheckRoundtrip();
+  }
+
+  // Round trip values alternating between the extremes of the type, whose deltas
+  // overflow
+  void ExecuteExtremes(int nvalues) {
+    this->InitData(nvalues, 1);
+    for (int i = 0; i < nvalues; ++i) {
+      draws_[i] = i % 2 == 0 ? std::numeric_limits<c_type>::min()
+                             : std::numeric_limits<c_type>::max();
+    }
+    CheckRoundtrip();
+  }
+
+  void CheckDecode(const std::vector<uint8_t>& encoded_data,
+                   const std::vector<c_type>& expected_decoded_data) {
+    const int num_elements = static_cast<int>(expected_decoded_data.size());
+    std::unique_ptr<TypedDecoder<Type>> decoder =
+        MakeTypedDecoder<Type>(Encoding::DELTA_BINARY_PACKED);
+    decoder->SetData(num_elements, encoded_data.data(),
+                     static_cast<int>(encoded_data.size()));
+    std::vector<c_type> decoded_data(num_elements);
+    int num_decoded_elements = decoder->Decode(decoded_data.data(), num_elements);
+    ASSERT_EQ(num_elements, num_decoded_elements);
+    ASSERT_EQ(expected_decoded_data, decoded_data);
+    ASSERT_EQ(0, decoder->values_left());
+  }
+
+  void CheckEncode(const std::vector<c_type>& data,
+                   const std::vector<uint8_t>& expected_encoded_data) {
+    std::unique_ptr<TypedEncoder<Type>> encoder =
+        MakeTypedEncoder<Type>(Encoding::DELTA_BINARY_PACKED);
+    encoder->Put(data.data(), static_cast<int>(data.size()));
+    auto encoded_data = encoder->FlushValues();
+    ASSERT_EQ(static_cast<int64_t>(expected_encoded_data.size()), encoded_data->size());
+    for (int64_t i = 0; i < encoded_data->size(); ++i) {
+      ASSERT_EQ(expected_encoded_data[i], encoded_data->data()[i]) << i;
+    }
+  }
+
+ protected:
+  USING_BASE_MEMBERS();
+};
+
+typedef ::testing::Types<Int32Type, Int64Type> DeltaBitPackTypes;
+TYPED_TEST_SUITE(TestDeltaBitPackEncoding, DeltaBitPackTypes);
+
+TYPED_TEST(TestDeltaBitPackEncoding, BasicRoundTrip) {
+  // Sizes around the block and miniblock boundaries
+  for (int values : {0, 1, 2, 31, 32, 33, 127, 128, 129, 1000}) {
+    ASSERT_NO_FATAL_FAILURE(this->Execute(values, 1));
+  }
+  ASSERT_NO_FATAL_FAILURE(this->Execute(1000, 10));
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, Sequences) {
+  for (int values : {1, 100, 1000}) {
+    ASSERT_NO_FATAL_FAILURE(this->ExecuteSequence(values, 0, 0));
+    ASSERT_NO_FATAL_FAILURE(this->ExecuteSequence(values, 7, 1));
+    ASSERT_NO_FATAL_FAILURE(this->ExecuteSequence(values, 1000000, -3));
+  }
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, Extremes) {
+  ASSERT_NO_FATAL_FAILURE(this->ExecuteExtremes(1000));
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, CheckOnlyEncode) {
+  // The examples of the Parquet format specification
+  ASSERT_NO_FATAL_FAILURE(this->CheckEncode(
+      {1, 2, 3, 4, 5}, {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00}));
+  ASSERT_NO_FATAL_FAILURE(
+      this->CheckEncode({7, 5, 3, 1, 2, 3, 4, 5},
+                        {0x80, 0x01, 0x04, 0x08, 0x0e, 0x03, 0x02, 0x00, 0x00,
+                         0x00, 0xc0, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, CheckOnlyDecode) {
+  ASSERT_NO_FATAL_FAILURE(this->CheckDecode(
+      {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00}, {1, 2, 3, 4, 5}));
+  ASSERT_NO_FATAL_FAILURE(
+      this->CheckDecode({0x80, 0x01, 0x04, 0x08, 0x0e, 0x03, 0x02, 0x00, 0x00, 0x00,
+                         0xc0, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+                        {7, 5, 3, 1, 2, 3, 4, 5}));
+}
+
+TEST(DeltaBitPackEncodeDecode, InvalidDataTypes) {
+  ASSERT_THROW(MakeTypedEncoder<BooleanType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<Int96Type>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<FloatType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<DoubleType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<ByteArrayType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<FLBAType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<Int32Type>(Encoding::DELTA_BYTE_ARRAY),
+               ParquetException);
+  ASSERT_THROW(MakeTypedEncoder<FLBAType>(Encoding::DELTA_LENGTH_BYTE_ARRAY),
+               ParquetException);
+
+  ASSERT_THROW(MakeTypedDecoder<BooleanType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedDecoder<DoubleType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedDecoder<ByteArrayType>(Encoding::DELTA_BINARY_PACKED),
+               ParquetException);
+  ASSERT_THROW(MakeTypedDecoder<Int64Type>(Encoding::DELTA_BYTE_ARRAY),
+               ParquetException);
+  ASSERT_THROW(MakeTypedDecoder<FLBAType>(Encoding::DELTA_LENGTH_BYTE_ARRAY),
+               ParquetException);
+}
+
+// ----------------------------------------------------------------------
+// DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY encode/decode tests.
+
+class DeltaByteArrayEncodingBase : public TestArrowBuilderDecoding {
+ protected:
+  void SetupDeltaEncoderDecoder(Encoding::type encoding) {
+    encoder_ = MakeTypedEncoder<ByteArrayType>(encoding);
+    plain_decoder_ = MakeTypedDecoder<ByteArrayType>(encoding);
+    decoder_ = plain_decoder_.get();
+    if (valid_bits_ != nullptr) {
+      ASSERT_NO_THROW(
+          encoder_->PutSpaced(input_data_.data(), num_values_, valid_bits_, 0));
+    } else {
+      ASSERT_NO_THROW(encoder_->Put(input_data_.data(), num_values_));
+    }
+    buffer_ = encoder_->FlushValues();
+    decoder_->SetData(num_values_, buffer_->data(), static_cast<int>(buffer_->size()));
+  }
+};
+
+class DeltaLengthByteArrayEncoding : public DeltaByteArrayEncodingBase {
+ public:
+  void SetupEncoderDecoder() override {
+    SetupDeltaEncoderDecoder(Encoding::DELTA_LENGTH_BYTE_ARRAY);
+  }
+};
+
+TEST_F(DeltaLengthByteArrayEncoding, CheckDecodeArrowUsingDenseBuilder) {
+  this->CheckDecodeArrowUsingDenseBuilder();
+}
+
+TEST_F(DeltaLengthByteArrayEncoding, CheckDecodeArrowUsingDictBuilder) {
+  this->CheckDecodeArrowUsingDictBuilder();
+}
+
+TEST_F(DeltaLengthByteArrayEncoding, CheckDecodeArrowNonNullDenseBuilder) {
+  this->CheckDecodeArrowNonNullUsingDenseBuilder();
+}
+
+TEST_F(DeltaLengthByteArrayEncoding, CheckDecodeArrowNonNullDictBuilder) {
+  this->CheckDecodeArrowNonNullUsingDictBuilder();
+}
+
+class DeltaByteArrayEncoding : public DeltaByteArrayEncodingBase {
+ public:
+  void SetupEncoderDecoder() override {
+    SetupDeltaEncoderDecoder(Encoding::DELTA_BYTE_ARRAY);
+  }
+};
+
+TEST_F(DeltaByteArrayEncoding, CheckDecodeArrowUsingDenseBuilder) {
+  this->CheckDecodeArrowUsingDenseBuilder();
+}
+
+TEST_F(DeltaByteArrayEncoding, CheckDecodeArrowUsingDictBuilder) {
+  this->CheckDecodeArrowUsingDictBuilder();
+}
+
+TEST_F(DeltaByteArrayEncoding, CheckDecodeArrowNonNullDenseBuilder) {
+  this->CheckDecodeArrowNonNullUsingDenseBuilder();
+}
+
+TEST_F(DeltaByteArrayEncoding, CheckDecodeArrowNonNullDictBuilder) {
+  this->CheckDecodeArrowNonNullUsingDictBuilder();
+}
+
+TEST(DeltaByteArrayEncodingAdHoc, SharedPrefixes) {
+  // Sorted values sharing long prefixes, as well as empty and repeated values
+  std::vector<std::string> strings = {"", "", "a"};
+  for (int i = 0; i < 500; ++i) {
+    strings.push_back("parquet/delta/" + std::to_string(1000 + i / 3));
+  }
+  strings.push_back("");
+  strings.push_back("parquet");
+
+  std::vector<ByteArray> values;
+  int64_t total_length = 0;
+  for (const std::string& s : strings) {
+    values.push_back(ByteArray(::arrow::util::string_view(s)));
+    total_length += static_cast<int64_t>(s.size());
+  }
+  const int num_values = static_cast<int>(values.size());
+
+  for (auto encoding : {Encoding::DELTA_LENGTH_BYTE_ARRAY, Encoding::DELTA_BYTE_ARRAY}) {
+    auto encoder = MakeTypedEncoder<ByteArrayType>(encoding);
+    auto decoder = MakeTypedDecoder<ByteArrayType>(encoding);
+    encoder->Put(values.data(), num_values);
+    auto buffer = encoder->FlushValues();
+    if (encoding == Encoding::DELTA_BYTE_ARRAY) {
+      // The shared prefixes aren't stored
+      ASSERT_LT(buffer->size(), total_length);
+    }
+
+    decoder->SetData(num_values, buffer->data(), static_cast<int>(buffer->size()));
+    std::vector<ByteArray> decoded(num_values);
+    const int step = 7;
+    for (int i = 0; i < num_values; i += step) {
+      const int expected_decoded = std::min(step, num_values - i);
+      ASSERT_EQ(expected_decoded, decoder->Decode(decoded.data() + i, step));
+    }
+    ASSERT_EQ(0, decoder->values_left());
+    for (int i = 0; i < num_values; ++i) {
+      ASSERT_EQ(values[i], decoded[i]) << i;
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace parquet
@@ -25,6 +25,7 @@
 #include <string>
 #include <utility>
 
+#include "arrow/buffer.h"
 #include "arrow/io/caching.h"
 #include "arrow/io/file.h"
 #include "arrow/io/memory.h"
@@ -33,6 +34,7 @@
 #include "arrow/util/int_util_internal.h"
 #include "arrow/util/logging.h"
 #include "arrow/util/ubsan.h"
+#include "parquet/bloom_filter.h"
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/encryption/encryption_internal.h"
@@ -40,6 +42,7 @@
 #include "parquet/exception.h"
 #include "parquet/file_writer.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/platform.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
@@ -59,6 +62,15 @@ static constexpr int64_t kMaxDictHeaderSize = 100;
 // ----------------------------------------------------------------------
 // RowGroupReader public API
 
+std::unique_ptr<PageReader> RowGroupReader::Contents::GetColumnPageReader(
+    int i, const OffsetIndex& offset_index, const RowRanges& row_ranges) {
+  return GetColumnPageReader(i);
+}
+
+std::unique_ptr<BloomFilter> RowGroupReader::Contents::GetBloomFilter(int i) {
+  return nullptr;
+}
+
 RowGroupReader::RowGroupReader(std::unique_ptr<Contents> contents)
     : contents_(std::move(contents)) {}
 
@@ -126,6 +138,50 @@ std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(int i) {
   return contents_->GetColumnPageReader(i);
 }
 
+std::unique_ptr<ColumnIndex> RowGroupReader::GetColumnIndex(int i) {
+  if (i >= metadata()->num_columns()) {
+    std::stringstream ss;
+    ss << "Trying to read column index " << i << " but row group metadata has only "
+       << metadata()->num_columns() << " columns";
+    throw ParquetException(ss.str());
+  }
+  return contents_->GetColumnIndex(i);
+}
+
+std::unique_ptr<OffsetIndex> RowGroupReader::GetOffsetIndex(int i) {
+  if (i >= metadata()->num_columns()) {
+    std::stringstream ss;
+    ss << "Trying to read column index " << i << " but row group metadata has only "
+       << metadata()->num_columns() << " columns";
+    throw ParquetException(ss.str());
+  }
+  return contents_->GetOffsetIndex(i);
+}
+
+std::unique_ptr<BloomFilter> RowGroupReader::GetBloomFilter(int i) {
+  if (i >= metadata()->num_columns()) {
+    std::stringstream ss;
+    ss << "Trying to read column index " << i << " but row group metadata has only "
+       << metadata()->num_columns() << " columns";
+    throw ParquetException(ss.str());
+  }
+  return contents_->GetBloomFilter(i);
+}
+
+std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(
+    int i, const OffsetIndex& offset_index, const RowRanges& row_ranges) {
+  if (i >= metadata()->num_columns()) {
+    std::stringstream ss;
+    ss << "Trying to read column index " << i << " but row group metadata has only "
+       << metadata()->num_columns() << " columns";
+    throw ParquetException(ss.str());
+  }
+  if (metadata()->schema()->Column(i)->max_repetition_level() > 0) {
+    throw ParquetException("Pages of repeated columns cannot be selected by row");
+  }
+  return contents_->GetColumnPageReader(i, offset_index, row_ranges);
+}
+
 // Returns the rowgroup metadata
 const RowGroupMetaData* RowGroupReader::metadata() const { return contents_->metadata(); }
 
@@ -247,7 +303,150 @@ class SerializedRowGroup : public RowGroupReader::Contents {
                             properties_.memory_pool(), &ctx);
   }
 
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    // Page indexes of encrypted columns are encrypted as well, which is not supported
+    if (!col->has_column_index() || col->crypto_metadata()) {
+      return nullptr;
+    }
+    std::shared_ptr<Buffer> buffer = ReadIndex(col->column_index_location());
+    return ColumnIndex::Make(row_group_metadata_->schema()->Column(i), buffer->data(),
+                             static_cast<uint32_t>(buffer->size()));
+  }
+
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_offset_index() || col->crypto_metadata()) {
+      return nullptr;
+    }
+    std::shared_ptr<Buffer> buffer = ReadIndex(col->offset_index_location());
+    return OffsetIndex::Make(buffer->data(), static_cast<uint32_t>(buffer->size()));
+  }
+
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_bloom_filter() || col->crypto_metadata()) {
+      return nullptr;
+    }
+    // The bitset follows a thrift BloomFilterHeader, which is read along with what
+    // may be the start of the bitset since its length is not known in advance
+    constexpr int64_t kHeaderLengthGuess = 256;
+    const int64_t offset = col->bloom_filter_offset();
+    if (offset < 0 || offset >= source_size_) {
+      return nullptr;
+    }
+    PARQUET_ASSIGN_OR_THROW(
+        auto header, source_->ReadAt(offset, std::min(kHeaderLengthGuess,
+                                                      source_size_ - offset)));
+    uint32_t header_length = static_cast<uint32_t>(header->size());
+    uint32_t num_bytes;
+    // Filters written by other implementations may use another algorithm or hash,
+    // treat them as missing rather than failing the read
+    try {
+      num_bytes =
+          BlockSplitBloomFilter::DeserializeHeader(header->data(), &header_length);
+    } catch (const ParquetException&) {
+      return nullptr;
+    }
+    if (offset + header_length + num_bytes > source_size_) {
+      return nullptr;
+    }
+    std::shared_ptr<Buffer> bitset;
+    if (header_length + num_bytes <= header->size()) {
+      bitset = SliceBuffer(header, header_length, num_bytes);
+    } else {
+      PARQUET_ASSIGN_OR_THROW(bitset, source_->ReadAt(offset + header_length, num_bytes));
+      if (bitset->size() != num_bytes) {
+        return nullptr;
+      }
+    }
+    std::unique_ptr<BlockSplitBloomFilter> bloom_filter(
+        new BlockSplitBloomFilter(BloomFilter::HashStrategy::XXHASH));
+    try {
+      bloom_filter->Init(bitset->data(), num_bytes);
+    } catch (const ParquetException&) {
+      return nullptr;
+    }
+    return std::move(bloom_filter);
+  }
+
+  std::unique_ptr<PageReader> GetColumnPageReader(int i, const OffsetIndex& offset_index,
+                                                  const RowRanges& row_ranges) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    // Encrypted pages are bound to their ordinal in the column chunk, so they can't be
+    // skipped
+    if (col->crypto_metadata() || offset_index.num_pages() == 0) {
+      return GetColumnPageReader(i);
+    }
+
+    ::arrow::io::ReadRange col_range =
+        ComputeColumnChunkRange(file_metadata_, source_size_, row_group_ordinal_, i);
+    const int64_t col_end = col_range.offset + col_range.length;
+    const std::vector<PageLocation>& locations = offset_index.page_locations();
+
+    // The dictionary page, if any, precedes the first data page
+    std::vector<::arrow::io::ReadRange> ranges;
+    if (locations[0].offset < col_range.offset || locations[0].offset > col_end) {
+      throw ParquetException("Invalid OffsetIndex (corrupt file?)");
+    }
+    if (locations[0].offset > col_range.offset) {
+      ranges.push_back({col_range.offset, locations[0].offset - col_range.offset});
+    }
+
+    const int64_t num_rows = row_group_metadata_->num_rows();
+    int64_t num_values = 0;
+    for (int page : offset_index.PagesInRanges(row_ranges, num_rows)) {
+      const PageLocation& location = locations[page];
+      if (location.offset < col_range.offset ||
+          location.offset + location.compressed_page_size > col_end) {
+        throw ParquetException("Invalid OffsetIndex (corrupt file?)");
+      }
+      if (!ranges.empty() &&
+          ranges.back().offset + ranges.back().length == location.offset) {
+        ranges.back().length += location.compressed_page_size;
+      } else {
+        ranges.push_back({location.offset, location.compressed_page_size});
+      }
+      // Pages of a column without repetition hold one value per row
+      num_values += offset_index.page_row_range(page, num_rows).length();
+    }
+
+    ::arrow::BufferVector buffers;
+    for (const ::arrow::io::ReadRange& range : ranges) {
+      std::shared_ptr<Buffer> buffer;
+      if (cached_source_) {
+        PARQUET_ASSIGN_OR_THROW(buffer, cached_source_->Read(range));
+      } else {
+        PARQUET_ASSIGN_OR_THROW(buffer, source_->ReadAt(range.offset, range.length));
+      }
+      buffers.push_back(std::move(buffer));
+    }
+    std::shared_ptr<Buffer> pages;
+    if (buffers.size() == 1) {
+      pages = std::move(buffers[0]);
+    } else {
+      PARQUET_ASSIGN_OR_THROW(
+          pages, ::arrow::ConcatenateBuffers(buffers, properties_.memory_pool()));
+    }
+    auto stream = std::make_shared<::arrow::io::BufferReader>(std::move(pages));
+    return PageReader::Open(std::move(stream), num_values, col->compression(),
+                            properties_.memory_pool());
+  }
+
  private:
+  std::shared_ptr<Buffer> ReadIndex(const IndexLocation& location) {
+    int64_t index_end;
+    if (location.offset < 0 || location.length < 0 ||
+        AddWithOverflow(location.offset, static_cast<int64_t>(location.length),
+                        &index_end) ||
+        index_end > source_size_) {
+      throw ParquetException("Invalid page index location (corrupt file?)");
+    }
+    PARQUET_ASSIGN_OR_THROW(auto buffer,
+                            source_->ReadAt(location.offset, location.length));
+    return buffer;
+  }
+
   std::shared_ptr<ArrowInputFile> source_;
   // Will be nullptr if PreBuffer() is not called.
   std::shared_ptr<::arrow::io::internal::ReadRangeCache> cached_source_;
@@ -25,11 +25,13 @@
 #include "arrow/io/caching.h"
 #include "arrow/util/type_fwd.h"
 #include "parquet/metadata.h"  // IWYU pragma: keep
+#include "parquet/page_index.h"
 #include "parquet/platform.h"
 #include "parquet/properties.h"
 
 namespace parquet {
 
+class BloomFilter;
 class ColumnReader;
 class FileMetaData;
 class PageReader;
@@ -45,6 +47,13 @@ class PARQUET_EXPORT RowGroupReader {
     virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) = 0;
     virtual const RowGroupMetaData* metadata() const = 0;
     virtual const ReaderProperties* properties() const = 0;
+    virtual std::unique_ptr<ColumnIndex> GetColumnIndex(int i) { return NULLPTR; }
+    virtual std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) { return NULLPTR; }
+    // No Bloom filters by default
+    virtual std::unique_ptr<BloomFilter> GetBloomFilter(int i);
+    // Read every page by default
+    virtual std::unique_ptr<PageReader> GetColumnPageReader(
+        int i, const OffsetIndex& offset_index, const RowRanges& row_ranges);
   };
 
   explicit RowGroupReader(std::unique_ptr<Contents> contents);
@@ -72,6 +81,25 @@ class PARQUET_EXPORT RowGroupReader {
 
   std::unique_ptr<PageReader> GetColumnPageReader(int i);
 
+  // Read the page index of the indicated column, or return nullptr if the column
+  // chunk has none
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i);
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i);
+
+  // Read the Bloom filter of the indicated column, or return nullptr if the column
+  // chunk has none or it can't be read
+  //
+  // \note API EXPERIMENTAL
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i);
+
+  // Construct a PageReader which only yields the dictionary page and the data pages
+  // holding any row within row_ranges, located through the column's OffsetIndex. Only
+  // the bytes of those pages are read. The column must not be repeated.
+  //
+  // \note API EXPERIMENTAL
+  std::unique_ptr<PageReader> GetColumnPageReader(int i, const OffsetIndex& offset_index,
+                                                  const RowRanges& row_ranges);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
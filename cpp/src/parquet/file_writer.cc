@@ -23,10 +23,12 @@
 #include <utility>
 #include <vector>
 
+#include "parquet/bloom_filter.h"
 #include "parquet/column_writer.h"
 #include "parquet/encryption/encryption_internal.h"
 #include "parquet/encryption/internal_file_encryptor.h"
 #include "parquet/exception.h"
+#include "parquet/page_index.h"
 #include "parquet/platform.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
@@ -82,7 +84,9 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   RowGroupSerializer(std::shared_ptr<ArrowOutputStream> sink,
                      RowGroupMetaDataBuilder* metadata, int16_t row_group_ordinal,
                      const WriterProperties* properties, bool buffered_row_group = false,
-                     InternalFileEncryptor* file_encryptor = nullptr)
+                     InternalFileEncryptor* file_encryptor = nullptr,
+                     PageIndexBuilder* page_index_builder = nullptr,
+                     BloomFilterBuilder* bloom_filter_builder = nullptr)
       : sink_(std::move(sink)),
         metadata_(metadata),
         properties_(properties),
@@ -92,7 +96,9 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
         next_column_index_(0),
         num_rows_(0),
         buffered_row_group_(buffered_row_group),
-        file_encryptor_(file_encryptor) {
+        file_encryptor_(file_encryptor),
+        page_index_builder_(page_index_builder),
+        bloom_filter_builder_(bloom_filter_builder) {
     if (buffered_row_group) {
       InitColumns();
     } else {
@@ -134,11 +140,14 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
     auto data_encryptor =
         file_encryptor_ ? file_encryptor_->GetColumnDataEncryptor(path->ToDotString())
                         : nullptr;
+    const int column_ordinal = next_column_index_ - 1;
     std::unique_ptr<PageWriter> pager = PageWriter::Open(
         sink_, properties_->compression(path), properties_->compression_level(path),
-        col_meta, row_group_ordinal_, static_cast<int16_t>(next_column_index_ - 1),
-        properties_->memory_pool(), false, meta_encryptor, data_encryptor);
-    column_writers_[0] = ColumnWriter::Make(col_meta, std::move(pager), properties_);
+        col_meta, row_group_ordinal_, static_cast<int16_t>(column_ordinal),
+        properties_->memory_pool(), false, meta_encryptor, data_encryptor,
+        GetColumnIndexBuilder(column_ordinal), GetOffsetIndexBuilder(column_ordinal));
+    column_writers_[0] = ColumnWriter::Make(col_meta, std::move(pager), properties_,
+                                            GetBloomFilter(column_ordinal));
     return column_writers_[0].get();
   }
 
@@ -207,6 +216,21 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   mutable int64_t num_rows_;
   bool buffered_row_group_;
   InternalFileEncryptor* file_encryptor_;
+  PageIndexBuilder* page_index_builder_;
+  BloomFilterBuilder* bloom_filter_builder_;
+
+  ColumnIndexBuilder* GetColumnIndexBuilder(int i) {
+    return page_index_builder_ ? page_index_builder_->GetColumnIndexBuilder(i) : nullptr;
+  }
+
+  OffsetIndexBuilder* GetOffsetIndexBuilder(int i) {
+    return page_index_builder_ ? page_index_builder_->GetOffsetIndexBuilder(i) : nullptr;
+  }
+
+  BloomFilter* GetBloomFilter(int i) {
+    return bloom_filter_builder_ ? bloom_filter_builder_->GetOrCreateBloomFilter(i)
+                                 : nullptr;
+  }
 
   void CheckRowsWritten() const {
     // verify when only one column is written at a time
@@ -243,10 +267,13 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       std::unique_ptr<PageWriter> pager = PageWriter::Open(
           sink_, properties_->compression(path), properties_->compression_level(path),
           col_meta, static_cast<int16_t>(row_group_ordinal_),
-          static_cast<int16_t>(next_column_index_++), properties_->memory_pool(),
-          buffered_row_group_, meta_encryptor, data_encryptor);
-      column_writers_.push_back(
-          ColumnWriter::Make(col_meta, std::move(pager), properties_));
+          static_cast<int16_t>(next_column_index_), properties_->memory_pool(),
+          buffered_row_group_, meta_encryptor, data_encryptor,
+          GetColumnIndexBuilder(next_column_index_),
+          GetOffsetIndexBuilder(next_column_index_));
+      column_writers_.push_back(ColumnWriter::Make(
+          col_meta, std::move(pager), properties_, GetBloomFilter(next_column_index_)));
+      ++next_column_index_;
     }
   }
 
@@ -280,9 +307,14 @@ class FileSerializer : public ParquetFileWriter::Contents {
       if (row_group_writer_) {
         num_rows_ += row_group_writer_->num_rows();
         row_group_writer_->Close();
+        WriteBloomFilters();
       }
       row_group_writer_.reset();
 
+      if (page_index_builder_) {
+        page_index_builder_->WriteTo(sink_.get(), metadata_.get());
+      }
+
       // Write magic bytes and metadata
       auto file_encryption_properties = properties_->file_encryption_properties();
 
@@ -308,12 +340,20 @@ class FileSerializer : public ParquetFileWriter::Contents {
   RowGroupWriter* AppendRowGroup(bool buffered_row_group) {
     if (row_group_writer_) {
       row_group_writer_->Close();
+      WriteBloomFilters();
     }
     num_row_groups_++;
     auto rg_metadata = metadata_->AppendRowGroup();
+    if (page_index_builder_) {
+      page_index_builder_->AppendRowGroup();
+    }
+    if (bloom_filter_builder_) {
+      bloom_filter_builder_->AppendRowGroup();
+    }
     std::unique_ptr<RowGroupWriter::Contents> contents(new RowGroupSerializer(
         sink_, rg_metadata, static_cast<int16_t>(num_row_groups_ - 1), properties_.get(),
-        buffered_row_group, file_encryptor_.get()));
+        buffered_row_group, file_encryptor_.get(), page_index_builder_.get(),
+        bloom_filter_builder_.get()));
     row_group_writer_.reset(new RowGroupWriter(std::move(contents)));
     return row_group_writer_.get();
   }
@@ -347,6 +387,23 @@ class FileSerializer : public ParquetFileWriter::Contents {
     } else {
       throw ParquetException("Appending to file not implemented.");
     }
+    // Page indexes are not encrypted, so they are only written for plaintext files
+    if (properties_->page_index_enabled() &&
+        properties_->file_encryption_properties() == nullptr) {
+      page_index_builder_.reset(new PageIndexBuilder(&schema_));
+    }
+    // Likewise for Bloom filters
+    if (properties_->file_encryption_properties() == nullptr) {
+      bloom_filter_builder_.reset(new BloomFilterBuilder(&schema_, properties_.get()));
+    }
+  }
+
+  // Write the Bloom filters of the row group which was just closed after its column
+  // chunks, so that they are not all held in memory until the file is closed
+  void WriteBloomFilters() {
+    if (bloom_filter_builder_) {
+      bloom_filter_builder_->WriteTo(sink_.get(), metadata_.get());
+    }
   }
 
   void CloseEncryptedFile(FileEncryptionProperties* file_encryption_properties) {
@@ -384,6 +441,10 @@ class FileSerializer : public ParquetFileWriter::Contents {
   int num_row_groups_;
   int64_t num_rows_;
   std::unique_ptr<FileMetaDataBuilder> metadata_;
+  // Collects the page indexes of all row groups if enabled
+  std::unique_ptr<PageIndexBuilder> page_index_builder_;
+  // Collects the Bloom filters of the current row group
+  std::unique_ptr<BloomFilterBuilder> bloom_filter_builder_;
   // Only one of the row group writers is active at a time
   std::unique_ptr<RowGroupWriter> row_group_writer_;
 
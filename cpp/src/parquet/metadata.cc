@@ -275,6 +275,30 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
 
   inline int64_t index_page_offset() const { return column_metadata_->index_page_offset; }
 
+  inline bool has_column_index() const {
+    return column_->__isset.column_index_offset && column_->__isset.column_index_length;
+  }
+
+  inline IndexLocation column_index_location() const {
+    return {column_->column_index_offset, column_->column_index_length};
+  }
+
+  inline bool has_offset_index() const {
+    return column_->__isset.offset_index_offset && column_->__isset.offset_index_length;
+  }
+
+  inline IndexLocation offset_index_location() const {
+    return {column_->offset_index_offset, column_->offset_index_length};
+  }
+
+  inline bool has_bloom_filter() const {
+    return column_metadata_->__isset.bloom_filter_offset;
+  }
+
+  inline int64_t bloom_filter_offset() const {
+    return column_metadata_->bloom_filter_offset;
+  }
+
   inline int64_t total_compressed_size() const {
     return column_metadata_->total_compressed_size;
   }
@@ -360,6 +384,24 @@ int64_t ColumnChunkMetaData::index_page_offset() const {
   return impl_->index_page_offset();
 }
 
+bool ColumnChunkMetaData::has_column_index() const { return impl_->has_column_index(); }
+
+IndexLocation ColumnChunkMetaData::column_index_location() const {
+  return impl_->column_index_location();
+}
+
+bool ColumnChunkMetaData::has_offset_index() const { return impl_->has_offset_index(); }
+
+IndexLocation ColumnChunkMetaData::offset_index_location() const {
+  return impl_->offset_index_location();
+}
+
+bool ColumnChunkMetaData::has_bloom_filter() const { return impl_->has_bloom_filter(); }
+
+int64_t ColumnChunkMetaData::bloom_filter_offset() const {
+  return impl_->bloom_filter_offset();
+}
+
 Compression::type ColumnChunkMetaData::compression() const {
   return impl_->compression();
 }
@@ -1645,6 +1687,23 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     return current_row_group_builder_.get();
   }
 
+  void SetColumnIndexLocation(int row_group, int column, const IndexLocation& location) {
+    format::ColumnChunk& chunk = row_groups_.at(row_group).columns.at(column);
+    chunk.__set_column_index_offset(location.offset);
+    chunk.__set_column_index_length(location.length);
+  }
+
+  void SetOffsetIndexLocation(int row_group, int column, const IndexLocation& location) {
+    format::ColumnChunk& chunk = row_groups_.at(row_group).columns.at(column);
+    chunk.__set_offset_index_offset(location.offset);
+    chunk.__set_offset_index_length(location.length);
+  }
+
+  void SetBloomFilterOffset(int row_group, int column, int64_t offset) {
+    format::ColumnChunk& chunk = row_groups_.at(row_group).columns.at(column);
+    chunk.meta_data.__set_bloom_filter_offset(offset);
+  }
+
   std::unique_ptr<FileMetaData> Finish() {
     int64_t total_rows = 0;
     for (auto row_group : row_groups_) {
@@ -1774,6 +1833,21 @@ RowGroupMetaDataBuilder* FileMetaDataBuilder::AppendRowGroup() {
   return impl_->AppendRowGroup();
 }
 
+void FileMetaDataBuilder::SetColumnIndexLocation(int row_group, int column,
+                                                 const IndexLocation& location) {
+  impl_->SetColumnIndexLocation(row_group, column, location);
+}
+
+void FileMetaDataBuilder::SetOffsetIndexLocation(int row_group, int column,
+                                                 const IndexLocation& location) {
+  impl_->SetOffsetIndexLocation(row_group, column, location);
+}
+
+void FileMetaDataBuilder::SetBloomFilterOffset(int row_group, int column,
+                                               int64_t offset) {
+  impl_->SetBloomFilterOffset(row_group, column, offset);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish() { return impl_->Finish(); }
 
 std::unique_ptr<FileCryptoMetaData> FileMetaDataBuilder::GetCryptoMetaData() {
@@ -117,6 +117,12 @@ struct PageEncodingStats {
   int32_t count;
 };
 
+/// \brief The location of a ColumnIndex or OffsetIndex in a file
+struct PARQUET_EXPORT IndexLocation {
+  int64_t offset;
+  int32_t length;
+};
+
 /// \brief ColumnChunkMetaData is a proxy around format::ColumnChunkMetaData.
 class PARQUET_EXPORT ColumnChunkMetaData {
  public:
@@ -157,6 +163,12 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t data_page_offset() const;
   bool has_index_page() const;
   int64_t index_page_offset() const;
+  bool has_column_index() const;
+  IndexLocation column_index_location() const;
+  bool has_offset_index() const;
+  IndexLocation offset_index_location() const;
+  bool has_bloom_filter() const;
+  int64_t bloom_filter_offset() const;
   int64_t total_compressed_size() const;
   int64_t total_uncompressed_size() const;
   std::unique_ptr<ColumnCryptoMetaData> crypto_metadata() const;
@@ -464,6 +476,13 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // The prior RowGroupMetaDataBuilder (if any) is destroyed
   RowGroupMetaDataBuilder* AppendRowGroup();
 
+  // Record where the page index of a column chunk of an appended row group was written
+  void SetColumnIndexLocation(int row_group, int column, const IndexLocation& location);
+  void SetOffsetIndexLocation(int row_group, int column, const IndexLocation& location);
+
+  // Record where the bloom filter of a column chunk of an appended row group was written
+  void SetBloomFilterOffset(int row_group, int column, int64_t offset);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish();
 
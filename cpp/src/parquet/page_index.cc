@@ -0,0 +1,262 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/page_index.h"
+
+#include <utility>
+
+#include "parquet/exception.h"
+#include "parquet/metadata.h"
+#include "parquet/schema.h"
+#include "parquet/statistics.h"
+#include "parquet/thrift_internal.h"
+
+namespace parquet {
+
+int64_t RowRangesLength(const RowRanges& ranges) {
+  int64_t length = 0;
+  for (const RowRange& range : ranges) {
+    length += range.length();
+  }
+  return length;
+}
+
+// ----------------------------------------------------------------------
+// OffsetIndex
+
+std::unique_ptr<OffsetIndex> OffsetIndex::Make(const void* serialized_index,
+                                               uint32_t index_len) {
+  format::OffsetIndex index;
+  DeserializeThriftMsg(reinterpret_cast<const uint8_t*>(serialized_index), &index_len,
+                       &index);
+
+  std::vector<PageLocation> page_locations;
+  page_locations.reserve(index.page_locations.size());
+  for (const format::PageLocation& location : index.page_locations) {
+    if (location.offset < 0 || location.compressed_page_size < 0 ||
+        location.first_row_index < 0 ||
+        (!page_locations.empty() &&
+         location.first_row_index < page_locations.back().first_row_index)) {
+      throw ParquetException("Invalid OffsetIndex (corrupt file?)");
+    }
+    page_locations.push_back(
+        {location.offset, location.compressed_page_size, location.first_row_index});
+  }
+  return std::unique_ptr<OffsetIndex>(new OffsetIndex(std::move(page_locations)));
+}
+
+RowRange OffsetIndex::page_row_range(int i, int64_t num_rows) const {
+  const int64_t next_first_row = i + 1 < num_pages()
+                                     ? page_locations_[i + 1].first_row_index
+                                     : num_rows;
+  return {page_locations_[i].first_row_index, next_first_row - 1};
+}
+
+std::vector<int> OffsetIndex::PagesInRanges(const RowRanges& ranges,
+                                            int64_t num_rows) const {
+  std::vector<int> pages;
+  size_t r = 0;
+  for (int i = 0; i < num_pages(); ++i) {
+    const RowRange page = page_row_range(i, num_rows);
+    if (page.length() <= 0) continue;
+
+    // Skip the ranges which end before this page
+    while (r < ranges.size() && ranges[r].last < page.first) ++r;
+    if (r == ranges.size()) break;
+
+    if (ranges[r].first <= page.last) {
+      pages.push_back(i);
+    }
+  }
+  return pages;
+}
+
+RowRanges OffsetIndex::ExpandToPages(const RowRanges& ranges, int64_t num_rows) const {
+  RowRanges expanded;
+  for (int i : PagesInRanges(ranges, num_rows)) {
+    const RowRange page = page_row_range(i, num_rows);
+    if (!expanded.empty() && expanded.back().last + 1 == page.first) {
+      expanded.back().last = page.last;
+    } else {
+      expanded.push_back(page);
+    }
+  }
+  return expanded;
+}
+
+// ----------------------------------------------------------------------
+// ColumnIndex
+
+std::unique_ptr<ColumnIndex> ColumnIndex::Make(const ColumnDescriptor* descr,
+                                               const void* serialized_index,
+                                               uint32_t index_len) {
+  format::ColumnIndex index;
+  DeserializeThriftMsg(reinterpret_cast<const uint8_t*>(serialized_index), &index_len,
+                       &index);
+
+  const size_t num_pages = index.null_pages.size();
+  if (index.min_values.size() != num_pages || index.max_values.size() != num_pages ||
+      (index.__isset.null_counts && index.null_counts.size() != num_pages)) {
+    throw ParquetException("Invalid ColumnIndex (corrupt file?)");
+  }
+
+  std::unique_ptr<ColumnIndex> result(new ColumnIndex(descr));
+  result->null_pages_ = std::move(index.null_pages);
+  result->min_values_ = std::move(index.min_values);
+  result->max_values_ = std::move(index.max_values);
+  if (index.__isset.null_counts) {
+    result->null_counts_ = std::move(index.null_counts);
+  }
+  return result;
+}
+
+std::shared_ptr<Statistics> ColumnIndex::page_statistics(int i, int64_t num_values,
+                                                         MemoryPool* pool) const {
+  const bool null_page = null_pages_[i];
+  bool has_null_count = has_null_counts();
+  int64_t null_count = 0;
+  if (null_page) {
+    has_null_count = true;
+    null_count = num_values;
+  } else if (has_null_count) {
+    null_count = null_counts_[i];
+  }
+  return Statistics::Make(descr_, min_values_[i], max_values_[i],
+                          num_values - null_count, null_count,
+                          /*distinct_count=*/0, /*has_min_max=*/!null_page,
+                          has_null_count, /*has_distinct_count=*/false, pool);
+}
+
+// ----------------------------------------------------------------------
+// Builders
+
+void ColumnIndexBuilder::AddPage(const EncodedStatistics& stats, int64_t num_values) {
+  if (!valid_) return;
+
+  if (stats.has_null_count && stats.null_count == num_values) {
+    null_pages_.push_back(true);
+    min_values_.emplace_back();
+    max_values_.emplace_back();
+  } else if (stats.has_min && stats.has_max) {
+    null_pages_.push_back(false);
+    min_values_.push_back(stats.min());
+    max_values_.push_back(stats.max());
+  } else {
+    // Statistics are disabled or were dropped for exceeding the size limit
+    valid_ = false;
+    return;
+  }
+
+  if (stats.has_null_count) {
+    null_counts_.push_back(stats.null_count);
+  } else {
+    has_null_counts_ = false;
+  }
+}
+
+int64_t ColumnIndexBuilder::WriteTo(ArrowOutputStream* sink) const {
+  format::ColumnIndex index;
+  index.__set_null_pages(null_pages_);
+  index.__set_min_values(min_values_);
+  index.__set_max_values(max_values_);
+  index.__set_boundary_order(format::BoundaryOrder::UNORDERED);
+  if (has_null_counts_) {
+    index.__set_null_counts(null_counts_);
+  }
+  ThriftSerializer serializer;
+  return serializer.Serialize(&index, sink);
+}
+
+void OffsetIndexBuilder::AddPage(int64_t offset, int32_t compressed_page_size,
+                                 int64_t first_row_index) {
+  page_locations_.push_back({offset, compressed_page_size, first_row_index});
+}
+
+void OffsetIndexBuilder::Finish(int64_t final_position) {
+  for (PageLocation& location : page_locations_) {
+    location.offset += final_position;
+  }
+}
+
+int64_t OffsetIndexBuilder::WriteTo(ArrowOutputStream* sink) const {
+  std::vector<format::PageLocation> page_locations(page_locations_.size());
+  for (size_t i = 0; i < page_locations_.size(); ++i) {
+    page_locations[i].__set_offset(page_locations_[i].offset);
+    page_locations[i].__set_compressed_page_size(
+        page_locations_[i].compressed_page_size);
+    page_locations[i].__set_first_row_index(page_locations_[i].first_row_index);
+  }
+  format::OffsetIndex index;
+  index.__set_page_locations(page_locations);
+  ThriftSerializer serializer;
+  return serializer.Serialize(&index, sink);
+}
+
+void PageIndexBuilder::AppendRowGroup() {
+  column_index_builders_.emplace_back(schema_->num_columns());
+  offset_index_builders_.emplace_back(schema_->num_columns());
+}
+
+ColumnIndexBuilder* PageIndexBuilder::GetColumnIndexBuilder(int i) {
+  if (column_index_builders_.empty() || schema_->Column(i)->max_repetition_level() > 0) {
+    return nullptr;
+  }
+  auto& builder = column_index_builders_.back()[i];
+  if (builder == nullptr) {
+    builder.reset(new ColumnIndexBuilder());
+  }
+  return builder.get();
+}
+
+OffsetIndexBuilder* PageIndexBuilder::GetOffsetIndexBuilder(int i) {
+  if (offset_index_builders_.empty() || schema_->Column(i)->max_repetition_level() > 0) {
+    return nullptr;
+  }
+  auto& builder = offset_index_builders_.back()[i];
+  if (builder == nullptr) {
+    builder.reset(new OffsetIndexBuilder());
+  }
+  return builder.get();
+}
+
+void PageIndexBuilder::WriteTo(ArrowOutputStream* sink,
+                               FileMetaDataBuilder* metadata) const {
+  // As in parquet-mr, the column indexes of all row groups come first, followed by
+  // the offset indexes
+  for (size_t rg = 0; rg < column_index_builders_.size(); ++rg) {
+    for (size_t col = 0; col < column_index_builders_[rg].size(); ++col) {
+      const auto& builder = column_index_builders_[rg][col];
+      if (builder == nullptr || !builder->valid()) continue;
+      PARQUET_ASSIGN_OR_THROW(int64_t offset, sink->Tell());
+      const int64_t length = builder->WriteTo(sink);
+      metadata->SetColumnIndexLocation(static_cast<int>(rg), static_cast<int>(col),
+                                       {offset, static_cast<int32_t>(length)});
+    }
+  }
+  for (size_t rg = 0; rg < offset_index_builders_.size(); ++rg) {
+    for (size_t col = 0; col < offset_index_builders_[rg].size(); ++col) {
+      const auto& builder = offset_index_builders_[rg][col];
+      if (builder == nullptr) continue;
+      PARQUET_ASSIGN_OR_THROW(int64_t offset, sink->Tell());
+      const int64_t length = builder->WriteTo(sink);
+      metadata->SetOffsetIndexLocation(static_cast<int>(rg), static_cast<int>(col),
+                                       {offset, static_cast<int32_t>(length)});
+    }
+  }
+}
+
+}  // namespace parquet
@@ -0,0 +1,200 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Page indexes (the ColumnIndex and OffsetIndex structures of the Parquet format)
+// describe every data page of a column chunk, so that readers can skip the pages
+// which hold no row they need.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/platform.h"
+#include "parquet/types.h"
+
+namespace parquet {
+
+class ColumnDescriptor;
+class EncodedStatistics;
+class FileMetaDataBuilder;
+class SchemaDescriptor;
+class Statistics;
+
+/// \brief An inclusive range of row indices of a row group
+struct PARQUET_EXPORT RowRange {
+  int64_t first;
+  int64_t last;
+
+  int64_t length() const { return last - first + 1; }
+};
+
+/// \brief Sorted and disjoint row ranges of a row group
+using RowRanges = std::vector<RowRange>;
+
+/// \brief Return the number of rows in the given ranges
+PARQUET_EXPORT
+int64_t RowRangesLength(const RowRanges& ranges);
+
+/// \brief The location of a data page of a column chunk
+struct PARQUET_EXPORT PageLocation {
+  /// Offset of the page (including its header) in the file
+  int64_t offset;
+  /// Size of the page, including its header
+  int32_t compressed_page_size;
+  /// Index of the first row of the page within the row group
+  int64_t first_row_index;
+};
+
+/// \brief The locations of the data pages of a column chunk
+class PARQUET_EXPORT OffsetIndex {
+ public:
+  /// \brief Deserialize an OffsetIndex as written in a Parquet file
+  static std::unique_ptr<OffsetIndex> Make(const void* serialized_index,
+                                           uint32_t index_len);
+
+  explicit OffsetIndex(std::vector<PageLocation> page_locations)
+      : page_locations_(std::move(page_locations)) {}
+
+  int num_pages() const { return static_cast<int>(page_locations_.size()); }
+
+  const std::vector<PageLocation>& page_locations() const { return page_locations_; }
+
+  /// \brief Return the row range of the i-th page, given the number of rows of the
+  /// row group
+  RowRange page_row_range(int i, int64_t num_rows) const;
+
+  /// \brief Return the indices of the pages holding any row of the given ranges
+  std::vector<int> PagesInRanges(const RowRanges& ranges, int64_t num_rows) const;
+
+  /// \brief Widen the given ranges to the boundaries of the pages they touch
+  RowRanges ExpandToPages(const RowRanges& ranges, int64_t num_rows) const;
+
+ private:
+  std::vector<PageLocation> page_locations_;
+};
+
+/// \brief The statistics of the data pages of a column chunk
+class PARQUET_EXPORT ColumnIndex {
+ public:
+  /// \brief Deserialize a ColumnIndex as written in a Parquet file
+  static std::unique_ptr<ColumnIndex> Make(const ColumnDescriptor* descr,
+                                           const void* serialized_index,
+                                           uint32_t index_len);
+
+  int num_pages() const { return static_cast<int>(null_pages_.size()); }
+
+  /// \brief Whether each page holds only null values
+  const std::vector<bool>& null_pages() const { return null_pages_; }
+
+  /// \brief The plain-encoded minimum value of each page; empty for null pages
+  const std::vector<std::string>& encoded_min_values() const { return min_values_; }
+
+  /// \brief The plain-encoded maximum value of each page; empty for null pages
+  const std::vector<std::string>& encoded_max_values() const { return max_values_; }
+
+  bool has_null_counts() const { return !null_counts_.empty(); }
+
+  const std::vector<int64_t>& null_counts() const { return null_counts_; }
+
+  /// \brief Return the statistics of the i-th page, given the number of values it
+  /// holds (for example from the OffsetIndex)
+  std::shared_ptr<Statistics> page_statistics(
+      int i, int64_t num_values,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool()) const;
+
+ private:
+  explicit ColumnIndex(const ColumnDescriptor* descr) : descr_(descr) {}
+
+  const ColumnDescriptor* descr_;
+  std::vector<bool> null_pages_;
+  std::vector<std::string> min_values_;
+  std::vector<std::string> max_values_;
+  std::vector<int64_t> null_counts_;
+};
+
+/// \brief Collects the statistics of the data pages of a column chunk as they are
+/// written
+class PARQUET_EXPORT ColumnIndexBuilder {
+ public:
+  /// \brief Record the statistics of the next data page, holding num_values values
+  void AddPage(const EncodedStatistics& stats, int64_t num_values);
+
+  /// \brief False if some page had no usable statistics, in which case no ColumnIndex
+  /// can be written
+  bool valid() const { return valid_; }
+
+  /// \brief Serialize the ColumnIndex, returning the number of bytes written
+  int64_t WriteTo(ArrowOutputStream* sink) const;
+
+ private:
+  bool valid_ = true;
+  bool has_null_counts_ = true;
+  std::vector<bool> null_pages_;
+  std::vector<std::string> min_values_;
+  std::vector<std::string> max_values_;
+  std::vector<int64_t> null_counts_;
+};
+
+/// \brief Collects the locations of the data pages of a column chunk as they are
+/// written
+class PARQUET_EXPORT OffsetIndexBuilder {
+ public:
+  /// \brief Record the location of the next data page
+  void AddPage(int64_t offset, int32_t compressed_page_size, int64_t first_row_index);
+
+  /// \brief Shift the recorded offsets by the position at which pages written to an
+  /// intermediate buffer were copied to the file
+  void Finish(int64_t final_position);
+
+  /// \brief Serialize the OffsetIndex, returning the number of bytes written
+  int64_t WriteTo(ArrowOutputStream* sink) const;
+
+ private:
+  std::vector<PageLocation> page_locations_;
+};
+
+/// \brief Collects the page indexes of every column chunk of a file, to be written
+/// together before the file footer
+class PARQUET_EXPORT PageIndexBuilder {
+ public:
+  explicit PageIndexBuilder(const SchemaDescriptor* schema) : schema_(schema) {}
+
+  /// \brief Start collecting the page indexes of a new row group
+  void AppendRowGroup();
+
+  /// \brief Return the builders for the i-th column of the current row group, or
+  /// nullptr if the column does not get a page index
+  ///
+  /// Page indexes are only kept for columns without repetition, whose data pages
+  /// always start at a row boundary.
+  ColumnIndexBuilder* GetColumnIndexBuilder(int i);
+  OffsetIndexBuilder* GetOffsetIndexBuilder(int i);
+
+  /// \brief Write all page indexes to the sink and record their locations in the
+  /// file metadata
+  void WriteTo(ArrowOutputStream* sink, FileMetaDataBuilder* metadata) const;
+
+ private:
+  const SchemaDescriptor* schema_;
+  std::vector<std::vector<std::unique_ptr<ColumnIndexBuilder>>> column_index_builders_;
+  std::vector<std::vector<std::unique_ptr<OffsetIndexBuilder>>> offset_index_builders_;
+};
+
+}  // namespace parquet
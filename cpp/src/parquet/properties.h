@@ -112,6 +112,19 @@ static constexpr int64_t DEFAULT_MAX_STATISTICS_SIZE = 4096;
 static constexpr Encoding::type DEFAULT_ENCODING = Encoding::PLAIN;
 static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE = Compression::UNCOMPRESSED;
+static constexpr int64_t DEFAULT_BLOOM_FILTER_NDV = 1024 * 1024;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.05;
+
+/// \brief Sizing of the bloom filter written for a column chunk
+struct PARQUET_EXPORT BloomFilterOptions {
+  /// Maximum number of distinct values the filter of a column chunk is sized for,
+  /// capped by the maximum row group length. Filters are sized for the actual number
+  /// of distinct values of their chunk when it is lower, which takes buffering the
+  /// hashes of up to about twice this many values while the chunk is written.
+  int64_t ndv = DEFAULT_BLOOM_FILTER_NDV;
+  /// Targeted probability of false positives for that many distinct values
+  double fpp = DEFAULT_BLOOM_FILTER_FPP;
+};
 
 class PARQUET_EXPORT ColumnProperties {
  public:
@@ -147,6 +160,14 @@ class PARQUET_EXPORT ColumnProperties {
     compression_level_ = compression_level;
   }
 
+  void set_bloom_filter_enabled(bool bloom_filter_enabled) {
+    bloom_filter_enabled_ = bloom_filter_enabled;
+  }
+
+  void set_bloom_filter_options(const BloomFilterOptions& bloom_filter_options) {
+    bloom_filter_options_ = bloom_filter_options;
+  }
+
   Encoding::type encoding() const { return encoding_; }
 
   Compression::type compression() const { return codec_; }
@@ -159,6 +180,10 @@ class PARQUET_EXPORT ColumnProperties {
 
   int compression_level() const { return compression_level_; }
 
+  bool bloom_filter_enabled() const { return bloom_filter_enabled_; }
+
+  const BloomFilterOptions& bloom_filter_options() const { return bloom_filter_options_; }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -166,6 +191,8 @@ class PARQUET_EXPORT ColumnProperties {
   bool statistics_enabled_;
   size_t max_stats_size_;
   int compression_level_;
+  bool bloom_filter_enabled_ = false;
+  BloomFilterOptions bloom_filter_options_;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -180,7 +207,8 @@ class PARQUET_EXPORT WriterProperties {
           pagesize_(kDefaultDataPageSize),
           version_(ParquetVersion::PARQUET_1_0),
           data_page_version_(ParquetDataPageVersion::V1),
-          created_by_(DEFAULT_CREATED_BY) {}
+          created_by_(DEFAULT_CREATED_BY),
+          write_page_index_(false) {}
     virtual ~Builder() {}
 
     Builder* memory_pool(MemoryPool* pool) {
@@ -251,6 +279,20 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /// Write a page index (ColumnIndex and OffsetIndex) for every column chunk
+    /// without repetition, so that readers can skip the data pages which cannot hold
+    /// the rows they need. The page index is not written for encrypted files.
+    /// Default disabled.
+    Builder* enable_write_page_index() {
+      write_page_index_ = true;
+      return this;
+    }
+
+    Builder* disable_write_page_index() {
+      write_page_index_ = false;
+      return this;
+    }
+
     /**
      * Define the encoding that is used when we don't utilise dictionary encoding.
      *
@@ -397,6 +439,32 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_statistics(path->ToDotString());
     }
 
+    /// Write a bloom filter of the values of each column chunk of the column.
+    ///
+    /// Bloom filters let readers skip the row groups which cannot hold a value they
+    /// look up by equality, which min/max statistics cannot do for unordered values
+    /// such as random identifiers. They are not written for boolean columns, nor
+    /// for encrypted files.
+    Builder* enable_bloom_filter(const std::string& path,
+                                 const BloomFilterOptions& options = {}) {
+      bloom_filter_options_[path] = options;
+      return this;
+    }
+
+    Builder* enable_bloom_filter(const std::shared_ptr<schema::ColumnPath>& path,
+                                 const BloomFilterOptions& options = {}) {
+      return this->enable_bloom_filter(path->ToDotString(), options);
+    }
+
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_options_.erase(path);
+      return this;
+    }
+
+    Builder* disable_bloom_filter(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_bloom_filter(path->ToDotString());
+    }
+
     std::shared_ptr<WriterProperties> build() {
       std::unordered_map<std::string, ColumnProperties> column_properties;
       auto get = [&](const std::string& key) -> ColumnProperties& {
@@ -415,11 +483,16 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_dictionary_enabled(item.second);
       for (const auto& item : statistics_enabled_)
         get(item.first).set_statistics_enabled(item.second);
+      for (const auto& item : bloom_filter_options_) {
+        get(item.first).set_bloom_filter_enabled(true);
+        get(item.first).set_bloom_filter_options(item.second);
+      }
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_, dictionary_pagesize_limit_, write_batch_size_, max_row_group_length_,
           pagesize_, version_, created_by_, std::move(file_encryption_properties_),
-          default_column_properties_, column_properties, data_page_version_));
+          default_column_properties_, column_properties, data_page_version_,
+          write_page_index_));
     }
 
    private:
@@ -431,6 +504,7 @@ class PARQUET_EXPORT WriterProperties {
     ParquetVersion::type version_;
     ParquetDataPageVersion data_page_version_;
     std::string created_by_;
+    bool write_page_index_;
 
     std::shared_ptr<FileEncryptionProperties> file_encryption_properties_;
 
@@ -441,6 +515,7 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, int32_t> codecs_compression_level_;
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
+    std::unordered_map<std::string, BloomFilterOptions> bloom_filter_options_;
   };
 
   inline MemoryPool* memory_pool() const { return pool_; }
@@ -461,6 +536,8 @@ class PARQUET_EXPORT WriterProperties {
 
   inline std::string created_by() const { return parquet_created_by_; }
 
+  inline bool page_index_enabled() const { return write_page_index_; }
+
   inline Encoding::type dictionary_index_encoding() const {
     if (parquet_version_ == ParquetVersion::PARQUET_1_0) {
       return Encoding::PLAIN_DICTIONARY;
@@ -508,6 +585,15 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).max_statistics_size();
   }
 
+  bool bloom_filter_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_enabled();
+  }
+
+  const BloomFilterOptions& bloom_filter_options(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_options();
+  }
+
   inline FileEncryptionProperties* file_encryption_properties() const {
     return file_encryption_properties_.get();
   }
@@ -529,7 +615,7 @@ class PARQUET_EXPORT WriterProperties {
       std::shared_ptr<FileEncryptionProperties> file_encryption_properties,
       const ColumnProperties& default_column_properties,
       const std::unordered_map<std::string, ColumnProperties>& column_properties,
-      ParquetDataPageVersion data_page_version)
+      ParquetDataPageVersion data_page_version, bool write_page_index)
       : pool_(pool),
         dictionary_pagesize_limit_(dictionary_pagesize_limit),
         write_batch_size_(write_batch_size),
@@ -538,6 +624,7 @@ class PARQUET_EXPORT WriterProperties {
         parquet_data_page_version_(data_page_version),
         parquet_version_(version),
         parquet_created_by_(created_by),
+        write_page_index_(write_page_index),
         file_encryption_properties_(file_encryption_properties),
         default_column_properties_(default_column_properties),
         column_properties_(column_properties) {}
@@ -550,6 +637,7 @@ class PARQUET_EXPORT WriterProperties {
   ParquetDataPageVersion parquet_data_page_version_;
   ParquetVersion::type parquet_version_;
   std::string parquet_created_by_;
+  bool write_page_index_;
 
   std::shared_ptr<FileEncryptionProperties> file_encryption_properties_;
 
@@ -573,6 +661,7 @@ class PARQUET_EXPORT ArrowReaderProperties {
   explicit ArrowReaderProperties(bool use_threads = kArrowDefaultUseThreads)
       : use_threads_(use_threads),
         read_dict_indices_(),
+        unify_dictionaries_(false),
         batch_size_(kArrowDefaultBatchSize),
         pre_buffer_(false),
         cache_options_(::arrow::io::CacheOptions::Defaults()),
@@ -597,6 +686,20 @@ class PARQUET_EXPORT ArrowReaderProperties {
     }
   }
 
+  /// Keep a single dictionary per column read as dictionary (see
+  /// set_read_dictionary) across all row groups and batches.
+  ///
+  /// By default, each row group produces a chunk with its own dictionary. When
+  /// enabled, the values of each new dictionary page are merged into the
+  /// dictionary read so far and the page's indices are remapped to it, so that
+  /// successive chunks have growing, prefix-compatible dictionaries and indices
+  /// never need to be decoded to strings.
+  void set_unify_dictionaries(bool unify_dictionaries) {
+    unify_dictionaries_ = unify_dictionaries;
+  }
+
+  bool unify_dictionaries() const { return unify_dictionaries_; }
+
   void set_batch_size(int64_t batch_size) { batch_size_ = batch_size; }
 
   int64_t batch_size() const { return batch_size_; }
@@ -634,6 +737,7 @@ class PARQUET_EXPORT ArrowReaderProperties {
  private:
   bool use_threads_;
   std::unordered_set<int> read_dict_indices_;
+  bool unify_dictionaries_;
   int64_t batch_size_;
   bool pre_buffer_;
   ::arrow::io::IOContext io_context_;